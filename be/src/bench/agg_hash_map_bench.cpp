@@ -0,0 +1,123 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+#include "bench.h"
+#include "column/column_helper.h"
+#include "exec/aggregate/agg_hash_variant.h"
+#include "runtime/mem_pool.h"
+
+namespace starrocks {
+
+// Compare the build throughput of the serialized key hash map (phase1_slice) with the fixed size one
+// (phase1_slice_fx32) on a typical wide group by: (int date, int date, int dict code, bigint id, bigint id),
+// which takes 28 bytes after serialization.
+class AggHashMapBench {
+public:
+    explicit AggHashMapBench(size_t num_groups) : _num_groups(num_groups) {}
+
+    void SetUp();
+
+    template <class HashMapWithKey>
+    size_t build();
+
+    size_t num_rows() const { return kNumChunks * kTestChunkSize; }
+
+private:
+    static constexpr size_t kNumChunks = 256;
+
+    size_t _num_groups;
+    std::vector<Columns> _chunks;
+};
+
+void AggHashMapBench::SetUp() {
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<int64_t> dist(0, static_cast<int64_t>(_num_groups) - 1);
+    for (size_t i = 0; i < kNumChunks; i++) {
+        auto date1 = Int32Column::create();
+        auto date2 = Int32Column::create();
+        auto dict_code = Int32Column::create();
+        auto id1 = Int64Column::create();
+        auto id2 = Int64Column::create();
+        for (size_t j = 0; j < kTestChunkSize; j++) {
+            // All the columns are derived from the group id, so that there are at most _num_groups groups.
+            int64_t group = dist(rng);
+            date1->append(static_cast<int32_t>(20230101 + group % 365));
+            date2->append(static_cast<int32_t>(20230101 + group % 31));
+            dict_code->append(static_cast<int32_t>(group % 64));
+            id1->append(group);
+            id2->append(group * 1000003);
+        }
+        _chunks.emplace_back(Columns{date1, date2, dict_code, id1, id2});
+    }
+}
+
+template <class HashMapWithKey>
+size_t AggHashMapBench::build() {
+    RuntimeProfile profile("AggHashMapBench");
+    AggStatistics agg_stat(&profile);
+    MemPool pool;
+    HashMapWithKey hash_map_with_key(kTestChunkSize, &agg_stat);
+    if constexpr (is_combined_fixed_size_key<HashMapWithKey>) {
+        hash_map_with_key.has_null_column = false;
+        hash_map_with_key.fixed_byte_size = 28;
+    }
+    Buffer<AggDataPtr> agg_states(kTestChunkSize);
+    auto allocate_func = [&pool](auto& key) { return pool.allocate(8); };
+    for (const auto& columns : _chunks) {
+        hash_map_with_key.build_hash_map(columns[0]->size(), columns, &pool, allocate_func, &agg_states);
+    }
+    return hash_map_with_key.hash_map.size();
+}
+
+template <class HashMapWithKey>
+static void do_bench_build(benchmark::State& state) {
+    AggHashMapBench bench(state.range(0));
+    bench.SetUp();
+
+    size_t num_groups = 0;
+    for (auto _ : state) {
+        num_groups += bench.build<HashMapWithKey>();
+    }
+    benchmark::DoNotOptimize(num_groups);
+    state.SetItemsProcessed(state.iterations() * bench.num_rows());
+}
+
+static void BM_AggHashMap_Serialized_Build(benchmark::State& state) {
+    do_bench_build<SerializedKeyAggHashMap<PhmapSeed1>>(state);
+}
+
+static void BM_AggHashMap_FixedSize32_Build(benchmark::State& state) {
+    do_bench_build<SerializedKeyFixedSize32AggHashMap<PhmapSeed1>>(state);
+}
+
+static void BM_AggHashMap_Args(benchmark::internal::Benchmark* b) {
+    b->Arg(1'000);
+    b->Arg(100'000);
+    b->Arg(10'000'000);
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_AggHashMap_Serialized_Build)->Apply(BM_AggHashMap_Args);
+BENCHMARK(BM_AggHashMap_FixedSize32_Build)->Apply(BM_AggHashMap_Args);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/binary_plain_page.h"
+#include "storage/rowset/fsst_page.h"
+#include "storage/types.h"
+#include "util/compression/block_compression.h"
+
+namespace starrocks {
+
+static constexpr size_t kNumRows = 4096;
+
+// URL-like strings, which have many common substrings but few duplicates.
+static std::vector<std::string> gen_strings() {
+    static const std::vector<std::string> hosts = {"www.example.com", "static.example.org", "api.starrocks.io",
+                                                   "docs.starrocks.io", "cdn.example.net"};
+    static const std::vector<std::string> paths = {"/index.html", "/search?q=", "/user/profile/", "/item/detail?id=",
+                                                   "/assets/images/"};
+    std::mt19937 rng(42);
+    std::vector<std::string> strings;
+    strings.reserve(kNumRows);
+    for (size_t i = 0; i < kNumRows; i++) {
+        strings.emplace_back("https://" + hosts[rng() % hosts.size()] + paths[rng() % paths.size()] +
+                             std::to_string(rng() % 1000000));
+    }
+    return strings;
+}
+
+static std::vector<Slice> to_slices(const std::vector<std::string>& strings) {
+    std::vector<Slice> slices;
+    slices.reserve(strings.size());
+    for (const auto& s : strings) {
+        slices.emplace_back(s);
+    }
+    return slices;
+}
+
+template <class PageBuilderType>
+static OwnedSlice build_page(const std::vector<Slice>& slices) {
+    PageBuilderOptions options;
+    options.data_page_size = 1024 * 1024;
+    PageBuilderType builder(options);
+    CHECK_EQ(slices.size(), builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size()));
+    return builder.finish()->build();
+}
+
+// Decode the plain page compressed by LZ4, which is how the plain encoded pages are read with LZ4 compression.
+static void BM_plain_lz4_decode(benchmark::State& state) {
+    auto strings = gen_strings();
+    OwnedSlice page = build_page<BinaryPlainPageBuilder>(to_slices(strings));
+
+    const BlockCompressionCodec* codec = nullptr;
+    CHECK(get_block_compression_codec(LZ4, &codec).ok());
+    std::string compressed(codec->max_compressed_len(page.slice().size), '\0');
+    Slice compressed_slice(compressed);
+    CHECK(codec->compress(page.slice(), &compressed_slice).ok());
+    compressed.resize(compressed_slice.size);
+
+    std::string decompressed(page.slice().size, '\0');
+    auto column = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    for (auto _ : state) {
+        Slice output(decompressed);
+        CHECK(codec->decompress(Slice(compressed), &output).ok());
+        BinaryPlainPageDecoder<TYPE_VARCHAR> decoder(output);
+        CHECK(decoder.init().ok());
+        column->reset_column();
+        size_t n = kNumRows;
+        CHECK(decoder.next_batch(&n, column.get()).ok());
+        benchmark::DoNotOptimize(column->raw_data());
+    }
+    state.counters["page_size"] = compressed.size();
+    state.SetBytesProcessed(state.iterations() * page.slice().size);
+}
+
+static void BM_fsst_decode(benchmark::State& state) {
+    auto strings = gen_strings();
+    OwnedSlice page = build_page<FsstPageBuilder>(to_slices(strings));
+
+    auto column = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    size_t raw_size = 0;
+    for (auto _ : state) {
+        FsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+        CHECK(decoder.init().ok());
+        column->reset_column();
+        size_t n = kNumRows;
+        CHECK(decoder.next_batch(&n, column.get()).ok());
+        benchmark::DoNotOptimize(column->raw_data());
+        raw_size = column->byte_size();
+    }
+    state.counters["page_size"] = page.slice().size;
+    state.SetBytesProcessed(state.iterations() * raw_size);
+}
+
+// Evaluate the IN predicate on the strings decoded from the plain page compressed by LZ4.
+static void BM_plain_lz4_in_predicate(benchmark::State& state) {
+    auto strings = gen_strings();
+    OwnedSlice page = build_page<BinaryPlainPageBuilder>(to_slices(strings));
+
+    const BlockCompressionCodec* codec = nullptr;
+    CHECK(get_block_compression_codec(LZ4, &codec).ok());
+    std::string compressed(codec->max_compressed_len(page.slice().size), '\0');
+    Slice compressed_slice(compressed);
+    CHECK(codec->compress(page.slice(), &compressed_slice).ok());
+    compressed.resize(compressed_slice.size);
+
+    std::unique_ptr<ColumnPredicate> predicate(
+            new_column_in_predicate(get_type_info(TYPE_VARCHAR), 0, {strings[1], strings[10], strings[100]}));
+    std::string decompressed(page.slice().size, '\0');
+    auto column = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    std::vector<uint8_t> selection(kNumRows);
+    for (auto _ : state) {
+        Slice output(decompressed);
+        CHECK(codec->decompress(Slice(compressed), &output).ok());
+        BinaryPlainPageDecoder<TYPE_VARCHAR> decoder(output);
+        CHECK(decoder.init().ok());
+        column->reset_column();
+        size_t n = kNumRows;
+        CHECK(decoder.next_batch(&n, column.get()).ok());
+        CHECK(predicate->evaluate(column.get(), selection.data()).ok());
+        benchmark::DoNotOptimize(selection.data());
+    }
+}
+
+// Evaluate the IN predicate on the compressed strings of the FSST page.
+static void BM_fsst_in_predicate(benchmark::State& state) {
+    auto strings = gen_strings();
+    OwnedSlice page = build_page<FsstPageBuilder>(to_slices(strings));
+
+    std::unique_ptr<ColumnPredicate> predicate(
+            new_column_in_predicate(get_type_info(TYPE_VARCHAR), 0, {strings[1], strings[10], strings[100]}));
+    std::vector<uint8_t> selection(kNumRows);
+    for (auto _ : state) {
+        FsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+        CHECK(decoder.init().ok());
+        size_t n = kNumRows;
+        CHECK(decoder.evaluate_next_batch(*predicate, &n, selection.data()).ok());
+        benchmark::DoNotOptimize(selection.data());
+    }
+}
+
+static void BM_fsst_encode(benchmark::State& state) {
+    auto strings = gen_strings();
+    auto slices = to_slices(strings);
+    for (auto _ : state) {
+        OwnedSlice page = build_page<FsstPageBuilder>(slices);
+        benchmark::DoNotOptimize(page.slice().data);
+    }
+}
+
+BENCHMARK(BM_plain_lz4_decode);
+BENCHMARK(BM_fsst_decode);
+BENCHMARK(BM_plain_lz4_in_predicate);
+BENCHMARK(BM_fsst_in_predicate);
+BENCHMARK(BM_fsst_encode);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
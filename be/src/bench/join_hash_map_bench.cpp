@@ -0,0 +1,163 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "bench.h"
+#include "column/column_helper.h"
+#include "exec/join_hash_map.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks {
+
+// Compare the probe throughput of the bucket-chained hash table (JoinBuildFunc/JoinProbeFunc) with the
+// linear probing one (LinearProbingJoinBuildFunc/LinearProbingJoinProbeFunc) on BIGINT keys.
+// Half of the probe keys hit the build side, the build keys are unique.
+class JoinHashMapBench {
+public:
+    explicit JoinHashMapBench(size_t num_build_rows) : _num_build_rows(num_build_rows) {}
+
+    void SetUp();
+
+    template <class BuildFunc, class ProbeFunc>
+    void build();
+
+    template <class ProbeFunc>
+    size_t probe(const Columns& probe_columns);
+
+    const std::vector<Columns>& probe_chunks() const { return _probe_chunks; }
+
+private:
+    static constexpr size_t kNumProbeChunks = 256;
+
+    size_t _num_build_rows;
+    std::shared_ptr<RuntimeState> _runtime_state;
+    std::unique_ptr<JoinHashTableItems> _table_items;
+    std::unique_ptr<HashTableProbeState> _probe_state;
+    std::vector<Columns> _probe_chunks;
+};
+
+void JoinHashMapBench::SetUp() {
+    TQueryOptions query_options;
+    query_options.batch_size = kTestChunkSize;
+    _runtime_state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    _runtime_state->init_instance_mem_tracker();
+
+    std::mt19937_64 rng(0);
+    // build keys are the even numbers in random order, so that odd probe keys never match.
+    auto build_column = Int64Column::create();
+    auto& build_data = build_column->get_data();
+    build_data.resize(_num_build_rows + 1);
+    build_data[0] = 0;
+    for (size_t i = 1; i <= _num_build_rows; i++) {
+        build_data[i] = static_cast<int64_t>(i) * 2;
+    }
+    std::shuffle(build_data.begin() + 1, build_data.end(), rng);
+
+    std::uniform_int_distribution<int64_t> dist(1, static_cast<int64_t>(_num_build_rows) * 2);
+    for (size_t i = 0; i < kNumProbeChunks; i++) {
+        auto probe_column = Int64Column::create();
+        auto& probe_data = probe_column->get_data();
+        probe_data.resize(kTestChunkSize);
+        for (auto& v : probe_data) {
+            v = dist(rng);
+        }
+        _probe_chunks.emplace_back(Columns{probe_column});
+    }
+
+    _table_items = std::make_unique<JoinHashTableItems>();
+    _table_items->key_columns.emplace_back(build_column);
+    _table_items->row_count = _num_build_rows;
+}
+
+template <class BuildFunc, class ProbeFunc>
+void JoinHashMapBench::build() {
+    _table_items->first.clear();
+    _table_items->next.clear();
+    _table_items->linear_probing_slots.clear();
+    _table_items->used_buckets = 0;
+
+    _probe_state = std::make_unique<HashTableProbeState>();
+    _probe_state->buckets.resize(kTestChunkSize);
+    _probe_state->next.resize(kTestChunkSize);
+
+    BuildFunc::prepare(_runtime_state.get(), _table_items.get());
+    ProbeFunc::prepare(_runtime_state.get(), _probe_state.get());
+    BuildFunc::construct_hash_table(_runtime_state.get(), _table_items.get(), _probe_state.get());
+}
+
+template <class ProbeFunc>
+size_t JoinHashMapBench::probe(const Columns& probe_columns) {
+    _probe_state->key_columns = &probe_columns;
+    _probe_state->probe_row_count = probe_columns[0]->size();
+    ProbeFunc::lookup_init(*_table_items, _probe_state.get());
+
+    // walk the chains like the inner join does.
+    const auto& build_data = JoinBuildFunc<TYPE_BIGINT>::get_key_data(*_table_items);
+    const auto& probe_data = ProbeFunc::get_key_data(*_probe_state);
+    size_t match_count = 0;
+    for (size_t i = 0; i < _probe_state->probe_row_count; i++) {
+        for (uint32_t index = _probe_state->next[i]; index != 0; index = _table_items->next[index]) {
+            match_count += ProbeFunc::equal(build_data[index], probe_data[i]);
+        }
+    }
+    return match_count;
+}
+
+template <class BuildFunc, class ProbeFunc>
+static void do_bench_probe(benchmark::State& state) {
+    size_t num_build_rows = state.range(0);
+    JoinHashMapBench bench(num_build_rows);
+    bench.SetUp();
+    bench.build<BuildFunc, ProbeFunc>();
+
+    size_t num_probe_rows = 0;
+    size_t match_count = 0;
+    for (auto _ : state) {
+        for (const auto& probe_columns : bench.probe_chunks()) {
+            match_count += bench.probe<ProbeFunc>(probe_columns);
+            num_probe_rows += probe_columns[0]->size();
+        }
+    }
+    benchmark::DoNotOptimize(match_count);
+    state.SetItemsProcessed(num_probe_rows);
+}
+
+static void BM_JoinHashMap_BucketChained_Probe(benchmark::State& state) {
+    do_bench_probe<JoinBuildFunc<TYPE_BIGINT>, JoinProbeFunc<TYPE_BIGINT>>(state);
+}
+
+static void BM_JoinHashMap_LinearProbing_Probe(benchmark::State& state) {
+    do_bench_probe<LinearProbingJoinBuildFunc<TYPE_BIGINT>, LinearProbingJoinProbeFunc<TYPE_BIGINT>>(state);
+}
+
+static void BM_JoinHashMap_Args(benchmark::internal::Benchmark* b) {
+    b->Arg(1'000'000);
+    b->Arg(10'000'000);
+    b->Arg(100'000'000);
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_JoinHashMap_BucketChained_Probe)->Apply(BM_JoinHashMap_Args);
+BENCHMARK(BM_JoinHashMap_LinearProbing_Probe)->Apply(BM_JoinHashMap_Args);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "util/lru_cache.h"
+
+namespace starrocks {
+
+// Measure the lookups of a warm ShardedLRUCache from many threads, which is how the scan threads hit the hot pages
+// of the page cache, with and without the read mostly mode.
+static constexpr int kCapacity = 1 << 20;
+static constexpr int kNumHotKeys = 1 << 12;
+static constexpr int kNumKeys = kCapacity * 2;
+
+static void noop_deleter(const CacheKey& key, void* value) {}
+
+static CacheKey make_key(int key, std::string* buf) {
+    buf->assign(reinterpret_cast<const char*>(&key), sizeof(key));
+    return CacheKey(*buf);
+}
+
+// The caches are shared by all the threads and benchmarks, and filled on the first use.
+static Cache* get_cache(bool read_mostly) {
+    static std::unique_ptr<Cache> caches[2];
+    static const bool initialized = []() {
+        for (bool mode : {false, true}) {
+            caches[mode].reset(new_lru_cache(kCapacity, ChargeMode::VALUESIZE, CacheEvictPolicy::LRU, mode));
+            std::string buf;
+            // only fill half of the capacity, so that the hot keys are not evicted by an unbalanced shard
+            for (int key = 0; key < kCapacity / 2; key++) {
+                caches[mode]->release(caches[mode]->insert(make_key(key, &buf), nullptr, 1, &noop_deleter));
+            }
+        }
+        return true;
+    }();
+    (void)initialized;
+    return caches[read_mostly].get();
+}
+
+// All the lookups hit a small set of hot keys.
+static void do_bench_hit(benchmark::State& state, bool read_mostly) {
+    Cache* cache = get_cache(read_mostly);
+    std::mt19937 rng(state.thread_index());
+    std::uniform_int_distribution<int> dist(0, kNumHotKeys - 1);
+    std::string buf;
+    for (auto _ : state) {
+        Cache::Handle* handle = cache->lookup(make_key(dist(rng), &buf));
+        benchmark::DoNotOptimize(handle);
+        cache->release(handle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The lookups are spread over twice the capacity, and the misses insert the keys, so about half of the accesses
+// take the exclusive lock.
+static void do_bench_mixed(benchmark::State& state, bool read_mostly) {
+    Cache* cache = get_cache(read_mostly);
+    std::mt19937 rng(state.thread_index());
+    std::uniform_int_distribution<int> dist(0, kNumKeys - 1);
+    std::string buf;
+    for (auto _ : state) {
+        const CacheKey key = make_key(dist(rng), &buf);
+        Cache::Handle* handle = cache->lookup(key);
+        if (handle == nullptr) {
+            handle = cache->insert(key, nullptr, 1, &noop_deleter);
+        }
+        cache->release(handle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_lru_cache_hit(benchmark::State& state) {
+    do_bench_hit(state, false);
+}
+static void BM_lru_cache_hit_read_mostly(benchmark::State& state) {
+    do_bench_hit(state, true);
+}
+static void BM_lru_cache_mixed(benchmark::State& state) {
+    do_bench_mixed(state, false);
+}
+static void BM_lru_cache_mixed_read_mostly(benchmark::State& state) {
+    do_bench_mixed(state, true);
+}
+
+static void CustomArgs(benchmark::internal::Benchmark* b) {
+    b->ThreadRange(1, 64)->UseRealTime();
+}
+
+BENCHMARK(BM_lru_cache_hit)->Apply(CustomArgs);
+BENCHMARK(BM_lru_cache_hit_read_mostly)->Apply(CustomArgs);
+BENCHMARK(BM_lru_cache_mixed)->Apply(CustomArgs);
+BENCHMARK(BM_lru_cache_mixed_read_mostly)->Apply(CustomArgs);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
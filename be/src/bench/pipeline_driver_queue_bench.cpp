@@ -0,0 +1,127 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "exec/pipeline/pipeline_driver.h"
+#include "exec/pipeline/pipeline_driver_queue.h"
+#include "exec/pipeline/query_context.h"
+#include "exec/pipeline/source_operator.h"
+#include "util/cpu_info.h"
+
+namespace starrocks::pipeline {
+
+class NoopSourceOperator final : public SourceOperator {
+public:
+    NoopSourceOperator() : SourceOperator(nullptr, 1, "noop_source", 1, false, 0) {}
+    ~NoopSourceOperator() override = default;
+
+    bool has_output() const override { return true; }
+    bool need_input() const override { return false; }
+    bool is_finished() const override { return false; }
+
+    StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override { return nullptr; }
+    Status push_chunk(RuntimeState* state, const ChunkPtr& chunk) override { return Status::OK(); }
+};
+
+// Simulate the executor threads scheduling tiny drivers, which yield immediately after being taken.
+// Each executor thread takes a driver, updates the statistics and puts it back, just like
+// GlobalDriverExecutor::_worker_thread does for the READY/RUNNING drivers.
+template <bool work_stealing>
+static void do_bench_schedule(benchmark::State& state) {
+    const int num_threads = state.range(0);
+    constexpr int64_t kNumSchedules = 4'000'000;
+    constexpr int kNumDriversPerThread = 4;
+
+    QueryContext query_ctx;
+    std::vector<std::shared_ptr<PipelineDriver>> drivers;
+    std::vector<DriverRawPtr> raw_drivers;
+    for (int i = 0; i < num_threads * kNumDriversPerThread; i++) {
+        Operators operators{std::make_shared<NoopSourceOperator>()};
+        drivers.emplace_back(std::make_shared<PipelineDriver>(operators, &query_ctx, nullptr, nullptr, -1));
+        raw_drivers.emplace_back(drivers.back().get());
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        DriverQueuePtr queue = std::make_unique<QuerySharedDriverQueue>();
+        if constexpr (work_stealing) {
+            queue = std::make_unique<WorkStealingDriverQueue>(std::move(queue), num_threads);
+        }
+        queue->put_back(raw_drivers);
+        std::atomic<int64_t> num_schedules = 0;
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < num_threads; i++) {
+            threads.emplace_back([&queue, &num_schedules] {
+                queue->register_worker();
+                while (num_schedules.fetch_add(1, std::memory_order_relaxed) < kNumSchedules) {
+                    DriverRawPtr driver = nullptr;
+                    while (driver == nullptr) {
+                        driver = queue->take(false).value();
+                    }
+                    queue->update_statistics(driver);
+                    queue->put_back_from_executor(driver);
+                }
+                queue->unregister_worker();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        state.PauseTiming();
+        queue->close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumSchedules);
+}
+
+static void BM_DriverQueue_QueryShared(benchmark::State& state) {
+    do_bench_schedule<false>(state);
+}
+
+static void BM_DriverQueue_WorkStealing(benchmark::State& state) {
+    do_bench_schedule<true>(state);
+}
+
+static void BM_DriverQueue_Args(benchmark::internal::Benchmark* b) {
+    for (int num_threads : {1, 4, 16, 64}) {
+        b->Arg(num_threads);
+    }
+    b->Unit(benchmark::kMillisecond);
+    b->UseRealTime();
+}
+
+BENCHMARK(BM_DriverQueue_QueryShared)->Apply(BM_DriverQueue_Args);
+BENCHMARK(BM_DriverQueue_WorkStealing)->Apply(BM_DriverQueue_Args);
+
+} // namespace starrocks::pipeline
+
+int main(int argc, char** argv) {
+    starrocks::CpuInfo::init();
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
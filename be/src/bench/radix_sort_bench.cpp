@@ -0,0 +1,101 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+
+#include <random>
+
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "exec/sorting/sorting.h"
+
+namespace starrocks {
+
+// Compare the comparison-based sort with the MSD radix sort on a single order-by column, which is how
+// ChunksSorterFullSort sorts a partial run.
+// The first argument is the number of rows, and the second one is the range of the values, the small range
+// simulates the dates and the dict codes, whose high bytes are shared by all the keys.
+template <typename ColumnType>
+static void do_bench_sort(benchmark::State& state, bool enable_radix_sort, bool nullable) {
+    const size_t num_rows = state.range(0);
+    const int64_t value_range = state.range(1);
+
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<int64_t> dist(0, value_range - 1);
+    auto data_column = ColumnType::create();
+    auto null_column = NullColumn::create();
+    for (size_t i = 0; i < num_rows; i++) {
+        data_column->append(static_cast<typename ColumnType::ValueType>(dist(rng)));
+        null_column->append(nullable && i % 10 == 0);
+    }
+    ColumnPtr column = data_column;
+    if (nullable) {
+        column = NullableColumn::create(data_column, null_column);
+    }
+
+    const bool old_enable_radix_sort = config::enable_radix_sort;
+    config::enable_radix_sort = enable_radix_sort;
+    std::atomic<bool> cancel = false;
+    SortDescs sort_desc = SortDescs::asc_null_first(1);
+    Permutation perm;
+    for (auto _ : state) {
+        perm.clear();
+        auto st = sort_and_tie_columns(cancel, Columns{column}, sort_desc, &perm);
+        DCHECK(st.ok());
+        benchmark::DoNotOptimize(perm.data());
+    }
+    config::enable_radix_sort = old_enable_radix_sort;
+    state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+static void BM_sort_int32_pdqsort(benchmark::State& state) {
+    do_bench_sort<Int32Column>(state, false, false);
+}
+static void BM_sort_int32_radix(benchmark::State& state) {
+    do_bench_sort<Int32Column>(state, true, false);
+}
+static void BM_sort_int64_pdqsort(benchmark::State& state) {
+    do_bench_sort<Int64Column>(state, false, false);
+}
+static void BM_sort_int64_radix(benchmark::State& state) {
+    do_bench_sort<Int64Column>(state, true, false);
+}
+static void BM_sort_nullable_int32_pdqsort(benchmark::State& state) {
+    do_bench_sort<Int32Column>(state, false, true);
+}
+static void BM_sort_nullable_int32_radix(benchmark::State& state) {
+    do_bench_sort<Int32Column>(state, true, true);
+}
+
+static void CustomArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t num_rows : {1 << 16, 1 << 20, 1 << 23}) {
+        for (int64_t value_range : {1 << 10, 1 << 30}) {
+            b->Args({num_rows, value_range});
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_sort_int32_pdqsort)->Apply(CustomArgs);
+BENCHMARK(BM_sort_int32_radix)->Apply(CustomArgs);
+BENCHMARK(BM_sort_int64_pdqsort)->Apply(CustomArgs);
+BENCHMARK(BM_sort_int64_radix)->Apply(CustomArgs);
+BENCHMARK(BM_sort_nullable_int32_pdqsort)->Apply(CustomArgs);
+BENCHMARK(BM_sort_nullable_int32_radix)->Apply(CustomArgs);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
@@ -20,6 +20,7 @@
 
 #include "bench.h"
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exprs/runtime_filter.h"
 #include "exprs/runtime_filter_bank.h"
 #include "simd/simd.h"
@@ -42,6 +43,8 @@ namespace starrocks {
 
 static void do_benchmark_hash_partitioned(benchmark::State& state, TRuntimeFilterBuildJoinMode::type join_mode,
                                           std::vector<ColumnPtr> columns, int64_t num_rows, int64_t num_partitions) {
+    // benchmark the bloom filters of the partitions rather than the bitset
+    config::runtime_filter_bitset_max_bits = 0;
     std::vector<uint32_t> hash_values;
     std::vector<size_t> num_rows_per_partitions(num_partitions, 0);
 
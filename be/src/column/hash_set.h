@@ -15,6 +15,10 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #include "column/column_hash.h"
 #include "runtime/memory/counting_allocator.h"
@@ -143,6 +147,39 @@ struct SliceKey16 {
     SliceKey16(SliceKey16&& x) noexcept { u.value = x.u.value; }
 };
 
+// SliceKey32 is used for the group by keys whose serialized size is in (16, 32] bytes, such as
+// several int32 dates, int64 ids and dict encoded strings. Since it can't be represented by a single
+// integer, the comparison is done by 256-bit SIMD if available.
+struct SliceKey32 {
+    union U {
+        struct {
+            char data[31];
+            uint8_t size;
+        } __attribute__((packed));
+        struct {
+            uint64_t ui64[4];
+        } __attribute__((packed));
+    } u;
+    static_assert(sizeof(u) == 32);
+    bool operator==(const SliceKey32& k) const {
+#ifdef __AVX2__
+        __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(u.ui64));
+        __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k.u.ui64));
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)) == -1;
+#else
+        return ((u.ui64[0] ^ k.u.ui64[0]) | (u.ui64[1] ^ k.u.ui64[1]) | (u.ui64[2] ^ k.u.ui64[2]) |
+                (u.ui64[3] ^ k.u.ui64[3])) == 0;
+#endif
+    }
+    SliceKey32() = default;
+    SliceKey32(const SliceKey32& x) { memcpy(&u, &x.u, sizeof(u)); }
+    SliceKey32& operator=(const SliceKey32& x) {
+        memcpy(&u, &x.u, sizeof(u));
+        return *this;
+    }
+    SliceKey32(SliceKey32&& x) noexcept { memcpy(&u, &x.u, sizeof(u)); }
+};
+
 template <typename SliceKey, PhmapSeed seed>
 class FixedSizeSliceKeyHash {
 public:
@@ -151,9 +188,17 @@ public:
             return phmap_mix_with_seed<sizeof(size_t), seed>()(std::hash<int32_t>()(s.u.value));
         } else if constexpr (sizeof(SliceKey) == 8) {
             return phmap_mix_with_seed<sizeof(size_t), seed>()(std::hash<size_t>()(s.u.value));
-        } else {
+        } else if constexpr (sizeof(SliceKey) == 16) {
             static_assert(sizeof(s.u.value) == 16);
             return Hash128WithSeed<seed>()(s.u.value);
+        } else {
+            static_assert(sizeof(SliceKey) == 32);
+            uint64_t hash = seed;
+            hash_combine(hash, s.u.ui64[0]);
+            hash_combine(hash, s.u.ui64[1]);
+            hash_combine(hash, s.u.ui64[2]);
+            hash_combine(hash, s.u.ui64[3]);
+            return phmap_mix_with_seed<sizeof(size_t), seed>()(hash);
         }
     }
 };
@@ -231,6 +231,13 @@ CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 CONF_mInt32(exchg_node_buffer_size_bytes, "10485760");
 // The block_size every block allocate for sorter.
 CONF_Int32(sorter_block_size, "8388608");
+// Whether to sort the large partial runs of full sort by MSD radix sort,
+// when there is only one fixed-width order-by column.
+CONF_mBool(enable_radix_sort, "true");
+// Whether to sort by the memcmp-able normalized keys when there are multiple order-by columns.
+CONF_mBool(enable_sort_normalized_key, "false");
+// The strings longer than it are truncated in the normalized sort key, and the ties are compared by the columns.
+CONF_mInt32(sort_normalized_key_string_prefix_length, "16");
 
 CONF_mInt64(column_dictionary_key_ratio_threshold, "0");
 CONF_mInt64(column_dictionary_key_size_threshold, "0");
@@ -274,6 +281,12 @@ CONF_Int32(data_page_size, "65536");
 
 // Cache for storage page size
 CONF_mString(storage_page_cache_limit, "20%");
+// The evict policy of storage page cache, "lru", "2q" or "w-tinylfu". "2q" and "w-tinylfu" keep the pages accessed
+// repeatedly from being evicted by the pages of a large scan.
+CONF_String(storage_page_cache_evict_policy, "lru");
+// If true, the hits of storage page cache only take the shared lock of a shard and don't block each other, and
+// the access order is updated in batches, which reduces the lock contention of the hot pages under high concurrency.
+CONF_Bool(enable_storage_page_cache_read_mostly, "false");
 // whether to disable page cache feature in storage
 CONF_mBool(disable_storage_page_cache, "false");
 // whether to enable the bitmap index memory cache
@@ -399,6 +412,19 @@ CONF_Int32(be_exit_after_disk_write_hang_second, "60");
 // set to 1 means always use dictionary encoding
 CONF_Double(dictionary_encoding_ratio, "0.7");
 
+// Whether to use FSST encoding instead of plain encoding for the string columns which turn off dictionary
+// encoding. The segments written with it could not be read by the BEs of older versions.
+CONF_mBool(enable_fsst_string_encoding, "false");
+
+// Whether to use ALP encoding instead of bitshuffle for the FLOAT and DOUBLE columns by default.
+// The segments written with it could not be read by the BEs of older versions.
+CONF_mBool(enable_alp_float_encoding, "false");
+
+// Whether to use delta encoding instead of bitshuffle for the INT, BIGINT, DATE and DATETIME columns by
+// default, which suits the sorted or nearly monotonic columns. The segments written with it could not be
+// read by the BEs of older versions.
+CONF_mBool(enable_delta_integer_encoding, "false");
+
 // Some data types use dictionary encoding, and this configuration is used to control
 // the size of dictionary pages. If you want a higher compression ratio, please increase
 // this configuration item, but be aware that excessively large values may lead to
@@ -701,6 +727,19 @@ CONF_Int32(late_materialization_ratio, "10");
 // `1000` will enable late materialization always select metric type.
 CONF_Int32(metric_late_materialization_ratio, "1000");
 
+// If true, the expr predicates pushed down to the storage, e.g. LIKE, are evaluated one by one and the chunk is
+// filtered after each of them, in the order of their cost and selectivity measured at runtime for each segment.
+CONF_mBool(enable_adaptive_predicate_order, "true");
+
+// If true, the join runtime filters which arrive during the scan are evaluated on the rows of the segments, before
+// the other columns are late materialized, and only once for each word of the dictionary encoded columns.
+CONF_mBool(enable_segment_runtime_filter_predicate, "true");
+
+// If true, the only column predicate pushed down to a segment is evaluated on the encoded pages of its column, e.g.
+// once for each run of RLE pages, before the columns are read, and only the selected rows are read then. It's only
+// used for the columns without null encoded by RLE, FOR, DELTA, FSST or the dictionary of strings.
+CONF_mBool(enable_segment_encoded_predicate, "true");
+
 // Max batched bytes for each transmit request. (256KB)
 CONF_Int64(max_transmit_batched_bytes, "262144");
 
@@ -786,6 +825,15 @@ CONF_mBool(pipeline_print_profile, "false");
 // when the value of level_time_slice_base_ns is smaller and queue_ratio_of_adjacent_queue is larger.
 CONF_Int64(pipeline_driver_queue_level_time_slice_base_ns, "200000000");
 CONF_Double(pipeline_driver_queue_ratio_of_adjacent_queue, "1.2");
+// Whether the pipeline executor threads keep the yielded drivers in their own lock-free deques and steal
+// from each other (same NUMA node first), instead of always going through the shared driver queue.
+// The shared driver queue (and workgroup scheduling on it) is still used for new and wakened drivers.
+CONF_Bool(pipeline_enable_work_stealing_driver_queue, "false");
+// Whether to assign a preferred NUMA node to each fragment instance in round robin, when there are more than
+// one NUMA node. The executor and scan threads allocate memory from the jemalloc arena of the node of the running
+// driver, whose pages are preferably placed on the node, and the work-stealing driver queue
+// (pipeline_enable_work_stealing_driver_queue) prefers the executor threads on the node to run the drivers.
+CONF_Bool(pipeline_enable_numa_aware_placement, "false");
 
 CONF_Int32(pipeline_analytic_max_buffer_size, "128");
 CONF_Int32(pipeline_analytic_removable_chunk_num, "128");
@@ -861,6 +909,19 @@ CONF_mBool(s3_use_list_objects_v1, "false");
 // Lake
 CONF_mBool(io_coalesce_lake_read_enable, "false");
 
+// Whether to read the pages of all the columns needed by the next chunk of a local segment scan in one
+// batch with io_uring, which falls back to pread if io_uring is not supported by the kernel. It only
+// takes effect on the scans not using the page cache.
+CONF_mBool(io_uring_segment_read_enable, "false");
+// The number of entries of the io_uring submission queue of each scan thread.
+CONF_Int32(io_uring_queue_depth, "64");
+// Whether to prefetch the data pages of the next chunks of all the columns while the current chunk of a
+// local segment is being read, by posix_fadvise(WILLNEED). It helps the cold scans on HDD and cloud disks.
+CONF_mBool(enable_segment_page_prefetch, "false");
+// The max number of chunks whose pages are prefetched ahead of the current chunk. The actual number
+// starts from 1 and grows when the page reads still wait for the device.
+CONF_mInt32(segment_page_prefetch_max_depth, "8");
+
 // orc reader
 CONF_Bool(enable_orc_late_materialization, "true");
 CONF_Bool(enable_orc_libdeflate_decompression, "true");
@@ -947,6 +1008,17 @@ CONF_Int64(send_runtime_filter_via_http_rpc_min_size, "67108864");
 // -1: ulimited, 0: limit by memory use, >0: limit by queue_size
 CONF_mInt64(runtime_filter_queue_limit, "-1");
 
+// The join runtime filter uses a binary fuse filter instead of a bloom filter if the number of the build rows is not
+// less than this, it takes about 9 bits per row for a false positive rate of about 1/256. -1 means never.
+CONF_mInt64(runtime_filter_binary_fuse_min_rows, "1048576");
+// The join runtime filter uses a bloom filter if the number of the build rows is more than this, because building a
+// binary fuse filter takes about 33 bytes per row, for the collected hashes and the temporary arrays. -1 means no limit.
+CONF_mInt64(runtime_filter_binary_fuse_max_rows, "16777216");
+
+// The join runtime filter of the integer keys uses an exact bitset instead of a bloom filter if the range of the keys
+// takes no more than this number of bits, and no more than 16 bits per build row. 0 means never.
+CONF_mInt64(runtime_filter_bitset_max_bits, "67108864");
+
 CONF_Int64(rpc_connect_timeout_ms, "30000");
 
 CONF_Int32(max_batch_publish_latency_ms, "100");
@@ -1003,6 +1075,10 @@ CONF_mInt32(starlet_delete_files_max_key_in_batch, "1000");
 #endif
 
 CONF_mInt64(lake_metadata_cache_limit, /*2GB=*/"2147483648");
+// The evict policy of lake metadata cache, "lru", "2q" or "w-tinylfu".
+CONF_String(lake_metadata_cache_evict_policy, "lru");
+// If true, the hits of lake metadata cache don't block each other, see enable_storage_page_cache_read_mostly.
+CONF_Bool(enable_lake_metadata_cache_read_mostly, "false");
 CONF_mBool(lake_print_delete_log, "false");
 CONF_mInt64(lake_compaction_stream_buffer_size_bytes, "1048576"); // 1MB
 // The interval to check whether lake compaction is valid. Set to <= 0 to disable the check.
@@ -1076,6 +1152,24 @@ CONF_Int64(spill_max_log_block_container_bytes, "10737418240"); // 10GB
 CONF_mDouble(spill_max_dir_bytes_ratio, "0.8"); // 80%
 // min bytes size of spill read buffer. if the buffer size is less than this value, we will disable buffer read
 CONF_Int64(spill_read_buffer_min_bytes, "1048576");
+// The serialized chunks of a spill output stream are buffered and written to the block in batches of this size.
+// The buffer is aligned, so that the batches could be written with direct io. 0 means writing each chunk directly.
+CONF_mInt64(spill_write_batch_bytes, "1048576");
+// The number of the next blocks of a spilled stream, which are prefetched into the page cache of the OS while the
+// current block is restored. 0 means no prefetch.
+CONF_mInt32(spill_restore_prefetch_blocks, "2");
+// Tiered spilling, which is used if spilling to the remote storage is enabled. Once the used size of the local spill
+// directories exceeds this ratio of their capacity, the cold blocks of the spilling queries are offloaded to the
+// remote storage in the background, and each query offloads in proportion to its share of the used size.
+CONF_mDouble(spill_local_offload_watermark, "0.7"); // 70%
+// The blocks offloaded together are written into one object on the remote storage, up to this size.
+CONF_mInt64(spill_offload_object_bytes, "268435456");
+// The max number of the threads of a query to offload the blocks.
+CONF_Int32(spill_offload_threads, "2");
+// A block on the remote storage is restored in ranges of this size, up to spill_remote_read_parallelism ranges
+// are read in parallel. 1 means reading the block sequentially.
+CONF_mInt64(spill_remote_read_range_bytes, "8388608");
+CONF_mInt32(spill_remote_read_parallelism, "4");
 CONF_mInt64(mem_limited_chunk_queue_block_size, "8388608");
 
 CONF_Int32(internal_service_query_rpc_thread_num, "-1");
@@ -1219,6 +1313,15 @@ CONF_mBool(enable_pindex_read_by_page, "true");
 
 // Used by query cache, cache entries are evicted when it exceeds its capacity(500MB in default)
 CONF_Int64(query_cache_capacity, "536870912");
+// The evict policy of query cache, "lru", "2q" or "w-tinylfu".
+CONF_String(query_cache_evict_policy, "lru");
+// The directory to persist the entries evicted from the query cache, so that they survive the memory pressure
+// and the restart of BE. Empty means the entries are dropped when evicted.
+CONF_String(query_cache_disk_path, "");
+// The capacity of the query cache entries on the disk, 10GB in default.
+CONF_Int64(query_cache_disk_capacity, "10737418240");
+// The max bytes of the evicted entries waiting to be written into the disk, the others are dropped.
+CONF_Int64(query_cache_disk_max_pending_bytes, "268435456");
 
 // When query cache enabled, the operators in the drivers contains cache operator are multilane
 // operators, if the number of lanes is big, Fragment Instance would spend too much time to prepare
@@ -1253,8 +1356,27 @@ CONF_Int64(local_exchange_buffer_mem_limit_per_driver, "134217728"); // 128MB
 CONF_mInt64(streaming_agg_limited_memory_size, "134217728");
 // mem limit for partition hash join probe side buffer
 CONF_mInt64(partition_hash_join_probe_limit_size, "134217728");
+// The partitioned hash join splits the build and probe sides into cache-sized partitions. If the planner does not set
+// enable_partition_hash_join, it's turned on automatically for the joins whose hash table is larger than this size.
+// 0 means only the planner decides.
+CONF_mInt64(auto_partition_hash_join_min_build_bytes, "16777216");
+// Use the open addressing (linear probing) hash table instead of the bucket-chained one for the join keys
+// that fit in 4/8/16 bytes. It takes effect for the hash tables built after the change.
+CONF_mBool(enable_hash_join_linear_probing, "true");
 // pipeline streaming aggregate chunk buffer size
 CONF_mInt32(streaming_agg_chunk_buffer_size, "1024");
+// When the streaming aggregate in AUTO mode finds the reduction is low, keep a hash table as small as the L2 cache
+// to aggregate the hot keys and stream the others, instead of passing through all the rows.
+CONF_mBool(enable_streaming_agg_cache_preaggregation, "false");
+// The max memory usage of the hash table of the streaming aggregate cache pre-aggregation, 0 means the L2 cache size.
+CONF_mInt64(streaming_agg_cache_preaggregation_ht_size, "0");
+// For the finalize aggregation with group by keys, aggregate the input locally in each driver and merge the
+// partitions of the intermediate results in parallel, instead of shuffling the input rows by the local exchange.
+// It helps when the local aggregation reduces the rows a lot.
+CONF_mBool(enable_local_partitioned_aggregation, "false");
+// The number of partitions per source driver of the local partitioned aggregation. Each source driver merges
+// and outputs the partitions one by one, so a larger value makes less merged states alive at the same time.
+CONF_mInt32(local_partitioned_aggregation_partitions_per_driver, "4");
 CONF_mInt64(wait_apply_time, "6000"); // 6s
 
 // Max size of a binlog file. The default is 512MB.
@@ -67,6 +67,9 @@ using FixedSize8SliceAggHashMap = phmap::flat_hash_map<SliceKey8, AggDataPtr, Fi
 template <PhmapSeed seed>
 using FixedSize16SliceAggHashMap =
         phmap::flat_hash_map<SliceKey16, AggDataPtr, FixedSizeSliceKeyHash<SliceKey16, seed>>;
+template <PhmapSeed seed>
+using FixedSize32SliceAggHashMap =
+        phmap::flat_hash_map<SliceKey32, AggDataPtr, FixedSizeSliceKeyHash<SliceKey32, seed>>;
 
 // =====================
 // two level agg hash map
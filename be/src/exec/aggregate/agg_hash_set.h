@@ -76,6 +76,8 @@ template <PhmapSeed seed>
 using FixedSize8SliceAggHashSet = phmap::flat_hash_set<SliceKey8, FixedSizeSliceKeyHash<SliceKey8, seed>>;
 template <PhmapSeed seed>
 using FixedSize16SliceAggHashSet = phmap::flat_hash_set<SliceKey16, FixedSizeSliceKeyHash<SliceKey16, seed>>;
+template <PhmapSeed seed>
+using FixedSize32SliceAggHashSet = phmap::flat_hash_set<SliceKey32, FixedSizeSliceKeyHash<SliceKey32, seed>>;
 
 // =====================
 // two level agg hash set
@@ -87,9 +87,11 @@ namespace starrocks {
     M(phase1_slice_fx4)              \
     M(phase1_slice_fx8)              \
     M(phase1_slice_fx16)             \
+    M(phase1_slice_fx32)             \
     M(phase2_slice_fx4)              \
     M(phase2_slice_fx8)              \
-    M(phase2_slice_fx16)
+    M(phase2_slice_fx16)             \
+    M(phase2_slice_fx32)
 
 // Aggregate Hash maps
 
@@ -164,6 +166,8 @@ template <PhmapSeed seed>
 using SerializedKeyFixedSize8AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize8SliceAggHashMap<seed>>;
 template <PhmapSeed seed>
 using SerializedKeyFixedSize16AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize16SliceAggHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize32AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize32SliceAggHashMap<seed>>;
 
 // Hash sets
 //
@@ -239,6 +243,9 @@ using SerializedKeyAggHashSetFixedSize8 = AggHashSetOfSerializedKeyFixedSize<Fix
 template <PhmapSeed seed>
 using SerializedKeyAggHashSetFixedSize16 = AggHashSetOfSerializedKeyFixedSize<FixedSize16SliceAggHashSet<seed>>;
 
+template <PhmapSeed seed>
+using SerializedKeyAggHashSetFixedSize32 = AggHashSetOfSerializedKeyFixedSize<FixedSize32SliceAggHashSet<seed>>;
+
 // aggregate key
 template <class HashMapWithKey>
 struct CombinedFixedSizeKey {
@@ -306,6 +313,7 @@ using AggHashMapWithKeyPtr = std::variant<
         std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed1>>,
         std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed1>>,
         std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed1>>,
+        std::unique_ptr<SerializedKeyFixedSize32AggHashMap<PhmapSeed1>>,
         std::unique_ptr<UInt8AggHashMapWithOneNumberKey<PhmapSeed2>>,
         std::unique_ptr<Int8AggHashMapWithOneNumberKey<PhmapSeed2>>,
         std::unique_ptr<Int16AggHashMapWithOneNumberKey<PhmapSeed2>>,
@@ -334,7 +342,8 @@ using AggHashMapWithKeyPtr = std::variant<
         std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyFixedSize4AggHashMap<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>>,
-        std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>>>;
+        std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>>,
+        std::unique_ptr<SerializedKeyFixedSize32AggHashMap<PhmapSeed2>>>;
 
 using AggHashSetWithKeyPtr = std::variant<
         std::unique_ptr<UInt8AggHashSetOfOneNumberKey<PhmapSeed1>>,
@@ -392,9 +401,11 @@ using AggHashSetWithKeyPtr = std::variant<
         std::unique_ptr<SerializedKeyAggHashSetFixedSize4<PhmapSeed1>>,
         std::unique_ptr<SerializedKeyAggHashSetFixedSize8<PhmapSeed1>>,
         std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed1>>,
+        std::unique_ptr<SerializedKeyAggHashSetFixedSize32<PhmapSeed1>>,
         std::unique_ptr<SerializedKeyAggHashSetFixedSize4<PhmapSeed2>>,
         std::unique_ptr<SerializedKeyAggHashSetFixedSize8<PhmapSeed2>>,
-        std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed2>>>;
+        std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed2>>,
+        std::unique_ptr<SerializedKeyAggHashSetFixedSize32<PhmapSeed2>>>;
 } // namespace detail
 struct AggHashMapVariant {
     enum class Type {
@@ -429,6 +440,7 @@ struct AggHashMapVariant {
         phase1_slice_fx4,
         phase1_slice_fx8,
         phase1_slice_fx16,
+        phase1_slice_fx32,
 
         phase2_uint8,
         phase2_int8,
@@ -461,6 +473,7 @@ struct AggHashMapVariant {
         phase2_slice_fx4,
         phase2_slice_fx8,
         phase2_slice_fx16,
+        phase2_slice_fx32,
     };
 
     detail::AggHashMapWithKeyPtr hash_map_with_key;
@@ -561,9 +574,11 @@ struct AggHashSetVariant {
         phase1_slice_fx4,
         phase1_slice_fx8,
         phase1_slice_fx16,
+        phase1_slice_fx32,
         phase2_slice_fx4,
         phase2_slice_fx8,
         phase2_slice_fx16,
+        phase2_slice_fx32,
     };
 
     detail::AggHashSetWithKeyPtr hash_set_with_key;
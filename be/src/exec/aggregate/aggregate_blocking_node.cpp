@@ -18,11 +18,13 @@
 #include <type_traits>
 #include <variant>
 
+#include "common/config.h"
 #include "exec/aggregator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
 #include "exec/pipeline/aggregate/aggregate_streaming_sink_operator.h"
 #include "exec/pipeline/aggregate/aggregate_streaming_source_operator.h"
+#include "exec/pipeline/aggregate/partitioned_aggregate_blocking_operator.h"
 #include "exec/pipeline/aggregate/sorted_aggregate_streaming_sink_operator.h"
 #include "exec/pipeline/aggregate/sorted_aggregate_streaming_source_operator.h"
 #include "exec/pipeline/aggregate/spillable_aggregate_blocking_sink_operator.h"
@@ -237,6 +239,42 @@ pipeline::OpFactories AggregateBlockingNode::_decompose_to_pipeline(pipeline::Op
     return ops_with_source;
 }
 
+// Aggregate the input in each sink driver, and merge the partitions of the intermediate results by the source drivers
+// in parallel, see PartitionedAggregateContext.
+pipeline::OpFactories AggregateBlockingNode::_decompose_to_partitioned_pipeline(
+        pipeline::OpFactories& ops_with_sink, pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+
+    // The source drivers wait for all the sink drivers, so they cannot be executed group by group.
+    ops_with_sink = context->maybe_interpolate_grouped_exchange(id(), ops_with_sink);
+    auto* upstream_source_op = context->source_operator(ops_with_sink);
+    const size_t num_sinkers = upstream_source_op->degree_of_parallelism();
+    const size_t num_sources = context->degree_of_parallelism();
+    const size_t num_partitions =
+            num_sources * std::max<int32_t>(1, config::local_partitioned_aggregation_partitions_per_driver);
+    auto partitioned_context = std::make_shared<PartitionedAggregateContext>(num_sinkers, num_partitions);
+
+    auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    auto merge_aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    auto sink_op = std::make_shared<PartitionedAggregateBlockingSinkOperatorFactory>(
+            context->next_operator_id(), id(), std::move(aggregator_factory), partitioned_context);
+    auto source_op = std::make_shared<PartitionedAggregateBlockingSourceOperatorFactory>(
+            context->next_operator_id(), id(), std::move(merge_aggregator_factory), partitioned_context);
+    context->inherit_upstream_source_properties(source_op.get(), upstream_source_op);
+    source_op->set_degree_of_parallelism(num_sources);
+
+    // Create a shared RefCountedRuntimeFilterCollector
+    // Initialize OperatorFactory's fields involving runtime filters.
+    auto&& rc_rf_probe_collector = std::make_shared<RcRfProbeCollector>(2, std::move(this->runtime_filter_collector()));
+    this->init_runtime_filter_for_operator(sink_op.get(), context, rc_rf_probe_collector);
+    this->init_runtime_filter_for_operator(source_op.get(), context, rc_rf_probe_collector);
+
+    ops_with_sink.push_back(std::move(sink_op));
+    context->add_pipeline(ops_with_sink);
+
+    return {std::move(source_op)};
+}
+
 pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
 
@@ -249,6 +287,14 @@ pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::Pip
             _tnode.agg_node.__isset.use_per_bucket_optimize && _tnode.agg_node.use_per_bucket_optimize;
     bool has_group_by_keys = agg_node.__isset.grouping_exprs && !_tnode.agg_node.grouping_exprs.empty();
     bool could_local_shuffle = context->could_local_shuffle(ops_with_sink);
+    bool enable_agg_spill = runtime_state()->enable_spill() && runtime_state()->enable_agg_spill();
+    // Use the local partitioned aggregation in place of the local shuffle by the group by keys.
+    bool use_partitioned_aggregate = config::enable_local_partitioned_aggregation && !sorted_streaming_aggregate &&
+                                     agg_node.need_finalize && has_group_by_keys && could_local_shuffle &&
+                                     !use_per_bucket_optimize && !enable_agg_spill &&
+                                     context->degree_of_parallelism() > 1 &&
+                                     context->source_operator(ops_with_sink)->partition_exprs().empty() &&
+                                     !context->should_interpolate_cache_operator(id(), ops_with_sink[0]);
 
     auto try_interpolate_local_shuffle = [this, context](auto& ops) {
         return context->maybe_interpolate_local_shuffle_exchange(runtime_state(), id(), ops, [this]() {
@@ -271,7 +317,7 @@ pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::Pip
             if (!has_group_by_keys) {
                 ops_with_sink =
                         context->maybe_interpolate_local_passthrough_exchange(runtime_state(), id(), ops_with_sink);
-            } else if (could_local_shuffle) {
+            } else if (could_local_shuffle && !use_partitioned_aggregate) {
                 ops_with_sink = try_interpolate_local_shuffle(ops_with_sink);
             }
         } else {
@@ -286,12 +332,14 @@ pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::Pip
     use_per_bucket_optimize &= dynamic_cast<LocalExchangeSourceOperatorFactory*>(ops_with_sink.back().get()) == nullptr;
 
     OpFactories ops_with_source;
-    if (sorted_streaming_aggregate) {
+    if (use_partitioned_aggregate) {
+        ops_with_source = _decompose_to_partitioned_pipeline(ops_with_sink, context);
+    } else if (sorted_streaming_aggregate) {
         ops_with_source =
                 _decompose_to_pipeline<StreamingAggregatorFactory, SortedAggregateStreamingSourceOperatorFactory,
                                        SortedAggregateStreamingSinkOperatorFactory>(ops_with_sink, context, false);
     } else {
-        if (runtime_state()->enable_spill() && runtime_state()->enable_agg_spill() && has_group_by_keys) {
+        if (enable_agg_spill && has_group_by_keys) {
             ops_with_source = _decompose_to_pipeline<AggregatorFactory, SpillableAggregateBlockingSourceOperatorFactory,
                                                      SpillableAggregateBlockingSinkOperatorFactory>(
                     ops_with_sink, context, use_per_bucket_optimize && has_group_by_keys);
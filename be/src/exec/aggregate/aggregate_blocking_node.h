@@ -36,5 +36,8 @@ private:
     template <class AggFactory, class SourceFactory, class SinkFactory>
     pipeline::OpFactories _decompose_to_pipeline(pipeline::OpFactories& ops_with_sink,
                                                  pipeline::PipelineBuilderContext* context, bool per_bucket_optimize);
+
+    pipeline::OpFactories _decompose_to_partitioned_pipeline(pipeline::OpFactories& ops_with_sink,
+                                                             pipeline::PipelineBuilderContext* context);
 };
 } // namespace starrocks
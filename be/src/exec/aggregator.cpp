@@ -89,6 +89,8 @@ std::string AggrAutoContext::get_auto_state_string(const AggrAutoState& state) {
         return "PREAGG";
     case SELECTIVE_PREAGG:
         return "SELECTIVE_PREAGG";
+    case CACHE_PREAGG:
+        return "CACHE_PREAGG";
     }
     return "UNKNOWN";
 }
@@ -980,6 +982,32 @@ Status Aggregator::convert_to_spill_format(Chunk* input_chunk, ChunkPtr* chunk)
     return Status::OK();
 }
 
+Status Aggregator::merge_intermediate_chunk(Chunk* chunk) {
+    const size_t chunk_size = chunk->num_rows();
+    const size_t num_group_by_columns = _group_by_columns.size();
+    DCHECK_EQ(num_group_by_columns + _agg_fn_ctxs.size(), chunk->num_columns());
+    for (size_t i = 0; i < num_group_by_columns; i++) {
+        _group_by_columns[i] = chunk->get_column_by_index(i);
+    }
+
+    TRY_CATCH_BAD_ALLOC(build_hash_map(chunk_size));
+    TRY_CATCH_BAD_ALLOC(try_convert_to_two_level_map());
+
+    {
+        SCOPED_TIMER(_agg_stat->agg_function_compute_timer);
+        SCOPED_THREAD_LOCAL_STATE_ALLOCATOR_SETTER(_allocator.get());
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            const auto& column = chunk->get_column_by_index(num_group_by_columns + i);
+            _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i], column.get(),
+                                           _tmp_agg_states.data());
+        }
+    }
+    RETURN_IF_ERROR(check_has_error());
+
+    _num_input_rows += chunk_size;
+    return Status::OK();
+}
+
 Status Aggregator::output_chunk_by_streaming_with_selection(Chunk* input_chunk, ChunkPtr* chunk) {
     // Streaming aggregate at least has one group by column
     size_t chunk_size = _group_by_columns[0]->size();
@@ -1294,6 +1322,11 @@ void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant) {
             } else if (max_size < 16 || (!has_null_column && max_size == 16)) {
                 type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_fx16
                                                  : HashVariantType::Type::phase2_slice_fx16;
+            } else if (max_size < 32 || (!has_null_column && max_size == 32)) {
+                // Wide keys like (date, date, int, bigint, bigint) still avoid the per row serialization
+                // and the arena allocation of phase1_slice/phase2_slice.
+                type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice_fx32
+                                                 : HashVariantType::Type::phase2_slice_fx32;
             }
             if (!has_null_column) {
                 fixed_byte_size = max_size;
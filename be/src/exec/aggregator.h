@@ -165,7 +165,7 @@ enum AggrMode {
     AM_STREAMING_POST_CACHE
 };
 
-enum AggrAutoState { INIT_PREAGG = 0, ADJUST, PASS_THROUGH, FORCE_PREAGG, PREAGG, SELECTIVE_PREAGG };
+enum AggrAutoState { INIT_PREAGG = 0, ADJUST, PASS_THROUGH, FORCE_PREAGG, PREAGG, SELECTIVE_PREAGG, CACHE_PREAGG };
 
 struct AggrAutoContext {
     static constexpr size_t ContinuousUpperLimit = 10000;
@@ -176,6 +176,10 @@ struct AggrAutoContext {
     static constexpr double HighReduction = 0.9;
     static constexpr size_t MaxHtSize = 64 * 1024 * 1024; // 64 MB
     static constexpr int StableLimit = 5;
+    // CACHE_PREAGG flushes the cache-resident hash table every CachePreaggFlushLimit chunks once it is full,
+    // so that the keys which are hot recently can take the place of the stale ones.
+    static constexpr int CachePreaggFlushLimit = 64;
+    static constexpr size_t MinCachePreaggHtSize = 256 * 1024; // 256 KB
     std::string get_auto_state_string(const AggrAutoState& state);
     size_t get_continuous_limit();
     void update_continuous_limit();
@@ -187,6 +191,9 @@ struct AggrAutoContext {
     size_t force_preagg_count = 0;
     size_t preagg_count = 0;
     size_t selective_preagg_count = 0;
+    size_t cache_preagg_count = 0;
+    size_t cache_preagg_low_reduction_count = 0;
+    size_t cache_preagg_high_reduction_count = 0;
     size_t continuous_limit = 100;
 };
 
@@ -352,6 +359,11 @@ public:
     // convert input chunk to spill format
     Status convert_to_spill_format(Chunk* input_chunk, ChunkPtr* chunk);
 
+    // Merge the chunk output by convert_hash_map_to_chunk(..., force_use_intermediate_as_output=true) of another
+    // aggregator of the same plan node. The group by columns and the intermediate agg columns are taken from the
+    // chunk directly, instead of evaluating the exprs.
+    Status merge_intermediate_chunk(Chunk* chunk);
+
     // Elements queried in HashTable will be added to HashTable,
     // elements that cannot be queried are not processed,
     // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
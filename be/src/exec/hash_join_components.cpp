@@ -100,6 +100,59 @@ void HashJoinProber::attach(HashJoinBuilder* builder, const HashJoinProbeMetrics
     _impl = builder->create_prober();
 }
 
+// Scatter the rows of chunk into num_partitions (a power of 2) partitions by the hash of partition_keys.
+// When it returns, selection[start_points[i], start_points[i + 1]) holds the rows of the i-th partition.
+// The partition is taken from the high bits of the hash, which are the least correlated with the low bits
+// that JoinHashMap uses to find the buckets inside a partition.
+static Status radix_partition_chunk(const std::vector<ExprContext*>& partition_keys, Chunk* chunk,
+                                    size_t num_partitions, std::vector<uint32_t>* selection,
+                                    std::vector<int32_t>* start_points) {
+    DCHECK_GT(num_partitions, 0);
+    DCHECK_EQ(num_partitions & (num_partitions - 1), 0);
+    size_t num_rows = chunk->num_rows();
+    size_t num_partition_cols = partition_keys.size();
+
+    std::vector<uint32_t> partitions;
+    if (num_partitions <= 1) {
+        // all the rows are in the partition 0, the shift below would be 32 bits
+        partitions.assign(num_rows, 0);
+        num_partitions = 1;
+    } else {
+        std::vector<ColumnPtr> partition_columns(num_partition_cols);
+        for (size_t i = 0; i < num_partition_cols; ++i) {
+            ASSIGN_OR_RETURN(partition_columns[i], partition_keys[i]->evaluate(chunk));
+        }
+        partitions.assign(num_rows, HashUtil::FNV_SEED);
+
+        for (const ColumnPtr& column : partition_columns) {
+            column->fnv_hash(partitions.data(), 0, num_rows);
+        }
+        // find partition id
+        const uint32_t shift = 32 - __builtin_ctzll(num_partitions);
+        for (size_t i = 0; i < num_rows; ++i) {
+            partitions[i] = HashUtil::fmix32(partitions[i]) >> shift;
+        }
+    }
+
+    selection->resize(num_rows);
+    start_points->assign(num_partitions + 1, 0);
+    auto& points = *start_points;
+
+    for (uint32_t i : partitions) {
+        points[i]++;
+    }
+
+    for (int32_t i = 1; i <= points.size() - 1; ++i) {
+        points[i] += points[i - 1];
+    }
+
+    for (int32_t i = num_rows - 1; i >= 0; --i) {
+        (*selection)[points[partitions[i]] - 1] = i;
+        points[partitions[i]]--;
+    }
+    return Status::OK();
+}
+
 class PartitionChunkChannel {
 public:
     PartitionChunkChannel(MemTracker* tracker) : _tracker(tracker) {}
@@ -203,47 +256,11 @@ Status PartitionedHashJoinProberImpl::push_probe_chunk(RuntimeState* state, Chun
     auto& probers = _probers;
     auto& partition_keys = _hash_joiner.probe_expr_ctxs();
 
-    size_t num_rows = chunk->num_rows();
     size_t num_partitions = probers.size();
-    size_t num_partition_cols = partition_keys.size();
-
-    std::vector<ColumnPtr> partition_columns(num_partition_cols);
-    for (size_t i = 0; i < num_partition_cols; ++i) {
-        ASSIGN_OR_RETURN(partition_columns[i], partition_keys[i]->evaluate(chunk.get()));
-    }
-    std::vector<uint32_t> hash_values;
-    {
-        hash_values.assign(num_rows, HashUtil::FNV_SEED);
-
-        for (const ColumnPtr& column : partition_columns) {
-            column->fnv_hash(hash_values.data(), 0, num_rows);
-        }
-        // find partition id
-        for (size_t i = 0; i < hash_values.size(); ++i) {
-            hash_values[i] = HashUtil::fmix32(hash_values[i]) & (num_partitions - 1);
-        }
-    }
-
-    const auto& partitions = hash_values;
-
     std::vector<uint32_t> selection;
-    selection.resize(chunk->num_rows());
-
     std::vector<int32_t> channel_row_idx_start_points;
-    channel_row_idx_start_points.assign(num_partitions + 1, 0);
-
-    for (uint32_t i : partitions) {
-        channel_row_idx_start_points[i]++;
-    }
-
-    for (int32_t i = 1; i <= channel_row_idx_start_points.size() - 1; ++i) {
-        channel_row_idx_start_points[i] += channel_row_idx_start_points[i - 1];
-    }
-
-    for (int32_t i = chunk->num_rows() - 1; i >= 0; --i) {
-        selection[channel_row_idx_start_points[partitions[i]] - 1] = i;
-        channel_row_idx_start_points[partitions[i]]--;
-    }
+    RETURN_IF_ERROR(radix_partition_chunk(partition_keys, chunk.get(), num_partitions, &selection,
+                                          &channel_row_idx_start_points));
     _partition_input_channels.resize(num_partitions, PartitionChunkChannel(&_mem_tracker));
 
     for (size_t i = 0; i < num_partitions; ++i) {
@@ -404,7 +421,7 @@ enum class CacheLevel { L2, L3, MEMORY };
 
 class AdaptivePartitionHashJoinBuilder final : public HashJoinBuilder {
 public:
-    AdaptivePartitionHashJoinBuilder(HashJoiner& hash_joiner);
+    AdaptivePartitionHashJoinBuilder(HashJoiner& hash_joiner, const HashJoinBuildOptions& options);
     ~AdaptivePartitionHashJoinBuilder() override = default;
 
     void create(const HashTableParam& param) override;
@@ -444,6 +461,7 @@ private:
     void _init_partition_nums(const HashTableParam& param);
     Status _convert_to_single_partition();
     Status _append_chunk_to_partitions(const ChunkPtr& chunk);
+    void _update_partition_profile();
 
 private:
     std::vector<std::unique_ptr<SingleHashJoinBuilder>> _builders;
@@ -461,10 +479,13 @@ private:
     size_t _L3_cache_size = 0;
 
     size_t _pushed_chunks = 0;
+
+    const size_t _partition_join_min_build_bytes;
 };
 
-AdaptivePartitionHashJoinBuilder::AdaptivePartitionHashJoinBuilder(HashJoiner& hash_joiner)
-        : HashJoinBuilder(hash_joiner) {
+AdaptivePartitionHashJoinBuilder::AdaptivePartitionHashJoinBuilder(HashJoiner& hash_joiner,
+                                                                   const HashJoinBuildOptions& options)
+        : HashJoinBuilder(hash_joiner), _partition_join_min_build_bytes(options.partition_join_min_build_bytes) {
     static constexpr size_t DEFAULT_L2_CACHE_SIZE = 1 * 1024 * 1024;
     static constexpr size_t DEFAULT_L3_CACHE_SIZE = 32 * 1024 * 1024;
     const auto& cache_sizes = CpuInfo::get_cache_sizes();
@@ -528,8 +549,8 @@ void AdaptivePartitionHashJoinBuilder::_adjust_partition_rows(size_t build_row_s
     _fit_L2_cache_max_rows = _L2_cache_size / build_row_size;
     _fit_L3_cache_max_rows = _L3_cache_size / build_row_size;
 
-    // If the hash table is smaller than the L2 cache. we don't think partition hash join is needed.
-    _partition_join_min_rows = _fit_L2_cache_max_rows;
+    _partition_join_min_rows = partition_hash_join_min_rows(_L2_cache_size, _partition_join_min_build_bytes,
+                                                             build_row_size);
     // If the hash table after partition can't be loaded to L3. we don't think partition hash join is needed.
     _partition_join_max_rows = _fit_L3_cache_max_rows * _partition_num;
 
@@ -540,7 +561,8 @@ void AdaptivePartitionHashJoinBuilder::_adjust_partition_rows(size_t build_row_s
     } else if (_probe_estimated_costs + _estimated_build_cost<CacheLevel::L3>(build_row_size) <
                _estimated_build_cost<CacheLevel::MEMORY>(build_row_size)) {
         // It is only after this that performance gains can be realized beyond the L3 cache.
-        _partition_join_min_rows = _fit_L3_cache_max_rows;
+        // The threshold of the build size still holds.
+        _partition_join_min_rows = std::max(_partition_join_min_rows, _fit_L3_cache_max_rows);
     } else {
         // Partitioned joins don't have performance gains. Not using partition hash join.
         _partition_num = 1;
@@ -638,47 +660,11 @@ Status AdaptivePartitionHashJoinBuilder::_convert_to_single_partition() {
 Status AdaptivePartitionHashJoinBuilder::_append_chunk_to_partitions(const ChunkPtr& chunk) {
     const std::vector<ExprContext*>& build_partition_keys = _hash_joiner.build_expr_ctxs();
 
-    size_t num_rows = chunk->num_rows();
     size_t num_partitions = _builders.size();
-    size_t num_partition_cols = build_partition_keys.size();
-
-    std::vector<ColumnPtr> partition_columns(num_partition_cols);
-    for (size_t i = 0; i < num_partition_cols; ++i) {
-        ASSIGN_OR_RETURN(partition_columns[i], build_partition_keys[i]->evaluate(chunk.get()));
-    }
-    std::vector<uint32_t> hash_values;
-    {
-        hash_values.assign(num_rows, HashUtil::FNV_SEED);
-
-        for (const ColumnPtr& column : partition_columns) {
-            column->fnv_hash(hash_values.data(), 0, num_rows);
-        }
-        // find partition id
-        for (size_t i = 0; i < hash_values.size(); ++i) {
-            hash_values[i] = HashUtil::fmix32(hash_values[i]) & (num_partitions - 1);
-        }
-    }
-
-    const auto& partitions = hash_values;
-
     std::vector<uint32_t> selection;
-    selection.resize(chunk->num_rows());
-
     std::vector<int32_t> channel_row_idx_start_points;
-    channel_row_idx_start_points.assign(num_partitions + 1, 0);
-
-    for (uint32_t i : partitions) {
-        channel_row_idx_start_points[i]++;
-    }
-
-    for (int32_t i = 1; i <= channel_row_idx_start_points.size() - 1; ++i) {
-        channel_row_idx_start_points[i] += channel_row_idx_start_points[i - 1];
-    }
-
-    for (int32_t i = chunk->num_rows() - 1; i >= 0; --i) {
-        selection[channel_row_idx_start_points[partitions[i]] - 1] = i;
-        channel_row_idx_start_points[partitions[i]]--;
-    }
+    RETURN_IF_ERROR(radix_partition_chunk(build_partition_keys, chunk.get(), num_partitions, &selection,
+                                          &channel_row_idx_start_points));
 
     for (size_t i = 0; i < num_partitions; ++i) {
         auto from = channel_row_idx_start_points[i];
@@ -730,10 +716,20 @@ Status AdaptivePartitionHashJoinBuilder::build(RuntimeState* state) {
     for (auto& builder : _builders) {
         RETURN_IF_ERROR(builder->build(state));
     }
+    _update_partition_profile();
     _ready = true;
     return Status::OK();
 }
 
+void AdaptivePartitionHashJoinBuilder::_update_partition_profile() {
+    std::vector<size_t> partition_rows;
+    partition_rows.reserve(_builders.size());
+    for (const auto& builder : _builders) {
+        partition_rows.push_back(builder->hash_table().get_row_count());
+    }
+    _hash_joiner.build_metrics().update_partition_stats(partition_rows);
+}
+
 void AdaptivePartitionHashJoinBuilder::visitHt(const std::function<void(JoinHashTable*)>& visitor) {
     for (auto& builder : _builders) {
         builder->visitHt(visitor);
@@ -775,10 +771,17 @@ void AdaptivePartitionHashJoinBuilder::clone_readable(HashJoinBuilder* builder)
     }
 }
 
+size_t partition_hash_join_min_rows(size_t l2_cache_size, size_t min_build_bytes, size_t build_row_size) {
+    build_row_size = std::max(build_row_size, 4UL);
+    // If the hash table is smaller than the L2 cache. we don't think partition hash join is needed.
+    // Partitioning turned on automatically only pays off for the hash tables large enough.
+    return std::max(l2_cache_size, min_build_bytes) / build_row_size;
+}
+
 HashJoinBuilder* HashJoinBuilderFactory::create(ObjectPool* pool, const HashJoinBuildOptions& options,
                                                 HashJoiner& hash_joiner) {
     if (options.enable_partitioned_hash_join) {
-        return pool->add(new AdaptivePartitionHashJoinBuilder(hash_joiner));
+        return pool->add(new AdaptivePartitionHashJoinBuilder(hash_joiner, options));
     } else {
         return pool->add(new SingleHashJoinBuilder(hash_joiner));
     }
@@ -180,8 +180,14 @@ private:
 
 struct HashJoinBuildOptions {
     bool enable_partitioned_hash_join = false;
+    // When greater than 0, the build side is only kept partitioned when its hash table is larger than it.
+    size_t partition_join_min_build_bytes = 0;
 };
 
+// Return the min rows of the build side to keep it partitioned, i.e. the rows of the hash table which is larger than
+// both the L2 cache and |min_build_bytes|.
+size_t partition_hash_join_min_rows(size_t l2_cache_size, size_t min_build_bytes, size_t build_row_size);
+
 class HashJoinBuilderFactory {
 public:
     static HashJoinBuilder* create(ObjectPool* pool, const HashJoinBuildOptions& options, HashJoiner& hash_joiner);
@@ -967,6 +967,7 @@ Status HashJoinNode::_do_publish_runtime_filters(RuntimeState* state, int64_t li
         bool eq_null = _is_null_safes[expr_order];
         RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter,
                                                                        kHashJoinKeyColumnOffset, eq_null));
+        filter->finish_build();
         rf_desc->set_runtime_filter(filter);
     }
 
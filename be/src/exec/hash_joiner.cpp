@@ -58,6 +58,21 @@ void HashJoinBuildMetrics::prepare(RuntimeProfile* runtime_profile) {
     hash_table_memory_usage = ADD_COUNTER(runtime_profile, "HashTableMemoryUsage", TUnit::BYTES);
     partial_runtime_bloom_filter_bytes = ADD_COUNTER(runtime_profile, "PartialRuntimeBloomFilterBytes", TUnit::BYTES);
     partition_nums = ADD_COUNTER(runtime_profile, "PartitionNums", TUnit::UNIT);
+    partition_max_rows = ADD_COUNTER(runtime_profile, "PartitionMaxRows", TUnit::UNIT);
+    partition_skew = ADD_COUNTER(runtime_profile, "PartitionSkew%", TUnit::UNIT);
+}
+
+void HashJoinBuildMetrics::update_partition_stats(const std::vector<size_t>& partition_rows) const {
+    size_t total_rows = 0;
+    size_t max_rows = 0;
+    for (size_t rows : partition_rows) {
+        total_rows += rows;
+        max_rows = std::max(max_rows, rows);
+    }
+    const size_t avg_rows = partition_rows.empty() ? 0 : total_rows / partition_rows.size();
+    COUNTER_SET(partition_nums, (int64_t)partition_rows.size());
+    COUNTER_SET(partition_max_rows, (int64_t)max_rows);
+    COUNTER_SET(partition_skew, avg_rows == 0 ? 100 : (int64_t)(100 * max_rows / avg_rows));
 }
 
 HashJoiner::HashJoiner(const HashJoinerParam& param)
@@ -89,15 +104,26 @@ HashJoiner::HashJoiner(const HashJoinerParam& param)
         _build_runtime_filters_from_planner = param._hash_join_node.build_runtime_filters_from_planner;
     }
 
-    HashJoinBuildOptions build_options;
-    build_options.enable_partitioned_hash_join = param._enable_partition_hash_join;
-
-    _hash_join_builder = HashJoinBuilderFactory::create(_pool, build_options, *this);
+    _hash_join_builder = HashJoinBuilderFactory::create(_pool, build_options(param), *this);
     _hash_join_prober = _pool->add(new HashJoinProber(*this));
     _build_metrics = _pool->add(new HashJoinBuildMetrics());
     _probe_metrics = _pool->add(new HashJoinProbeMetrics());
 }
 
+HashJoinBuildOptions HashJoiner::build_options(const HashJoinerParam& param) {
+    HashJoinBuildOptions build_options;
+    build_options.enable_partitioned_hash_join = param._enable_partition_hash_join;
+    // An explicit enable_partition_hash_join=false of the planner is respected. With late materialization the
+    // planner decides by the filter ratio of the join whether partitioning pays off, otherwise turn it on for the
+    // large build sides by ourselves.
+    if (!param._hash_join_node.__isset.enable_partition_hash_join && !param._enable_late_materialization &&
+        !param._mor_reader_mode && config::auto_partition_hash_join_min_build_bytes > 0) {
+        build_options.enable_partitioned_hash_join = true;
+        build_options.partition_join_min_build_bytes = config::auto_partition_hash_join_min_build_bytes;
+    }
+    return build_options;
+}
+
 Status HashJoiner::prepare_builder(RuntimeState* state, RuntimeProfile* runtime_profile) {
     if (_runtime_state == nullptr) {
         _runtime_state = state;
@@ -597,6 +623,7 @@ Status HashJoiner::_create_runtime_bloom_filters(RuntimeState* state, int64_t li
             filter->init(ht_row_count);
             RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(columns, build_type, filter.get(),
                                                                            kHashJoinKeyColumnOffset, eq_null));
+            filter->finish_build();
         }
 
         _runtime_bloom_filter_build_params.emplace_back(pipeline::RuntimeBloomFilterBuildParam(
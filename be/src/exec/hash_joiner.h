@@ -161,8 +161,13 @@ struct HashJoinBuildMetrics {
     RuntimeProfile::Counter* hash_table_memory_usage = nullptr;
     RuntimeProfile::Counter* partial_runtime_bloom_filter_bytes = nullptr;
     RuntimeProfile::Counter* partition_nums = nullptr;
+    RuntimeProfile::Counter* partition_max_rows = nullptr;
+    // rows of the largest partition / average rows of the partitions * 100
+    RuntimeProfile::Counter* partition_skew = nullptr;
 
     void prepare(RuntimeProfile* runtime_profile);
+    // Set the partition counters by the rows of each partition of the build side.
+    void update_partition_stats(const std::vector<size_t>& partition_rows) const;
 };
 
 // TODO: rename HashJoiner to HashJoinController
@@ -170,6 +175,10 @@ class HashJoiner final : public pipeline::ContextWithDependency {
 public:
     explicit HashJoiner(const HashJoinerParam& param);
 
+    // The partitioned hash join is used if the planner asks for it. If the planner leaves it unset, it's turned on
+    // for the build sides larger than config::auto_partition_hash_join_min_build_bytes.
+    static HashJoinBuildOptions build_options(const HashJoinerParam& param);
+
     ~HashJoiner() override {
         if (_runtime_state != nullptr) {
             close(_runtime_state);
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/statusor.h"
 #include "exec/hash_join_node.h"
 #include "serde/column_array_serde.h"
@@ -528,6 +529,7 @@ int64_t JoinHashTable::mem_usage() const {
     }
     usage += _table_items->first.capacity() * sizeof(uint32_t);
     usage += _table_items->next.capacity() * sizeof(uint32_t);
+    usage += _table_items->linear_probing_slots.capacity();
     if (_table_items->build_pool != nullptr) {
         usage += _table_items->build_pool->total_reserved_bytes();
     }
@@ -772,9 +774,9 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
         case LogicalType::TYPE_SMALLINT:
             return JoinHashMapType::key16;
         case LogicalType::TYPE_INT:
-            return JoinHashMapType::key32;
+            return _use_linear_probing() ? JoinHashMapType::linear_probing_key32 : JoinHashMapType::key32;
         case LogicalType::TYPE_BIGINT:
-            return JoinHashMapType::key64;
+            return _use_linear_probing() ? JoinHashMapType::linear_probing_key64 : JoinHashMapType::key64;
         case LogicalType::TYPE_LARGEINT:
             return JoinHashMapType::key128;
         case LogicalType::TYPE_FLOAT:
@@ -821,15 +823,24 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
         return JoinHashMapType::fixed32;
     }
     if (total_size_in_byte <= 8) {
-        return JoinHashMapType::fixed64;
+        return _use_linear_probing() ? JoinHashMapType::linear_probing_fixed64 : JoinHashMapType::fixed64;
     }
     if (total_size_in_byte <= 16) {
-        return JoinHashMapType::fixed128;
+        return _use_linear_probing() ? JoinHashMapType::linear_probing_fixed128 : JoinHashMapType::fixed128;
     }
 
     return JoinHashMapType::slice;
 }
 
+bool JoinHashTable::_use_linear_probing() const {
+    // Once built, keep the layout of the hash table even if the config has been changed since.
+    if (!_table_items->first.empty() || !_table_items->linear_probing_slots.empty()) {
+        return !_table_items->linear_probing_slots.empty();
+    }
+    // The slots are sized to twice the row count, make sure they can never be filled up.
+    return config::enable_hash_join_linear_probing && _table_items->row_count < JoinHashMapHelper::MAX_BUCKET_SIZE / 2;
+}
+
 size_t JoinHashTable::_get_size_of_fixed_and_contiguous_type(LogicalType data_type) {
     switch (data_type) {
     case LogicalType::TYPE_BOOLEAN:
@@ -983,5 +994,9 @@ template class JoinHashMapForSerializedKey(TYPE_VARCHAR);
 template class JoinHashMapForFixedSizeKey(TYPE_INT);
 template class JoinHashMapForFixedSizeKey(TYPE_BIGINT);
 template class JoinHashMapForFixedSizeKey(TYPE_LARGEINT);
+template class JoinHashMapForLinearProbing(TYPE_INT);
+template class JoinHashMapForLinearProbing(TYPE_BIGINT);
+template class JoinHashMapForFixedSizeLinearProbing(TYPE_BIGINT);
+template class JoinHashMapForFixedSizeLinearProbing(TYPE_LARGEINT);
 
 } // namespace starrocks
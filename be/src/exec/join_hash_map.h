@@ -59,7 +59,11 @@ class ColumnRef;
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(linear_probing_key32)        \
+    M(linear_probing_key64)        \
+    M(linear_probing_fixed64)      \
+    M(linear_probing_fixed128)
 
 enum class JoinHashMapType {
     empty,
@@ -80,8 +84,12 @@ enum class JoinHashMapType {
     keydecimal128,
     slice,
     fixed32, // 4 bytes
-    fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed64,  // 8 bytes
+    fixed128, // 16 bytes
+    linear_probing_key32,
+    linear_probing_key64,
+    linear_probing_fixed64,
+    linear_probing_fixed128
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
@@ -113,6 +121,10 @@ struct JoinHashTableItems {
     // about the bucket-chained hash table of this kind.
     Buffer<uint32_t> first;
     Buffer<uint32_t> next;
+    // Used by the linear probing hash maps instead of "first". Every slot stores a distinct build key side by side
+    // with the index of a build row holding it, and the other rows with the same key are chained through "next",
+    // so a chain never contains a key different from the one in its slot.
+    Buffer<uint8_t> linear_probing_slots;
     Buffer<Slice> build_slice;
     ColumnPtr build_key_column = nullptr;
     uint32_t bucket_size = 0;
@@ -152,6 +164,17 @@ struct JoinHashTableItems {
         }
     }
 
+    void calculate_linear_probing_ht_info(size_t distinct_keys, size_t slot_bytes) {
+        used_buckets = distinct_keys;
+        keys_per_bucket = used_buckets == 0 ? 0 : row_count * 1.0 / used_buckets;
+        // each probe touches one slot (keys and indexes are stored together) and rarely its neighbour,
+        // so only the size of slots decides whether interleaving is worth it.
+        size_t probe_bytes = slot_bytes + row_count * sizeof(uint32_t);
+        cache_miss_serious = row_count > (1UL << 18) && probe_bytes > (1UL << 27);
+        VLOG_QUERY << "linear probing ht cache miss serious = " << cache_miss_serious << " row# = " << row_count
+                   << " , bytes = " << probe_bytes << " , distinct keys = " << distinct_keys;
+    }
+
     TJoinOp::type join_type = TJoinOp::INNER_JOIN;
 
     std::unique_ptr<MemPool> build_pool = nullptr;
@@ -344,6 +367,15 @@ public:
         return phmap::priv::NormalizeCapacity(expect_bucket_size) + 1;
     }
 
+    // Linear probing degrades quickly with the load factor, so keep at least half of the slots empty.
+    static uint32_t calc_linear_probing_bucket_size(uint32_t size) {
+        size_t expect_bucket_size = static_cast<size_t>(size) * 2;
+        if (expect_bucket_size >= MAX_BUCKET_SIZE) {
+            return MAX_BUCKET_SIZE;
+        }
+        return phmap::priv::NormalizeCapacity(expect_bucket_size) + 1;
+    }
+
     template <typename CppType>
     static uint32_t calc_bucket_num(const CppType& value, uint32_t bucket_size) {
         using HashFunc = JoinKeyHash<CppType>;
@@ -521,6 +553,111 @@ private:
                                        const Columns& data_columns, const NullColumns& null_columns, uint8_t* ptr);
 };
 
+// An open addressing hash table with linear probing, which keeps the build keys and the build row indexes side by
+// side in "JoinHashTableItems.linear_probing_slots". Compared with the bucket-chained table, a probe that misses the
+// cache touches one slot (usually one cache line) instead of "first", "next" and the key column, and the buckets
+// of a whole batch of rows are prefetched before any of them are compared.
+// Only distinct keys occupy slots, rows with the same key are chained through "JoinHashTableItems.next", so the
+// probe loops of JoinHashMap can consume "HashTableProbeState.next" exactly as they do for the chained table.
+template <LogicalType LT>
+class LinearProbingHashTable {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+
+    struct Slot {
+        CppType key;
+        // 0 means the slot is empty, because the row 0 of the build side is always a placeholder.
+        uint32_t index;
+    };
+
+    // The number of rows whose buckets are prefetched ahead of the comparisons.
+    static constexpr uint32_t PREFETCH_BATCH_SIZE = 16;
+
+    static void prepare(JoinHashTableItems* table_items);
+
+    // Insert build rows [start, start + count) whose keys are keys[start, start + count).
+    // is_nulls is indexed from 0 by row - start and can be nullptr.
+    // Returns the number of new distinct keys.
+    static size_t insert(JoinHashTableItems* table_items, const Buffer<CppType>& keys, const uint8_t* is_nulls,
+                         uint32_t start, uint32_t count, Buffer<uint32_t>* buckets);
+
+    // Find the first build row of each probe key and store it into next, 0 means not found.
+    static void lookup(const JoinHashTableItems& table_items, const Buffer<CppType>& keys, const uint8_t* is_nulls,
+                       uint32_t count, Buffer<uint32_t>* buckets, Buffer<uint32_t>* next);
+
+    static Slot* slots(JoinHashTableItems* table_items) {
+        return reinterpret_cast<Slot*>(table_items->linear_probing_slots.data());
+    }
+    static const Slot* slots(const JoinHashTableItems& table_items) {
+        return reinterpret_cast<const Slot*>(table_items.linear_probing_slots.data());
+    }
+
+private:
+    static void _prefetch(const Slot* slots, const Buffer<uint32_t>& buckets, uint32_t from, uint32_t to) {
+        for (uint32_t i = from; i < to; i++) {
+            __builtin_prefetch(slots + buckets[i]);
+        }
+    }
+};
+
+template <LogicalType LT>
+class LinearProbingJoinBuildFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
+
+    static void prepare(RuntimeState* state, JoinHashTableItems* table_items);
+    static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items) {
+        return JoinBuildFunc<LT>::get_key_data(table_items);
+    }
+    static void construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
+                                     HashTableProbeState* probe_state);
+};
+
+template <LogicalType LT>
+class FixedSizeLinearProbingJoinBuildFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
+
+    static void prepare(RuntimeState* state, JoinHashTableItems* table_items);
+    static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items) {
+        return FixedSizeJoinBuildFunc<LT>::get_key_data(table_items);
+    }
+    static void construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
+                                     HashTableProbeState* probe_state);
+};
+
+template <LogicalType LT>
+class LinearProbingJoinProbeFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
+
+    static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {}
+    static void lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+    static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
+        return JoinProbeFunc<LT>::get_key_data(probe_state);
+    }
+    static bool equal(const CppType& x, const CppType& y) { return x == y; }
+};
+
+template <LogicalType LT>
+class FixedSizeLinearProbingJoinProbeFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<LT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<LT>::ColumnType;
+
+    static void prepare(RuntimeState* state, HashTableProbeState* probe_state) {
+        FixedSizeJoinProbeFunc<LT>::prepare(state, probe_state);
+    }
+    static void lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+    static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
+        return FixedSizeJoinProbeFunc<LT>::get_key_data(probe_state);
+    }
+    static bool equal(const CppType& x, const CppType& y) { return x == y; }
+};
+
 // When hash table is empty, specific its implemention.
 // TODO: Merge with JoinHashMap?
 class JoinHashMapForEmpty {
@@ -804,6 +941,9 @@ private:
 #define JoinHashMapForDirectMapping(LT) JoinHashMap<LT, DirectMappingJoinBuildFunc<LT>, DirectMappingJoinProbeFunc<LT>>
 #define JoinHashMapForFixedSizeKey(LT) JoinHashMap<LT, FixedSizeJoinBuildFunc<LT>, FixedSizeJoinProbeFunc<LT>>
 #define JoinHashMapForSerializedKey(LT) JoinHashMap<LT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
+#define JoinHashMapForLinearProbing(LT) JoinHashMap<LT, LinearProbingJoinBuildFunc<LT>, LinearProbingJoinProbeFunc<LT>>
+#define JoinHashMapForFixedSizeLinearProbing(LT) \
+    JoinHashMap<LT, FixedSizeLinearProbingJoinBuildFunc<LT>, FixedSizeLinearProbingJoinProbeFunc<LT>>
 
 class JoinHashTable {
 public:
@@ -860,6 +1000,7 @@ private:
     void _init_join_keys();
 
     JoinHashMapType _choose_join_hash_map();
+    bool _use_linear_probing() const;
     static size_t _get_size_of_fixed_and_contiguous_type(LogicalType data_type);
 
     Status _upgrade_key_columns_if_overflow();
@@ -892,6 +1033,10 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForLinearProbing(TYPE_INT)> _linear_probing_key32 = nullptr;
+    std::unique_ptr<JoinHashMapForLinearProbing(TYPE_BIGINT)> _linear_probing_key64 = nullptr;
+    std::unique_ptr<JoinHashMapForFixedSizeLinearProbing(TYPE_BIGINT)> _linear_probing_fixed64 = nullptr;
+    std::unique_ptr<JoinHashMapForFixedSizeLinearProbing(TYPE_LARGEINT)> _linear_probing_fixed128 = nullptr;
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
 
@@ -387,6 +387,243 @@ void FixedSizeJoinProbeFunc<LT>::_probe_nullable_column(const JoinHashTableItems
     }
 }
 
+template <LogicalType LT>
+void LinearProbingHashTable<LT>::prepare(JoinHashTableItems* table_items) {
+    table_items->bucket_size = JoinHashMapHelper::calc_linear_probing_bucket_size(table_items->row_count + 1);
+    table_items->linear_probing_slots.resize(static_cast<size_t>(table_items->bucket_size) * sizeof(Slot), 0);
+    table_items->next.resize(table_items->row_count + 1, 0);
+}
+
+template <LogicalType LT>
+size_t LinearProbingHashTable<LT>::insert(JoinHashTableItems* table_items, const Buffer<CppType>& keys,
+                                          const uint8_t* is_nulls, uint32_t start, uint32_t count,
+                                          Buffer<uint32_t>* buckets) {
+    Slot* slots = LinearProbingHashTable<LT>::slots(table_items);
+    const uint32_t mask = table_items->bucket_size - 1;
+    auto& next = table_items->next;
+
+    JoinHashMapHelper::calc_bucket_nums<CppType>(keys, table_items->bucket_size, buckets, start, count);
+
+    size_t distinct_keys = 0;
+    _prefetch(slots, *buckets, 0, std::min(count, PREFETCH_BATCH_SIZE));
+    for (uint32_t batch_start = 0; batch_start < count; batch_start += PREFETCH_BATCH_SIZE) {
+        uint32_t batch_end = std::min(count, batch_start + PREFETCH_BATCH_SIZE);
+        _prefetch(slots, *buckets, batch_end, std::min(count, batch_end + PREFETCH_BATCH_SIZE));
+
+        for (uint32_t i = batch_start; i < batch_end; i++) {
+            if (is_nulls != nullptr && is_nulls[i] != 0) {
+                continue;
+            }
+            const uint32_t row = start + i;
+            const CppType& key = keys[row];
+            uint32_t bucket = (*buckets)[i];
+            while (true) {
+                Slot& slot = slots[bucket];
+                if (slot.index == 0) {
+                    slot.key = key;
+                    slot.index = row;
+                    distinct_keys++;
+                    break;
+                }
+                if (slot.key == key) {
+                    // Prepend to the chain of this key, which keeps the same order as the bucket-chained table.
+                    next[row] = slot.index;
+                    slot.index = row;
+                    break;
+                }
+                bucket = (bucket + 1) & mask;
+            }
+        }
+    }
+    return distinct_keys;
+}
+
+template <LogicalType LT>
+void LinearProbingHashTable<LT>::lookup(const JoinHashTableItems& table_items, const Buffer<CppType>& keys,
+                                        const uint8_t* is_nulls, uint32_t count, Buffer<uint32_t>* buckets,
+                                        Buffer<uint32_t>* next) {
+    const Slot* slots = LinearProbingHashTable<LT>::slots(table_items);
+    const uint32_t mask = table_items.bucket_size - 1;
+
+    JoinHashMapHelper::calc_bucket_nums<CppType>(keys, table_items.bucket_size, buckets, 0, count);
+
+    // Prefetch the buckets of the next batch while comparing the current one, so that the cache misses of a whole
+    // batch overlap with each other instead of being paid one by one.
+    _prefetch(slots, *buckets, 0, std::min(count, PREFETCH_BATCH_SIZE));
+    for (uint32_t batch_start = 0; batch_start < count; batch_start += PREFETCH_BATCH_SIZE) {
+        uint32_t batch_end = std::min(count, batch_start + PREFETCH_BATCH_SIZE);
+        _prefetch(slots, *buckets, batch_end, std::min(count, batch_end + PREFETCH_BATCH_SIZE));
+
+        for (uint32_t i = batch_start; i < batch_end; i++) {
+            if (is_nulls != nullptr && is_nulls[i] != 0) {
+                (*next)[i] = 0;
+                continue;
+            }
+            const CppType& key = keys[i];
+            uint32_t bucket = (*buckets)[i];
+            while (true) {
+                const Slot& slot = slots[bucket];
+                if (slot.index == 0 || slot.key == key) {
+                    (*next)[i] = slot.index;
+                    break;
+                }
+                bucket = (bucket + 1) & mask;
+            }
+        }
+    }
+}
+
+template <LogicalType LT>
+void LinearProbingJoinBuildFunc<LT>::prepare(RuntimeState* state, JoinHashTableItems* table_items) {
+    LinearProbingHashTable<LT>::prepare(table_items);
+}
+
+template <LogicalType LT>
+void LinearProbingJoinBuildFunc<LT>::construct_hash_table(RuntimeState* state, JoinHashTableItems* table_items,
+                                                          HashTableProbeState* probe_state) {
+    const auto& data = get_key_data(*table_items);
+    const uint8_t* null_data = nullptr;
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        null_data = nullable_column->null_column()->get_data().data();
+    }
+
+    const uint32_t row_count = table_items->row_count;
+    const uint32_t batch_size = state->chunk_size();
+    size_t distinct_keys = 0;
+    for (uint32_t start = 1; start < row_count + 1; start += batch_size) {
+        uint32_t count = std::min(batch_size, row_count + 1 - start);
+        distinct_keys += LinearProbingHashTable<LT>::insert(table_items, data,
+                                                            null_data == nullptr ? nullptr : null_data + start, start,
+                                                            count, &probe_state->buckets);
+    }
+    table_items->calculate_linear_probing_ht_info(distinct_keys, table_items->linear_probing_slots.size());
+}
+
+template <LogicalType LT>
+void FixedSizeLinearProbingJoinBuildFunc<LT>::prepare(RuntimeState* state, JoinHashTableItems* table_items) {
+    LinearProbingHashTable<LT>::prepare(table_items);
+    table_items->build_key_column = ColumnType::create(table_items->row_count + 1);
+}
+
+template <LogicalType LT>
+void FixedSizeLinearProbingJoinBuildFunc<LT>::construct_hash_table(RuntimeState* state,
+                                                                   JoinHashTableItems* table_items,
+                                                                   HashTableProbeState* probe_state) {
+    // prepare columns
+    Columns data_columns;
+    NullColumns null_columns;
+    for (size_t i = 0; i < table_items->key_columns.size(); i++) {
+        if (table_items->join_keys[i].is_null_safe_equal) {
+            data_columns.emplace_back(table_items->key_columns[i]);
+        } else if (table_items->key_columns[i]->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[i]);
+            data_columns.emplace_back(nullable_column->data_column());
+            if (table_items->key_columns[i]->has_null()) {
+                null_columns.emplace_back(nullable_column->null_column());
+            }
+        } else {
+            data_columns.emplace_back(table_items->key_columns[i]);
+        }
+    }
+
+    // serialize and build hash table
+    const uint32_t row_count = table_items->row_count;
+    const uint32_t batch_size = state->chunk_size();
+    const auto& data = get_key_data(*table_items);
+    size_t distinct_keys = 0;
+    for (uint32_t start = 1; start < row_count + 1; start += batch_size) {
+        uint32_t count = std::min(batch_size, row_count + 1 - start);
+        JoinHashMapHelper::serialize_fixed_size_key_column<LT>(data_columns, table_items->build_key_column.get(),
+                                                               start, count);
+        const uint8_t* is_nulls = nullptr;
+        if (!null_columns.empty()) {
+            for (uint32_t i = 0; i < count; i++) {
+                probe_state->is_nulls[i] = null_columns[0]->get_data()[start + i];
+            }
+            for (uint32_t i = 1; i < null_columns.size(); i++) {
+                for (uint32_t j = 0; j < count; j++) {
+                    probe_state->is_nulls[j] |= null_columns[i]->get_data()[start + j];
+                }
+            }
+            is_nulls = probe_state->is_nulls.data();
+        }
+        distinct_keys += LinearProbingHashTable<LT>::insert(table_items, data, is_nulls, start, count,
+                                                            &probe_state->buckets);
+    }
+    table_items->calculate_linear_probing_ht_info(distinct_keys, table_items->linear_probing_slots.size());
+}
+
+template <LogicalType LT>
+void LinearProbingJoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items,
+                                                 HashTableProbeState* probe_state) {
+    const uint32_t probe_row_count = probe_state->probe_row_count;
+    const auto& data = get_key_data(*probe_state);
+
+    const uint8_t* is_nulls = nullptr;
+    probe_state->null_array = nullptr;
+    if ((*probe_state->key_columns)[0]->is_nullable()) {
+        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        if (nullable_column->has_null()) {
+            probe_state->null_array = &nullable_column->null_column()->get_data();
+            is_nulls = probe_state->null_array->data();
+        }
+    }
+
+    LinearProbingHashTable<LT>::lookup(table_items, data, is_nulls, probe_row_count, &probe_state->buckets,
+                                       &probe_state->next);
+    probe_state->consider_probe_time_locality();
+}
+
+template <LogicalType LT>
+void FixedSizeLinearProbingJoinProbeFunc<LT>::lookup_init(const JoinHashTableItems& table_items,
+                                                          HashTableProbeState* probe_state) {
+    // prepare columns
+    Columns data_columns;
+    NullColumns null_columns;
+
+    for (size_t i = 0; i < probe_state->key_columns->size(); i++) {
+        if (table_items.join_keys[i].is_null_safe_equal) {
+            if ((*probe_state->key_columns)[i]->is_nullable()) {
+                data_columns.emplace_back((*probe_state->key_columns)[i]);
+            } else {
+                auto tmp_column = NullableColumn::create((*probe_state->key_columns)[i],
+                                                         NullColumn::create(probe_state->probe_row_count, 0));
+                data_columns.emplace_back(tmp_column);
+            }
+        } else if ((*probe_state->key_columns)[i]->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[i]);
+            data_columns.emplace_back(nullable_column->data_column());
+            if ((*probe_state->key_columns)[i]->has_null()) {
+                null_columns.emplace_back(nullable_column->null_column());
+            }
+        } else {
+            data_columns.emplace_back((*probe_state->key_columns)[i]);
+        }
+    }
+
+    const uint32_t row_count = probe_state->probe_row_count;
+    const uint8_t* is_nulls = nullptr;
+    if (!null_columns.empty()) {
+        for (uint32_t i = 0; i < row_count; i++) {
+            probe_state->is_nulls[i] = null_columns[0]->get_data()[i];
+        }
+        for (uint32_t i = 1; i < null_columns.size(); i++) {
+            for (uint32_t j = 0; j < row_count; j++) {
+                probe_state->is_nulls[j] |= null_columns[i]->get_data()[j];
+            }
+        }
+        probe_state->null_array = &null_columns[0]->get_data();
+        is_nulls = probe_state->is_nulls.data();
+    }
+
+    JoinHashMapHelper::serialize_fixed_size_key_column<LT>(data_columns, probe_state->probe_key_column.get(), 0,
+                                                           row_count);
+    LinearProbingHashTable<LT>::lookup(table_items, get_key_data(*probe_state), is_nulls, row_count,
+                                       &probe_state->buckets, &probe_state->next);
+    probe_state->consider_probe_time_locality();
+}
+
 template <LogicalType LT, class BuildFunc, class ProbeFunc>
 void JoinHashMap<LT, BuildFunc, ProbeFunc>::build_prepare(RuntimeState* state) {
     BuildFunc().prepare(state, _table_items);
@@ -604,6 +604,7 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _segments_read_count = ADD_CHILD_COUNTER(_scan_profile, "SegmentsReadCount", TUnit::UNIT, "SegmentRead");
     _total_columns_data_page_count =
             ADD_CHILD_COUNTER(_scan_profile, "TotalColumnsDataPageCount", TUnit::UNIT, "SegmentRead");
+    _page_prefetch_bytes = ADD_CHILD_COUNTER(_scan_profile, "PagePrefetchBytes", TUnit::BYTES, "SegmentRead");
 
     /// IOTime
     _io_timer = ADD_TIMER(_scan_profile, "IOTime");
@@ -252,6 +252,7 @@ private:
     RuntimeProfile::Counter* _rowsets_read_count = nullptr;
     RuntimeProfile::Counter* _segments_read_count = nullptr;
     RuntimeProfile::Counter* _total_columns_data_page_count = nullptr;
+    RuntimeProfile::Counter* _page_prefetch_bytes = nullptr;
     RuntimeProfile::Counter* _pushdown_access_paths_counter = nullptr;
 };
 
@@ -22,6 +22,7 @@
 #include "aggregate_distinct_streaming_source_operator.cpp"
 #include "aggregate_streaming_sink_operator.cpp"
 #include "aggregate_streaming_source_operator.cpp"
+#include "partitioned_aggregate_blocking_operator.cpp"
 #include "sorted_aggregate_streaming_sink_operator.cpp"
 #include "sorted_aggregate_streaming_source_operator.cpp"
 #include "spillable_aggregate_blocking_sink_operator.cpp"
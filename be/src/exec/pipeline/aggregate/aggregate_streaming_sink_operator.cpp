@@ -21,6 +21,7 @@
 #include "exec/pipeline/pipeline_fwd.h"
 #include "runtime/current_thread.h"
 #include "simd/simd.h"
+#include "util/cpu_info.h"
 namespace starrocks::pipeline {
 
 Status AggregateStreamingSinkOperator::prepare(RuntimeState* state) {
@@ -29,6 +30,14 @@ Status AggregateStreamingSinkOperator::prepare(RuntimeState* state) {
     if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::LIMITED_MEM) {
         _limited_mem_state.limited_memory_size = config::streaming_agg_limited_memory_size;
     }
+    if (config::streaming_agg_cache_preaggregation_ht_size > 0) {
+        _cache_preagg_ht_size = config::streaming_agg_cache_preaggregation_ht_size;
+    } else {
+        _cache_preagg_ht_size = std::max<size_t>(CpuInfo::get_cache_sizes()[CpuInfo::L2_CACHE],
+                                                 AggrAutoContext::MinCachePreaggHtSize);
+    }
+    _cache_preagg_flush_counter = ADD_COUNTER(_unique_metrics, "CachePreaggFlushCount", TUnit::UNIT);
+    _cache_preagg_hit_rows_counter = ADD_COUNTER(_unique_metrics, "CachePreaggHitRows", TUnit::UNIT);
     return _aggregator->open(state);
 }
 
@@ -157,7 +166,8 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_selective_preaggregation(c
  * more data into hash table, the state shifts from INIT_PREAGG to ADJUST. The ADJUST state has 3 branches:
  * (1) If continuous AggrAutoContext::StableLimit chunks are lowly aggregated, shifting to PASS_THROUGH state;
  * (2) Else if continuous AggrAutoContext::StableLimit chunks are highly aggregated, shifting to PREAGG state;
- * (3) otherwise or the ADJUST state sustains continuous_limit times, shifting to SELECTIVE_PREAGG state.
+ * (3) otherwise or the ADJUST state sustains continuous_limit times, shifting to SELECTIVE_PREAGG state, or
+ *     CACHE_PREAGG state if enable_streaming_agg_cache_preaggregation is true.
  *
  * PASS_THROUGH state sustains continuous_limit times, it will force doing preaggregation if the hash table's size <
  * MaxHtSize, otherwise it will go to ADJUST state. Doing FORCE_PREAGG aims freshening the hash table with new coming
@@ -167,6 +177,10 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_selective_preaggregation(c
  * should be small enough to limit the size of hash table.
  *
  * SELECTIVE_PREAGG state aggregates continuous_limit chunks, then shifting to ADJUST state.
+ *
+ * CACHE_PREAGG state limits the hash table to the size of L2 cache, see _push_chunk_by_cache_preaggregation. If
+ * continuous AggrAutoContext::StableLimit chunks are lowly aggregated even by the hot keys, shifting to PASS_THROUGH
+ * state; if they are highly aggregated, shifting to ADJUST state to give the hash table a chance to grow.
  */
 Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk, const size_t chunk_size) {
     size_t allocated_bytes = _aggregator->hash_map_variant().allocated_memory_usage(_aggregator->mem_pool());
@@ -241,7 +255,19 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
             _auto_context.pass_through_count = 0;
             _auto_context.preagg_count = 0;
             if (_auto_context.selective_preagg_count == AggrAutoContext::StableLimit) {
-                _auto_state = AggrAutoState::SELECTIVE_PREAGG;
+                if (config::enable_streaming_agg_cache_preaggregation) {
+                    _auto_state = AggrAutoState::CACHE_PREAGG;
+                    _auto_context.selective_preagg_count = 0;
+                    _auto_context.cache_preagg_count = 0;
+                    _auto_context.cache_preagg_low_reduction_count = 0;
+                    _auto_context.cache_preagg_high_reduction_count = 0;
+                    // The hash table built by the former states is too large to stay in the cache, start over.
+                    if (allocated_bytes >= _cache_preagg_ht_size) {
+                        _flush_cache_preagg_hash_table();
+                    }
+                } else {
+                    _auto_state = AggrAutoState::SELECTIVE_PREAGG;
+                }
                 VLOG_ROW << "auto agg: continuous " << AggrAutoContext::StableLimit << " "
                          << _auto_context.get_auto_state_string(AggrAutoState::ADJUST)
                          << _auto_context.get_auto_state_string(_auto_state);
@@ -296,10 +322,76 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const ChunkPtr& chunk
         }
         break;
     }
+    case AggrAutoState::CACHE_PREAGG: {
+        RETURN_IF_ERROR(_push_chunk_by_cache_preaggregation(chunk, chunk_size, allocated_bytes));
+        break;
+    }
+    }
+    return Status::OK();
+}
+
+// Aggregate the hot keys in a hash table as small as the L2 cache, and stream the other rows.
+// Before the hash table is full, all the rows are aggregated into it. After that, only the rows hitting the keys in it
+// are aggregated, and the hash table is flushed every AggrAutoContext::CachePreaggFlushLimit chunks, so that the keys
+// getting hot recently can take the place of the stale ones. The reduction of each chunk after the hash table is full
+// decides whether to leave this state.
+Status AggregateStreamingSinkOperator::_push_chunk_by_cache_preaggregation(const ChunkPtr& chunk,
+                                                                           const size_t chunk_size,
+                                                                           const size_t allocated_bytes) {
+    if (allocated_bytes < _cache_preagg_ht_size) {
+        const size_t ht_size = _aggregator->hash_map_variant().size();
+        RETURN_IF_ERROR(_push_chunk_by_force_preaggregation(chunk, chunk_size));
+        COUNTER_UPDATE(_cache_preagg_hit_rows_counter, chunk_size - (_aggregator->hash_map_variant().size() - ht_size));
+        return Status::OK();
+    }
+
+    {
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        TRY_CATCH_BAD_ALLOC(_aggregator->build_hash_map_with_selection(chunk_size));
+    }
+    size_t hit_count = SIMD::count_zero(_aggregator->streaming_selection());
+    COUNTER_UPDATE(_cache_preagg_hit_rows_counter, hit_count);
+    RETURN_IF_ERROR(_push_chunk_by_selective_preaggregation(chunk, chunk_size, false));
+
+    if (_auto_context.is_low_reduction(hit_count, chunk_size)) {
+        _auto_context.cache_preagg_low_reduction_count++;
+        _auto_context.cache_preagg_high_reduction_count = 0;
+    } else if (_auto_context.is_high_reduction(hit_count, chunk_size)) {
+        _auto_context.cache_preagg_high_reduction_count++;
+        _auto_context.cache_preagg_low_reduction_count = 0;
+    } else {
+        _auto_context.cache_preagg_low_reduction_count = 0;
+        _auto_context.cache_preagg_high_reduction_count = 0;
+    }
+
+    if (_auto_context.cache_preagg_low_reduction_count == AggrAutoContext::StableLimit) {
+        _auto_state = AggrAutoState::PASS_THROUGH;
+        _auto_context.pass_through_count = 0;
+    } else if (_auto_context.cache_preagg_high_reduction_count == AggrAutoContext::StableLimit) {
+        _auto_state = AggrAutoState::ADJUST;
+        _auto_context.adjust_count = 0;
+        _auto_context.preagg_count = 0;
+    } else if (++_auto_context.cache_preagg_count >= AggrAutoContext::CachePreaggFlushLimit) {
+        _auto_context.cache_preagg_count = 0;
+        _flush_cache_preagg_hash_table();
+    }
+
+    if (_auto_state != AggrAutoState::CACHE_PREAGG) {
+        VLOG_ROW << "auto agg: continuous " << AggrAutoContext::StableLimit << " reduction "
+                 << hit_count * 1.0 / chunk_size << " "
+                 << _auto_context.get_auto_state_string(AggrAutoState::CACHE_PREAGG) << " -> "
+                 << _auto_context.get_auto_state_string(_auto_state);
     }
     return Status::OK();
 }
 
+// Let the source operator output all the states in the hash table and reset the aggregator,
+// just like the LIMITED_MEM mode does when the memory limit is reached.
+void AggregateStreamingSinkOperator::_flush_cache_preagg_hash_table() {
+    COUNTER_UPDATE(_cache_preagg_flush_counter, 1);
+    _aggregator->set_streaming_all_states(true);
+}
+
 Status AggregateStreamingSinkOperator::_push_chunk_by_limited_memory(const ChunkPtr& chunk, const size_t chunk_size) {
     if (_limited_mem_state.has_limited(*_aggregator)) {
         RETURN_IF_ERROR(_push_chunk_by_force_streaming(chunk));
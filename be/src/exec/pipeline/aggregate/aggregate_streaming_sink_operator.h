@@ -49,6 +49,8 @@ public:
     bool releaseable() const override { return true; }
     void set_execute_mode(int performance_level) override;
 
+    AggrAutoState auto_state() const { return _auto_state; }
+
 private:
     // Invoked by push_chunk if current mode is TStreamingPreaggregationMode::FORCE_STREAMING
     Status _push_chunk_by_force_streaming(const ChunkPtr& chunk);
@@ -64,6 +66,11 @@ private:
     // Invoked by push_chunk  if current mode is TStreamingPreaggregationMode::LIMITED
     Status _push_chunk_by_limited_memory(const ChunkPtr& chunk, const size_t chunk_size);
 
+    // Invoked by _push_chunk_by_auto if the auto state is AggrAutoState::CACHE_PREAGG
+    Status _push_chunk_by_cache_preaggregation(const ChunkPtr& chunk, const size_t chunk_size,
+                                               const size_t allocated_bytes);
+    void _flush_cache_preagg_hash_table();
+
     // It is used to perform aggregation algorithms shared by
     // AggregateStreamingSourceOperator. It is
     // - prepared at SinkOperator::prepare(),
@@ -75,6 +82,10 @@ private:
     AggrAutoState _auto_state{};
     AggrAutoContext _auto_context;
     LimitedMemAggState _limited_mem_state;
+    // The max memory usage of the hash table in AggrAutoState::CACHE_PREAGG state.
+    size_t _cache_preagg_ht_size = 0;
+    RuntimeProfile::Counter* _cache_preagg_flush_counter = nullptr;
+    RuntimeProfile::Counter* _cache_preagg_hit_rows_counter = nullptr;
 };
 
 class AggregateStreamingSinkOperatorFactory final : public OperatorFactory {
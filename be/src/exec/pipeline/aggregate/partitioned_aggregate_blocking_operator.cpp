@@ -0,0 +1,216 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/aggregate/partitioned_aggregate_blocking_operator.h"
+
+#include "column/chunk.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::pipeline {
+
+Status PartitionedAggregateBlockingSinkOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(AggregateBlockingSinkOperator::prepare(state));
+    // The sink operator only produces the partial result of the keys, the limit can't be applied to it.
+    _agg_group_by_with_limit = false;
+    _partition_timer = ADD_TIMER(_unique_metrics, "PartitionTime");
+    return Status::OK();
+}
+
+Status PartitionedAggregateBlockingSinkOperator::set_finishing(RuntimeState* state) {
+    if (is_finished()) return Status::OK();
+    RETURN_IF_ERROR(AggregateBlockingSinkOperator::set_finishing(state));
+    if (state->is_cancelled()) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_partition_timer);
+    while (!_aggregator->is_ht_eos()) {
+        ChunkPtr chunk = std::make_shared<Chunk>();
+        RETURN_IF_ERROR(_aggregator->convert_hash_map_to_chunk(state->chunk_size(), &chunk, true));
+        if (!chunk->is_empty()) {
+            RETURN_IF_ERROR(_partition_chunk(state, chunk));
+        }
+    }
+    // All the states have been scattered into the partitions, release the hash map instead of keeping it
+    // alive together with the partition chunks until the operator is closed.
+    _hash_table_memory_usage = _aggregator->hash_map_memory_usage();
+    RETURN_IF_ERROR(_aggregator->reset_state(state, {}, nullptr, false));
+    _aggregator->set_ht_eos();
+    _context->finish_sinker();
+    return Status::OK();
+}
+
+void PartitionedAggregateBlockingSinkOperator::close(RuntimeState* state) {
+    AggregateBlockingSinkOperator::close(state);
+    // The hash map has been released in set_finishing(), report its size before the release.
+    auto* counter = ADD_COUNTER(_unique_metrics, "HashTableMemoryUsage", TUnit::BYTES);
+    counter->set(_hash_table_memory_usage);
+}
+
+// Scatter the intermediate chunk into the partitions by the hash of the group by columns, which are the first
+// columns of the chunk. The rows of a partition are appended to its last chunk until the chunk is full.
+Status PartitionedAggregateBlockingSinkOperator::_partition_chunk(RuntimeState* state, const ChunkPtr& chunk) {
+    const size_t num_rows = chunk->num_rows();
+    const size_t num_partitions = _context->num_partitions();
+    const size_t num_group_by_columns = _aggregator->group_by_expr_ctxs().size();
+
+    _hash_values.assign(num_rows, HashUtil::FNV_SEED);
+    for (size_t i = 0; i < num_group_by_columns; i++) {
+        chunk->get_column_by_index(i)->fnv_hash(_hash_values.data(), 0, num_rows);
+    }
+    for (size_t i = 0; i < num_rows; i++) {
+        _hash_values[i] = HashUtil::fmix32(_hash_values[i]) % num_partitions;
+    }
+
+    // Counting sort the rows by partition, rows of the i-th partition are in
+    // _selection[_partition_row_counts[i], _partition_row_counts[i + 1]).
+    _partition_row_counts.assign(num_partitions + 1, 0);
+    for (size_t i = 0; i < num_rows; i++) {
+        _partition_row_counts[_hash_values[i] + 1]++;
+    }
+    for (size_t i = 1; i <= num_partitions; i++) {
+        _partition_row_counts[i] += _partition_row_counts[i - 1];
+    }
+    _selection.resize(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        _selection[_partition_row_counts[_hash_values[i]]++] = i;
+    }
+    // After the above loop, _partition_row_counts[i] is the end of the i-th partition.
+    for (size_t i = num_partitions; i > 0; i--) {
+        _partition_row_counts[i] = _partition_row_counts[i - 1];
+    }
+    _partition_row_counts[0] = 0;
+
+    const size_t chunk_size = state->chunk_size();
+    for (size_t i = 0; i < num_partitions; i++) {
+        const uint32_t from = _partition_row_counts[i];
+        const uint32_t size = _partition_row_counts[i + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+        auto& partition_chunks = _context->partition_chunks(_driver_sequence, i);
+        if (partition_chunks.empty() || partition_chunks.back()->num_rows() + size > chunk_size) {
+            partition_chunks.emplace_back(chunk->clone_empty(chunk_size));
+        }
+        partition_chunks.back()->append_selective(*chunk, _selection.data(), from, size);
+    }
+    return Status::OK();
+}
+
+OperatorPtr PartitionedAggregateBlockingSinkOperatorFactory::create(int32_t degree_of_parallelism,
+                                                                    int32_t driver_sequence) {
+    DCHECK_LT(driver_sequence, _context->num_sinkers());
+    return std::make_shared<PartitionedAggregateBlockingSinkOperator>(
+            _aggregator_factory->get_or_create(driver_sequence), _context, this, _id, _plan_node_id, driver_sequence,
+            _aggregator_factory->get_shared_limit_countdown());
+}
+
+Status PartitionedAggregateBlockingSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(AggregateBlockingSourceOperator::prepare(state));
+    // There is no sink operator sharing the aggregator, so prepare it here.
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _unique_metrics.get()));
+    RETURN_IF_ERROR(_aggregator->open(state));
+    _merge_timer = ADD_TIMER(_unique_metrics, "MergeTime");
+    _merged_partitions = ADD_COUNTER(_unique_metrics, "MergedPartitions", TUnit::UNIT);
+    return Status::OK();
+}
+
+bool PartitionedAggregateBlockingSourceOperator::has_output() const {
+    if (!_context->is_sink_complete()) {
+        return false;
+    }
+    return !_aggregator->is_sink_complete() || !_aggregator->is_ht_eos();
+}
+
+bool PartitionedAggregateBlockingSourceOperator::is_finished() const {
+    return _aggregator->is_sink_complete() && _aggregator->is_ht_eos();
+}
+
+StatusOr<ChunkPtr> PartitionedAggregateBlockingSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_CANCELLED(state);
+    if (_partition < 0) {
+        _partition = _context->claim_partition();
+        if (_partition < 0) {
+            // All the partitions have been claimed, the operator is finished.
+            _aggregator->set_ht_eos();
+            _aggregator->sink_complete();
+            return nullptr;
+        }
+        COUNTER_UPDATE(_merged_partitions, 1);
+    }
+
+    if (!_aggregator->is_sink_complete()) {
+        // Merge the partition of one sink operator each time, to avoid occupying the driver thread too long.
+        ASSIGN_OR_RETURN(auto all_merged, _merge_next_sinker());
+        if (!all_merged) {
+            return nullptr;
+        }
+
+        COUNTER_UPDATE(_aggregator->input_row_count(), _aggregator->num_input_rows());
+        COUNTER_UPDATE(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        if (_aggregator->hash_map_variant().size() == 0) {
+            RETURN_IF_ERROR(_finish_partition(state));
+            return nullptr;
+        }
+        _aggregator->it_hash() = _aggregator->_state_allocator.begin();
+        _aggregator->sink_complete();
+        return nullptr;
+    }
+
+    ASSIGN_OR_RETURN(auto chunk, AggregateBlockingSourceOperator::pull_chunk(state));
+    if (_aggregator->is_ht_eos()) {
+        RETURN_IF_ERROR(_finish_partition(state));
+    }
+    return chunk;
+}
+
+StatusOr<bool> PartitionedAggregateBlockingSourceOperator::_merge_next_sinker() {
+    SCOPED_TIMER(_merge_timer);
+    if (_num_merged_sinkers < _context->num_sinkers()) {
+        auto& chunks = _context->partition_chunks(_num_merged_sinkers, _partition);
+        for (auto& chunk : chunks) {
+            RETURN_IF_ERROR(_aggregator->merge_intermediate_chunk(chunk.get()));
+            // Release the merged chunk as soon as possible.
+            chunk.reset();
+        }
+        chunks.clear();
+        _num_merged_sinkers++;
+    }
+    return _num_merged_sinkers == _context->num_sinkers();
+}
+
+Status PartitionedAggregateBlockingSourceOperator::_finish_partition(RuntimeState* state) {
+    // The limit applies to the rows of all the partitions output by this operator.
+    const int64_t num_rows_returned = _aggregator->num_rows_returned();
+    if (_aggregator->limit() != -1 && num_rows_returned >= _aggregator->limit()) {
+        _aggregator->set_ht_eos();
+        _aggregator->sink_complete();
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_aggregator->reset_state(state, {}, nullptr, true));
+    _aggregator->update_num_rows_returned(num_rows_returned);
+    _partition = -1;
+    _num_merged_sinkers = 0;
+    return Status::OK();
+}
+
+OperatorPtr PartitionedAggregateBlockingSourceOperatorFactory::create(int32_t degree_of_parallelism,
+                                                                      int32_t driver_sequence) {
+    DCHECK_LT(driver_sequence, _context->num_partitions());
+    return std::make_shared<PartitionedAggregateBlockingSourceOperator>(
+            _merge_aggregator_factory->get_or_create(driver_sequence), _context, this, _id, _plan_node_id,
+            driver_sequence);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,166 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "exec/aggregator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+
+namespace starrocks::pipeline {
+
+// Local partitioned aggregation replaces the local shuffle exchange in front of a finalize blocking aggregation.
+//
+// Each PartitionedAggregateBlockingSinkOperator aggregates its input into its own hash map first, then
+// scatters the intermediate states into num_partitions partitions by the hash of the group by keys and releases
+// its hash map. After all the sink operators finish, the PartitionedAggregateBlockingSourceOperators claim the
+// partitions one by one, each merges the claimed partition from all the sink operators, outputs the final result
+// and releases the merged states before claiming the next one. There are more partitions than source operators,
+// so only a part of the merged states is alive at the same time.
+//
+// Comparing with the local shuffle, only the pre-aggregated states instead of the input rows are shuffled.
+class PartitionedAggregateContext {
+public:
+    PartitionedAggregateContext(size_t num_sinkers, size_t num_partitions)
+            : _num_partitions(num_partitions), _partition_chunks(num_sinkers, std::vector<Chunks>(num_partitions)) {}
+
+    size_t num_partitions() const { return _num_partitions; }
+
+    // Only called by the sink operator of driver_sequence before finish_sinker().
+    Chunks& partition_chunks(int32_t sinker, int32_t partition) { return _partition_chunks[sinker][partition]; }
+    void finish_sinker() { _num_finished_sinkers.fetch_add(1, std::memory_order_release); }
+
+    bool is_sink_complete() const {
+        return _num_finished_sinkers.load(std::memory_order_acquire) == _partition_chunks.size();
+    }
+    size_t num_sinkers() const { return _partition_chunks.size(); }
+
+    // Return the next partition to be merged by a source operator, or -1 if all the partitions have been claimed.
+    int32_t claim_partition() {
+        const size_t partition = _next_partition.fetch_add(1, std::memory_order_relaxed);
+        return partition < _num_partitions ? static_cast<int32_t>(partition) : -1;
+    }
+
+private:
+    const size_t _num_partitions;
+    // _partition_chunks[sinker][partition].
+    std::vector<std::vector<Chunks>> _partition_chunks;
+    std::atomic<size_t> _num_finished_sinkers = 0;
+    std::atomic<size_t> _next_partition = 0;
+};
+using PartitionedAggregateContextPtr = std::shared_ptr<PartitionedAggregateContext>;
+
+class PartitionedAggregateBlockingSinkOperator final : public AggregateBlockingSinkOperator {
+public:
+    PartitionedAggregateBlockingSinkOperator(AggregatorPtr aggregator, PartitionedAggregateContextPtr context,
+                                             OperatorFactory* factory, int32_t id, int32_t plan_node_id,
+                                             int32_t driver_sequence, std::atomic<int64_t>& shared_limit_countdown)
+            : AggregateBlockingSinkOperator(std::move(aggregator), factory, id, plan_node_id, driver_sequence,
+                                            shared_limit_countdown, "partitioned_aggregate_blocking_sink"),
+              _context(std::move(context)) {}
+
+    ~PartitionedAggregateBlockingSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+    Status set_finishing(RuntimeState* state) override;
+    void close(RuntimeState* state) override;
+
+private:
+    Status _partition_chunk(RuntimeState* state, const ChunkPtr& chunk);
+
+    PartitionedAggregateContextPtr _context;
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _selection;
+    std::vector<uint32_t> _partition_row_counts;
+    int64_t _hash_table_memory_usage = 0;
+
+    RuntimeProfile::Counter* _partition_timer = nullptr;
+};
+
+class PartitionedAggregateBlockingSourceOperator final : public AggregateBlockingSourceOperator {
+public:
+    PartitionedAggregateBlockingSourceOperator(AggregatorPtr aggregator, PartitionedAggregateContextPtr context,
+                                               OperatorFactory* factory, int32_t id, int32_t plan_node_id,
+                                               int32_t driver_sequence)
+            : AggregateBlockingSourceOperator(std::move(aggregator), factory, id, plan_node_id, driver_sequence,
+                                              "partitioned_aggregate_blocking_source"),
+              _context(std::move(context)) {}
+
+    ~PartitionedAggregateBlockingSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    bool has_output() const override;
+    bool is_finished() const override;
+
+    StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    // Merge the chunks of _partition from one sink operator, return true if all the sink operators have been merged.
+    StatusOr<bool> _merge_next_sinker();
+    // Release the merged states of _partition after all its rows have been output.
+    Status _finish_partition(RuntimeState* state);
+
+    PartitionedAggregateContextPtr _context;
+    // The partition being merged or output, -1 if no partition has been claimed.
+    int32_t _partition = -1;
+    size_t _num_merged_sinkers = 0;
+
+    RuntimeProfile::Counter* _merge_timer = nullptr;
+    RuntimeProfile::Counter* _merged_partitions = nullptr;
+};
+
+class PartitionedAggregateBlockingSinkOperatorFactory final : public OperatorFactory {
+public:
+    PartitionedAggregateBlockingSinkOperatorFactory(int32_t id, int32_t plan_node_id,
+                                                    AggregatorFactoryPtr aggregator_factory,
+                                                    PartitionedAggregateContextPtr context)
+            : OperatorFactory(id, "partitioned_aggregate_blocking_sink", plan_node_id),
+              _aggregator_factory(std::move(aggregator_factory)),
+              _context(std::move(context)) {}
+
+    ~PartitionedAggregateBlockingSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override;
+
+private:
+    AggregatorFactoryPtr _aggregator_factory;
+    PartitionedAggregateContextPtr _context;
+};
+
+class PartitionedAggregateBlockingSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    // The merge_aggregator_factory creates the aggregators used by the source operators to merge the partitions,
+    // which are different from the ones of the sink operators.
+    PartitionedAggregateBlockingSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                                      AggregatorFactoryPtr merge_aggregator_factory,
+                                                      PartitionedAggregateContextPtr context)
+            : SourceOperatorFactory(id, "partitioned_aggregate_blocking_source", plan_node_id),
+              _merge_aggregator_factory(std::move(merge_aggregator_factory)),
+              _context(std::move(context)) {}
+
+    ~PartitionedAggregateBlockingSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override;
+
+private:
+    AggregatorFactoryPtr _merge_aggregator_factory;
+    PartitionedAggregateContextPtr _context;
+};
+
+} // namespace starrocks::pipeline
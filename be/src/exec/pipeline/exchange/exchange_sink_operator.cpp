@@ -663,6 +663,19 @@ void ExchangeSinkOperator::close(RuntimeState* state) {
     if (_driver_sequence == 0) {
         _buffer->update_profile(_unique_metrics.get());
     }
+    if (_encode_context != nullptr) {
+        // the bytes saved by encoding, compared with the bytes of the columns in memory
+        auto* saved_bytes_counter = ADD_COUNTER(_unique_metrics, "EncodeSavedBytes", TUnit::BYTES);
+        for (size_t i = 0; i < _encode_context->num_columns(); i++) {
+            const uint64_t raw_bytes = _encode_context->total_raw_bytes(i);
+            const uint64_t encoded_bytes = _encode_context->total_encoded_bytes(i);
+            const int64_t saved_bytes = raw_bytes > encoded_bytes ? raw_bytes - encoded_bytes : 0;
+            const std::string name = strings::Substitute("EncodeSavedBytesColumn$0", i);
+            auto* column_counter = ADD_CHILD_COUNTER(_unique_metrics, name, TUnit::BYTES, "EncodeSavedBytes");
+            COUNTER_UPDATE(column_counter, saved_bytes);
+            COUNTER_UPDATE(saved_bytes_counter, saved_bytes);
+        }
+    }
     Operator::close(state);
 }
 
@@ -138,6 +138,10 @@ public:
 
     void set_workgroup(workgroup::WorkGroupPtr wg) { _workgroup = std::move(wg); }
     const workgroup::WorkGroupPtr& workgroup() const { return _workgroup; }
+
+    // The preferred NUMA node of the drivers of this fragment instance, -1 means no preference.
+    void set_numa_node(int numa_node) { _numa_node = numa_node; }
+    int numa_node() const { return _numa_node; }
     bool enable_resource_group() const { return _workgroup != nullptr; }
 
     // STREAM MV
@@ -200,6 +204,7 @@ private:
 
     MorselQueueFactoryMap _morsel_queue_factories;
     workgroup::WorkGroupPtr _workgroup = nullptr;
+    int _numa_node = -1;
 
     std::atomic<Status*> _final_status = nullptr;
     Status _s_status;
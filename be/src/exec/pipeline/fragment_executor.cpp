@@ -43,6 +43,7 @@
 #include "runtime/data_stream_sender.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory/numa_arena_manager.h"
 #include "runtime/result_sink.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/transaction_mgr.h"
@@ -197,6 +198,7 @@ Status FragmentExecutor::_prepare_workgroup(const UnifiedExecPlanFragmentParams&
 
     _fragment_ctx->set_workgroup(wg);
     _wg = wg;
+    _fragment_ctx->set_numa_node(NumaArenaManager::instance()->next_numa_node());
 
     return Status::OK();
 }
@@ -20,6 +20,8 @@
 #include "exec/workgroup/work_group.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/memory/numa_arena_manager.h"
+#include "util/cpu_info.h"
 #include "util/debug/query_trace.h"
 #include "util/defer_op.h"
 #include "util/failpoint/fail_point.h"
@@ -28,11 +30,21 @@
 
 namespace starrocks::pipeline {
 
+static DriverQueuePtr create_driver_queue(bool enable_resource_group, size_t max_num_threads) {
+    DriverQueuePtr driver_queue = enable_resource_group ? DriverQueuePtr(std::make_unique<WorkGroupDriverQueue>())
+                                                        : std::make_unique<QuerySharedDriverQueue>();
+    if (config::pipeline_enable_work_stealing_driver_queue) {
+        driver_queue = std::make_unique<WorkStealingDriverQueue>(std::move(driver_queue), max_num_threads,
+                                                                 NumaArenaManager::instance()->num_numa_nodes());
+    }
+    return driver_queue;
+}
+
 GlobalDriverExecutor::GlobalDriverExecutor(const std::string& name, std::unique_ptr<ThreadPool> thread_pool,
                                            bool enable_resource_group, const CpuUtil::CpuIds& cpuids)
         : Base("pip_exec_" + name),
-          _driver_queue(enable_resource_group ? std::unique_ptr<DriverQueue>(std::make_unique<WorkGroupDriverQueue>())
-                                              : std::make_unique<QuerySharedDriverQueue>()),
+          _driver_queue(create_driver_queue(enable_resource_group,
+                                            std::max<size_t>(thread_pool->max_threads(), CpuInfo::num_cores()))),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(name, _driver_queue.get(), cpuids)),
           _exec_state_reporter(new ExecStateReporter(cpuids)),
@@ -79,6 +91,8 @@ void GlobalDriverExecutor::_worker_thread() {
     auto current_thread = Thread::current_thread();
     const int worker_id = _next_id++;
     std::queue<DriverRawPtr> local_driver_queue;
+    _driver_queue->register_worker();
+    DeferOp unregister_worker([this]() { _driver_queue->unregister_worker(); });
     while (true) {
         if (local_driver_queue.empty() && _num_threads_setter.should_shrink()) {
             break;
@@ -106,6 +120,7 @@ void GlobalDriverExecutor::_worker_thread() {
         }
         auto* query_ctx = driver->query_ctx();
         auto* fragment_ctx = driver->fragment_ctx();
+        NumaArenaManager::instance()->bind_current_thread(fragment_ctx->numa_node());
 
         driver->increment_schedule_times();
         _schedule_count++;
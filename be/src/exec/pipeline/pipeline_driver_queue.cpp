@@ -17,6 +17,8 @@
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group.h"
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
+#include "util/defer_op.h"
 
 namespace starrocks::pipeline {
 
@@ -406,4 +408,306 @@ int64_t WorkGroupDriverQueue::_ideal_runtime_ns(workgroup::WorkGroupDriverSchedE
     return SCHEDULE_PERIOD_PER_WG_NS * _wg_entities.size() * wg_entity->cpu_weight() / _sum_cpu_weight;
 }
 
+/// WorkStealingDriverQueue.
+namespace {
+// The deque owned by the current executor thread.
+struct WorkStealingWorkerContext {
+    const WorkStealingDriverQueue* queue = nullptr;
+    size_t worker_idx = 0;
+};
+thread_local WorkStealingWorkerContext tls_work_stealing_worker;
+} // namespace
+
+WorkStealingDriverQueue::WorkStealingDriverQueue(DriverQueuePtr shared_queue, size_t max_num_workers,
+                                                 int num_numa_nodes)
+        : _shared_queue(std::move(shared_queue)) {
+    _workers.reserve(max_num_workers);
+    for (size_t i = 0; i < max_num_workers; ++i) {
+        _workers.emplace_back(std::make_unique<Worker>(DEQUE_CAPACITY));
+    }
+    if (num_numa_nodes > 1) {
+        _numa_inboxes.reserve(num_numa_nodes);
+        for (int i = 0; i < num_numa_nodes; ++i) {
+            _numa_inboxes.emplace_back(std::make_unique<NumaNodeInbox>());
+        }
+    }
+}
+
+void WorkStealingDriverQueue::close() {
+    _is_closed.store(true, std::memory_order_release);
+    _shared_queue->close();
+}
+
+void WorkStealingDriverQueue::put_back(const DriverRawPtr driver) {
+    if (!_try_put_to_inbox(driver)) {
+        _shared_queue->put_back(driver);
+    }
+}
+
+void WorkStealingDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
+    if (_numa_inboxes.empty()) {
+        _shared_queue->put_back(drivers);
+        return;
+    }
+
+    std::vector<DriverRawPtr> shared_drivers;
+    for (auto* driver : drivers) {
+        if (!_try_put_to_inbox(driver)) {
+            shared_drivers.emplace_back(driver);
+        }
+    }
+    if (!shared_drivers.empty()) {
+        _shared_queue->put_back(shared_drivers);
+    }
+}
+
+void WorkStealingDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
+    Worker* worker = _current_worker();
+    // The driver prefers the other NUMA node.
+    if (const int numa_node = _numa_node_of(driver);
+        worker != nullptr && numa_node >= 0 && numa_node != worker->numa_node.load(std::memory_order_relaxed)) {
+        if (!_try_put_to_inbox(driver)) {
+            _shared_queue->put_back_from_executor(driver);
+        }
+        return;
+    }
+    // If some executor threads are idle, put the driver to the shared queue to wake up one of them.
+    if (worker == nullptr || _num_idle_workers.load() > 0 || driver->driver_state() == DriverState::CANCELED ||
+        _shared_queue->should_yield(driver, 0) || !worker->deque.push(driver)) {
+        _shared_queue->put_back_from_executor(driver);
+    }
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take(const bool block) {
+    if (_is_closed.load(std::memory_order_acquire)) {
+        return Status::Cancelled("Shutdown");
+    }
+
+    Worker* worker = _current_worker();
+    if (worker != nullptr) {
+        if (!_numa_inboxes.empty()) {
+            _update_numa_node(worker);
+        }
+        if (++worker->num_takes % LOCAL_TAKES_PER_SHARED_TAKE == 0) {
+            ASSIGN_OR_RETURN(auto* driver, _shared_queue->take(false));
+            if (driver != nullptr) {
+                return driver;
+            }
+        }
+        // The owner also takes from the top of its deque, to run the drivers in FIFO order like the shared queue.
+        if (auto driver = worker->deque.steal(); driver.has_value()) {
+            return driver.value();
+        }
+        if (!_numa_inboxes.empty()) {
+            if (auto* driver = _take_from_inbox(worker->numa_node.load(std::memory_order_relaxed)); driver != nullptr) {
+                return driver;
+            }
+        }
+        if (auto* driver = _steal(worker); driver != nullptr) {
+            return driver;
+        }
+    }
+
+    ASSIGN_OR_RETURN(auto* driver, _shared_queue->take(false));
+    if (driver != nullptr || !block) {
+        return driver;
+    }
+
+    ++_num_idle_workers;
+    DeferOp defer([this]() { --_num_idle_workers; });
+    // After this thread is marked idle, the other threads put the yielded drivers to the shared queue instead of
+    // their deques. Steal again to take the drivers pushed to the deques before that.
+    if (worker != nullptr) {
+        if (auto* stolen_driver = _steal(worker); stolen_driver != nullptr) {
+            return stolen_driver;
+        }
+    }
+    for (int numa_node = 0; numa_node < _numa_inboxes.size(); ++numa_node) {
+        if (auto* inbox_driver = _take_from_inbox(numa_node); inbox_driver != nullptr) {
+            return inbox_driver;
+        }
+    }
+    return _shared_queue->take(true);
+}
+
+void WorkStealingDriverQueue::cancel(DriverRawPtr driver) {
+    _shared_queue->cancel(driver);
+}
+
+void WorkStealingDriverQueue::update_statistics(const DriverRawPtr driver) {
+    _shared_queue->update_statistics(driver);
+}
+
+size_t WorkStealingDriverQueue::size() const {
+    size_t num_drivers = _shared_queue->size();
+    const size_t num_used_workers = _num_used_workers.load();
+    for (size_t i = 0; i < num_used_workers; ++i) {
+        num_drivers += _workers[i]->deque.size();
+    }
+    for (const auto& inbox : _numa_inboxes) {
+        num_drivers += inbox->num_drivers.load();
+    }
+    return num_drivers;
+}
+
+bool WorkStealingDriverQueue::should_yield(const DriverRawPtr driver, int64_t unaccounted_runtime_ns) const {
+    return _shared_queue->should_yield(driver, unaccounted_runtime_ns);
+}
+
+void WorkStealingDriverQueue::register_worker() {
+    DCHECK(tls_work_stealing_worker.queue == nullptr);
+    const int numa_node = _current_numa_node();
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        auto& worker = _workers[i];
+        bool expected = false;
+        if (!worker->in_use.load() && worker->in_use.compare_exchange_strong(expected, true)) {
+            worker->numa_node.store(numa_node, std::memory_order_relaxed);
+            if (!_numa_inboxes.empty()) {
+                _numa_inboxes[numa_node]->num_workers++;
+            }
+            worker->num_takes = 0;
+            tls_work_stealing_worker = {this, i};
+
+            size_t num_used_workers = _num_used_workers.load();
+            while (num_used_workers < i + 1 && !_num_used_workers.compare_exchange_weak(num_used_workers, i + 1)) {
+            }
+            return;
+        }
+    }
+    // All the deques are owned by other threads, this thread only uses the shared queue.
+}
+
+void WorkStealingDriverQueue::unregister_worker() {
+    Worker* worker = _current_worker();
+    if (worker == nullptr) {
+        return;
+    }
+    while (!worker->deque.empty()) {
+        if (auto driver = worker->deque.pop(); driver.has_value()) {
+            _shared_queue->put_back_from_executor(driver.value());
+        }
+    }
+    if (!_numa_inboxes.empty()) {
+        const int numa_node = worker->numa_node.load(std::memory_order_relaxed);
+        // Nobody will check the inbox of this node any more.
+        if (--_numa_inboxes[numa_node]->num_workers == 0) {
+            _drain_inbox(numa_node);
+        }
+    }
+    tls_work_stealing_worker = {};
+    worker->in_use.store(false);
+}
+
+WorkStealingDriverQueue::Worker* WorkStealingDriverQueue::_current_worker() const {
+    if (tls_work_stealing_worker.queue != this) {
+        return nullptr;
+    }
+    return _workers[tls_work_stealing_worker.worker_idx].get();
+}
+
+int WorkStealingDriverQueue::_current_numa_node() const {
+    if (_numa_inboxes.empty()) {
+        return 0;
+    }
+    const int numa_node = CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core());
+    return std::clamp<int>(numa_node, 0, _numa_inboxes.size() - 1);
+}
+
+void WorkStealingDriverQueue::_update_numa_node(Worker* worker) {
+    const int numa_node = _current_numa_node();
+    const int prev_numa_node = worker->numa_node.load(std::memory_order_relaxed);
+    if (numa_node == prev_numa_node) {
+        return;
+    }
+    _numa_inboxes[numa_node]->num_workers++;
+    worker->numa_node.store(numa_node, std::memory_order_relaxed);
+    // Nobody will check the inbox of the previous node any more.
+    if (--_numa_inboxes[prev_numa_node]->num_workers == 0) {
+        _drain_inbox(prev_numa_node);
+    }
+}
+
+DriverRawPtr WorkStealingDriverQueue::_steal(const Worker* thief) {
+    const size_t num_used_workers = _num_used_workers.load();
+    const size_t thief_idx = tls_work_stealing_worker.worker_idx;
+    const int numa_node = thief->numa_node.load(std::memory_order_relaxed);
+    // Steal from the threads on the same NUMA node first, and then the others.
+    for (const bool same_node : {true, false}) {
+        for (size_t i = 1; i < num_used_workers; ++i) {
+            auto& victim = _workers[(thief_idx + i) % num_used_workers];
+            if ((victim->numa_node.load(std::memory_order_relaxed) == numa_node) != same_node ||
+                victim->deque.empty()) {
+                continue;
+            }
+            if (auto driver = victim->deque.steal(); driver.has_value()) {
+                _num_steals.fetch_add(1, std::memory_order_relaxed);
+                return driver.value();
+            }
+        }
+    }
+    return nullptr;
+}
+
+int WorkStealingDriverQueue::_numa_node_of(const DriverRawPtr driver) const {
+    if (_numa_inboxes.empty() || driver->fragment_ctx() == nullptr) {
+        return -1;
+    }
+    const int numa_node = driver->fragment_ctx()->numa_node();
+    return numa_node < _numa_inboxes.size() ? numa_node : -1;
+}
+
+bool WorkStealingDriverQueue::_try_put_to_inbox(const DriverRawPtr driver) {
+    const int numa_node = _numa_node_of(driver);
+    if (numa_node < 0) {
+        return false;
+    }
+    auto& inbox = *_numa_inboxes[numa_node];
+    // If some executor threads are idle, put the driver to the shared queue to wake up one of them,
+    // since running it on the other node is better than waiting for the busy threads on this node.
+    if (inbox.num_workers.load() == 0 || _num_idle_workers.load() > 0 ||
+        driver->driver_state() == DriverState::CANCELED || _shared_queue->should_yield(driver, 0)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(inbox.mutex);
+        inbox.drivers.emplace_back(driver);
+        inbox.num_drivers++;
+    }
+    // The last executor thread on this node may exit concurrently.
+    if (inbox.num_workers.load() == 0) {
+        _drain_inbox(numa_node);
+    }
+    return true;
+}
+
+DriverRawPtr WorkStealingDriverQueue::_take_from_inbox(int numa_node) {
+    auto& inbox = *_numa_inboxes[numa_node];
+    if (inbox.num_drivers.load() == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    if (inbox.drivers.empty()) {
+        return nullptr;
+    }
+    auto* driver = inbox.drivers.front();
+    inbox.drivers.pop_front();
+    inbox.num_drivers--;
+    return driver;
+}
+
+void WorkStealingDriverQueue::_drain_inbox(int numa_node) {
+    auto& inbox = *_numa_inboxes[numa_node];
+    std::vector<DriverRawPtr> drivers;
+    {
+        std::lock_guard<std::mutex> lock(inbox.mutex);
+        drivers.assign(inbox.drivers.begin(), inbox.drivers.end());
+        inbox.drivers.clear();
+        inbox.num_drivers = 0;
+    }
+    if (!drivers.empty()) {
+        _shared_queue->put_back(drivers);
+    }
+}
+
 } // namespace starrocks::pipeline
@@ -19,6 +19,7 @@
 #include "exec/pipeline/pipeline_driver.h"
 #include "exec/workgroup/work_group_fwd.h"
 #include "util/factory_method.h"
+#include "util/work_stealing_deque.h"
 
 namespace starrocks::pipeline {
 
@@ -46,6 +47,11 @@ public:
     bool empty() const { return size() == 0; }
 
     virtual bool should_yield(const DriverRawPtr driver, int64_t unaccounted_runtime_ns) const = 0;
+
+    // Called by each executor thread before it starts to take drivers and before it exits.
+    // Only the queues keeping per-thread state need to override them.
+    virtual void register_worker() {}
+    virtual void unregister_worker() {}
 };
 
 // SubQuerySharedDriverQueue is used to store the driver waiting to be executed.
@@ -215,4 +221,112 @@ private:
     std::atomic<workgroup::WorkGroupDriverSchedEntity*> _min_wg_entity = nullptr;
 };
 
+// WorkStealingDriverQueue keeps the drivers yielded by an executor thread in the lock-free deque of this thread,
+// and the executor thread whose deque is empty steals drivers from the deques of the other threads, preferring
+// the threads on the same NUMA node. It avoids the global mutex of the shared queue in the common case that
+// a driver is yielded due to the time slice and is ready to run again.
+//
+// It wraps the shared queue (QuerySharedDriverQueue or WorkGroupDriverQueue), which still receives the new drivers
+// and the drivers wakened by the poller. A yielded driver is also put back to the shared queue in the following cases,
+// so that the priority and the workgroup weighting of the shared queue still take effect:
+// - its workgroup should yield according to the shared queue.
+// - some executor threads are blocked on the shared queue, which could run it right now.
+// - the deque of this thread is full.
+// Besides, the shared queue is checked once every LOCAL_TAKES_PER_SHARED_TAKE takes, to avoid starving
+// the drivers in it.
+//
+// With NUMA-aware placement, each NUMA node has an inbox for the drivers whose fragment instance prefers
+// this node (FragmentContext::numa_node). When all the executor threads are busy, the drivers running on
+// or wakened for the other nodes are sent to the inbox, which is checked by the threads on this node right after
+// their own deques. The idle threads still take drivers from all the inboxes, before blocking on the shared queue.
+// The executor threads aren't pinned to the CPUs, so the node of a thread is looked up again on each take.
+class WorkStealingDriverQueue final : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    // At most *max_num_workers* executor threads could own a deque,
+    // and the other executor threads only use the shared queue.
+    // NUMA-aware placement is enabled when *num_numa_nodes* is larger than 1.
+    WorkStealingDriverQueue(DriverQueuePtr shared_queue, size_t max_num_workers, int num_numa_nodes = 0);
+    ~WorkStealingDriverQueue() override = default;
+    void close() override;
+
+    void put_back(const DriverRawPtr driver) override;
+    void put_back(const std::vector<DriverRawPtr>& drivers) override;
+    // Push the driver to the deque of the current executor thread if possible, otherwise to the shared queue.
+    void put_back_from_executor(const DriverRawPtr driver) override;
+
+    // Return cancelled status, if the queue is closed.
+    // Take the driver from the deque of the current executor thread firstly, then steal from the other deques,
+    // and finally take from the shared queue.
+    StatusOr<DriverRawPtr> take(const bool block) override;
+
+    // The drivers in the deques are not in the ready queue, and the executor thread checks
+    // whether the fragment is cancelled after taking them, so only forward it to the shared queue.
+    void cancel(DriverRawPtr driver) override;
+
+    void update_statistics(const DriverRawPtr driver) override;
+
+    size_t size() const override;
+
+    bool should_yield(const DriverRawPtr driver, int64_t unaccounted_runtime_ns) const override;
+
+    void register_worker() override;
+    // Move the drivers remaining in the deque of the current executor thread to the shared queue.
+    void unregister_worker() override;
+
+    int64_t num_steals() const { return _num_steals.load(std::memory_order_relaxed); }
+
+    static constexpr size_t DEQUE_CAPACITY = 256;
+    static constexpr int64_t LOCAL_TAKES_PER_SHARED_TAKE = 16;
+
+private:
+    struct Worker {
+        explicit Worker(size_t deque_capacity) : deque(deque_capacity) {}
+
+        WorkStealingDeque<DriverRawPtr> deque;
+        std::atomic<bool> in_use = false;
+        std::atomic<int> numa_node = 0;
+        // Only accessed by the owner thread.
+        int64_t num_takes = 0;
+    };
+
+    struct NumaNodeInbox {
+        std::mutex mutex;
+        std::deque<DriverRawPtr> drivers;
+        std::atomic<size_t> num_drivers = 0;
+        // The number of the registered executor threads on this node.
+        std::atomic<int> num_workers = 0;
+    };
+
+    Worker* _current_worker() const;
+    // Return the NUMA node of the CPU running the current thread.
+    int _current_numa_node() const;
+    // Move the worker to the NUMA node of the current thread, if the thread has been migrated to the other node.
+    void _update_numa_node(Worker* worker);
+    DriverRawPtr _steal(const Worker* thief);
+
+    // Return the preferred NUMA node of the driver, or -1 if there is no preference.
+    int _numa_node_of(const DriverRawPtr driver) const;
+    // Send the driver to the inbox of its preferred NUMA node. Return false if it should go to the shared queue.
+    bool _try_put_to_inbox(const DriverRawPtr driver);
+    DriverRawPtr _take_from_inbox(int numa_node);
+    void _drain_inbox(int numa_node);
+
+private:
+    DriverQueuePtr _shared_queue;
+    // Empty when NUMA-aware placement is disabled.
+    std::vector<std::unique_ptr<NumaNodeInbox>> _numa_inboxes;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    // The workers in [0, _num_used_workers) have been registered at least once.
+    std::atomic<size_t> _num_used_workers = 0;
+
+    // The number of executor threads blocked on the shared queue.
+    std::atomic<size_t> _num_idle_workers = 0;
+    std::atomic<bool> _is_closed = false;
+
+    std::atomic<int64_t> _num_steals = 0;
+};
+
 } // namespace starrocks::pipeline
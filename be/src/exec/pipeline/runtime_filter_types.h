@@ -445,6 +445,9 @@ public:
                     break;
                 }
             }
+            if (desc->runtime_filter() != nullptr) {
+                desc->runtime_filter()->finish_build();
+            }
         }
         return Status::OK();
     }
@@ -520,6 +523,8 @@ public:
                 }
                 rf->concat(param.runtime_filter.get());
             }
+            // rf uses the bloom filter like before if no partial filter is concatenated into its bitset
+            rf->finish_build();
         }
         return Status::OK();
     }
@@ -162,6 +162,10 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _block_seek_counter = ADD_CHILD_COUNTER(_runtime_profile, "BlockSeekCount", TUnit::UNIT, segment_read_name);
     _pred_filter_timer = ADD_CHILD_TIMER(_runtime_profile, "PredFilter", segment_read_name);
     _pred_filter_counter = ADD_CHILD_COUNTER(_runtime_profile, "PredFilterRows", TUnit::UNIT, segment_read_name);
+    _encoded_pred_filter_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "EncodedPredFilterRows", TUnit::UNIT, segment_read_name);
+    _pred_reorder_counter = ADD_CHILD_COUNTER(_runtime_profile, "PredReorderCount", TUnit::UNIT, segment_read_name);
+    _rf_filter_counter = ADD_CHILD_COUNTER(_runtime_profile, "RuntimeFilterRows", TUnit::UNIT, segment_read_name);
     _del_vec_filter_counter = ADD_CHILD_COUNTER(_runtime_profile, "DelVecFilterRows", TUnit::UNIT, segment_read_name);
     _chunk_copy_timer = ADD_CHILD_TIMER(_runtime_profile, "ChunkCopy", segment_read_name);
     _decompress_timer = ADD_CHILD_TIMER(_runtime_profile, "DecompressT", segment_read_name);
@@ -169,6 +173,7 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _segments_read_count = ADD_CHILD_COUNTER(_runtime_profile, "SegmentsReadCount", TUnit::UNIT, segment_read_name);
     _total_columns_data_page_count =
             ADD_CHILD_COUNTER(_runtime_profile, "TotalColumnsDataPageCount", TUnit::UNIT, segment_read_name);
+    _page_prefetch_bytes = ADD_CHILD_COUNTER(_runtime_profile, "PagePrefetchBytes", TUnit::BYTES, segment_read_name);
 
     // IOTime
     _io_timer = ADD_CHILD_TIMER(_runtime_profile, "IOTime", IO_TASK_EXEC_TIMER_NAME);
@@ -601,10 +606,14 @@ void OlapChunkSource::_update_counter() {
     cond_evaluate_ns += _reader->stats().vec_cond_evaluate_ns;
     cond_evaluate_ns += _reader->stats().branchless_cond_evaluate_ns;
     cond_evaluate_ns += _reader->stats().expr_cond_evaluate_ns;
+    cond_evaluate_ns += _reader->stats().runtime_filter_evaluate_ns;
     // In order to avoid exposing too detailed metrics, we still record these infos on `_pred_filter_timer`
     // When we support metric classification, we can disassemble it again.
     COUNTER_UPDATE(_pred_filter_timer, cond_evaluate_ns);
     COUNTER_UPDATE(_pred_filter_counter, _reader->stats().rows_vec_cond_filtered);
+    COUNTER_UPDATE(_encoded_pred_filter_counter, _reader->stats().rows_encoded_cond_filtered);
+    COUNTER_UPDATE(_pred_reorder_counter, _reader->stats().expr_cond_reorder_count);
+    COUNTER_UPDATE(_rf_filter_counter, _reader->stats().rows_runtime_filter_filtered);
     COUNTER_UPDATE(_del_vec_filter_counter, _reader->stats().rows_del_vec_filtered);
 
     COUNTER_UPDATE(_seg_zm_filtered_counter, _reader->stats().segment_stats_filtered);
@@ -627,6 +636,7 @@ void OlapChunkSource::_update_counter() {
     COUNTER_UPDATE(_rowsets_read_count, _reader->stats().rowsets_read_count);
     COUNTER_UPDATE(_segments_read_count, _reader->stats().segments_read_count);
     COUNTER_UPDATE(_total_columns_data_page_count, _reader->stats().total_columns_data_page_count);
+    COUNTER_UPDATE(_page_prefetch_bytes, _reader->stats().page_prefetch_bytes);
 
     COUNTER_SET(_pushdown_predicates_counter, (int64_t)_params.pred_tree.size());
 
@@ -27,6 +27,7 @@
 #include "exec/workgroup/work_group.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory/numa_arena_manager.h"
 #include "util/debug/query_trace.h"
 #include "util/failpoint/fail_point.h"
 #include "util/runtime_profile.h"
@@ -409,6 +410,8 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
             SCOPED_SET_TRACE_INFO(driver_id, state->query_id(), state->fragment_instance_id());
             SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
             SCOPED_THREAD_LOCAL_OPERATOR_MEM_TRACKER_SETTER(this);
+            // The scan threads are shared by all the fragment instances, restore the binding when the task finishes.
+            ScopedNumaArenaBinding numa_arena_binding(state->fragment_ctx()->numa_node());
 
             auto& chunk_source = _chunk_sources[chunk_source_index];
             SCOPED_SET_CUSTOM_COREDUMP_MSG(chunk_source->get_custom_coredump_msg());
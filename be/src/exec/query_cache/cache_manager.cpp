@@ -14,28 +14,67 @@
 
 #include "exec/query_cache/cache_manager.h"
 
+#include "exec/query_cache/disk_cache.h"
 #include "util/defer_op.h"
 namespace starrocks::query_cache {
 
-CacheManager::CacheManager(size_t capacity) : _cache(capacity) {}
-static void delete_cache_entry(const CacheKey& key, void* value) {
-    auto* cache_value = (CacheValue*)value;
-    delete cache_value;
+// The value of the entries in ShardedLRUCache, the deleter needs the owner to persist the evicted ones.
+struct CacheEntry {
+    CacheManager* owner;
+    CacheValue value;
+};
+
+CacheManager::CacheManager(size_t capacity, CacheEvictPolicy evict_policy)
+        : _cache(capacity, ChargeMode::VALUESIZE, evict_policy) {}
+
+CacheManager::~CacheManager() {
+    // the pending loads insert the entries into _cache
+    if (_disk_cache != nullptr) {
+        _disk_cache->flush();
+    }
 }
 
-void CacheManager::populate(const std::string& key, const CacheValue& value) {
-    auto* cache_value = new CacheValue(value);
-    auto* handle = _cache.insert(key, cache_value, cache_value->size(), &delete_cache_entry, CachePriority::NORMAL);
+Status CacheManager::enable_disk_cache(const std::string& dir, size_t disk_capacity, size_t max_pending_bytes) {
+    auto disk_cache = std::make_unique<DiskCache>(dir, disk_capacity, max_pending_bytes);
+    RETURN_IF_ERROR(disk_cache->init());
+    _disk_cache = std::move(disk_cache);
+    return Status::OK();
+}
+
+void CacheManager::_delete_cache_entry(const CacheKey& key, void* value) {
+    std::unique_ptr<CacheEntry> entry(reinterpret_cast<CacheEntry*>(value));
+    CacheManager* owner = entry->owner;
+    if (owner->_disk_cache != nullptr && !owner->_invalidating.load(std::memory_order_relaxed)) {
+        owner->_disk_cache->put(key.to_string(), entry->value);
+    }
+}
+
+void CacheManager::_insert(const std::string& key, const CacheValue& value) {
+    auto* entry = new CacheEntry{this, value};
+    auto* handle = _cache.insert(key, entry, entry->value.size(), &_delete_cache_entry, CachePriority::NORMAL);
     _cache.release(handle);
 }
 
+void CacheManager::populate(const std::string& key, const CacheValue& value) {
+    _insert(key, value);
+}
+
 StatusOr<CacheValue> CacheManager::probe(const std::string& key) {
     auto* handle = _cache.lookup(key);
     if (handle == nullptr) {
+        if (_disk_cache == nullptr) {
+            return Status::NotFound("CacheMiss");
+        }
+        // probe is called by the pipeline driver, so the entry hit on the disk is not read here but promoted into
+        // the memory in the background, and used by the following queries.
+        _disk_cache->load(key, [this, key](CacheValue&& value) {
+            _disk_hit_count.fetch_add(1, std::memory_order_relaxed);
+            _insert(key, value);
+        });
         return Status::NotFound("CacheMiss");
     }
     DeferOp defer([this, handle]() { _cache.release(handle); });
-    CacheValue cache_value(*reinterpret_cast<CacheValue*>(_cache.value(handle)));
+    CacheValue cache_value(reinterpret_cast<CacheEntry*>(_cache.value(handle))->value);
     return cache_value;
 }
 
@@ -55,11 +94,20 @@ size_t CacheManager::hit_count() {
     return _cache.get_hit_count();
 }
 
+size_t CacheManager::admission_reject_count() {
+    return _cache.get_admission_reject_count();
+}
+
 void CacheManager::invalidate_all() {
     auto old_capacity = _cache.get_capacity();
+    _invalidating = true;
     // set capacity of cache to zero, the cache shall prune all cache entries.
     _cache.set_capacity(0);
     _cache.set_capacity(old_capacity);
+    _invalidating = false;
+    if (_disk_cache != nullptr) {
+        _disk_cache->invalidate_all();
+    }
 }
 
 } // namespace starrocks::query_cache
@@ -14,18 +14,22 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "column/chunk.h"
 #include "common/status.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/types.h"
 #include "util/lru_cache.h"
 #include "util/slice.h"
 
 namespace starrocks::query_cache {
 class CacheManager;
+class DiskCache;
 using CacheManagerRawPtr = CacheManager*;
 using CacheManagerPtr = std::shared_ptr<CacheManager>;
 
@@ -37,6 +41,8 @@ struct CacheValue {
     int64_t populate_time;
     int64_t version;
     CacheResult result;
+    // the types of the slots of the chunks in result, only required to persist the value in DiskCache.
+    std::unordered_map<SlotId, TypeDescriptor> slot_types;
 
     CacheValue(int64_t populate_time, int64_t cache_version, CacheResult&& cache_result)
             : populate_time(populate_time), version(cache_version), result(cache_result) {}
@@ -49,11 +55,11 @@ struct CacheValue {
 
     ~CacheValue() { result.clear(); }
 
-    size_t size() {
+    size_t size() const {
         // zero-charge cache entry can not be purged in LRU cache, so size of CacheValue must be at least
         // greater than zero, so add sizeof(CacheValue) to size.
         size_t value_size = sizeof(CacheValue);
-        for (auto& chk : result) {
+        for (const auto& chk : result) {
             value_size += chk->memory_usage();
         }
         return value_size;
@@ -62,18 +68,33 @@ struct CacheValue {
 
 class CacheManager {
 public:
-    explicit CacheManager(size_t capacity);
-    ~CacheManager() = default;
+    explicit CacheManager(size_t capacity, CacheEvictPolicy evict_policy = CacheEvictPolicy::LRU);
+    ~CacheManager();
+    // Persist the entries evicted from the memory into |dir|. The entries missed in the memory but found on the disk
+    // are promoted into the memory asynchronously, so probe() never waits for the disk.
+    Status enable_disk_cache(const std::string& dir, size_t disk_capacity, size_t max_pending_bytes);
+    bool disk_cache_enabled() const { return _disk_cache != nullptr; }
+    DiskCache* disk_cache() const { return _disk_cache.get(); }
     void populate(const std::string& key, const CacheValue& value);
     StatusOr<CacheValue> probe(const std::string& key);
     size_t memory_usage();
     size_t capacity();
     size_t lookup_count();
     size_t hit_count();
+    size_t admission_reject_count();
+    size_t disk_hit_count() const { return _disk_hit_count.load(std::memory_order_relaxed); }
     // vacuum cache by invalidate all cache entries
     void invalidate_all();
 
 private:
+    static void _delete_cache_entry(const CacheKey& key, void* value);
+    void _insert(const std::string& key, const CacheValue& value);
+
+    // _disk_cache must be destroyed after _cache, which persists its entries when it's destroyed.
+    std::unique_ptr<DiskCache> _disk_cache;
+    // the entries evicted by invalidate_all() are not persisted
+    std::atomic<bool> _invalidating{false};
+    std::atomic<size_t> _disk_hit_count{0};
     ShardedLRUCache _cache;
 };
 } // namespace starrocks::query_cache
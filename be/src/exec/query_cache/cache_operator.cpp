@@ -21,6 +21,7 @@
 #include "column/vectorized_fwd.h"
 #include "common/compiler_util.h"
 #include "exec/pipeline/pipeline_driver.h"
+#include "runtime/descriptors.h"
 #include "storage/rowset/rowset.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_manager.h"
@@ -183,6 +184,17 @@ Status CacheOperator::prepare(RuntimeState* state) {
     _cache_passthrough_rows_counter = ADD_COUNTER(_unique_metrics, "CachePassthroughRowNum", TUnit::UNIT);
     _cache_passthrough_bytes_counter = ADD_COUNTER(_unique_metrics, "CachePassthroughBytes", TUnit::BYTES);
 
+    if (_cache_mgr->disk_cache_enabled()) {
+        for (const auto& [slot_id, new_slot_id] : _cache_param.slot_remapping) {
+            auto* slot_desc = state->desc_tbl().get_slot_descriptor(slot_id);
+            if (slot_desc == nullptr) {
+                // the cache values without the types of all the slots are not persisted
+                _cache_slot_types.clear();
+                break;
+            }
+            _cache_slot_types[new_slot_id] = slot_desc->type();
+        }
+    }
     return Status::OK();
 }
 
@@ -409,6 +421,7 @@ void CacheOperator::populate_cache(int64_t tablet_id) {
     int64_t current = GetMonoTimeMicros();
     auto chunks = remap_chunks(buffer->chunks, _cache_param.slot_remapping);
     CacheValue cache_value(current, buffer->required_version, std::move(chunks));
+    cache_value.slot_types = _cache_slot_types;
     // If the cache implementation is global, populate method must be asynchronous and try its best to
     // update the cache.
     _cache_populate_bytes_counter->update(buffer->num_bytes);
@@ -89,6 +89,8 @@ private:
     std::unordered_set<int64_t> _populate_tablets;
     std::unordered_set<int64_t> _probe_tablets;
     std::unordered_set<int64_t> _all_tablets;
+    // the types of the remapped slots of the cached chunks, only used if the disk cache is enabled
+    std::unordered_map<SlotId, TypeDescriptor> _cache_slot_types;
 
     RuntimeProfile::Counter* _cache_probe_timer = nullptr;
     RuntimeProfile::Counter* _cache_probe_chunks_counter = nullptr;
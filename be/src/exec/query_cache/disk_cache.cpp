@@ -0,0 +1,415 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/query_cache/disk_cache.h"
+
+#include <fmt/format.h>
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "fs/fs.h"
+#include "fs/fs_util.h"
+#include "serde/protobuf_serde.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/defer_op.h"
+#include "util/hash_util.hpp"
+#include "util/threadpool.h"
+
+namespace starrocks::query_cache {
+
+// The layout of a file:
+//   magic: fixed32
+//   version, populate_time: varint64
+//   key: length prefixed
+//   number of slots: varint32, and for each slot:
+//     slot id: varint32, PTypeDesc: length prefixed
+//   number of chunks: varint32, and for each chunk:
+//     owner id: varint64, is last chunk: varint32, ChunkPB: length prefixed, empty if the chunk has no columns
+//   crc32c of all the above: fixed32
+static constexpr uint32_t kDiskCacheMagic = 0x43515253; // "SRQC"
+static constexpr const char* kDiskCacheFileSuffix = ".qc";
+static constexpr int kDiskCacheMaxPendingLoads = 1024;
+
+static uint64_t hash_key(const std::string& key) {
+    return HashUtil::xx_hash3_64(key.data(), static_cast<int32_t>(key.size()), 0);
+}
+
+DiskCache::DiskCache(std::string dir, size_t capacity, size_t max_pending_bytes)
+        : _dir(std::move(dir)), _capacity(capacity), _max_pending_bytes(max_pending_bytes) {}
+
+DiskCache::~DiskCache() {
+    if (_load_pool != nullptr) {
+        _load_pool->wait();
+        _load_pool->shutdown();
+    }
+    if (_write_pool != nullptr) {
+        _write_pool->wait();
+        _write_pool->shutdown();
+    }
+}
+
+std::string DiskCache::_file_path(uint64_t hash, int64_t version) const {
+    return fmt::format("{}/{:016x}_{}{}", _dir, hash, version, kDiskCacheFileSuffix);
+}
+
+Status DiskCache::init() {
+    RETURN_IF_ERROR(fs::create_directories(_dir));
+    RETURN_IF_ERROR(ThreadPoolBuilder("query_cache_disk")
+                            .set_min_threads(0)
+                            .set_max_threads(1)
+                            .set_max_queue_size(INT32_MAX)
+                            .build(&_write_pool));
+    RETURN_IF_ERROR(ThreadPoolBuilder("query_cache_load")
+                            .set_min_threads(0)
+                            .set_max_threads(1)
+                            .set_max_queue_size(kDiskCacheMaxPendingLoads)
+                            .build(&_load_pool));
+
+    std::vector<std::string> files;
+    RETURN_IF_ERROR(fs::get_children(_dir, &files));
+    std::vector<std::string> files_to_delete;
+    std::lock_guard<std::mutex> l(_mutex);
+    for (const auto& name : files) {
+        const std::string path = _dir + "/" + name;
+        uint64_t hash = 0;
+        int64_t version = 0;
+        char suffix[8] = {0};
+        // the temporary files of the interrupted writes are removed too
+        if (sscanf(name.c_str(), "%16" SCNx64 "_%" SCNd64 "%7s", &hash, &version, suffix) != 3 ||
+            kDiskCacheFileSuffix != std::string_view(suffix) || _entries.count(hash) > 0) {
+            files_to_delete.emplace_back(path);
+            continue;
+        }
+        auto size_or = FileSystem::Default()->get_file_size(path);
+        if (!size_or.ok()) {
+            files_to_delete.emplace_back(path);
+            continue;
+        }
+        _lru.push_front(hash);
+        _entries[hash] = Entry{version, size_or.value(), _lru.begin()};
+        _usage += size_or.value();
+    }
+    _evict_if_needed(&files_to_delete);
+    for (const auto& path : files_to_delete) {
+        WARN_IF_ERROR(fs::delete_file(path), "Fail to delete query cache file");
+    }
+    LOG(INFO) << "Load " << _entries.size() << " query cache entries from " << _dir << ", usage: " << _usage;
+    return Status::OK();
+}
+
+void DiskCache::put(const std::string& key, const CacheValue& value) {
+    if (value.slot_types.empty()) {
+        return;
+    }
+    const uint64_t hash = hash_key(key);
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto it = _entries.find(hash);
+        if (it != _entries.end() && it->second.version >= value.version) {
+            return;
+        }
+    }
+    // the serialized size is not known yet, the memory usage is a good estimation of the pending bytes
+    const size_t charge = value.size();
+    if (_pending_bytes.fetch_add(charge) + charge > _max_pending_bytes) {
+        _pending_bytes.fetch_sub(charge);
+        return;
+    }
+    const uint64_t epoch = _epoch.load();
+    auto st = _write_pool->submit_func(
+            [this, epoch, key, value, charge]() { _write(epoch, key, value, charge); });
+    if (!st.ok()) {
+        _pending_bytes.fetch_sub(charge);
+    }
+}
+
+void DiskCache::_write(uint64_t epoch, const std::string& key, const CacheValue& value, size_t charge) {
+    DeferOp defer([this, charge]() { _pending_bytes.fetch_sub(charge); });
+    if (epoch != _epoch.load()) {
+        return;
+    }
+    auto buffer_or = serialize(key, value);
+    if (!buffer_or.ok()) {
+        LOG(WARNING) << "Fail to serialize query cache entry: " << buffer_or.status();
+        return;
+    }
+    const std::string& buffer = buffer_or.value();
+    const uint64_t hash = hash_key(key);
+    const std::string path = _file_path(hash, value.version);
+    const std::string tmp_path = path + ".tmp";
+    auto st = [&]() -> Status {
+        ASSIGN_OR_RETURN(auto file, fs::new_writable_file(tmp_path));
+        RETURN_IF_ERROR(file->append(Slice(buffer)));
+        RETURN_IF_ERROR(file->close());
+        return FileSystem::Default()->rename_file(tmp_path, path);
+    }();
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to write query cache file " << path << ": " << st;
+        WARN_IF_ERROR(fs::delete_file(tmp_path), "Fail to delete query cache file");
+        return;
+    }
+
+    std::vector<std::string> files_to_delete;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (epoch != _epoch.load()) {
+            files_to_delete.emplace_back(path);
+        } else {
+            auto it = _entries.find(hash);
+            if (it != _entries.end() && it->second.version != value.version) {
+                _remove_entry(hash, &files_to_delete);
+            } else if (it != _entries.end()) {
+                // the same file is written again
+                _usage -= it->second.size;
+                _lru.erase(it->second.lru_iter);
+                _entries.erase(it);
+            }
+            _lru.push_front(hash);
+            _entries[hash] = Entry{value.version, buffer.size(), _lru.begin()};
+            _usage += buffer.size();
+            _evict_if_needed(&files_to_delete);
+        }
+    }
+    for (const auto& file : files_to_delete) {
+        WARN_IF_ERROR(fs::delete_file(file), "Fail to delete query cache file");
+    }
+}
+
+StatusOr<CacheValue> DiskCache::get(const std::string& key) {
+    const uint64_t hash = hash_key(key);
+    int64_t version;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto it = _entries.find(hash);
+        if (it == _entries.end()) {
+            return Status::NotFound("CacheMiss");
+        }
+        version = it->second.version;
+        _lru.splice(_lru.begin(), _lru, it->second.lru_iter);
+    }
+    const std::string path = _file_path(hash, version);
+    auto buffer_or = [&]() -> StatusOr<std::string> {
+        ASSIGN_OR_RETURN(auto file, fs::new_random_access_file(path));
+        return file->read_all();
+    }();
+    StatusOr<CacheValue> res = buffer_or.ok() ? deserialize(key, buffer_or.value()) : buffer_or.status();
+    if (!res.ok() && !res.status().is_not_found()) {
+        LOG(WARNING) << "Fail to read query cache file " << path << ": " << res.status();
+        std::vector<std::string> files_to_delete;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            auto it = _entries.find(hash);
+            if (it != _entries.end() && it->second.version == version) {
+                _remove_entry(hash, &files_to_delete);
+            }
+        }
+        for (const auto& file : files_to_delete) {
+            WARN_IF_ERROR(fs::delete_file(file), "Fail to delete query cache file");
+        }
+    }
+    return res;
+}
+
+void DiskCache::load(const std::string& key, std::function<void(CacheValue&&)> callback) {
+    const uint64_t hash = hash_key(key);
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_entries.count(hash) == 0 || !_loading.insert(hash).second) {
+            return;
+        }
+    }
+    const uint64_t epoch = _epoch.load();
+    auto st = _load_pool->submit_func([this, epoch, hash, key, callback = std::move(callback)]() {
+        auto res = get(key);
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _loading.erase(hash);
+        }
+        // the entries loaded before invalidate_all() are dropped
+        if (res.ok() && epoch == _epoch.load()) {
+            callback(std::move(res.value()));
+        }
+    });
+    if (!st.ok()) {
+        std::lock_guard<std::mutex> l(_mutex);
+        _loading.erase(hash);
+    }
+}
+
+void DiskCache::invalidate_all() {
+    std::vector<std::string> files_to_delete;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _epoch.fetch_add(1);
+        while (!_lru.empty()) {
+            _remove_entry(_lru.back(), &files_to_delete);
+        }
+    }
+    for (const auto& file : files_to_delete) {
+        WARN_IF_ERROR(fs::delete_file(file), "Fail to delete query cache file");
+    }
+}
+
+void DiskCache::flush() {
+    // the loaded entries could evict others from the memory, which are written then
+    _load_pool->wait();
+    _write_pool->wait();
+}
+
+size_t DiskCache::usage() {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _usage;
+}
+
+size_t DiskCache::num_entries() {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _entries.size();
+}
+
+void DiskCache::_evict_if_needed(std::vector<std::string>* files_to_delete) {
+    while (_usage > _capacity && !_lru.empty()) {
+        _remove_entry(_lru.back(), files_to_delete);
+    }
+}
+
+void DiskCache::_remove_entry(uint64_t hash, std::vector<std::string>* files_to_delete) {
+    auto it = _entries.find(hash);
+    DCHECK(it != _entries.end());
+    files_to_delete->emplace_back(_file_path(hash, it->second.version));
+    _usage -= it->second.size;
+    _lru.erase(it->second.lru_iter);
+    _entries.erase(it);
+}
+
+StatusOr<std::string> DiskCache::serialize(const std::string& key, const CacheValue& value) {
+    std::string buffer;
+    put_fixed32_le(&buffer, kDiskCacheMagic);
+    put_varint64(&buffer, value.version);
+    put_varint64(&buffer, value.populate_time);
+    put_length_prefixed_slice(&buffer, Slice(key));
+    put_varint32(&buffer, value.slot_types.size());
+    for (const auto& [slot_id, type] : value.slot_types) {
+        put_varint32(&buffer, slot_id);
+        put_length_prefixed_slice(&buffer, Slice(type.to_protobuf().SerializeAsString()));
+    }
+    put_varint32(&buffer, value.result.size());
+    for (const auto& chunk : value.result) {
+        put_varint64(&buffer, chunk->owner_info().owner_id());
+        put_varint32(&buffer, chunk->owner_info().is_last_chunk());
+        if (chunk->num_columns() == 0) {
+            put_length_prefixed_slice(&buffer, Slice());
+            continue;
+        }
+        ASSIGN_OR_RETURN(auto chunk_pb, serde::ProtobufChunkSerde::serialize(*chunk));
+        put_length_prefixed_slice(&buffer, Slice(chunk_pb.SerializeAsString()));
+    }
+    put_fixed32_le(&buffer, crc32c::Value(buffer.data(), buffer.size()));
+    return buffer;
+}
+
+StatusOr<CacheValue> DiskCache::deserialize(const std::string& key, const std::string& buffer) {
+    if (buffer.size() < 8) {
+        return Status::Corruption("query cache file is too small");
+    }
+    const uint32_t checksum = decode_fixed32_le(reinterpret_cast<const uint8_t*>(buffer.data() + buffer.size() - 4));
+    if (checksum != crc32c::Value(buffer.data(), buffer.size() - 4)) {
+        return Status::Corruption("query cache file checksum mismatch");
+    }
+    if (decode_fixed32_le(reinterpret_cast<const uint8_t*>(buffer.data())) != kDiskCacheMagic) {
+        return Status::Corruption("bad magic of query cache file");
+    }
+    Slice input(buffer.data() + 4, buffer.size() - 8);
+    uint64_t version = 0;
+    uint64_t populate_time = 0;
+    Slice stored_key;
+    if (!get_varint64(&input, &version) || !get_varint64(&input, &populate_time) ||
+        !get_length_prefixed_slice(&input, &stored_key)) {
+        return Status::Corruption("bad header of query cache file");
+    }
+    if (stored_key != Slice(key)) {
+        return Status::NotFound("CacheMiss");
+    }
+
+    uint32_t num_slots = 0;
+    if (!get_varint32(&input, &num_slots)) {
+        return Status::Corruption("bad slots of query cache file");
+    }
+    std::unordered_map<SlotId, TypeDescriptor> slot_types;
+    for (uint32_t i = 0; i < num_slots; ++i) {
+        uint32_t slot_id = 0;
+        Slice type_data;
+        PTypeDesc type_pb;
+        if (!get_varint32(&input, &slot_id) || !get_length_prefixed_slice(&input, &type_data) ||
+            !type_pb.ParseFromArray(type_data.data, type_data.size)) {
+            return Status::Corruption("bad slots of query cache file");
+        }
+        slot_types[slot_id] = TypeDescriptor::from_protobuf(type_pb);
+    }
+
+    uint32_t num_chunks = 0;
+    if (!get_varint32(&input, &num_chunks)) {
+        return Status::Corruption("bad chunks of query cache file");
+    }
+    CacheResult result;
+    result.reserve(num_chunks);
+    for (uint32_t i = 0; i < num_chunks; ++i) {
+        uint64_t owner_id = 0;
+        uint32_t is_last_chunk = 0;
+        Slice chunk_data;
+        if (!get_varint64(&input, &owner_id) || !get_varint32(&input, &is_last_chunk) ||
+            !get_length_prefixed_slice(&input, &chunk_data)) {
+            return Status::Corruption("bad chunks of query cache file");
+        }
+        ChunkPtr chunk;
+        if (chunk_data.size == 0) {
+            chunk = std::make_shared<Chunk>();
+        } else {
+            ChunkPB chunk_pb;
+            if (!chunk_pb.ParseFromArray(chunk_data.data, chunk_data.size)) {
+                return Status::Corruption("bad chunks of query cache file");
+            }
+            serde::ProtobufChunkMeta meta;
+            meta.types.resize(chunk_pb.is_nulls_size());
+            meta.is_nulls.resize(chunk_pb.is_nulls_size());
+            meta.is_consts.resize(chunk_pb.is_nulls_size(), false);
+            for (int j = 0; j < chunk_pb.is_nulls_size(); ++j) {
+                meta.is_nulls[j] = chunk_pb.is_nulls(j);
+                meta.is_consts[j] = j < chunk_pb.is_consts_size() && chunk_pb.is_consts(j);
+            }
+            for (int j = 0; j + 1 < chunk_pb.slot_id_map_size(); j += 2) {
+                const SlotId slot_id = chunk_pb.slot_id_map(j);
+                const int index = chunk_pb.slot_id_map(j + 1);
+                auto it = slot_types.find(slot_id);
+                if (it == slot_types.end() || index < 0 || index >= meta.types.size()) {
+                    return Status::Corruption("unknown slot in query cache file");
+                }
+                meta.slot_id_to_index[slot_id] = index;
+                meta.types[index] = it->second;
+            }
+            serde::ProtobufChunkDeserializer deserializer(meta);
+            ASSIGN_OR_RETURN(auto deserialized, deserializer.deserialize(chunk_pb.data()));
+            chunk = std::make_shared<Chunk>(std::move(deserialized));
+        }
+        chunk->owner_info().set_owner_id(owner_id, is_last_chunk != 0);
+        result.emplace_back(std::move(chunk));
+    }
+
+    CacheValue value(static_cast<int64_t>(populate_time), static_cast<int64_t>(version), std::move(result));
+    value.slot_types = std::move(slot_types);
+    return value;
+}
+
+} // namespace starrocks::query_cache
@@ -0,0 +1,109 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/status.h"
+#include "common/statusor.h"
+#include "exec/query_cache/cache_manager.h"
+
+namespace starrocks {
+class ThreadPool;
+}
+
+namespace starrocks::query_cache {
+
+// DiskCache is the second tier of the query cache, the entries evicted from the memory are written into the files of
+// a local directory, so that they survive the memory pressure and the restart of BE.
+//
+// Each entry is written into a file named by the hash of its key and its version, by a background thread. The chunks
+// are serialized by ProtobufChunkSerde, together with the types of their slots. The files are evicted in LRU order
+// when the total size exceeds the capacity, and the existing files are loaded when BE starts.
+//
+// The version of an entry is kept as is, CacheOperator decides whether it could be used for the required version of
+// the tablet, just like the entries in memory.
+class DiskCache {
+public:
+    DiskCache(std::string dir, size_t capacity, size_t max_pending_bytes);
+    ~DiskCache();
+
+    // Create the directory if not exists, and load the entries of the existing files.
+    Status init();
+
+    // Write the entry asynchronously. It's dropped if the value has no slot types, the pending entries exceed
+    // max_pending_bytes, or the same key of a version not less than value.version exists.
+    void put(const std::string& key, const CacheValue& value);
+
+    StatusOr<CacheValue> get(const std::string& key);
+
+    // Read the entry asynchronously and pass it to |callback| if it's found, so that the caller is not blocked by
+    // the disk IO. It's a no-op if the same key is being loaded, or there are too many pending loads.
+    void load(const std::string& key, std::function<void(CacheValue&&)> callback);
+
+    // Remove all the entries, including the pending ones.
+    void invalidate_all();
+
+    // Wait for the pending entries to be loaded and written.
+    void flush();
+
+    size_t usage();
+    size_t capacity() const { return _capacity; }
+    size_t num_entries();
+
+    static StatusOr<std::string> serialize(const std::string& key, const CacheValue& value);
+    // Return Corruption if the buffer is broken, or NotFound if it's the entry of another key with the same hash.
+    static StatusOr<CacheValue> deserialize(const std::string& key, const std::string& buffer);
+
+private:
+    struct Entry {
+        int64_t version;
+        size_t size;
+        std::list<uint64_t>::iterator lru_iter;
+    };
+
+    std::string _file_path(uint64_t hash, int64_t version) const;
+    void _write(uint64_t epoch, const std::string& key, const CacheValue& value, size_t charge);
+    // REQUIRE: _mutex is held
+    void _evict_if_needed(std::vector<std::string>* files_to_delete);
+    // REQUIRE: _mutex is held
+    void _remove_entry(uint64_t hash, std::vector<std::string>* files_to_delete);
+
+    const std::string _dir;
+    const size_t _capacity;
+    const size_t _max_pending_bytes;
+    std::unique_ptr<ThreadPool> _write_pool;
+    std::unique_ptr<ThreadPool> _load_pool;
+    std::atomic<size_t> _pending_bytes{0};
+    // bumped by invalidate_all(), the pending entries of the old epochs are not written
+    std::atomic<uint64_t> _epoch{0};
+
+    std::mutex _mutex;
+    size_t _usage = 0;
+    std::unordered_map<uint64_t, Entry> _entries;
+    // the hashes of the entries, the most recently used one is at the front
+    std::list<uint64_t> _lru;
+    // the hashes of the keys being loaded
+    std::unordered_set<uint64_t> _loading;
+};
+
+} // namespace starrocks::query_cache
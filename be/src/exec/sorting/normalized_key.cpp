@@ -0,0 +1,227 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/sorting/normalized_key.h"
+
+#include <algorithm>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/column_visitor_adapter.h"
+#include "column/nullable_column.h"
+#include "exec/sorting/radix_sort.h"
+#include "exec/sorting/sort_helper.h"
+#include "exec/sorting/sorting.h"
+#include "util/orlp/pdqsort.h"
+
+namespace starrocks {
+
+// Compute the width of the encoded data column, excluding the null byte.
+class NormalizedKeyWidthVisitor final : public ColumnVisitorAdapter<NormalizedKeyWidthVisitor> {
+public:
+    explicit NormalizedKeyWidthVisitor(size_t string_prefix_length)
+            : ColumnVisitorAdapter(this), _string_prefix_length(string_prefix_length) {}
+
+    template <RadixSortableColumn ColumnType>
+    Status do_visit(const ColumnType& column) {
+        width = sizeof(typename RadixKeyTraits<typename ColumnType::ValueType>::UKey);
+        return Status::OK();
+    }
+
+    template <typename T>
+    Status do_visit(const BinaryColumnBase<T>& column) {
+        width = _string_prefix_length;
+        is_string = true;
+        return Status::OK();
+    }
+
+    template <typename ColumnType>
+    Status do_visit(const ColumnType& column) {
+        return Status::NotSupported("normalized key is not supported for this column");
+    }
+
+    size_t width = 0;
+    bool is_string = false;
+
+private:
+    const size_t _string_prefix_length;
+};
+
+// Encode the data column into the keys at `offset` of each row, `width` is the encoded width of the data column.
+class NormalizedKeyEncoder final : public ColumnVisitorAdapter<NormalizedKeyEncoder> {
+public:
+    NormalizedKeyEncoder(bool is_asc, uint8_t* keys, size_t key_width, size_t offset, size_t width)
+            : ColumnVisitorAdapter(this),
+              _is_asc(is_asc),
+              _keys(keys),
+              _key_width(key_width),
+              _offset(offset),
+              _width(width) {}
+
+    template <RadixSortableColumn ColumnType>
+    Status do_visit(const ColumnType& column) {
+        using Traits = RadixKeyTraits<typename ColumnType::ValueType>;
+        using UKey = typename Traits::UKey;
+        DCHECK_EQ(sizeof(UKey), _width);
+
+        const auto& data = column.get_data();
+        uint8_t* key = _keys + _offset;
+        for (size_t i = 0; i < data.size(); i++, key += _key_width) {
+            UKey value = Traits::to_key(data[i]);
+            if (!_is_asc) {
+                value = ~value;
+            }
+            for (int b = sizeof(UKey) - 1; b >= 0; b--) {
+                key[sizeof(UKey) - 1 - b] = static_cast<uint8_t>(value >> (b * 8));
+            }
+        }
+        return Status::OK();
+    }
+
+    template <typename T>
+    Status do_visit(const BinaryColumnBase<T>& column) {
+        uint8_t* key = _keys + _offset;
+        for (size_t i = 0; i < column.size(); i++, key += _key_width) {
+            Slice value = column.get_slice(i);
+            size_t prefix_length = std::min(value.size, _width);
+            memcpy(key, value.data, prefix_length);
+            memset(key + prefix_length, 0, _width - prefix_length);
+            if (!_is_asc) {
+                for (size_t j = 0; j < _width; j++) {
+                    key[j] = ~key[j];
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+    template <typename ColumnType>
+    Status do_visit(const ColumnType& column) {
+        return Status::NotSupported("normalized key is not supported for this column");
+    }
+
+private:
+    const bool _is_asc;
+    uint8_t* _keys;
+    const size_t _key_width;
+    const size_t _offset;
+    const size_t _width;
+};
+
+// Return the width of the encoded column including the null byte, or zero if it can't be encoded.
+static size_t normalized_column_width(const Column* column, size_t string_prefix_length, bool* is_string) {
+    if (column->is_constant()) {
+        return 0;
+    }
+    NormalizedKeyWidthVisitor visitor(string_prefix_length);
+    if (!ColumnHelper::get_data_column(column)->accept(&visitor).ok()) {
+        return 0;
+    }
+    *is_string = visitor.is_string;
+    return visitor.width + (column->is_nullable() ? 1 : 0);
+}
+
+size_t NormalizedSortKeys::num_normalizable_columns(const Columns& columns, size_t string_prefix_length) {
+    size_t key_width = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+        bool is_string = false;
+        size_t width = normalized_column_width(columns[i].get(), string_prefix_length, &is_string);
+        if (width == 0 || key_width + width > kMaxKeyWidth) {
+            return i;
+        }
+        key_width += width;
+        if (is_string) {
+            return i + 1;
+        }
+    }
+    return columns.size();
+}
+
+Status NormalizedSortKeys::build(const Columns& columns, const SortDescs& sort_desc, size_t string_prefix_length) {
+    const size_t num_columns = num_normalizable_columns(columns, string_prefix_length);
+    DCHECK_GT(num_columns, 0);
+    _num_rows = columns[0]->size();
+    _is_exact = num_columns == columns.size();
+
+    std::vector<size_t> widths(num_columns);
+    _key_width = 0;
+    for (size_t i = 0; i < num_columns; i++) {
+        bool is_string = false;
+        widths[i] = normalized_column_width(columns[i].get(), string_prefix_length, &is_string);
+        _key_width += widths[i];
+        _is_exact &= !is_string;
+    }
+    _keys.resize(_num_rows * _key_width);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < num_columns; i++) {
+        const Column* column = columns[i].get();
+        const SortDesc& desc = sort_desc.descs[i];
+        size_t data_offset = offset;
+        if (column->is_nullable()) {
+            // The nulls are placed by the null byte, and their data bytes are set to zeros.
+            const uint8_t null_byte = desc.is_null_first() ? 0 : 1;
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            const auto& null_data = nullable_column->immutable_null_column_data();
+            uint8_t* key = _keys.data() + offset;
+            for (size_t row = 0; row < _num_rows; row++, key += _key_width) {
+                key[0] = null_data[row] ? null_byte : 1 - null_byte;
+            }
+            data_offset++;
+        }
+
+        NormalizedKeyEncoder encoder(desc.asc_order(), _keys.data(), _key_width, data_offset,
+                                     widths[i] - (data_offset - offset));
+        RETURN_IF_ERROR(ColumnHelper::get_data_column(column)->accept(&encoder));
+
+        if (column->is_nullable() && column->has_null()) {
+            const auto& null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data();
+            for (size_t row = 0; row < _num_rows; row++) {
+                if (null_data[row]) {
+                    memset(_keys.data() + row * _key_width + data_offset, 0, widths[i] - 1);
+                }
+            }
+        }
+        offset += widths[i];
+    }
+    DCHECK_EQ(offset, _key_width);
+    return Status::OK();
+}
+
+Status sort_by_normalized_keys(const std::atomic<bool>& cancel, const Columns& columns, const SortDescs& sort_desc,
+                               size_t string_prefix_length, SmallPermutation* permutation) {
+    NormalizedSortKeys keys;
+    RETURN_IF_ERROR(keys.build(columns, sort_desc, string_prefix_length));
+    if (UNLIKELY(cancel.load(std::memory_order_acquire))) {
+        return Status::Cancelled("Sort cancelled");
+    }
+
+    *permutation = create_small_permutation(keys.num_rows());
+    if (keys.is_exact()) {
+        ::pdqsort(permutation->begin(), permutation->end(), [&](SmallPermuteItem lhs, SmallPermuteItem rhs) {
+            return keys.compare(lhs.index_in_chunk, rhs.index_in_chunk) < 0;
+        });
+    } else {
+        ::pdqsort(permutation->begin(), permutation->end(), [&](SmallPermuteItem lhs, SmallPermuteItem rhs) {
+            int x = keys.compare(lhs.index_in_chunk, rhs.index_in_chunk);
+            if (x == 0) {
+                x = compare_chunk_row(sort_desc, columns, columns, lhs.index_in_chunk, rhs.index_in_chunk);
+            }
+            return x < 0;
+        });
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
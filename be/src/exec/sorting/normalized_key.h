@@ -0,0 +1,70 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "exec/sorting/sort_permute.h"
+
+namespace starrocks {
+
+struct SortDescs;
+
+// NormalizedSortKeys encodes the order-by columns of each row into a fixed-width binary key, so that the order
+// of two rows could be decided by a single memcmp of their keys instead of comparing the columns one by one.
+//
+// The key of a row is the concatenation of the encoded columns:
+// - A nullable column is prefixed with one byte, which puts the nulls first or last according to the SortDesc.
+// - A fixed-width integer-like column is encoded in big endian after being transformed into an unsigned integer
+//   with the same order, see RadixKeyTraits.
+// - A string column is encoded by its prefix of at most `string_prefix_length` bytes, padded with zeros.
+// - All the bytes of a column except the null byte are inverted for descending order.
+//
+// The columns after a string column are not encoded, since the truncated prefix can't decide the order of them.
+// The encoding also stops before the key exceeds kMaxKeyWidth. In these cases the key is not exact, which means
+// the rows with the same key are not necessarily equal and must be compared by the columns, but the different
+// keys still decide the order.
+class NormalizedSortKeys {
+public:
+    static constexpr size_t kMaxKeyWidth = 64;
+
+    // Return the number of leading columns could be encoded, zero means that the normalized key can't be used.
+    static size_t num_normalizable_columns(const Columns& columns, size_t string_prefix_length);
+
+    Status build(const Columns& columns, const SortDescs& sort_desc, size_t string_prefix_length);
+
+    size_t num_rows() const { return _num_rows; }
+    size_t key_width() const { return _key_width; }
+    bool is_exact() const { return _is_exact; }
+    const uint8_t* key(size_t row) const { return _keys.data() + row * _key_width; }
+
+    int compare(size_t lhs_row, size_t rhs_row) const { return memcmp(key(lhs_row), key(rhs_row), _key_width); }
+
+private:
+    size_t _num_rows = 0;
+    size_t _key_width = 0;
+    bool _is_exact = true;
+    std::vector<uint8_t> _keys;
+};
+
+// Sort the rows by the normalized keys of the order-by columns, the rows with the same inexact key are compared
+// by the columns. The columns must be normalizable, see NormalizedSortKeys::num_normalizable_columns.
+Status sort_by_normalized_keys(const std::atomic<bool>& cancel, const Columns& columns, const SortDescs& sort_desc,
+                               size_t string_prefix_length, SmallPermutation* permutation);
+
+} // namespace starrocks
@@ -0,0 +1,209 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/sorting/radix_sort.h"
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+#include "column/column_helper.h"
+#include "column/column_visitor_adapter.h"
+#include "column/fixed_length_column_base.h"
+#include "column/nullable_column.h"
+#include "exec/sorting/sorting.h"
+#include "util/orlp/pdqsort.h"
+
+namespace starrocks {
+
+template <typename UKey>
+struct RadixItem {
+    UKey key;
+    uint32_t index;
+};
+
+template <typename UKey>
+class MsdRadixSorter {
+public:
+    using Item = RadixItem<UKey>;
+
+    // The buckets not larger than it are sorted by pdqsort.
+    static constexpr size_t kFallbackRows = 64;
+
+    explicit MsdRadixSorter(const std::atomic<bool>& cancel) : _cancel(cancel) {}
+
+    Status sort(std::vector<Item>& items) {
+        _items = items.data();
+        _buffer.resize(items.size());
+        return _sort(0, items.size(), sizeof(UKey) - 1);
+    }
+
+private:
+    static uint8_t _digit(UKey key, int byte_index) { return static_cast<uint8_t>(key >> (byte_index * 8)); }
+
+    Status _sort(size_t from, size_t size, int byte_index) {
+        Item* items = _items + from;
+        if (size <= kFallbackRows) {
+            ::pdqsort(items, items + size, [](const Item& lhs, const Item& rhs) { return lhs.key < rhs.key; });
+            return Status::OK();
+        }
+
+        // Skip the bytes shared by all the keys.
+        std::array<size_t, 256> counts;
+        for (; byte_index >= 0; byte_index--) {
+            counts.fill(0);
+            for (size_t i = 0; i < size; i++) {
+                counts[_digit(items[i].key, byte_index)]++;
+            }
+            if (counts[_digit(items[0].key, byte_index)] != size) {
+                break;
+            }
+        }
+        if (byte_index < 0) {
+            // All the keys are equal.
+            return Status::OK();
+        }
+
+        std::array<size_t, 256> offsets;
+        offsets[0] = 0;
+        for (size_t i = 1; i < 256; i++) {
+            offsets[i] = offsets[i - 1] + counts[i - 1];
+        }
+        Item* buffer = _buffer.data() + from;
+        for (size_t i = 0; i < size; i++) {
+            buffer[offsets[_digit(items[i].key, byte_index)]++] = items[i];
+        }
+        memcpy(items, buffer, size * sizeof(Item));
+
+        if (UNLIKELY(_cancel.load(std::memory_order_acquire))) {
+            return Status::Cancelled("Sort cancelled");
+        }
+        if (byte_index == 0) {
+            return Status::OK();
+        }
+
+        size_t bucket_from = from;
+        for (size_t i = 0; i < 256; i++) {
+            if (counts[i] > 1) {
+                RETURN_IF_ERROR(_sort(bucket_from, counts[i], byte_index - 1));
+            }
+            bucket_from += counts[i];
+        }
+        return Status::OK();
+    }
+
+    const std::atomic<bool>& _cancel;
+    Item* _items = nullptr;
+    std::vector<Item> _buffer;
+};
+
+class RadixColumnSorter final : public ColumnVisitorAdapter<RadixColumnSorter> {
+public:
+    RadixColumnSorter(const std::atomic<bool>& cancel, const SortDesc& sort_desc, const NullData* null_data,
+                      SmallPermutation* permutation)
+            : ColumnVisitorAdapter(this),
+              _cancel(cancel),
+              _sort_desc(sort_desc),
+              _null_data(null_data),
+              _permutation(permutation) {}
+
+    template <RadixSortableColumn ColumnType>
+    Status do_visit(const ColumnType& column) {
+        using Traits = RadixKeyTraits<typename ColumnType::ValueType>;
+        using UKey = typename Traits::UKey;
+
+        const auto& data = column.get_data();
+        const size_t num_rows = data.size();
+        const bool is_asc = _sort_desc.asc_order();
+        std::vector<RadixItem<UKey>> items;
+        std::vector<uint32_t> null_indexes;
+        items.reserve(num_rows);
+        for (uint32_t i = 0; i < num_rows; i++) {
+            if (_null_data != nullptr && (*_null_data)[i]) {
+                null_indexes.emplace_back(i);
+                continue;
+            }
+            UKey key = Traits::to_key(data[i]);
+            items.push_back({is_asc ? key : static_cast<UKey>(~key), i});
+        }
+
+        MsdRadixSorter<UKey> sorter(_cancel);
+        RETURN_IF_ERROR(sorter.sort(items));
+
+        _permutation->resize(num_rows);
+        size_t pos = 0;
+        if (_sort_desc.is_null_first()) {
+            for (uint32_t index : null_indexes) {
+                (*_permutation)[pos++].index_in_chunk = index;
+            }
+        }
+        for (const auto& item : items) {
+            (*_permutation)[pos++].index_in_chunk = item.index;
+        }
+        if (!_sort_desc.is_null_first()) {
+            for (uint32_t index : null_indexes) {
+                (*_permutation)[pos++].index_in_chunk = index;
+            }
+        }
+        DCHECK_EQ(pos, num_rows);
+        return Status::OK();
+    }
+
+    template <typename ColumnType>
+    Status do_visit(const ColumnType& column) {
+        return Status::NotSupported("radix sort is not supported for this column");
+    }
+
+private:
+    const std::atomic<bool>& _cancel;
+    const SortDesc& _sort_desc;
+    const NullData* _null_data;
+    SmallPermutation* _permutation;
+};
+
+class RadixSortableChecker final : public ColumnVisitorAdapter<RadixSortableChecker> {
+public:
+    RadixSortableChecker() : ColumnVisitorAdapter(this) {}
+
+    template <RadixSortableColumn ColumnType>
+    Status do_visit(const ColumnType& column) {
+        return Status::OK();
+    }
+
+    template <typename ColumnType>
+    Status do_visit(const ColumnType& column) {
+        return Status::NotSupported("radix sort is not supported for this column");
+    }
+};
+
+bool is_radix_sortable_column(const Column* column) {
+    if (column->is_constant()) {
+        return false;
+    }
+    RadixSortableChecker checker;
+    return ColumnHelper::get_data_column(column)->accept(&checker).ok();
+}
+
+Status radix_sort_column(const std::atomic<bool>& cancel, const Column* column, const SortDesc& sort_desc,
+                         SmallPermutation* permutation) {
+    DCHECK(is_radix_sortable_column(column));
+    const NullData* null_data = nullptr;
+    if (column->is_nullable() && column->has_null()) {
+        null_data = &down_cast<const NullableColumn*>(column)->immutable_null_column_data();
+    }
+    RadixColumnSorter sorter(cancel, sort_desc, null_data, permutation);
+    return ColumnHelper::get_data_column(column)->accept(&sorter);
+}
+
+} // namespace starrocks
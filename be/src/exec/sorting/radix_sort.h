@@ -0,0 +1,85 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "column/column.h"
+#include "column/fixed_length_column_base.h"
+#include "common/statusor.h"
+#include "exec/sorting/sort_permute.h"
+
+namespace starrocks {
+
+struct SortDesc;
+
+// Transform the value into an unsigned integer with the same order.
+template <typename T>
+struct RadixKeyTraits {
+    static constexpr bool supported = false;
+};
+
+template <typename T>
+requires std::is_integral_v<T> struct RadixKeyTraits<T> {
+    static constexpr bool supported = true;
+    using UKey = std::make_unsigned_t<T>;
+    static UKey to_key(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            return static_cast<UKey>(value) ^ (UKey(1) << (sizeof(UKey) * 8 - 1));
+        } else {
+            return value;
+        }
+    }
+};
+
+template <>
+struct RadixKeyTraits<DateValue> {
+    static constexpr bool supported = true;
+    using UKey = uint32_t;
+    static UKey to_key(const DateValue& value) { return RadixKeyTraits<int32_t>::to_key(value.julian()); }
+};
+
+template <>
+struct RadixKeyTraits<TimestampValue> {
+    static constexpr bool supported = true;
+    using UKey = uint64_t;
+    static UKey to_key(const TimestampValue& value) { return RadixKeyTraits<int64_t>::to_key(value.timestamp()); }
+};
+
+template <typename ColumnType>
+concept RadixSortableColumn = requires {
+    typename ColumnType::ValueType;
+} && std::is_base_of_v<FixedLengthColumnBase<typename ColumnType::ValueType>, ColumnType> &&
+        RadixKeyTraits<typename ColumnType::ValueType>::supported;
+
+// The comparison-based sort is not worth to be replaced by radix sort for small inputs, since the radix sort
+// has to scan the whole input at least once for each byte of the key.
+static constexpr size_t kRadixSortMinRows = 65536;
+
+// Whether the column could be sorted by radix sort, that is, the data column is a fixed-width integer-like column,
+// including the integers, dates, datetimes, decimal32/64 and the dict codes of low-cardinality strings.
+bool is_radix_sortable_column(const Column* column);
+
+// Sort a single fixed-width key column by MSD radix sort, and output the order in permutation.
+// The keys are transformed into unsigned integers with the same order (flip the sign bit, and invert all the bits
+// for descending order), then distributed byte by byte from the most significant one. A byte is skipped when all the
+// keys of the bucket share it, which is the common case for dates and small integers, and a bucket falls back to
+// pdqsort when it is small enough.
+// The column must be radix sortable, see is_radix_sortable_column.
+Status radix_sort_column(const std::atomic<bool>& cancel, const Column* column, const SortDesc& sort_desc,
+                         SmallPermutation* permutation);
+
+} // namespace starrocks
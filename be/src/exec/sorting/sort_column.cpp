@@ -27,6 +27,9 @@
 #include "column/map_column.h"
 #include "column/nullable_column.h"
 #include "column/struct_column.h"
+#include "common/config.h"
+#include "exec/sorting/normalized_key.h"
+#include "exec/sorting/radix_sort.h"
 #include "exec/sorting/sort_helper.h"
 #include "exec/sorting/sort_permute.h"
 #include "exec/sorting/sorting.h"
@@ -502,6 +505,22 @@ Status sort_and_tie_columns(const std::atomic<bool>& cancel, const Columns& colu
         return Status::OK();
     }
     size_t num_rows = columns[0]->size();
+    if (columns.size() == 1 && num_rows >= kRadixSortMinRows && config::enable_radix_sort &&
+        is_radix_sortable_column(columns[0].get())) {
+        SmallPermutation small_perm;
+        RETURN_IF_ERROR(radix_sort_column(cancel, columns[0].get(), sort_desc.get_column_desc(0), &small_perm));
+        restore_small_permutation(small_perm, *permutation);
+        return Status::OK();
+    }
+    const size_t string_prefix_length = config::sort_normalized_key_string_prefix_length;
+    if (columns.size() > 1 && config::enable_sort_normalized_key &&
+        NormalizedSortKeys::num_normalizable_columns(columns, string_prefix_length) > 0) {
+        SmallPermutation small_perm;
+        RETURN_IF_ERROR(sort_by_normalized_keys(cancel, columns, sort_desc, string_prefix_length, &small_perm));
+        restore_small_permutation(small_perm, *permutation);
+        return Status::OK();
+    }
+
     Tie tie(num_rows, 1);
     std::pair<int, int> range{0, num_rows};
     SmallPermutation small_perm = create_small_permutation(num_rows);
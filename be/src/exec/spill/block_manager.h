@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "common/status.h"
@@ -43,6 +44,10 @@ public:
 
     virtual std::shared_ptr<BlockReader> get_reader(const BlockReaderOptions& options) = 0;
 
+    // Hint that the block is going to be read soon, so that its data could be loaded in the background,
+    // e.g. into the page cache of the OS. It does nothing by default.
+    virtual Status prefetch() { return Status::OK(); }
+
     virtual std::string debug_string() const = 0;
 
     size_t size() const { return _size; }
@@ -60,7 +65,8 @@ public:
 protected:
     size_t _num_rows{};
     size_t _size{};
-    bool _is_remote = false;
+    // a local block may be offloaded to the remote storage in the background, see HyBirdBlockManager
+    std::atomic_bool _is_remote = false;
     bool _exclusive{};
 };
 
@@ -14,6 +14,7 @@
 
 #include "exec/spill/data_stream.h"
 
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/spill/block_manager.h"
 #include "exec/spill/executor.h"
@@ -44,7 +45,18 @@ public:
 private:
     // acquire block from block manager
     Status _prepare_block(RuntimeState* state, size_t write_size);
+    // write the data in |_write_buffer| to the current block
+    Status _write_buffered_data();
+
     BlockPtr _cur_block;
+    bool _direct_io = false;
+
+    // The serialized chunks are buffered and written to the current block in batches of
+    // config::spill_write_batch_bytes. With direct io, all data is written through the buffer, because
+    // direct io requires the address of the data to be aligned.
+    AlignedBuffer _write_buffer;
+    size_t _buffered_bytes = 0;
+    size_t _buffered_rows = 0;
 
     Spiller* _spiller{};
 
@@ -63,6 +75,7 @@ Status BlockSpillOutputDataStream::_prepare_block(RuntimeState* state, size_t wr
         opts.plan_node_id = _spiller->options().plan_node_id;
         opts.name = _spiller->options().name;
         opts.block_size = write_size;
+        opts.direct_io = _direct_io;
         opts.exclusive = _spiller->options().init_partition_nums > 0 || !_spiller->options().is_unordered;
         ASSIGN_OR_RETURN(auto block, _block_manager->acquire_block(opts));
         // update metrics
@@ -78,19 +91,49 @@ Status BlockSpillOutputDataStream::_prepare_block(RuntimeState* state, size_t wr
 
 Status BlockSpillOutputDataStream::append(RuntimeState* state, const std::vector<Slice>& data, size_t total_write_size,
                                           size_t write_num_rows) {
+    _direct_io = state->spill_enable_direct_io();
     // acquire block if current block is nullptr or full
     RETURN_IF_ERROR(_prepare_block(state, total_write_size));
     _append_rows += write_num_rows;
-    {
-        auto write_io_timer = GET_METRICS(_cur_block->is_remote(), _spiller->metrics(), write_io_timer);
-        SCOPED_TIMER(write_io_timer);
+    auto write_io_timer = GET_METRICS(_cur_block->is_remote(), _spiller->metrics(), write_io_timer);
+    SCOPED_TIMER(write_io_timer);
+    const auto batch_bytes = static_cast<size_t>(std::max<int64_t>(config::spill_write_batch_bytes, 0));
+    if (batch_bytes == 0 && !_direct_io) {
         TRACE_SPILL_LOG << fmt::format("append block[{}], size[{}]", _cur_block->debug_string(), total_write_size);
         RETURN_IF_ERROR(_cur_block->append(data));
         _cur_block->inc_num_rows(write_num_rows);
-        auto flush_bytes = GET_METRICS(_cur_block->is_remote(), _spiller->metrics(), flush_bytes);
-        COUNTER_UPDATE(flush_bytes, total_write_size);
-        (*_spiller->metrics().total_spill_bytes) += total_write_size;
+    } else {
+        if (_buffered_bytes > 0 && _buffered_bytes + total_write_size > batch_bytes) {
+            RETURN_IF_ERROR(_write_buffered_data());
+        }
+        const size_t buffer_size = std::max(batch_bytes, _buffered_bytes + total_write_size);
+        if (_write_buffer.size() < buffer_size) {
+            _write_buffer.resize(buffer_size);
+        }
+        for (const auto& slice : data) {
+            memcpy(_write_buffer.data() + _buffered_bytes, slice.data, slice.size);
+            _buffered_bytes += slice.size;
+        }
+        _buffered_rows += write_num_rows;
+        if (_buffered_bytes >= batch_bytes) {
+            RETURN_IF_ERROR(_write_buffered_data());
+        }
+    }
+    auto flush_bytes = GET_METRICS(_cur_block->is_remote(), _spiller->metrics(), flush_bytes);
+    COUNTER_UPDATE(flush_bytes, total_write_size);
+    (*_spiller->metrics().total_spill_bytes) += total_write_size;
+    return Status::OK();
+}
+
+Status BlockSpillOutputDataStream::_write_buffered_data() {
+    if (_buffered_bytes == 0) {
+        return Status::OK();
     }
+    TRACE_SPILL_LOG << fmt::format("append block[{}], size[{}]", _cur_block->debug_string(), _buffered_bytes);
+    RETURN_IF_ERROR(_cur_block->append({Slice(_write_buffer.data(), _buffered_bytes)}));
+    _cur_block->inc_num_rows(_buffered_rows);
+    _buffered_bytes = 0;
+    _buffered_rows = 0;
     return Status::OK();
 }
 
@@ -101,6 +144,7 @@ Status BlockSpillOutputDataStream::flush() {
     {
         auto write_io_timer = GET_METRICS(_cur_block->is_remote(), _spiller->metrics(), write_io_timer);
         SCOPED_TIMER(write_io_timer);
+        RETURN_IF_ERROR(_write_buffered_data());
         RETURN_IF_ERROR(_cur_block->flush());
         TRACE_SPILL_LOG << fmt::format("flush block[{}]", _cur_block->debug_string());
     }
@@ -108,6 +152,8 @@ Status BlockSpillOutputDataStream::flush() {
     // release block if not exclusive
     RETURN_IF_ERROR(_block_manager->release_block(std::move(_cur_block)));
     DCHECK(_cur_block == nullptr);
+    // the stream may be idle for a long time until the next flush, e.g. a partition of the spilled join
+    _write_buffer = AlignedBuffer();
 
     return Status::OK();
 }
@@ -118,4 +118,20 @@ StatusOr<DirPtr> DirManager::acquire_writable_dir(const AcquireDirOptions& opts)
     return Status::CapacityLimitExceed("no writable spill storage directories");
 }
 
-} // namespace starrocks::spill
\ No newline at end of file
+int64_t DirManager::current_size() const {
+    int64_t size = 0;
+    for (const auto& dir : _dirs) {
+        size += dir->get_current_size();
+    }
+    return size;
+}
+
+int64_t DirManager::max_size() const {
+    int64_t size = 0;
+    for (const auto& dir : _dirs) {
+        size += dir->get_max_size();
+    }
+    return size;
+}
+
+} // namespace starrocks::spill
@@ -96,6 +96,10 @@ public:
 
     StatusOr<DirPtr> acquire_writable_dir(const AcquireDirOptions& opts);
 
+    // the used size and the capacity of all the dirs
+    int64_t current_size() const;
+    int64_t max_size() const;
+
 private:
     bool is_same_disk(const std::string& path1, const std::string& path2) {
         struct statfs stat1, stat2;
@@ -14,8 +14,12 @@
 
 #include "exec/spill/file_block_manager.h"
 
+#include <cstring>
+#include <deque>
+#include <future>
 #include <utility>
 
+#include "common/config.h"
 #include "exec/spill/block_manager.h"
 #include "exec/spill/common.h"
 #include "fmt/format.h"
@@ -77,7 +81,11 @@ public:
         }
     }
 
-    StatusOr<std::unique_ptr<io::InputStreamWrapper>> get_readable();
+    // the size acquired from Dir when a block is acquired from the container, it's released with the container
+    void add_acquired_size(size_t acquired_size) { _acquired_data_size += acquired_size; }
+
+    StatusOr<std::unique_ptr<io::InputStreamWrapper>> get_readable(size_t offset, size_t length,
+                                                                    ThreadPool* read_pool);
 
     static StatusOr<FileBlockContainerPtr> create(const DirPtr& dir, const TUniqueId& query_id,
                                                   const TUniqueId& fragment_instance_id, int32_t plan_node_id,
@@ -126,10 +134,132 @@ Status FileBlockContainer::flush() {
     return _writable_file->flush(WritableFile::FLUSH_ASYNC);
 }
 
-StatusOr<std::unique_ptr<io::InputStreamWrapper>> FileBlockContainer::get_readable() {
+// ParallelRangeInputStream reads [offset, offset + length) of a file in ranges of |range_bytes|. While a range is
+// consumed, up to |parallelism| next ranges are read by |pool| in parallel, each of which uses its own file, because
+// a file of the remote storage can't be read concurrently.
+class ParallelRangeInputStream final : public io::InputStream {
+public:
+    ParallelRangeInputStream(FileSystem* fs, std::string path, size_t offset, size_t length, size_t range_bytes,
+                             size_t parallelism, ThreadPool* pool)
+            : _fs(fs),
+              _path(std::move(path)),
+              _offset(offset),
+              _length(length),
+              _range_bytes(range_bytes),
+              _files(parallelism),
+              _pool(pool) {}
+
+    ~ParallelRangeInputStream() override {
+        // the ranges being read refer to this stream
+        for (auto& range : _ranges) {
+            range->future.wait();
+        }
+    }
+
+    StatusOr<int64_t> read(void* data, int64_t count) override { return _read(static_cast<uint8_t*>(data), count); }
+
+    Status skip(int64_t count) override { return _read(nullptr, count).status(); }
+
+private:
+    struct Range {
+        size_t offset = 0;
+        size_t length = 0;
+        size_t slot = 0;
+        std::unique_ptr<uint8_t[]> data;
+        std::future<Status> future;
+    };
+    using RangePtr = std::shared_ptr<Range>;
+
+    // copy the next |count| bytes to |data| if it's not nullptr
+    StatusOr<int64_t> _read(uint8_t* data, int64_t count);
+    // submit the next ranges until |_files.size()| ranges are being read
+    void _submit_ranges();
+    Status _read_range(Range* range);
+
+    FileSystem* _fs;
+    const std::string _path;
+    const size_t _offset;
+    const size_t _length;
+    const size_t _range_bytes;
+    // the i-th range is read with _files[i % _files.size()]
+    std::vector<std::unique_ptr<RandomAccessFile>> _files;
+    ThreadPool* _pool;
+
+    // the ranges being read, in the order of the offset
+    std::deque<RangePtr> _ranges;
+    size_t _num_submitted_ranges = 0;
+    size_t _submitted_bytes = 0;
+    RangePtr _current;
+    size_t _current_pos = 0;
+};
+
+StatusOr<int64_t> ParallelRangeInputStream::_read(uint8_t* data, int64_t count) {
+    int64_t read_bytes = 0;
+    while (read_bytes < count) {
+        if (_current == nullptr || _current_pos == _current->length) {
+            _current.reset();
+            _submit_ranges();
+            if (_ranges.empty()) {
+                break;
+            }
+            auto range = std::move(_ranges.front());
+            _ranges.pop_front();
+            RETURN_IF_ERROR(range->future.get());
+            _current = std::move(range);
+            _current_pos = 0;
+            // the slot of the current range is free now
+            _submit_ranges();
+        }
+        const size_t n = std::min<size_t>(count - read_bytes, _current->length - _current_pos);
+        if (data != nullptr) {
+            memcpy(data + read_bytes, _current->data.get() + _current_pos, n);
+        }
+        _current_pos += n;
+        read_bytes += n;
+    }
+    return read_bytes;
+}
+
+void ParallelRangeInputStream::_submit_ranges() {
+    while (_ranges.size() < _files.size() && _submitted_bytes < _length) {
+        auto range = std::make_shared<Range>();
+        range->offset = _submitted_bytes;
+        range->length = std::min(_range_bytes, _length - _submitted_bytes);
+        range->slot = _num_submitted_ranges % _files.size();
+        auto promise = std::make_shared<std::promise<Status>>();
+        range->future = promise->get_future();
+        auto task = [this, range, promise]() { promise->set_value(_read_range(range.get())); };
+        if (_pool == nullptr || !_pool->submit_func(task).ok()) {
+            task();
+        }
+        _ranges.emplace_back(std::move(range));
+        _num_submitted_ranges++;
+        _submitted_bytes += _ranges.back()->length;
+    }
+}
+
+Status ParallelRangeInputStream::_read_range(Range* range) {
+    auto& file = _files[range->slot];
+    if (file == nullptr) {
+        ASSIGN_OR_RETURN(file, _fs->new_random_access_file(_path));
+    }
+    range->data.reset(new uint8_t[range->length]);
+    return file->read_at_fully(_offset + range->offset, range->data.get(), range->length);
+}
+
+StatusOr<std::unique_ptr<io::InputStreamWrapper>> FileBlockContainer::get_readable(size_t offset, size_t length,
+                                                                                   ThreadPool* read_pool) {
     std::string file_path = path();
-    ASSIGN_OR_RETURN(auto f, _dir->fs()->new_sequential_file(file_path));
-    return f;
+    const auto range_bytes = static_cast<size_t>(std::max<int64_t>(config::spill_remote_read_range_bytes, 1));
+    const auto parallelism = static_cast<size_t>(std::max(config::spill_remote_read_parallelism, 1));
+    if (read_pool == nullptr || parallelism == 1 || length <= range_bytes) {
+        ASSIGN_OR_RETURN(auto f, _dir->fs()->new_sequential_file(file_path));
+        RETURN_IF_ERROR(f->skip(offset));
+        return f;
+    }
+    auto stream = std::make_unique<ParallelRangeInputStream>(_dir->fs(), std::move(file_path), offset, length,
+                                                             range_bytes, parallelism, read_pool);
+    return std::make_unique<io::InputStreamWrapper>(std::move(stream));
 }
 
 StatusOr<FileBlockContainerPtr> FileBlockContainer::create(const DirPtr& dir, const TUniqueId& query_id,
@@ -154,7 +284,14 @@ public:
 
 class FileBlock : public Block {
 public:
-    FileBlock(FileBlockContainerPtr container) : _container(std::move(container)) {}
+    FileBlock(FileBlockContainerPtr container, ThreadPool* read_pool)
+            : _container(std::move(container)), _read_pool(read_pool) {}
+
+    // the block of the range [offset, offset + size) of the container, which has been written
+    FileBlock(FileBlockContainerPtr container, ThreadPool* read_pool, size_t offset, size_t size)
+            : _container(std::move(container)), _read_pool(read_pool), _offset(offset) {
+        _size = size;
+    }
 
     ~FileBlock() override = default;
 
@@ -171,7 +308,7 @@ public:
     Status flush() override { return _container->flush(); }
 
     StatusOr<std::unique_ptr<io::InputStreamWrapper>> get_readable() const override {
-        return _container->get_readable();
+        return _container->get_readable(_offset, _size, _read_pool);
     }
 
     std::shared_ptr<BlockReader> get_reader(const BlockReaderOptions& options) override {
@@ -180,7 +317,8 @@ public:
 
     std::string debug_string() const override {
 #ifndef BE_TEST
-        return fmt::format("FileBlock:{}[container={}, len={}]", (void*)this, _container->path(), _size);
+        return fmt::format("FileBlock:{}[container={}, offset={}, len={}]", (void*)this, _container->path(), _offset,
+                           _size);
 #else
         return fmt::format("FileBlock[container={}]", _container->path());
 #endif
@@ -190,24 +328,38 @@ public:
 
 private:
     FileBlockContainerPtr _container;
+    ThreadPool* _read_pool = nullptr;
+    size_t _offset{};
 };
 
 FileBlockManager::FileBlockManager(const TUniqueId& query_id, DirManager* dir_mgr)
         : _query_id(query_id), _dir_mgr(dir_mgr) {}
 
 Status FileBlockManager::open() {
-    return Status::OK();
+    return ThreadPoolBuilder("spill_read")
+            .set_min_threads(0)
+            .set_max_threads(std::max(config::spill_remote_read_parallelism, 1))
+            .build(&_read_pool);
 }
 
-void FileBlockManager::close() {}
+void FileBlockManager::close() {
+    if (_read_pool != nullptr) {
+        _read_pool->shutdown();
+    }
+}
 
 StatusOr<BlockPtr> FileBlockManager::acquire_block(const AcquireBlockOptions& opts) {
     AcquireDirOptions acquire_dir_opts;
     acquire_dir_opts.data_size = opts.block_size;
     ASSIGN_OR_RETURN(auto dir, _dir_mgr->acquire_writable_dir(acquire_dir_opts));
-    ASSIGN_OR_RETURN(auto block_container,
-                     get_or_create_container(dir, opts.fragment_instance_id, opts.plan_node_id, opts.name));
-    auto res = std::make_shared<FileBlock>(block_container);
+    auto container_or = get_or_create_container(dir, opts.fragment_instance_id, opts.plan_node_id, opts.name);
+    if (!container_or.ok()) {
+        dir->dec_size(opts.block_size);
+        return container_or.status();
+    }
+    auto block_container = std::move(container_or).value();
+    block_container->add_acquired_size(opts.block_size);
+    auto res = std::make_shared<FileBlock>(block_container, _read_pool.get());
     res->set_is_remote(dir->is_remote());
     return res;
 }
@@ -220,6 +372,55 @@ Status FileBlockManager::release_block(BlockPtr block) {
     return Status::OK();
 }
 
+StatusOr<std::vector<BlockPtr>> FileBlockManager::copy_blocks(const AcquireBlockOptions& opts,
+                                                               const std::vector<BlockPtr>& blocks,
+                                                               const std::atomic_bool* stopped) {
+    auto is_stopped = [stopped]() { return stopped != nullptr && stopped->load(); };
+    size_t total_size = 0;
+    for (const auto& block : blocks) {
+        total_size += block->size();
+    }
+    AcquireDirOptions acquire_dir_opts;
+    acquire_dir_opts.data_size = total_size;
+    ASSIGN_OR_RETURN(auto dir, _dir_mgr->acquire_writable_dir(acquire_dir_opts));
+    auto container_or = get_or_create_container(dir, opts.fragment_instance_id, opts.plan_node_id, opts.name);
+    if (!container_or.ok()) {
+        dir->dec_size(total_size);
+        return container_or.status();
+    }
+    // if any error occurs, the container is destroyed with its file
+    auto block_container = std::move(container_or).value();
+    block_container->add_acquired_size(total_size);
+
+    const size_t buffer_size = std::min(total_size, kCopyBufferBytes);
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+    std::vector<BlockPtr> res;
+    size_t offset = 0;
+    for (const auto& block : blocks) {
+        ASSIGN_OR_RETURN(auto readable, block->get_readable());
+        size_t remaining = block->size();
+        while (remaining > 0) {
+            if (is_stopped()) {
+                return Status::Cancelled("copy spill blocks is cancelled");
+            }
+            const size_t n = std::min(remaining, buffer_size);
+            RETURN_IF_ERROR(readable->read_fully(buffer.get(), n));
+            RETURN_IF_ERROR(block_container->append_data({Slice(buffer.get(), n)}, n));
+            remaining -= n;
+        }
+        auto file_block = std::make_shared<FileBlock>(block_container, _read_pool.get(), offset, block->size());
+        file_block->set_is_remote(dir->is_remote());
+        file_block->set_exclusive(true);
+        res.emplace_back(std::move(file_block));
+        offset += block->size();
+    }
+    // the object becomes visible on the remote storage after it's closed
+    RETURN_IF_ERROR(block_container->close());
+    TRACE_SPILL_LOG << fmt::format("copy {} blocks to container [{}], size[{}]", blocks.size(),
+                                   block_container->path(), total_size);
+    return res;
+}
+
 StatusOr<FileBlockContainerPtr> FileBlockManager::get_or_create_container(const DirPtr& dir,
                                                                           const TUniqueId& fragment_instance_id,
                                                                           int32_t plan_node_id,
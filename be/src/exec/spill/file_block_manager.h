@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "exec/spill/block_manager.h"
 #include "exec/spill/dir_manager.h"
 #include "gen_cpp/Types_types.h"
+#include "util/threadpool.h"
 
 namespace starrocks::spill {
 class FileBlockContainer;
@@ -31,6 +35,9 @@ using FileBlockContainerPtr = std::shared_ptr<FileBlockContainer>;
 // Therefore, blocks placed on such storage systems cannot be managed by LogBlockManager.
 // FileBlockManager is designed to solve this problem.
 
+// A block on the remote storage is restored in ranges, which are read in parallel, see
+// config::spill_remote_read_parallelism.
+
 class FileBlockManager : public BlockManager {
 public:
     FileBlockManager(const TUniqueId& query_id, DirManager* dir_manager);
@@ -41,6 +48,12 @@ public:
     StatusOr<BlockPtr> acquire_block(const AcquireBlockOptions& opts) override;
     Status release_block(BlockPtr block) override;
 
+    // Copy the data of the sealed |blocks| into one new file, and return the blocks that refer to the ranges of
+    // the file, so that many small blocks are stored as one large object on the remote storage.
+    // The copying is cancelled once |stopped| is set.
+    StatusOr<std::vector<BlockPtr>> copy_blocks(const AcquireBlockOptions& opts, const std::vector<BlockPtr>& blocks,
+                                                const std::atomic_bool* stopped = nullptr);
+
 private:
     StatusOr<FileBlockContainerPtr> get_or_create_container(const DirPtr& dir, const TUniqueId& fragment_instance_id,
                                                             int32_t plan_node_id, const std::string& plan_node_name);
@@ -49,6 +62,9 @@ private:
     std::atomic<uint64_t> _next_container_id = 0;
 
     DirManager* _dir_mgr = nullptr;
+    // used to read the ranges of the blocks in parallel
+    std::unique_ptr<ThreadPool> _read_pool;
+    static constexpr size_t kCopyBufferBytes = 8L * 1024 * 1024; // 8MB
 };
 
 } // namespace starrocks::spill
\ No newline at end of file
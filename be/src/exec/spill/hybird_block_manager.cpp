@@ -14,16 +14,99 @@
 
 #include "exec/spill/hybird_block_manager.h"
 
+#include <algorithm>
+
+#include "common/config.h"
+#include "exec/spill/common.h"
+#include "exec/spill/query_spill_manager.h"
+#include "fmt/format.h"
+#include "gutil/casts.h"
 #include "util/failpoint/fail_point.h"
 
 namespace starrocks::spill {
 
+// TieredBlock is a local block, which could be replaced by a remote block of the same data after it's sealed.
+// Once it's read, it's pinned on the local disk, since the readers refer to the local block.
+class TieredBlock final : public Block {
+public:
+    TieredBlock(BlockPtr block, AcquireBlockOptions opts) : _block(std::move(block)), _opts(std::move(opts)) {
+        _exclusive = _block->exclusive();
+    }
+
+    ~TieredBlock() override = default;
+
+    // the block is written only before it's sealed, when it can't be offloaded
+    Status append(const std::vector<Slice>& data) override {
+        RETURN_IF_ERROR(_block->append(data));
+        _size = _block->size();
+        return Status::OK();
+    }
+
+    Status flush() override { return _block->flush(); }
+
+    bool preallocate(size_t write_size) override { return _block->preallocate(write_size); }
+
+    StatusOr<std::unique_ptr<io::InputStreamWrapper>> get_readable() const override {
+        return _pin()->get_readable();
+    }
+
+    std::shared_ptr<BlockReader> get_reader(const BlockReaderOptions& options) override {
+        return _pin()->get_reader(options);
+    }
+
+    Status prefetch() override { return _pin()->prefetch(); }
+
+    std::string debug_string() const override { return _current()->debug_string(); }
+
+    BlockPtr current_block() const { return _current(); }
+
+    const AcquireBlockOptions& options() const { return _opts; }
+
+    bool is_pinned() const {
+        std::lock_guard l(_mutex);
+        return _pinned;
+    }
+
+    // Replace the local block with |remote_block|, return false if the block has been pinned.
+    bool offload(BlockPtr remote_block) {
+        std::lock_guard l(_mutex);
+        if (_pinned) {
+            return false;
+        }
+        _block = std::move(remote_block);
+        set_is_remote(true);
+        return true;
+    }
+
+private:
+    BlockPtr _pin() const {
+        std::lock_guard l(_mutex);
+        _pinned = true;
+        return _block;
+    }
+
+    BlockPtr _current() const {
+        std::lock_guard l(_mutex);
+        return _block;
+    }
+
+    mutable std::mutex _mutex;
+    mutable bool _pinned = false;
+    BlockPtr _block;
+    AcquireBlockOptions _opts;
+};
+
 HyBirdBlockManager::HyBirdBlockManager(const TUniqueId& query_id, std::unique_ptr<BlockManager> local_block_manager,
-                                       std::unique_ptr<BlockManager> remote_block_manager)
+                                       std::unique_ptr<FileBlockManager> remote_block_manager,
+                                       QuerySpillManager* query_spill_manager)
         : _local_block_manager(std::move(local_block_manager)),
-          _remote_block_manager(std::move(remote_block_manager)) {}
+          _remote_block_manager(std::move(remote_block_manager)),
+          _query_spill_manager(query_spill_manager) {}
 
 HyBirdBlockManager::~HyBirdBlockManager() {
+    // cancel and wait for the blocks being offloaded
+    _stopped = true;
+    _offload_pool.reset();
     _local_block_manager.reset();
     _remote_block_manager.reset();
 }
@@ -31,14 +114,27 @@ HyBirdBlockManager::~HyBirdBlockManager() {
 Status HyBirdBlockManager::open() {
     RETURN_IF_ERROR(_local_block_manager->open());
     RETURN_IF_ERROR(_remote_block_manager->open());
-    return Status::OK();
+    return ThreadPoolBuilder("spill_offload")
+            .set_min_threads(0)
+            .set_max_threads(std::max(config::spill_offload_threads, 1))
+            .build(&_offload_pool);
 }
 
 void HyBirdBlockManager::close() {
+    _stopped = true;
+    if (_offload_pool != nullptr) {
+        _offload_pool->shutdown();
+    }
     _local_block_manager->close();
     _remote_block_manager->close();
 }
 
+void HyBirdBlockManager::flush() {
+    if (_offload_pool != nullptr) {
+        _offload_pool->wait();
+    }
+}
+
 DEFINE_FAIL_POINT(force_allocate_remote_block);
 
 StatusOr<BlockPtr> HyBirdBlockManager::acquire_block(const AcquireBlockOptions& opts) {
@@ -47,8 +143,10 @@ StatusOr<BlockPtr> HyBirdBlockManager::acquire_block(const AcquireBlockOptions&
     if (enable_allocate_local_block) {
         auto local_block = _local_block_manager->acquire_block(opts);
         if (local_block.ok()) {
-            return local_block;
+            return std::make_shared<TieredBlock>(std::move(local_block).value(), opts);
         }
+        // make room for the next blocks
+        _try_offload();
     }
     ASSIGN_OR_RETURN(auto remote_block, _remote_block_manager->acquire_block(opts));
     return remote_block;
@@ -58,6 +156,114 @@ Status HyBirdBlockManager::release_block(BlockPtr block) {
     if (block->is_remote()) {
         return _remote_block_manager->release_block(std::move(block));
     }
-    return _local_block_manager->release_block(std::move(block));
+    auto tiered_block = std::static_pointer_cast<TieredBlock>(block);
+    RETURN_IF_ERROR(_local_block_manager->release_block(tiered_block->current_block()));
+    if (_query_spill_manager == nullptr || !tiered_block->exclusive()) {
+        return Status::OK();
+    }
+    {
+        std::lock_guard l(_mutex);
+        _candidates.push_back({tiered_block, tiered_block->size()});
+    }
+    _query_spill_manager->update_local_spill_bytes(tiered_block->size());
+    _try_offload();
+    return Status::OK();
+}
+
+void HyBirdBlockManager::_remove_hot_candidates() {
+    auto iter = std::remove_if(_candidates.begin(), _candidates.end(), [this](const OffloadCandidate& candidate) {
+        auto block = candidate.block.lock();
+        if (block != nullptr && !block->is_pinned()) {
+            return false;
+        }
+        _query_spill_manager->update_local_spill_bytes(-static_cast<int64_t>(candidate.size));
+        return true;
+    });
+    _candidates.erase(iter, _candidates.end());
+}
+
+void HyBirdBlockManager::_try_offload() {
+    if (_query_spill_manager == nullptr || _offload_pool == nullptr) {
+        return;
+    }
+    const auto object_bytes = std::max<int64_t>(config::spill_offload_object_bytes, 1);
+    std::vector<OffloadBatch> batches;
+    {
+        std::lock_guard l(_mutex);
+        if (_query_spill_manager->local_bytes_to_offload() <= _offloading_bytes) {
+            return;
+        }
+        _remove_hot_candidates();
+        int64_t bytes_to_offload = _query_spill_manager->local_bytes_to_offload() - _offloading_bytes;
+        if (bytes_to_offload <= 0) {
+            return;
+        }
+        // offload an object at least, so that the objects are large and the offloading isn't triggered by each block
+        bytes_to_offload = std::max(bytes_to_offload, object_bytes);
+        OffloadBatch batch;
+        while (bytes_to_offload > 0 && !_candidates.empty()) {
+            auto candidate = std::move(_candidates.front());
+            _candidates.pop_front();
+            auto block = candidate.block.lock();
+            if (block == nullptr) {
+                _query_spill_manager->update_local_spill_bytes(-static_cast<int64_t>(candidate.size));
+                continue;
+            }
+            if (!batch.blocks.empty() && batch.size + candidate.size > object_bytes) {
+                batches.emplace_back(std::move(batch));
+                batch = OffloadBatch();
+            }
+            batch.blocks.emplace_back(std::move(block));
+            batch.size += candidate.size;
+            bytes_to_offload -= candidate.size;
+            _offloading_bytes += candidate.size;
+        }
+        if (!batch.blocks.empty()) {
+            batches.emplace_back(std::move(batch));
+        }
+    }
+    for (auto& batch : batches) {
+        auto st = _offload_pool->submit_func([this, batch]() { _offload_blocks(batch); });
+        if (!st.ok()) {
+            _finish_offload(batch, 0);
+        }
+    }
+}
+
+void HyBirdBlockManager::_offload_blocks(const OffloadBatch& batch) {
+    if (_stopped) {
+        _finish_offload(batch, 0);
+        return;
+    }
+    std::vector<BlockPtr> local_blocks;
+    for (const auto& block : batch.blocks) {
+        local_blocks.emplace_back(block->current_block());
+    }
+    auto remote_blocks = _remote_block_manager->copy_blocks(batch.blocks[0]->options(), local_blocks, &_stopped);
+    if (!remote_blocks.ok()) {
+        LOG(WARNING) << fmt::format("offload {} spill blocks failed, they are kept on the local disk: {}",
+                                    batch.blocks.size(), remote_blocks.status().to_string());
+        _finish_offload(batch, 0);
+        return;
+    }
+    size_t offloaded_bytes = 0;
+    for (size_t i = 0; i < batch.blocks.size(); i++) {
+        if (batch.blocks[i]->offload(remote_blocks.value()[i])) {
+            offloaded_bytes += batch.blocks[i]->size();
+        }
+    }
+    // free the local blocks before the offloaded bytes are accounted
+    local_blocks.clear();
+    TRACE_SPILL_LOG << fmt::format("offload {} spill blocks, size[{}], offloaded size[{}]", batch.blocks.size(),
+                                   batch.size, offloaded_bytes);
+    _finish_offload(batch, offloaded_bytes);
 }
-} // namespace starrocks::spill
\ No newline at end of file
+
+void HyBirdBlockManager::_finish_offload(const OffloadBatch& batch, size_t offloaded_bytes) {
+    _query_spill_manager->update_local_spill_bytes(-static_cast<int64_t>(batch.size));
+    _query_spill_manager->update_offloaded_bytes(offloaded_bytes);
+    std::lock_guard l(_mutex);
+    _offloading_bytes -= batch.size;
+}
+
+} // namespace starrocks::spill
@@ -14,17 +14,38 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "exec/spill/block_manager.h"
+#include "exec/spill/file_block_manager.h"
+#include "util/threadpool.h"
 
 namespace starrocks::spill {
 
+class QuerySpillManager;
+class TieredBlock;
+
 // HybirdManager contains two independent BlockManagers, which manage local blocks and remote blocks respectively.
 // If the local disk capacity is large enough, we will allocate blocks from the local disk first,
 // otherwise allocate them from the remote storage.
+//
+// The local blocks are tiered. Once the local disks are short of space, the cold local blocks of the query are
+// offloaded to the remote storage in the background, so that the local disks are left to the hot blocks, i.e. the
+// blocks being written and the blocks going to be restored. How many bytes to offload is decided by
+// QuerySpillManager::local_bytes_to_offload().
+// A local block becomes a candidate to offload once it's sealed, i.e. released after writing, and the earliest
+// sealed one is offloaded first. A block isn't offloaded if it's being restored, or if it shares its container
+// with other blocks, whose space couldn't be freed. The offloaded blocks are copied into large objects, see
+// FileBlockManager::copy_blocks().
 class HyBirdBlockManager : public BlockManager {
 public:
     HyBirdBlockManager(const TUniqueId& query_id, std::unique_ptr<BlockManager> local_block_manager,
-                       std::unique_ptr<BlockManager> remote_block_manager);
+                       std::unique_ptr<FileBlockManager> remote_block_manager,
+                       QuerySpillManager* query_spill_manager = nullptr);
     ~HyBirdBlockManager() override;
 
     Status open() override;
@@ -32,9 +53,38 @@ public:
     StatusOr<BlockPtr> acquire_block(const AcquireBlockOptions& opts) override;
     Status release_block(BlockPtr block) override;
 
+    // wait for the blocks being offloaded
+    void flush();
+
 private:
+    struct OffloadCandidate {
+        std::weak_ptr<TieredBlock> block;
+        size_t size = 0;
+    };
+    struct OffloadBatch {
+        std::vector<std::shared_ptr<TieredBlock>> blocks;
+        size_t size = 0;
+    };
+
+    // offload the cold blocks in the background if QuerySpillManager requires
+    void _try_offload();
+    // remove the candidates which have been restored or are going to be restored
+    void _remove_hot_candidates();
+    void _offload_blocks(const OffloadBatch& batch);
+    void _finish_offload(const OffloadBatch& batch, size_t offloaded_bytes);
+
     std::unique_ptr<BlockManager> _local_block_manager;
-    std::unique_ptr<BlockManager> _remote_block_manager;
+    std::unique_ptr<FileBlockManager> _remote_block_manager;
+    QuerySpillManager* _query_spill_manager = nullptr;
+    std::unique_ptr<ThreadPool> _offload_pool;
+    // set once the manager is closed, the blocks being offloaded are left on the local disk
+    std::atomic_bool _stopped = false;
+
+    std::mutex _mutex;
+    // the sealed local blocks which could be offloaded, in the order of sealing
+    std::deque<OffloadCandidate> _candidates;
+    // the size of the blocks being offloaded
+    int64_t _offloading_bytes = 0;
 };
 
-} // namespace starrocks::spill
\ No newline at end of file
+} // namespace starrocks::spill
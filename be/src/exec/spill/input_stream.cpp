@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/spill/block_manager.h"
 #include "exec/spill/serde.h"
@@ -267,9 +268,13 @@ public:
     void close() override {}
 
 private:
+    void _prefetch_next_blocks();
+
     std::vector<BlockPtr> _input_blocks;
     std::shared_ptr<BlockReader> _current_reader;
     size_t _current_idx = 0;
+    // the index of the next block to prefetch
+    size_t _prefetch_idx = 0;
     size_t _block_read_rows = 0;
     SerdePtr _serde;
     BlockReaderOptions _options;
@@ -290,6 +295,7 @@ StatusOr<ChunkUniquePtr> SequenceInputStream::get_next(workgroup::YieldContext&
             _options.read_io_timer = GET_METRICS(is_remote, _serde->parent()->metrics(), read_io_timer);
             _options.read_io_count = GET_METRICS(is_remote, _serde->parent()->metrics(), read_io_count);
             _current_reader = _input_blocks[_current_idx]->get_reader(_options);
+            _prefetch_next_blocks();
         }
         auto& block = _input_blocks[_current_idx];
         if (!(block->is_remote() ^ io_ctx->use_local_io_executor)) {
@@ -322,6 +328,25 @@ StatusOr<ChunkUniquePtr> SequenceInputStream::get_next(workgroup::YieldContext&
     __builtin_unreachable();
 }
 
+// Prefetch the local blocks next to the current one, so that they're loaded while the current one is restored.
+void SequenceInputStream::_prefetch_next_blocks() {
+    const auto depth = static_cast<size_t>(std::max(config::spill_restore_prefetch_blocks, 0));
+    const size_t end = std::min(_input_blocks.size(), _current_idx + 1 + depth);
+    _prefetch_idx = std::max(_prefetch_idx, _current_idx + 1);
+    for (; _prefetch_idx < end; _prefetch_idx++) {
+        const auto& block = _input_blocks[_prefetch_idx];
+        if (block->is_remote()) {
+            continue;
+        }
+        auto st = block->prefetch();
+        if (!st.ok()) {
+            TRACE_SPILL_LOG << fmt::format("prefetch block[{}] failed: {}", block->debug_string(), st.to_string());
+            continue;
+        }
+        COUNTER_UPDATE(_serde->parent()->metrics().restore_prefetch_bytes, block->size());
+    }
+}
+
 class OrderedInputStream : public SpillInputStream {
 public:
     OrderedInputStream(std::vector<InputStreamPtr> input_streams, RuntimeState* state)
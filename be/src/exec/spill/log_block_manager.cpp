@@ -84,12 +84,17 @@ public:
         }
     }
 
+    // the size acquired from Dir when a block is acquired from the container, it's released with the container
+    void add_acquired_size(size_t acquired_size) { _acquired_data_size += acquired_size; }
+
     Status append_data(const std::vector<Slice>& data, size_t total_size);
 
     Status flush();
 
     StatusOr<std::unique_ptr<io::InputStreamWrapper>> get_readable(size_t offset, size_t length);
 
+    Status prefetch(size_t offset, size_t length);
+
     static StatusOr<LogBlockContainerPtr> create(const DirPtr& dir, const TUniqueId& query_id,
                                                  const TUniqueId& fragment_instance_id, int32_t plan_node_id,
                                                  const std::string& plan_node_name, uint64_t id, bool enable_direct_io);
@@ -153,6 +158,11 @@ StatusOr<std::unique_ptr<io::InputStreamWrapper>> LogBlockContainer::get_readabl
     return f;
 }
 
+Status LogBlockContainer::prefetch(size_t offset, size_t length) {
+    ASSIGN_OR_RETURN(auto f, _dir->fs()->new_random_access_file(path()));
+    return f->prefetch(offset, length);
+}
+
 StatusOr<LogBlockContainerPtr> LogBlockContainer::create(const DirPtr& dir, const TUniqueId& query_id,
                                                          const TUniqueId& fragment_instance_id, int32_t plan_node_id,
                                                          const std::string& plan_node_name, uint64_t id,
@@ -202,6 +212,8 @@ public:
         return std::make_shared<LogBlockReader>(this, options);
     }
 
+    Status prefetch() override { return _container->prefetch(_offset, _size); }
+
     std::string debug_string() const override {
 #ifndef BE_TEST
         return fmt::format("LogBlock:{}[container={}, offset={}, len={}]", (void*)this, _container->path(), _offset,
@@ -251,8 +263,14 @@ StatusOr<BlockPtr> LogBlockManager::acquire_block(const AcquireBlockOptions& opt
     ASSIGN_OR_RETURN(auto dir, ExecEnv::GetInstance()->spill_dir_mgr()->acquire_writable_dir(acquire_dir_opts));
 #endif
 
-    ASSIGN_OR_RETURN(auto block_container, get_or_create_container(dir, opts.fragment_instance_id, opts.plan_node_id,
-                                                                   opts.name, opts.direct_io));
+    auto container_or = get_or_create_container(dir, opts.fragment_instance_id, opts.plan_node_id, opts.name,
+                                                 opts.direct_io);
+    if (!container_or.ok()) {
+        dir->dec_size(opts.block_size);
+        return container_or.status();
+    }
+    auto block_container = std::move(container_or).value();
+    block_container->add_acquired_size(opts.block_size);
     auto res = std::make_shared<LogBlock>(block_container, block_container->size());
     res->set_is_remote(dir->is_remote());
     res->set_exclusive(opts.exclusive);
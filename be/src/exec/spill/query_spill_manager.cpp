@@ -14,9 +14,11 @@
 
 #include "exec/spill/query_spill_manager.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
+#include "common/config.h"
 #include "exec/spill/dir_manager.h"
 #include "exec/spill/file_block_manager.h"
 #include "exec/spill/hybird_block_manager.h"
@@ -26,6 +28,14 @@
 
 namespace starrocks::spill {
 
+QuerySpillManager::~QuerySpillManager() {
+    // stop the offloading before the dir manager and the accounting it uses are destroyed
+    if (_block_manager != nullptr) {
+        _block_manager->close();
+        _block_manager.reset();
+    }
+}
+
 Status QuerySpillManager::init_block_manager(const TQueryOptions& query_options) {
     const TSpillOptions& spill_options = query_options.spill_options;
     bool enable_spill_to_remote_storage =
@@ -59,15 +69,30 @@ Status QuerySpillManager::init_block_manager(const TQueryOptions& query_options)
             options.__isset.disable_spill_to_local_disk && options.disable_spill_to_local_disk;
     if (disable_spill_to_local_disk) {
         _block_manager = std::make_unique<FileBlockManager>(_uid, _remote_dir_manager.get());
-        return Status::OK();
+        return _block_manager->open();
     }
 
     // init block manager
     auto local_block_manager = std::make_unique<LogBlockManager>(_uid, ExecEnv::GetInstance()->spill_dir_mgr());
     auto remote_block_manager = std::make_unique<FileBlockManager>(_uid, _remote_dir_manager.get());
-    _block_manager =
-            std::make_unique<HyBirdBlockManager>(_uid, std::move(local_block_manager), std::move(remote_block_manager));
+    _local_dir_manager = ExecEnv::GetInstance()->spill_dir_mgr();
+    _block_manager = std::make_unique<HyBirdBlockManager>(_uid, std::move(local_block_manager),
+                                                          std::move(remote_block_manager), this);
 
-    return Status::OK();
+    return _block_manager->open();
+}
+
+int64_t QuerySpillManager::local_bytes_to_offload() const {
+    if (_local_dir_manager == nullptr) {
+        return 0;
+    }
+    const int64_t local_spill_bytes = _local_spill_bytes;
+    const int64_t used_size = _local_dir_manager->current_size();
+    const auto watermark = static_cast<int64_t>(_local_dir_manager->max_size() * config::spill_local_offload_watermark);
+    if (local_spill_bytes <= 0 || used_size <= watermark) {
+        return 0;
+    }
+    const double share = static_cast<double>(local_spill_bytes) / used_size;
+    return std::min(local_spill_bytes, static_cast<int64_t>((used_size - watermark) * share));
 }
 } // namespace starrocks::spill
\ No newline at end of file
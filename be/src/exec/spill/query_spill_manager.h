@@ -25,9 +25,17 @@
 #include "gen_cpp/Types_types.h"
 
 namespace starrocks::spill {
+
+// QuerySpillManager manages the spilled blocks of a query.
+//
+// If spilling to the remote storage is enabled, the blocks are spilled to the local disks first, and the cold
+// blocks are offloaded to the remote storage in the background once the local disks are short of space, see
+// HyBirdBlockManager. QuerySpillManager accounts the local size used by the query, which decides how many blocks
+// should be offloaded, so that each query gives up the local disks in proportion to its share of them.
 class QuerySpillManager {
 public:
     QuerySpillManager(const TUniqueId& uid) : _uid(uid) {}
+    ~QuerySpillManager();
 
     Status init_block_manager(const TQueryOptions& query_options);
 
@@ -41,10 +49,31 @@ public:
 
     BlockManager* block_manager() const { return _block_manager.get(); }
 
+    // the size of the sealed blocks of the query, which could be offloaded, on the local disks
+    void update_local_spill_bytes(int64_t delta) { _local_spill_bytes += delta; }
+    int64_t local_spill_bytes() const { return _local_spill_bytes; }
+    // the size of the offloaded blocks of the query on the remote storage
+    void update_offloaded_bytes(int64_t delta) { _offloaded_bytes += delta; }
+    int64_t offloaded_bytes() const { return _offloaded_bytes; }
+
+    // Return the size of the local blocks that the query should offload to the remote storage. It's 0 unless
+    // the used size of the local disks exceeds config::spill_local_offload_watermark of their capacity, then the
+    // query offloads the excess in proportion to its share of the used size.
+    int64_t local_bytes_to_offload() const;
+
+#ifdef BE_TEST
+    void set_local_dir_manager(DirManager* dir_mgr) { _local_dir_manager = dir_mgr; }
+#endif
+
 private:
     TUniqueId _uid;
-    std::unique_ptr<BlockManager> _block_manager;
     std::unique_ptr<DirManager> _remote_dir_manager;
+    // the local dirs shared by all the queries, only used by the accounting of tiered spilling
+    DirManager* _local_dir_manager = nullptr;
+    std::atomic_int64_t _local_spill_bytes = 0;
+    std::atomic_int64_t _offloaded_bytes = 0;
+    // declared after the members above, since the blocks being offloaded in the background refer to them
+    std::unique_ptr<BlockManager> _block_manager;
     std::atomic_size_t _spilling_operators = 0;
     size_t _spillable_operators = 0;
 };
@@ -72,6 +72,17 @@ private:
             _encode_context->update(i, column_stats[i].first, column_stats[i].second);
         }
         _encode_context->adjust_encode_levels();
+
+        uint64_t raw_bytes = 0;
+        uint64_t encoded_bytes = 0;
+        for (size_t i = 0; i < _encode_context->num_columns(); i++) {
+            raw_bytes += _encode_context->total_raw_bytes(i);
+            encoded_bytes += _encode_context->total_encoded_bytes(i);
+        }
+        if (raw_bytes > 0) {
+            const auto ratio_percent = static_cast<int64_t>(encoded_bytes * 100 / raw_bytes);
+            COUNTER_SET(_parent->metrics().compression_ratio_percent, ratio_percent);
+        }
     }
 
     ChunkBuilder _chunk_builder;
@@ -41,6 +41,13 @@
 
 namespace starrocks::spill {
 
+static int64_t bytes_per_second(int64_t bytes, int64_t elapsed_ns) {
+    if (elapsed_ns == 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(static_cast<double>(bytes) * 1000000000 / elapsed_ns);
+}
+
 SpillProcessMetrics::SpillProcessMetrics(RuntimeProfile* profile, std::atomic_int64_t* total_spill_bytes_) {
     DCHECK(profile != nullptr);
     total_spill_bytes = total_spill_bytes_;
@@ -71,6 +78,35 @@ SpillProcessMetrics::SpillProcessMetrics(RuntimeProfile* profile, std::atomic_in
     local_restore_bytes = ADD_CHILD_COUNTER(profile, "BytesRestoreFromLocalDisk", TUnit::BYTES, "BytesRestore");
     remote_restore_bytes = ADD_CHILD_COUNTER(profile, "BytesRestoreFromRemoteStorage", TUnit::BYTES, "BytesRestore");
 
+    restore_prefetch_bytes = ADD_CHILD_COUNTER(profile, "BytesRestorePrefetch", TUnit::BYTES, parent);
+
+    // the throughput of the disk io, the bytes of both the local disk and the remote storage are counted
+    auto* local_write_timer = local_write_io_timer;
+    auto* remote_write_timer = remote_write_io_timer;
+    auto* local_write_bytes = local_flush_bytes;
+    auto* remote_write_bytes = remote_flush_bytes;
+    profile->add_derived_counter(
+            "WriteThroughput", TUnit::BYTES_PER_SECOND,
+            [=] {
+                return bytes_per_second(local_write_bytes->value() + remote_write_bytes->value(),
+                                        local_write_timer->value() + remote_write_timer->value());
+            },
+            parent);
+    auto* local_read_timer = local_read_io_timer;
+    auto* remote_read_timer = remote_read_io_timer;
+    auto* local_read_bytes = local_restore_bytes;
+    auto* remote_read_bytes = remote_restore_bytes;
+    profile->add_derived_counter(
+            "ReadThroughput", TUnit::BYTES_PER_SECOND,
+            [=] {
+                return bytes_per_second(local_read_bytes->value() + remote_read_bytes->value(),
+                                        local_read_timer->value() + remote_read_timer->value());
+            },
+            parent);
+    compression_ratio_percent =
+            profile->add_child_counter("CompressionRatioPercent", TUnit::UNIT,
+                                       RuntimeProfile::Counter::create_strategy(TCounterAggregateType::AVG), parent);
+
     serialize_timer = ADD_CHILD_TIMER(profile, "SerializeTime", parent);
     deserialize_timer = ADD_CHILD_TIMER(profile, "DeserializeTime", parent);
     mem_table_peak_memory_usage = profile->AddHighWaterMarkCounter(
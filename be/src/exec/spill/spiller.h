@@ -84,6 +84,10 @@ public:
     RuntimeProfile::Counter* restore_bytes = nullptr;
     RuntimeProfile::Counter* local_restore_bytes = nullptr;
     RuntimeProfile::Counter* remote_restore_bytes = nullptr;
+    // data bytes of the next blocks prefetched into the page cache of the OS during restore
+    RuntimeProfile::Counter* restore_prefetch_bytes = nullptr;
+    // the serialized bytes in percent of the bytes of the spilled columns in memory
+    RuntimeProfile::Counter* compression_ratio_percent = nullptr;
     // time spent to serialize data before flush it to disk
     RuntimeProfile::Counter* serialize_timer = nullptr;
     // time spent to deserialize data after read it from disk
@@ -0,0 +1,179 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/binary_fuse_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace starrocks {
+
+static uint64_t splitmix64(uint64_t* seed) {
+    uint64_t z = (*seed += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+static uint8_t mod3(uint8_t x) {
+    return x > 2 ? x - 3 : x;
+}
+
+void BinaryFuseFilter::_allocate(uint32_t size) {
+    // These parameters are very sensitive, see the paper for details.
+    _segment_length = size == 0 ? 4 : (1u << static_cast<int>(std::floor(std::log(size) / std::log(3.33) + 2.25)));
+    _segment_length = std::min<uint32_t>(_segment_length, 262144);
+    _segment_length_mask = _segment_length - 1;
+    const double size_factor = size <= 1 ? 0 : std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(size));
+    const auto capacity = static_cast<int64_t>(size <= 1 ? 0 : std::round(size * size_factor));
+    const int64_t segment_count = std::max<int64_t>((capacity + _segment_length - 1) / _segment_length - 2, 1);
+    _segment_count_length = segment_count * _segment_length;
+    _fingerprints.assign((segment_count + 2) * _segment_length, 0);
+}
+
+bool BinaryFuseFilter::build() {
+    // the construction requires the keys to be distinct
+    std::sort(_hashes.begin(), _hashes.end());
+    _hashes.erase(std::unique(_hashes.begin(), _hashes.end()), _hashes.end());
+    const auto size = static_cast<uint32_t>(_hashes.size());
+    _allocate(size);
+    const size_t array_length = _fingerprints.size();
+
+    // t2count[i] >> 2 is the number of the keys mapped to position i, and t2count[i] & 3 is the xor of
+    // the indexes of position i in the positions of these keys. t2hash[i] is the xor of these keys,
+    // which is the only key when there is one.
+    std::vector<uint8_t> t2count(array_length);
+    std::vector<uint64_t> t2hash(array_length);
+    std::vector<uint32_t> alone(array_length);
+    // the keys peeled in order, and the index of the position of each key which it's peeled from
+    std::vector<uint64_t> reverse_order(size);
+    std::vector<uint8_t> reverse_h(size);
+
+    uint64_t rng_counter = 0x726b2b9d438b9d4d;
+    bool success = false;
+    for (int loop = 0; loop < kMaxIterations && !success; ++loop) {
+        _seed = splitmix64(&rng_counter);
+        std::fill(t2count.begin(), t2count.end(), 0);
+        std::fill(t2hash.begin(), t2hash.end(), 0);
+
+        bool error = false;
+        for (uint64_t key : _hashes) {
+            const uint64_t hash = _mix(key + _seed);
+            for (int i = 0; i < 3; i++) {
+                const uint32_t h = _position(i, hash);
+                t2count[h] += 4;
+                t2count[h] ^= i;
+                t2hash[h] ^= hash;
+                // the count overflows
+                error |= t2count[h] < 4;
+            }
+        }
+        if (error) {
+            continue;
+        }
+
+        uint32_t queue_size = 0;
+        for (uint32_t i = 0; i < array_length; i++) {
+            alone[queue_size] = i;
+            queue_size += (t2count[i] >> 2) == 1;
+        }
+        uint32_t stack_size = 0;
+        while (queue_size > 0) {
+            const uint32_t index = alone[--queue_size];
+            if ((t2count[index] >> 2) != 1) {
+                continue;
+            }
+            const uint64_t hash = t2hash[index];
+            const uint32_t h012[5] = {_position(0, hash), _position(1, hash), _position(2, hash), _position(0, hash),
+                                      _position(1, hash)};
+            const uint8_t found = t2count[index] & 3;
+            reverse_h[stack_size] = found;
+            reverse_order[stack_size] = hash;
+            stack_size++;
+            for (uint8_t j = 1; j <= 2; j++) {
+                const uint32_t other = h012[found + j];
+                alone[queue_size] = other;
+                queue_size += (t2count[other] >> 2) == 2;
+                t2count[other] -= 4;
+                t2count[other] ^= mod3(found + j);
+                t2hash[other] ^= hash;
+            }
+        }
+        // all the keys are peeled
+        success = stack_size == size;
+    }
+    if (!success) {
+        _fingerprints.clear();
+        return false;
+    }
+
+    for (uint32_t i = size; i-- > 0;) {
+        const uint64_t hash = reverse_order[i];
+        const uint32_t h012[5] = {_position(0, hash), _position(1, hash), _position(2, hash), _position(0, hash),
+                                  _position(1, hash)};
+        const uint8_t found = reverse_h[i];
+        _fingerprints[h012[found]] =
+                _fingerprint(hash) ^ _fingerprints[h012[found + 1]] ^ _fingerprints[h012[found + 2]];
+    }
+    _built = true;
+    std::vector<uint64_t>().swap(_hashes);
+    return true;
+}
+
+size_t BinaryFuseFilter::max_serialized_size() const {
+    return sizeof(_seed) + sizeof(_segment_length) + sizeof(_segment_count_length) + sizeof(uint32_t) +
+           _fingerprints.size();
+}
+
+size_t BinaryFuseFilter::serialize(uint8_t* data) const {
+    size_t offset = 0;
+#define BF_COPY_FIELD(field)                      \
+    memcpy(data + offset, &field, sizeof(field)); \
+    offset += sizeof(field);
+    BF_COPY_FIELD(_seed);
+    BF_COPY_FIELD(_segment_length);
+    BF_COPY_FIELD(_segment_count_length);
+    auto data_size = static_cast<uint32_t>(_fingerprints.size());
+    BF_COPY_FIELD(data_size);
+#undef BF_COPY_FIELD
+    memcpy(data + offset, _fingerprints.data(), data_size);
+    offset += data_size;
+    return offset;
+}
+
+size_t BinaryFuseFilter::deserialize(const uint8_t* data) {
+    size_t offset = 0;
+    uint32_t data_size = 0;
+#define BF_COPY_FIELD(field)                      \
+    memcpy(&field, data + offset, sizeof(field)); \
+    offset += sizeof(field);
+    BF_COPY_FIELD(_seed);
+    BF_COPY_FIELD(_segment_length);
+    BF_COPY_FIELD(_segment_count_length);
+    BF_COPY_FIELD(data_size);
+#undef BF_COPY_FIELD
+    _segment_length_mask = _segment_length - 1;
+    _fingerprints.assign(data + offset, data + offset + data_size);
+    offset += data_size;
+    _built = true;
+    return offset;
+}
+
+bool BinaryFuseFilter::check_equal(const BinaryFuseFilter& bf) const {
+    return _built == bf._built && _seed == bf._seed && _segment_length == bf._segment_length &&
+           _segment_count_length == bf._segment_count_length && _fingerprints == bf._fingerprints;
+}
+
+} // namespace starrocks
@@ -0,0 +1,113 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starrocks {
+
+// Modify from https://github.com/FastFilter/xor_singleheader/blob/master/include/binaryfusefilter.h
+// This is the 3-wise binary fuse filter with 8-bit fingerprints of paper
+// <<Binary Fuse Filters: Fast and Smaller Than Xor Filters>>, it takes about 9 bits per key and its
+// false positive rate is about 1/256, which is much denser than a bloom filter of the same false positive rate.
+//
+// The filter can't be updated after it's built, so the hashes are collected by add_hash() first,
+// and the filter is built by build() once all the hashes are added.
+class BinaryFuseFilter {
+public:
+    BinaryFuseFilter() = default;
+
+    void add_hash(uint64_t hash) { _hashes.push_back(hash); }
+
+    // Build the filter from the added hashes, which are released if it succeeds.
+    // Return false if the filter can't be built in a reasonable number of attempts, which hardly happens,
+    // and the added hashes are kept, so that the caller could build another kind of filter from them.
+    bool build();
+
+    bool built() const { return _built; }
+
+    // The bytes of the temporary arrays of build() for |num_hashes| hashes, besides the hashes themselves.
+    static size_t build_bytes(size_t num_hashes) { return num_hashes * kBuildBytesPerHash; }
+
+    const std::vector<uint64_t>& hashes() const { return _hashes; }
+
+    bool test_hash(uint64_t hash) const noexcept {
+        hash = _mix(hash + _seed);
+        uint8_t f = _fingerprint(hash);
+        const uint32_t h0 = _mulhi(hash, _segment_count_length);
+        uint32_t h1 = h0 + _segment_length;
+        uint32_t h2 = h1 + _segment_length;
+        h1 ^= static_cast<uint32_t>(hash >> 18) & _segment_length_mask;
+        h2 ^= static_cast<uint32_t>(hash) & _segment_length_mask;
+        f ^= _fingerprints[h0] ^ _fingerprints[h1] ^ _fingerprints[h2];
+        return f == 0;
+    }
+
+    size_t max_serialized_size() const;
+    size_t serialize(uint8_t* data) const;
+    size_t deserialize(const uint8_t* data);
+    bool check_equal(const BinaryFuseFilter& bf) const;
+
+    size_t get_alloc_size() const { return _fingerprints.size() + _hashes.capacity() * sizeof(uint64_t); }
+
+private:
+    static constexpr int kMaxIterations = 100;
+    // the fingerprints, t2count, t2hash, alone, reverse_order and reverse_h of build(), the first three of which are
+    // about 1.13 times the number of the hashes
+    static constexpr size_t kBuildBytesPerHash = 25;
+
+    static uint64_t _mix(uint64_t h) {
+        // the finalizer of murmur64, it's a bijection, so the distinct hashes are still distinct after mixed
+        h ^= h >> 33;
+        h *= UINT64_C(0xff51afd7ed558ccd);
+        h ^= h >> 33;
+        h *= UINT64_C(0xc4ceb9fe1a85ec53);
+        h ^= h >> 33;
+        return h;
+    }
+
+    static uint8_t _fingerprint(uint64_t hash) { return static_cast<uint8_t>(hash ^ (hash >> 32)); }
+
+    static uint32_t _mulhi(uint64_t a, uint64_t b) {
+        return static_cast<uint32_t>((static_cast<__uint128_t>(a) * b) >> 64);
+    }
+
+    // The |index|-th position of the mixed |hash|, the same as the ones in test_hash().
+    uint32_t _position(int index, uint64_t hash) const {
+        uint32_t h = _mulhi(hash, _segment_count_length) + index * _segment_length;
+        // index 0: no xor; index 1: xor (hash >> 18); index 2: xor hash
+        if (index == 1) {
+            h ^= static_cast<uint32_t>(hash >> 18) & _segment_length_mask;
+        } else if (index == 2) {
+            h ^= static_cast<uint32_t>(hash) & _segment_length_mask;
+        }
+        return h;
+    }
+
+    void _allocate(uint32_t size);
+
+    bool _built = false;
+    uint64_t _seed = 0;
+    uint32_t _segment_length = 0;
+    uint32_t _segment_length_mask = 0;
+    uint32_t _segment_count_length = 0;
+    std::vector<uint8_t> _fingerprints;
+    // the hashes added before the filter is built
+    std::vector<uint64_t> _hashes;
+};
+
+} // namespace starrocks
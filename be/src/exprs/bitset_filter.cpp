@@ -0,0 +1,162 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/bitset_filter.h"
+
+#include <cstring>
+#include <limits>
+
+namespace starrocks {
+
+bool BitsetFilter::reserve(int64_t value, uint64_t max_bits) {
+    if (covers(value)) {
+        return true;
+    }
+    int64_t lo = empty() ? value : std::min(value, min_value());
+    int64_t hi = empty() ? value : std::max(value, max_value());
+    const uint64_t max_words = _max_words(max_bits);
+    const uint64_t num_words = _num_words(lo, hi);
+    if (num_words > max_words) {
+        return false;
+    }
+    if (!empty()) {
+        // reserve as many words again towards the direction of the growth, without exceeding max_bits
+        constexpr int64_t kMinValue = std::numeric_limits<int64_t>::min();
+        constexpr int64_t kMaxValue = std::numeric_limits<int64_t>::max();
+        const uint64_t extra = std::min(num_words, max_words - num_words) * 64;
+        if (value > max_value()) {
+            const uint64_t room = static_cast<uint64_t>(kMaxValue) - static_cast<uint64_t>(hi);
+            hi = room < extra ? kMaxValue : static_cast<int64_t>(static_cast<uint64_t>(hi) + extra);
+        } else {
+            const uint64_t room = static_cast<uint64_t>(lo) - static_cast<uint64_t>(kMinValue);
+            lo = room < extra ? kMinValue : static_cast<int64_t>(static_cast<uint64_t>(lo) - extra);
+        }
+    }
+    _resize(lo, hi);
+    return true;
+}
+
+bool BitsetFilter::merge(const BitsetFilter& bf, uint64_t max_bits) {
+    if (bf.empty()) {
+        return true;
+    }
+    if (empty()) {
+        if (bf._words.size() > _max_words(max_bits)) {
+            return false;
+        }
+        _base = bf._base;
+        _words = bf._words;
+        return true;
+    }
+    const int64_t lo = std::min(min_value(), bf.min_value());
+    const int64_t hi = std::max(max_value(), bf.max_value());
+    if (_num_words(lo, hi) > _max_words(max_bits)) {
+        return false;
+    }
+    _resize(lo, hi);
+    const uint64_t offset = _offset(bf._base) >> 6;
+    for (size_t i = 0; i < bf._words.size(); i++) {
+        _words[offset + i] |= bf._words[i];
+    }
+    return true;
+}
+
+void BitsetFilter::shrink_to_fit() {
+    size_t first = 0;
+    while (first < _words.size() && _words[first] == 0) {
+        first++;
+    }
+    if (first == _words.size()) {
+        clear();
+        return;
+    }
+    size_t last = _words.size() - 1;
+    while (_words[last] == 0) {
+        last--;
+    }
+    const auto lo = static_cast<int64_t>(static_cast<uint64_t>(_base) + first * 64);
+    const auto hi = static_cast<int64_t>(static_cast<uint64_t>(_base) + last * 64 + 63);
+    _resize(lo, hi);
+    _words.shrink_to_fit();
+}
+
+size_t BitsetFilter::cardinality() const {
+    size_t count = 0;
+    for (uint64_t word : _words) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+void BitsetFilter::_resize(int64_t min_value, int64_t max_value) {
+    const int64_t base = _align(min_value);
+    std::vector<uint64_t> words(_num_words(min_value, max_value), 0);
+    if (!_words.empty()) {
+        if (base <= _base) {
+            const uint64_t offset = (static_cast<uint64_t>(_base) - static_cast<uint64_t>(base)) >> 6;
+            DCHECK_LE(offset + _words.size(), words.size());
+            std::copy(_words.begin(), _words.end(), words.begin() + offset);
+        } else {
+            const uint64_t offset = _offset(base) >> 6;
+            DCHECK_LE(offset + words.size(), _words.size());
+            std::copy(_words.begin() + offset, _words.begin() + offset + words.size(), words.begin());
+        }
+    }
+    _base = base;
+    _words.swap(words);
+}
+
+size_t BitsetFilter::max_serialized_size() const {
+    return sizeof(_base) + sizeof(uint64_t) + _words.size() * sizeof(uint64_t);
+}
+
+size_t BitsetFilter::serialize(uint8_t* data) const {
+    size_t offset = 0;
+    auto num_words = static_cast<uint64_t>(_words.size());
+#define BITSET_COPY_FIELD(field)                  \
+    memcpy(data + offset, &field, sizeof(field)); \
+    offset += sizeof(field);
+    BITSET_COPY_FIELD(_base);
+    BITSET_COPY_FIELD(num_words);
+#undef BITSET_COPY_FIELD
+    memcpy(data + offset, _words.data(), num_words * sizeof(uint64_t));
+    offset += num_words * sizeof(uint64_t);
+    return offset;
+}
+
+size_t BitsetFilter::deserialize(const uint8_t* data) {
+    size_t offset = 0;
+    uint64_t num_words = 0;
+#define BITSET_COPY_FIELD(field)                  \
+    memcpy(&field, data + offset, sizeof(field)); \
+    offset += sizeof(field);
+    BITSET_COPY_FIELD(_base);
+    BITSET_COPY_FIELD(num_words);
+#undef BITSET_COPY_FIELD
+    _words.resize(num_words);
+    memcpy(_words.data(), data + offset, num_words * sizeof(uint64_t));
+    offset += num_words * sizeof(uint64_t);
+    return offset;
+}
+
+bool BitsetFilter::check_equal(const BitsetFilter& bf) const {
+    return _base == bf._base && _words == bf._words;
+}
+
+void BitsetFilter::clear() {
+    _base = 0;
+    std::vector<uint64_t>().swap(_words);
+}
+
+} // namespace starrocks
@@ -0,0 +1,107 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glog/logging.h"
+
+namespace starrocks {
+
+// BitsetFilter is an exact filter of the integers in a dense range, which keeps one bit for each integer of
+// [min_value(), max_value()]. It has no false positive, and it's cheaper to test than a bloom filter, so it's
+// used by the runtime filters of the integer join keys, i.e. surrogate keys and date ids, if their range is small.
+//
+// The range is aligned to 64 bits, and it grows while the values are inserted, see reserve().
+class BitsetFilter {
+public:
+    BitsetFilter() = default;
+
+    bool empty() const { return _words.empty(); }
+    size_t num_bits() const { return _words.size() * 64; }
+    int64_t min_value() const { return _base; }
+    int64_t max_value() const { return static_cast<int64_t>(static_cast<uint64_t>(_base) + num_bits() - 1); }
+
+    bool covers(int64_t value) const { return _offset(value) < num_bits(); }
+
+    // Extend the range to cover |value|, return false if the range needs more than |max_bits| bits.
+    // The range is extended by its width more than required, to amortize the copies of the ascending or
+    // descending values.
+    bool reserve(int64_t value, uint64_t max_bits);
+
+    // REQUIRE: covers(value)
+    void insert(int64_t value) {
+        DCHECK(covers(value));
+        const uint64_t offset = _offset(value);
+        _words[offset >> 6] |= UINT64_C(1) << (offset & 63);
+    }
+
+    bool test(int64_t value) const noexcept {
+        const uint64_t offset = _offset(value);
+        return offset < num_bits() && ((_words[offset >> 6] >> (offset & 63)) & 1);
+    }
+
+    // Union the values of |bf|. Return false and keep this filter unchanged if the union needs more than
+    // |max_bits| bits.
+    bool merge(const BitsetFilter& bf, uint64_t max_bits);
+
+    // Shrink the range to the smallest one that holds all the values.
+    void shrink_to_fit();
+
+    size_t cardinality() const;
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (size_t i = 0; i < _words.size(); i++) {
+            uint64_t word = _words[i];
+            while (word != 0) {
+                const uint64_t offset = i * 64 + __builtin_ctzll(word);
+                func(static_cast<int64_t>(static_cast<uint64_t>(_base) + offset));
+                word &= word - 1;
+            }
+        }
+    }
+
+    size_t max_serialized_size() const;
+    size_t serialize(uint8_t* data) const;
+    size_t deserialize(const uint8_t* data);
+    bool check_equal(const BitsetFilter& bf) const;
+
+    void clear();
+    size_t get_alloc_size() const { return _words.capacity() * sizeof(uint64_t); }
+
+private:
+    uint64_t _offset(int64_t value) const { return static_cast<uint64_t>(value) - static_cast<uint64_t>(_base); }
+
+    static int64_t _align(int64_t value) { return value & ~INT64_C(63); }
+    // The number of the words to cover [min_value, max_value].
+    static uint64_t _num_words(int64_t min_value, int64_t max_value) {
+        return ((static_cast<uint64_t>(max_value) - static_cast<uint64_t>(_align(min_value))) >> 6) + 1;
+    }
+    static uint64_t _max_words(uint64_t max_bits) { return std::max<uint64_t>(max_bits / 64, 1); }
+
+    // Resize the range to [min_value, max_value], the values in the new range are kept.
+    // REQUIRE: the new range contains the current range, or is contained by it.
+    void _resize(int64_t min_value, int64_t max_value);
+
+    // the first value of the range, which is aligned to 64
+    int64_t _base = 0;
+    std::vector<uint64_t> _words;
+};
+
+} // namespace starrocks
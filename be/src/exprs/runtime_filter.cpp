@@ -14,6 +14,8 @@
 
 #include "exprs/runtime_filter.h"
 
+#include "common/config.h"
+#include "runtime/current_thread.h"
 #include "types/logical_type_infra.h"
 #include "util/compression/stream_compression.h"
 
@@ -54,14 +56,77 @@ void SimdBlockFilter::init(size_t nums) {
     memset(_directory, 0, alloc_size);
 }
 
+void SimdBlockFilter::init_binary_fuse() {
+    _fuse_filter = std::make_unique<BinaryFuseFilter>();
+}
+
+// The memory of building the binary fuse filter is consumed by the mem tracker of the current thread, i.e. the one of
+// the join, so the bloom filter is used instead if it would exceed the limit.
+static bool exceed_mem_limit(size_t bytes) {
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    return mem_tracker != nullptr && mem_tracker->any_limit_exceeded_precheck(static_cast<int64_t>(bytes));
+}
+
+bool SimdBlockFilter::should_use_binary_fuse(size_t nums) {
+    const int64_t min_rows = config::runtime_filter_binary_fuse_min_rows;
+    const int64_t max_rows = config::runtime_filter_binary_fuse_max_rows;
+    if (min_rows < 0 || nums < static_cast<size_t>(min_rows)) {
+        return false;
+    }
+    if (max_rows >= 0 && nums > static_cast<size_t>(max_rows)) {
+        return false;
+    }
+    return !exceed_mem_limit(nums * sizeof(uint64_t) + BinaryFuseFilter::build_bytes(nums));
+}
+
+void SimdBlockFilter::finish_build() {
+    if (_fuse_filter == nullptr || _fuse_filter->built()) {
+        return;
+    }
+    // the hashes may be more than expected, e.g. the unfinished filters of several partitions are merged
+    const size_t num_hashes = _fuse_filter->hashes().size();
+    const int64_t max_rows = config::runtime_filter_binary_fuse_max_rows;
+    const bool too_large = (max_rows >= 0 && num_hashes > static_cast<size_t>(max_rows)) ||
+                           exceed_mem_limit(BinaryFuseFilter::build_bytes(num_hashes));
+    if (!too_large && _fuse_filter->build()) {
+        return;
+    }
+    // fall back to the bloom filter
+    std::unique_ptr<BinaryFuseFilter> fuse_filter = std::move(_fuse_filter);
+    init(fuse_filter->hashes().size());
+    for (uint64_t hash : fuse_filter->hashes()) {
+        insert_hash(hash);
+    }
+}
+
 SimdBlockFilter::SimdBlockFilter(SimdBlockFilter&& bf) noexcept {
     _log_num_buckets = bf._log_num_buckets;
     _directory_mask = bf._directory_mask;
     _directory = bf._directory;
     bf._directory = nullptr;
+    _fuse_filter = std::move(bf._fuse_filter);
+}
+
+SimdBlockFilter& SimdBlockFilter::operator=(SimdBlockFilter&& bf) noexcept {
+    if (this != &bf) {
+        if (_directory) free(_directory);
+        _log_num_buckets = bf._log_num_buckets;
+        _directory_mask = bf._directory_mask;
+        _directory = bf._directory;
+        bf._directory = nullptr;
+        _fuse_filter = std::move(bf._fuse_filter);
+    }
+    return *this;
 }
 
+// The binary fuse filter is serialized as |kBinaryFuseMark| | BinaryFuseFilter |, the mark is at the place of
+// _log_num_buckets of the bloom filter, which is never negative.
+static constexpr int kBinaryFuseMark = -1;
+
 size_t SimdBlockFilter::max_serialized_size() const {
+    if (_fuse_filter != nullptr) {
+        return sizeof(kBinaryFuseMark) + _fuse_filter->max_serialized_size();
+    }
     const size_t alloc_size = _directory == nullptr ? 0 : get_alloc_size();
     return sizeof(_log_num_buckets) + sizeof(_directory_mask) + // data size + max data size
            sizeof(int32_t) + alloc_size;
@@ -69,6 +134,12 @@ size_t SimdBlockFilter::max_serialized_size() const {
 
 size_t SimdBlockFilter::serialize(uint8_t* data) const {
     size_t offset = 0;
+    if (_fuse_filter != nullptr) {
+        DCHECK(_fuse_filter->built());
+        memcpy(data + offset, &kBinaryFuseMark, sizeof(kBinaryFuseMark));
+        offset += sizeof(kBinaryFuseMark);
+        return offset + _fuse_filter->serialize(data + offset);
+    }
 #define SIMD_BF_COPY_FIELD(field)                 \
     memcpy(data + offset, &field, sizeof(field)); \
     offset += sizeof(field);
@@ -94,6 +165,11 @@ size_t SimdBlockFilter::deserialize(const uint8_t* data) {
     memcpy(&field, data + offset, sizeof(field)); \
     offset += sizeof(field);
     SIMD_BF_COPY_FIELD(_log_num_buckets);
+    if (_log_num_buckets == kBinaryFuseMark) {
+        _log_num_buckets = 0;
+        _fuse_filter = std::make_unique<BinaryFuseFilter>();
+        return offset + _fuse_filter->deserialize(data + offset);
+    }
     SIMD_BF_COPY_FIELD(_directory_mask);
     SIMD_BF_COPY_FIELD(data_size);
 #undef SIMD_BF_COPY_FIELD
@@ -109,6 +185,10 @@ size_t SimdBlockFilter::deserialize(const uint8_t* data) {
 }
 
 void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
+    if (UNLIKELY(_fuse_filter != nullptr || bf._fuse_filter != nullptr)) {
+        _merge_binary_fuse(bf);
+        return;
+    }
     if (_directory == nullptr || bf._directory == nullptr) {
         return;
     }
@@ -129,6 +209,23 @@ void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
     }
 }
 
+void SimdBlockFilter::_merge_binary_fuse(const SimdBlockFilter& bf) {
+    if (!can_use() || !bf.can_use()) {
+        return;
+    }
+    // the hashes could be merged only if the binary fuse filter is not built yet
+    if (bf._fuse_filter != nullptr && !bf._fuse_filter->built()) {
+        if (_fuse_filter == nullptr || !_fuse_filter->built()) {
+            for (uint64_t hash : bf._fuse_filter->hashes()) {
+                insert_hash(hash);
+            }
+            return;
+        }
+    }
+    // a built binary fuse filter can't be updated, so give up the filter rather than missing the hashes of bf
+    clear();
+}
+
 // For scalar version:
 void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
     for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
@@ -142,12 +239,16 @@ void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
 }
 
 bool SimdBlockFilter::check_equal(const SimdBlockFilter& bf) const {
+    if (_fuse_filter != nullptr || bf._fuse_filter != nullptr) {
+        return _fuse_filter != nullptr && bf._fuse_filter != nullptr && _fuse_filter->check_equal(*bf._fuse_filter);
+    }
     const size_t alloc_size = get_alloc_size();
     return _log_num_buckets == bf._log_num_buckets && _directory_mask == bf._directory_mask &&
            memcmp(_directory, bf._directory, alloc_size) == 0;
 }
 
 void SimdBlockFilter::clear() {
+    _fuse_filter.reset();
     if (_directory) {
         free(_directory);
         _directory = nullptr;
@@ -156,11 +257,17 @@ void SimdBlockFilter::clear() {
     }
 }
 
+// The bitset is serialized as | kBitsetMark | ... | _bitset_num_partitions | BitsetFilter |, the mark is at the place
+// of num_partitions, which is never so large.
+static constexpr size_t kBitsetMark = std::numeric_limits<size_t>::max();
+
 size_t JoinRuntimeFilter::max_serialized_size() const {
     // todo(yan): noted that it's not serialize compatible with 32-bit and 64-bit.
     auto num_partitions = _hash_partition_bf.size();
     size_t size = sizeof(_has_null) + sizeof(_size) + sizeof(num_partitions) + sizeof(_join_mode);
-    if (num_partitions == 0) {
+    if (!_bitset.empty()) {
+        size += sizeof(_bitset_num_partitions) + _bitset.max_serialized_size();
+    } else if (num_partitions == 0) {
         size += _bf.max_serialized_size();
     } else {
         for (const auto& bf : _hash_partition_bf) {
@@ -172,7 +279,7 @@ size_t JoinRuntimeFilter::max_serialized_size() const {
 
 size_t JoinRuntimeFilter::serialize(int serialize_version, uint8_t* data) const {
     size_t offset = 0;
-    auto num_partitions = _hash_partition_bf.size();
+    auto num_partitions = _bitset.empty() ? _hash_partition_bf.size() : kBitsetMark;
 #define JRF_COPY_FIELD(field)                     \
     memcpy(data + offset, &field, sizeof(field)); \
     offset += sizeof(field);
@@ -180,9 +287,14 @@ size_t JoinRuntimeFilter::serialize(int serialize_version, uint8_t* data) const
     JRF_COPY_FIELD(_size);
     JRF_COPY_FIELD(num_partitions);
     JRF_COPY_FIELD(_join_mode);
+    if (num_partitions == kBitsetMark) {
+        JRF_COPY_FIELD(_bitset_num_partitions);
+    }
 #undef JRF_COPY_FIELD
 
-    if (num_partitions == 0) {
+    if (num_partitions == kBitsetMark) {
+        offset += _bitset.serialize(data + offset);
+    } else if (num_partitions == 0) {
         offset += _bf.serialize(data + offset);
 
     } else {
@@ -203,9 +315,14 @@ size_t JoinRuntimeFilter::deserialize(int serialize_version, const uint8_t* data
     JRF_COPY_FIELD(_size);
     JRF_COPY_FIELD(num_partitions);
     JRF_COPY_FIELD(_join_mode);
+    if (num_partitions == kBitsetMark) {
+        JRF_COPY_FIELD(_bitset_num_partitions);
+    }
 #undef JRF_COPY_FIELD
 
-    if (num_partitions == 0) {
+    if (num_partitions == kBitsetMark) {
+        offset += _bitset.deserialize(data + offset);
+    } else if (num_partitions == 0) {
         offset += _bf.deserialize(data + offset);
     } else {
         for (size_t i = 0; i < num_partitions; i++) {
@@ -224,6 +341,9 @@ bool JoinRuntimeFilter::check_equal(const JoinRuntimeFilter& rf) const {
     bool first = (_has_null == rf._has_null && _size == rf._size && lhs_num_partitions == rhs_num_partitions &&
                   _join_mode == rf._join_mode);
     if (!first) return false;
+    if (!_bitset.empty() || !rf._bitset.empty()) {
+        return _bitset_num_partitions == rf._bitset_num_partitions && _bitset.check_equal(rf._bitset);
+    }
     if (lhs_num_partitions == 0) {
         if (!_bf.check_equal(rf._bf)) return false;
     } else {
@@ -237,6 +357,10 @@ bool JoinRuntimeFilter::check_equal(const JoinRuntimeFilter& rf) const {
 }
 
 void JoinRuntimeFilter::clear_bf() {
+    // a cleared bitset is not partitioned, the probe side only evaluates min/max in both cases
+    _bitset.clear();
+    _bitset_max_bits = 0;
+    _bitset_num_partitions = 0;
     if (_hash_partition_bf.empty()) {
         _bf.clear();
     } else {
@@ -247,4 +371,69 @@ void JoinRuntimeFilter::clear_bf() {
     _size = 0;
 }
 
+void JoinRuntimeFilter::finish_build() {
+    if (_bitset_max_bits > 0) {
+        _bitset_max_bits = 0;
+        if (_bitset.empty()) {
+            // no value is inserted, use the bloom filter like the others, so that they could be concatenated
+            _init_bf();
+        } else {
+            _bitset.shrink_to_fit();
+        }
+    }
+    if (_bitset.empty() && _hash_partition_bf.empty()) {
+        _bf.finish_build();
+    }
+    for (auto& bf : _hash_partition_bf) {
+        bf.finish_build();
+    }
+}
+
+bool JoinRuntimeFilter::has_binary_fuse() const {
+    if (_hash_partition_bf.empty()) {
+        return _bf.is_binary_fuse();
+    }
+    return std::any_of(_hash_partition_bf.begin(), _hash_partition_bf.end(),
+                       [](const SimdBlockFilter& bf) { return bf.is_binary_fuse(); });
+}
+
+void JoinRuntimeFilter::_init_bf() {
+    if (SimdBlockFilter::should_use_binary_fuse(_size)) {
+        _bf.init_binary_fuse();
+    } else {
+        _bf.init(_size);
+    }
+}
+
+// A bitset takes at most kBitsetMaxBitsPerRow bits for each row, so that it's not much larger than the bloom filter.
+static constexpr uint64_t kBitsetMaxBitsPerRow = 16;
+
+void JoinRuntimeFilter::_init_bitset() {
+    const uint64_t max_bits = _max_bitset_bits();
+    _bitset_max_bits = std::min(max_bits, std::max<uint64_t>(_size, 1) * kBitsetMaxBitsPerRow);
+}
+
+uint64_t JoinRuntimeFilter::_max_bitset_bits() {
+    return std::max<int64_t>(config::runtime_filter_bitset_max_bits, 0);
+}
+
+void JoinRuntimeFilter::_merge_bitset(const JoinRuntimeFilter* rf) {
+    const bool has_no_value = _bitset.empty() && _bitset_max_bits > 0;
+    if (!rf->_bitset.empty()) {
+        if ((has_no_value || !_bitset.empty()) && _bitset.merge(rf->_bitset, _max_bitset_bits())) {
+            return;
+        }
+    } else if (rf->_bitset_max_bits > 0) {
+        // rf has no value
+        return;
+    } else if (has_no_value) {
+        _bitset_max_bits = 0;
+        _init_bf();
+        _bf.merge(rf->_bf);
+        return;
+    }
+    // a bitset can't be merged with a bloom filter, give up the filters but keep min/max
+    clear_bf();
+}
+
 } // namespace starrocks
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <memory>
 #include <numeric>
 
 #include "column/chunk.h"
@@ -26,6 +27,8 @@
 #include "common/global_types.h"
 #include "common/object_pool.h"
 #include "exec/pipeline/exchange/shuffler.h"
+#include "exprs/binary_fuse_filter.h"
+#include "exprs/bitset_filter.h"
 #include "exprs/runtime_filter_layout.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gen_cpp/Types_types.h"
@@ -35,9 +38,12 @@ namespace starrocks {
 // 0x1. initial global runtime filter impl
 // 0x2. change simd-block-filter hash function.
 // 0x3. Fix serialize problem
+// 0x4. binary fuse filter and bitset filter, only used when the filter contains them
 inline const constexpr uint8_t RF_VERSION = 0x2;
 inline const constexpr uint8_t RF_VERSION_V2 = 0x3;
+inline const constexpr uint8_t RF_VERSION_V3 = 0x4;
 static_assert(sizeof(RF_VERSION_V2) == sizeof(RF_VERSION));
+static_assert(sizeof(RF_VERSION_V3) == sizeof(RF_VERSION));
 inline const constexpr int32_t RF_VERSION_SZ = sizeof(RF_VERSION_V2);
 
 // compatible code from 2.5 to 3.0
@@ -95,6 +101,9 @@ static constexpr uint32_t SALT[8] = {0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b72
 
 // Modify from https://github.com/FastFilter/fastfilter_cpp/blob/master/src/bloom/simd-block.h
 // This is avx2 simd implementation for paper <<Cache-, Hash- and Space-Efficient Bloom Filters>>
+//
+// If it's initialized by init_binary_fuse(), a BinaryFuseFilter is used instead of the bloom filter, which is
+// denser for the large build sides, and it's built by finish_build() after all the hashes are inserted.
 class SimdBlockFilter {
 public:
     // The filter is divided up into Buckets:
@@ -110,10 +119,25 @@ public:
 
     SimdBlockFilter(const SimdBlockFilter& bf) = delete;
     SimdBlockFilter(SimdBlockFilter&& bf) noexcept;
+    SimdBlockFilter& operator=(SimdBlockFilter&& bf) noexcept;
 
     void init(size_t nums);
+    void init_binary_fuse();
+    // Whether to use a binary fuse filter rather than a bloom filter for |nums| elements, decided by
+    // config::runtime_filter_binary_fuse_min_rows and runtime_filter_binary_fuse_max_rows, and the memory limit.
+    static bool should_use_binary_fuse(size_t nums);
+
+    // Build the binary fuse filter from the inserted hashes, it falls back to a bloom filter if fails, or if the
+    // hashes are too many to build it.
+    // It's a no-op for bloom filters.
+    void finish_build();
+    bool is_binary_fuse() const { return _fuse_filter != nullptr; }
 
     void insert_hash(const uint64_t hash) noexcept {
+        if (UNLIKELY(_fuse_filter != nullptr)) {
+            _fuse_filter->add_hash(hash);
+            return;
+        }
         const uint32_t bucket_idx = hash & _directory_mask;
 #ifdef __AVX2__
         const __m256i mask = make_mask(hash >> _log_num_buckets);
@@ -130,6 +154,10 @@ public:
 
     bool test_hash(const uint64_t hash) const noexcept {
         if (UNLIKELY(_directory == nullptr)) {
+            if (_fuse_filter != nullptr) {
+                DCHECK(_fuse_filter->built()) << "unexpected test_hash on unfinished binary fuse filter";
+                return !_fuse_filter->built() || _fuse_filter->test_hash(hash);
+            }
             DCHECK(false) << "unexpected test_hash on cleared bf";
             return true;
         }
@@ -182,13 +210,18 @@ public:
     // we still send this rf but ignore bloom filter and only keep min/max filter,
     // in this case, we will use clear() to release the memory of bloom filter,
     // we can use can_use() to check if this bloom filter can be used
-    bool can_use() const { return _directory != nullptr; }
+    bool can_use() const { return _directory != nullptr || _fuse_filter != nullptr; }
 
     size_t get_alloc_size() const {
+        if (_fuse_filter != nullptr) {
+            return _fuse_filter->get_alloc_size();
+        }
         return _log_num_buckets == 0 ? 0 : (1ull << (_log_num_buckets + LOG_BUCKET_BYTE_SIZE));
     }
 
 private:
+    void _merge_binary_fuse(const SimdBlockFilter& bf);
+
     // The number of bits to set in a tiny Bloom filter block
 
     // For scalar version:
@@ -236,6 +269,8 @@ private:
     // directory_mask_ is (1 << log_num_buckets_) - 1
     uint32_t _directory_mask = 0;
     Bucket* _directory = nullptr;
+    // not null if the binary fuse filter is used, and _directory is null in this case
+    std::unique_ptr<BinaryFuseFilter> _fuse_filter;
 };
 
 // If size is very small(< 1000), SmallHashSet is faster than SimdBlockFilter
@@ -327,7 +362,20 @@ public:
 
     void clear_bf();
 
+    // Called after all the values are inserted, to build the filters that can't be built incrementally,
+    // i.e. binary fuse filters.
+    void finish_build();
+    bool has_binary_fuse() const;
+
+    // Whether the values are kept in the exact bitset rather than the bloom filters, it's only possible for the
+    // integer keys of a dense range. The bitset holds the values of all the partitions if it's concatenated.
+    bool is_bitset() const { return !_bitset.empty(); }
+    const BitsetFilter& bitset() const { return _bitset; }
+
     bool can_use_bf() const {
+        if (!_bitset.empty()) {
+            return true;
+        }
         if (_hash_partition_bf.empty()) {
             return _bf.can_use();
         }
@@ -335,6 +383,9 @@ public:
     }
 
     size_t bf_alloc_size() const {
+        if (!_bitset.empty()) {
+            return _bitset.get_alloc_size();
+        }
         if (_hash_partition_bf.empty()) {
             return _bf.get_alloc_size();
         }
@@ -356,6 +407,10 @@ public:
 
     virtual void merge(const JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
+        if (UNLIKELY(!_bitset.empty() || !rf->_bitset.empty() || _bitset_max_bits > 0)) {
+            _merge_bitset(rf);
+            return;
+        }
         _bf.merge(rf->_bf);
     }
 
@@ -383,12 +438,26 @@ public:
 protected:
     void _update_version() { _rf_version++; }
 
+    void _init_bf();
+    // Start to insert the values into the bitset, the bloom filter is initialized by _init_bf() instead
+    // if the values turn out to be too sparse.
+    void _init_bitset();
+    // The max bits of the bitset concatenated or merged from the others.
+    static uint64_t _max_bitset_bits();
+    void _merge_bitset(const JoinRuntimeFilter* rf);
+
     bool _has_null = false;
     bool _global = false;
     size_t _size = 0;
     int8_t _join_mode = 0;
     SimdBlockFilter _bf;
     std::vector<SimdBlockFilter> _hash_partition_bf;
+    // The exact bitset used instead of the bloom filters. _bitset_max_bits is the limit of its bits while the values
+    // are being inserted, and 0 if they're not. _bitset_num_partitions is the number of the partitions concatenated
+    // into the bitset, and 0 if it's not concatenated.
+    BitsetFilter _bitset;
+    uint64_t _bitset_max_bits = 0;
+    size_t _bitset_num_partitions = 0;
     bool _always_true = false;
     size_t _rf_version = 0;
     // local colocate filters is local filter we don't have to serialize them
@@ -470,6 +539,9 @@ public:
     using ContainerType = RunTimeProxyContainerType<Type>;
     using SelfType = RuntimeBloomFilter<Type>;
 
+    // the integer keys could be kept in the exact bitset if they are in a dense range
+    static constexpr bool kCanUseBitset = std::is_integral_v<CppType> && sizeof(CppType) <= sizeof(int64_t);
+
     RuntimeBloomFilter() { _init_min_max(); }
     ~RuntimeBloomFilter() override = default;
 
@@ -484,6 +556,7 @@ public:
         auto* p = pool->add(new RuntimeBloomFilter());
         p->_init_full_range();
         p->init(1);
+        p->finish_build();
 
         if constexpr (IsSlice<CppType>) {
             p->_slice_min = val.to_string();
@@ -524,7 +597,13 @@ public:
 
     void init(size_t hash_table_size) override {
         _size = hash_table_size;
-        _bf.init(_size);
+        if constexpr (kCanUseBitset) {
+            _init_bitset();
+            if (_bitset_max_bits > 0) {
+                return;
+            }
+        }
+        _init_bf();
     }
 
     size_t compute_hash(CppType value) const {
@@ -536,7 +615,9 @@ public:
     }
 
     void insert(const CppType& value) {
-        if (LIKELY(_bf.can_use())) {
+        if (_bitset_max_bits > 0) {
+            _insert_bitset(value);
+        } else if (LIKELY(_bf.can_use())) {
             size_t hash = compute_hash(value);
             _bf.insert_hash(hash);
         }
@@ -555,6 +636,9 @@ public:
     bool right_close_interval() const { return _right_close_interval; }
 
     void evaluate(Column* input_column, RunningContext* ctx) const override {
+        if (!_bitset.empty()) {
+            return _t_evaluate<false, true, true>(input_column, ctx);
+        }
         if (!_hash_partition_bf.empty()) {
             return _hash_partition_bf[0].can_use() ? _t_evaluate<true, true>(input_column, ctx)
                                                    : _t_evaluate<true, false>(input_column, ctx);
@@ -580,14 +664,22 @@ public:
     }
 
     void concat(JoinRuntimeFilter* rf) override {
-        JoinRuntimeFilter::concat(rf);
-        _merge_min_max(down_cast<const RuntimeBloomFilter*>(rf));
+        auto* other = down_cast<RuntimeBloomFilter*>(rf);
+        if (!_bitset.empty() || !other->_bitset.empty()) {
+            _concat_bitset(other);
+        } else {
+            JoinRuntimeFilter::concat(rf);
+        }
+        _merge_min_max(other);
     }
 
     std::string debug_string() const override {
         LogicalType ltype = Type;
         std::stringstream ss;
         ss << "RuntimeBF(type = " << ltype << ", bfsize = " << _size << ", has_null = " << _has_null;
+        if (!_bitset.empty()) {
+            ss << ", bitset_bits = " << _bitset.num_bits();
+        }
         if constexpr (std::is_integral_v<CppType> || std::is_floating_point_v<CppType>) {
             if constexpr (!std::is_same_v<CppType, __int128>) {
                 ss << ", _min = " << _min << ", _max = " << _max;
@@ -842,7 +934,89 @@ private:
         }
     }
 
+    void _insert_bitset(CppType value) {
+        if constexpr (kCanUseBitset) {
+            if (LIKELY(_bitset.reserve(value, _bitset_max_bits))) {
+                _bitset.insert(value);
+                return;
+            }
+            // the values are too sparse, move them into the bloom filter
+            _bitset_max_bits = 0;
+            _init_bf();
+            _bitset.for_each([this](int64_t v) { _bf.insert_hash(compute_hash(static_cast<CppType>(v))); });
+            _bitset.clear();
+            _bf.insert_hash(compute_hash(value));
+        }
+    }
+
+    // Move the values of the bitset into the bloom filters, one for each of the partitions concatenated into it.
+    void _bitset_to_bf() {
+        if constexpr (kCanUseBitset) {
+            if (_bitset.empty()) {
+                return;
+            }
+            SimdBlockFilter bf;
+            const size_t num_values = _bitset.cardinality();
+            if (SimdBlockFilter::should_use_binary_fuse(num_values)) {
+                bf.init_binary_fuse();
+            } else {
+                bf.init(num_values);
+            }
+            _bitset.for_each([this, &bf](int64_t v) { bf.insert_hash(compute_hash(static_cast<CppType>(v))); });
+            bf.finish_build();
+            _bitset.clear();
+            _bitset_max_bits = 0;
+            if (_bitset_num_partitions == 0) {
+                _bf = std::move(bf);
+                return;
+            }
+            // every partition has all the values
+            std::vector<uint8_t> buffer(bf.max_serialized_size());
+            bf.serialize(buffer.data());
+            for (size_t i = 1; i < _bitset_num_partitions; i++) {
+                SimdBlockFilter partition_bf;
+                partition_bf.deserialize(buffer.data());
+                _hash_partition_bf.emplace_back(std::move(partition_bf));
+            }
+            _hash_partition_bf.emplace_back(std::move(bf));
+            _bitset_num_partitions = 0;
+        }
+    }
+
+    // A bitset holds the values of all the partitions, so the bitsets are concatenated by their union,
+    // and they are converted into the bloom filters of the partitions if they can't be unioned.
+    void _concat_bitset(RuntimeBloomFilter* other) {
+        if (!other->_bitset.empty()) {
+            const bool is_first = _bitset.empty() && _hash_partition_bf.empty();
+            if (is_first || (!_bitset.empty() && _bitset.merge(other->_bitset, _max_bitset_bits()))) {
+                if (is_first) {
+                    _bitset = std::move(other->_bitset);
+                }
+                _bitset_num_partitions += std::max<size_t>(other->_bitset_num_partitions, 1);
+                _bitset_max_bits = 0;
+                _has_null |= other->_has_null;
+                _join_mode = other->_join_mode;
+                _size += other->_size;
+                return;
+            }
+        }
+        _bitset_to_bf();
+        other->_bitset_to_bf();
+        JoinRuntimeFilter::concat(other);
+    }
+
+    bool _test_bitset(CppType value) const {
+        if constexpr (kCanUseBitset) {
+            return _bitset.test(value);
+        } else {
+            return true;
+        }
+    }
+
     bool _test_data(CppType value) const {
+        if (!_bitset.empty()) {
+            return _test_bitset(value);
+        }
         DCHECK(_bf.can_use());
         size_t hash = compute_hash(value);
         return _bf.test_hash(hash);
@@ -860,11 +1034,13 @@ private:
     }
 
     using HashValues = std::vector<uint32_t>;
-    template <bool hash_partition>
+    template <bool hash_partition, bool use_bitset = false>
     void _rf_test_data(uint8_t* selection, const ContainerType& input_data, const HashValues& hash_values,
                        int idx) const {
         if (selection[idx]) {
-            if constexpr (hash_partition) {
+            if constexpr (use_bitset) {
+                selection[idx] = _test_bitset(input_data[idx]);
+            } else if constexpr (hash_partition) {
                 selection[idx] = _test_data_with_hash(input_data[idx], hash_values[idx]);
             } else {
                 selection[idx] = _test_data(input_data[idx]);
@@ -877,7 +1053,9 @@ private:
     // and for global runtime filter, since it concates multiple runtime filters from partitions
     // so it has multiple `simd-block-filter` and `multi_partition` is true.
     // For more information, you can refers to doc `shuffle-aware runtime filter`.
-    template <bool multi_partition = false, bool can_use_bf = true>
+    // `use_bitset` means the exact bitset is tested instead of `simd-block-filter`, it holds the values of all the
+    // partitions, so `multi_partition` is always false in this case.
+    template <bool multi_partition = false, bool can_use_bf = true, bool use_bitset = false>
     void _t_evaluate(Column* input_column, RunningContext* ctx) const {
         size_t size = input_column->size();
         Filter& _selection_filter = ctx->use_merged_selection ? ctx->merged_selection : ctx->selection;
@@ -897,7 +1075,7 @@ private:
                 const auto& input_data = GetContainer<Type>::get_data(const_column->data_column());
                 _evaluate_min_max(input_data, _selection, 1);
                 if constexpr (can_use_bf) {
-                    _rf_test_data<multi_partition>(_selection, input_data, _hash_values, 0);
+                    _rf_test_data<multi_partition, use_bitset>(_selection, input_data, _hash_values, 0);
                 }
             }
             uint8_t sel = _selection[0];
@@ -913,14 +1091,14 @@ private:
                         _selection[i] = _has_null;
                     } else {
                         if constexpr (can_use_bf) {
-                            _rf_test_data<multi_partition>(_selection, input_data, _hash_values, i);
+                            _rf_test_data<multi_partition, use_bitset>(_selection, input_data, _hash_values, i);
                         }
                     }
                 }
             } else {
                 if constexpr (can_use_bf) {
                     for (int i = 0; i < size; ++i) {
-                        _rf_test_data<multi_partition>(_selection, input_data, _hash_values, i);
+                        _rf_test_data<multi_partition, use_bitset>(_selection, input_data, _hash_values, i);
                     }
                 }
             }
@@ -929,7 +1107,7 @@ private:
             _evaluate_min_max(input_data, _selection, size);
             if constexpr (can_use_bf) {
                 for (int i = 0; i < size; ++i) {
-                    _rf_test_data<multi_partition>(_selection, input_data, _hash_values, i);
+                    _rf_test_data<multi_partition, use_bitset>(_selection, input_data, _hash_values, i);
                 }
             }
         }
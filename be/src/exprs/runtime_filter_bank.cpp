@@ -60,6 +60,10 @@ size_t RuntimeFilterHelper::max_runtime_filter_serialized_size(const JoinRuntime
 }
 
 size_t RuntimeFilterHelper::serialize_runtime_filter(int rf_version, const JoinRuntimeFilter* rf, uint8_t* data) {
+    // the BEs that don't know binary fuse filters or bitset filters skip the filter by the version
+    if (rf->has_binary_fuse() || rf->is_bitset()) {
+        rf_version = RF_VERSION_V3;
+    }
     size_t offset = 0;
     // put version at the head.
     memcpy(data + offset, &rf_version, RF_VERSION_SZ);
@@ -86,7 +90,7 @@ int RuntimeFilterHelper::deserialize_runtime_filter(ObjectPool* pool, JoinRuntim
     uint8_t version = 0;
     memcpy(&version, data, sizeof(version));
     offset += sizeof(version);
-    if (version != RF_VERSION && version != RF_VERSION_V2) {
+    if (version != RF_VERSION && version != RF_VERSION_V2 && version != RF_VERSION_V3) {
         // version mismatch and skip this chunk.
         LOG(WARNING) << "unrecognized version:" << version;
         return 0;
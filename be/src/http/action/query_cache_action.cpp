@@ -21,6 +21,7 @@
 #include <string>
 
 #include "common/logging.h"
+#include "exec/query_cache/disk_cache.h"
 #include "gutil/strings/substitute.h"
 #include "http/http_channel.h"
 #include "http/http_headers.h"
@@ -85,6 +86,11 @@ void QueryCacheAction::_handle_stat(HttpRequest* req) {
         root.AddMember("lookup_count", rapidjson::Value(lookup_count), allocator);
         root.AddMember("hit_count", rapidjson::Value(hit_count), allocator);
         root.AddMember("hit_ratio", rapidjson::Value(hit_ratio), allocator);
+        if (auto* disk_cache = cache_mgr->disk_cache(); disk_cache != nullptr) {
+            root.AddMember("disk_capacity", rapidjson::Value(disk_cache->capacity()), allocator);
+            root.AddMember("disk_usage", rapidjson::Value(disk_cache->usage()), allocator);
+            root.AddMember("disk_hit_count", rapidjson::Value(cache_mgr->disk_hit_count()), allocator);
+        }
     });
 }
 
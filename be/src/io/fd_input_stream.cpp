@@ -14,6 +14,7 @@
 
 #include "io/fd_input_stream.h"
 
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -89,6 +90,16 @@ StatusOr<int64_t> FdInputStream::read(void* data, int64_t count) {
     return res;
 }
 
+Status FdInputStream::prefetch(int64_t offset, int64_t count) {
+    CHECK_IS_CLOSED(_is_closed);
+    // POSIX_FADV_WILLNEED starts the readahead of the range and returns without waiting for it.
+    int res = ::posix_fadvise(_fd, offset, count, POSIX_FADV_WILLNEED);
+    if (res != 0) {
+        return io_error("posix_fadvise", res);
+    }
+    return Status::OK();
+}
+
 StatusOr<int64_t> FdInputStream::get_size() {
     CHECK_IS_CLOSED(_is_closed);
     struct stat st;
@@ -32,6 +32,9 @@ public:
 
     StatusOr<int64_t> read(void* data, int64_t count) override;
 
+    // Advise the kernel to read the range into the page cache in the background.
+    Status prefetch(int64_t offset, int64_t count) override;
+
     StatusOr<int64_t> get_size() override;
 
     StatusOr<int64_t> position() override { return _offset; }
@@ -57,6 +60,8 @@ public:
     // Otherwise, this is zero.
     int get_errno() const { return _errno; }
 
+    int fd() const { return _fd; }
+
 private:
     int _fd;
     int _errno;
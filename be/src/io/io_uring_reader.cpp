@@ -0,0 +1,365 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/io_uring_reader.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <thread>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define STARROCKS_HAVE_IO_URING 1
+#endif
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/macros.h"
+#include "io/io_error.h"
+#include "io/io_profiler.h"
+#include "util/failpoint/fail_point.h"
+#include "util/stopwatch.hpp"
+
+namespace starrocks::io {
+
+Status IoUringReader::pread(const std::vector<Request>& requests) {
+    for (const Request& request : requests) {
+        MonotonicStopWatch watch;
+        watch.start();
+        auto* data = static_cast<char*>(request.data);
+        int64_t offset = request.offset;
+        int64_t remaining = request.count;
+        while (remaining > 0) {
+            ssize_t res;
+            RETRY_ON_EINTR(res, ::pread(request.fd, data, remaining, offset));
+            if (UNLIKELY(res < 0)) {
+                return io_error("pread", errno);
+            }
+            if (UNLIKELY(res == 0)) {
+                return Status::EndOfFile("reached the end of file");
+            }
+            data += res;
+            offset += res;
+            remaining -= res;
+        }
+        IOProfiler::add_read(request.count, watch.elapsed_time());
+    }
+    return Status::OK();
+}
+
+#ifdef STARROCKS_HAVE_IO_URING
+
+DEFINE_FAIL_POINT(io_uring_enter_failed);
+
+// A minimal io_uring of a single thread, which only submits IORING_OP_READV (Linux 5.1+) and waits for
+// the completions. It talks to the kernel by the system calls directly, as liburing is not a dependency.
+class IoUring {
+public:
+    ~IoUring() {
+        if (_sqes != nullptr) {
+            munmap(_sqes, _sqes_size);
+        }
+        if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+            munmap(_cq_ring, _cq_ring_size);
+        }
+        if (_sq_ring != nullptr) {
+            munmap(_sq_ring, _sq_ring_size);
+        }
+        if (_fd >= 0) {
+            close(_fd);
+        }
+    }
+
+    // Return errno if failed.
+    int init(uint32_t entries) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        _fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (_fd < 0) {
+            return errno;
+        }
+        _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+        }
+        _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                        IORING_OFF_SQ_RING);
+        if (_sq_ring == MAP_FAILED) {
+            _sq_ring = nullptr;
+            return errno;
+        }
+        if (single_mmap) {
+            _cq_ring = _sq_ring;
+        } else {
+            _cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                            IORING_OFF_CQ_RING);
+            if (_cq_ring == MAP_FAILED) {
+                _cq_ring = nullptr;
+                return errno;
+            }
+        }
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                          IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return errno;
+        }
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<uint8_t*>(_sq_ring);
+        _sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+        _sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        _sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        _sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+        auto* cq = static_cast<uint8_t*>(_cq_ring);
+        _cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        _cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        _cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        _entries = params.sq_entries;
+        return 0;
+    }
+
+    uint32_t entries() const { return _entries; }
+
+    // Queue a read, which is submitted by the next submit_and_wait(). The |iov| must be valid until it completes.
+    void prepare_readv(int fd, const iovec* iov, int64_t offset, uint64_t user_data) {
+        const uint32_t tail = *_sq_tail;
+        const uint32_t idx = tail & _sq_mask;
+        io_uring_sqe* sqe = &_sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->off = offset;
+        sqe->addr = reinterpret_cast<uint64_t>(iov);
+        sqe->len = 1;
+        sqe->user_data = user_data;
+        _sq_array[idx] = idx;
+        __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+        _to_submit++;
+    }
+
+    // Submit the queued reads and wait for at least one completion, return errno if failed.
+    // If it fails, some of the queued reads may not be submitted, see cancel_unsubmitted().
+    int submit_and_wait() {
+        FAIL_POINT_TRIGGER_EXECUTE(io_uring_enter_failed, { return ENOMEM; });
+        while (true) {
+            int res = static_cast<int>(
+                    syscall(__NR_io_uring_enter, _fd, _to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (res >= 0) {
+                _to_submit -= std::min<uint32_t>(res, _to_submit);
+                return 0;
+            }
+            if (errno != EINTR) {
+                return errno;
+            }
+        }
+    }
+
+    // Wait for at least one completion without submitting, return errno if failed.
+    int wait() {
+        while (true) {
+            int res = static_cast<int>(syscall(__NR_io_uring_enter, _fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (res >= 0) {
+                return 0;
+            }
+            if (errno != EINTR) {
+                return errno;
+            }
+        }
+    }
+
+    // Take back the queued reads which are not consumed by the kernel, and call |func| with the user data of each.
+    // The kernel only consumes the submission queue in io_uring_enter, so it's safe to rewind the tail.
+    template <typename Func>
+    void cancel_unsubmitted(Func&& func) {
+        const uint32_t head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+        uint32_t tail = *_sq_tail;
+        while (tail != head) {
+            tail--;
+            func(_sqes[tail & _sq_mask].user_data);
+        }
+        __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+        _to_submit = 0;
+    }
+
+    // Call |func| with the user data and the result of each completion.
+    template <typename Func>
+    void reap(Func&& func) {
+        uint32_t head = *_cq_head;
+        const uint32_t tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = _cqes[head & _cq_mask];
+            func(cqe.user_data, cqe.res);
+            head++;
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    int _fd{-1};
+    uint32_t _entries{0};
+    uint32_t _to_submit{0};
+    void* _sq_ring{nullptr};
+    void* _cq_ring{nullptr};
+    size_t _sq_ring_size{0};
+    size_t _cq_ring_size{0};
+    io_uring_sqe* _sqes{nullptr};
+    size_t _sqes_size{0};
+    uint32_t* _sq_head{nullptr};
+    uint32_t* _sq_tail{nullptr};
+    uint32_t _sq_mask{0};
+    uint32_t* _sq_array{nullptr};
+    uint32_t* _cq_head{nullptr};
+    uint32_t* _cq_tail{nullptr};
+    uint32_t _cq_mask{0};
+    io_uring_cqe* _cqes{nullptr};
+};
+
+static std::atomic<bool> s_io_uring_supported{true};
+
+// Return the ring of the current thread, or nullptr if io_uring is not supported.
+static IoUring* current_ring() {
+    static thread_local std::unique_ptr<IoUring> ring;
+    if (ring != nullptr) {
+        return ring.get();
+    }
+    if (!s_io_uring_supported.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    auto new_ring = std::make_unique<IoUring>();
+    int err = new_ring->init(std::max(1, config::io_uring_queue_depth));
+    if (err != 0) {
+        if (s_io_uring_supported.exchange(false)) {
+            LOG(WARNING) << "io_uring is not supported, fall back to pread: " << std::strerror(err);
+        }
+        return nullptr;
+    }
+    ring = std::move(new_ring);
+    return ring.get();
+}
+
+bool IoUringReader::is_supported() {
+    return current_ring() != nullptr;
+}
+
+Status IoUringReader::read(const std::vector<Request>& requests) {
+    IoUring* ring = current_ring();
+    if (ring == nullptr) {
+        return pread(requests);
+    }
+    MonotonicStopWatch watch;
+    watch.start();
+
+    // the remaining part of each request, which is resubmitted after a short read
+    std::vector<iovec> iovs(requests.size());
+    std::vector<int64_t> offsets(requests.size());
+    std::deque<size_t> pending;
+    int64_t total_bytes = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        iovs[i].iov_base = requests[i].data;
+        iovs[i].iov_len = requests[i].count;
+        offsets[i] = requests[i].offset;
+        total_bytes += requests[i].count;
+        if (requests[i].count > 0) {
+            pending.push_back(i);
+        }
+    }
+
+    Status status;
+    uint32_t in_flight = 0;
+    auto on_complete = [&](uint64_t i, int res) {
+        in_flight--;
+        if (res == -EINTR || res == -EAGAIN) {
+            pending.push_back(i);
+        } else if (res < 0) {
+            status.update(io_error("io_uring read", -res));
+        } else if (res == 0) {
+            status.update(Status::EndOfFile("reached the end of file"));
+        } else if (static_cast<size_t>(res) < iovs[i].iov_len) {
+            iovs[i].iov_base = static_cast<char*>(iovs[i].iov_base) + res;
+            iovs[i].iov_len -= res;
+            offsets[i] += res;
+            pending.push_back(i);
+        }
+    };
+    // whether the rest of the requests are read by pread, because io_uring_enter failed
+    bool fall_back = false;
+    while (!pending.empty() || in_flight > 0) {
+        // stop submitting after any failure, but wait for the ones in flight which write the buffers
+        while (status.ok() && !pending.empty() && in_flight < ring->entries()) {
+            size_t i = pending.front();
+            pending.pop_front();
+            ring->prepare_readv(requests[i].fd, &iovs[i], offsets[i], i);
+            in_flight++;
+        }
+        if (in_flight == 0) {
+            break;
+        }
+        int err = ring->submit_and_wait();
+        if (err != 0) {
+            // e.g. ENOMEM or EAGAIN, take back the reads not submitted yet, and wait for the submitted ones
+            // which write the buffers, then read the rest with pread
+            LOG(WARNING) << "io_uring_enter failed, fall back to pread: " << std::strerror(err);
+            ring->cancel_unsubmitted([&](uint64_t i) {
+                in_flight--;
+                pending.push_back(i);
+            });
+            while (in_flight > 0) {
+                ring->reap(on_complete);
+                if (in_flight > 0 && ring->wait() != 0) {
+                    // the completions are still posted to the ring, just poll it
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            fall_back = true;
+            break;
+        }
+        ring->reap(on_complete);
+    }
+    if (fall_back && status.ok()) {
+        std::vector<Request> remaining;
+        for (size_t i : pending) {
+            remaining.push_back({requests[i].fd, offsets[i], static_cast<int64_t>(iovs[i].iov_len), iovs[i].iov_base});
+            total_bytes -= iovs[i].iov_len;
+        }
+        status = pread(remaining);
+    }
+    IOProfiler::add_read(total_bytes, watch.elapsed_time());
+    return status;
+}
+
+#else
+
+bool IoUringReader::is_supported() {
+    return false;
+}
+
+Status IoUringReader::read(const std::vector<Request>& requests) {
+    return pread(requests);
+}
+
+#endif
+
+} // namespace starrocks::io
@@ -0,0 +1,49 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks::io {
+
+// Reads the ranges of the local files in one batch with io_uring, so that the device serves them
+// concurrently instead of one pread after another.
+//
+// Each thread has its own ring, which is created on the first use. It falls back to pread if io_uring
+// is not supported by the kernel or is forbidden, e.g. by the seccomp profile of a container. If io_uring_enter
+// fails, e.g. with ENOMEM, the reads in flight are drained and the rest of the requests are read with pread.
+class IoUringReader {
+public:
+    struct Request {
+        int fd;
+        int64_t offset;
+        int64_t count;
+        void* data;
+    };
+
+    // Whether io_uring could be used by this process, which is probed once.
+    static bool is_supported();
+
+    // Read all the |requests| fully, return error if any of them fails or reaches the end of the file.
+    static Status read(const std::vector<Request>& requests);
+
+    // Read the |requests| one by one with pread, which is the fallback of read().
+    static Status pread(const std::vector<Request>& requests);
+};
+
+} // namespace starrocks::io
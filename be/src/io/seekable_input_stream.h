@@ -57,6 +57,13 @@ public:
     // ```
     virtual Status read_at_fully(int64_t offset, void* out, int64_t count);
 
+    // Hint that the range [offset, offset + count) is going to be read soon, so that the
+    // implementation could load it in the background before it's read, e.g. into the page
+    // cache of the OS.
+    //
+    // Default implementation does nothing.
+    virtual Status prefetch(int64_t offset, int64_t count) { return Status::OK(); }
+
     // Return the total file size in bytes, or error.
     virtual StatusOr<int64_t> get_size() = 0;
 
@@ -126,6 +133,8 @@ public:
         return _impl->read_at_fully(offset, out, count);
     }
 
+    Status prefetch(int64_t offset, int64_t count) override { return _impl->prefetch(offset, count); }
+
     StatusOr<int64_t> get_size() override { return _impl->get_size(); }
 
     Status seek(int64_t offset) override { return _impl->seek(offset); }
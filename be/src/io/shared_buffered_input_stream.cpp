@@ -18,6 +18,7 @@
 
 #include "common/config.h"
 #include "gutil/strings/fastmem.h"
+#include "io/fd_input_stream.h"
 #include "runtime/current_thread.h"
 #include "util/runtime_profile.h"
 
@@ -232,6 +233,32 @@ Status SharedBufferedInputStream::get_bytes(const uint8_t** buffer, size_t offse
     return Status::OK();
 }
 
+Status SharedBufferedInputStream::collect_unread_buffers(const std::vector<IORange>& ranges,
+                                                         std::vector<IoUringReader::Request>* requests) {
+    auto* fd_stream = dynamic_cast<FdInputStream*>(_stream.get());
+    if (fd_stream == nullptr) {
+        return Status::OK();
+    }
+    for (const IORange& r : ranges) {
+        for (auto iter = _map.upper_bound(r.offset); iter != _map.end() && iter->second->offset < r.offset + r.size;
+             ++iter) {
+            SharedBuffer& sb = *iter->second;
+            if (sb.buffer.capacity() != 0) {
+                continue;
+            }
+            RETURN_IF_ERROR(CurrentThread::mem_tracker()->check_mem_limit("read into shared buffer"));
+            _shared_io_count += 1;
+            _shared_io_bytes += sb.size;
+            if (sb.size > sb.raw_size) {
+                _shared_align_io_bytes += sb.size - sb.raw_size;
+            }
+            sb.buffer.reserve(sb.size);
+            requests->push_back({fd_stream->fd(), sb.offset, sb.size, sb.buffer.data()});
+        }
+    }
+    return Status::OK();
+}
+
 void SharedBufferedInputStream::release() {
     _map.clear();
 }
@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "common/status.h"
+#include "io/io_uring_reader.h"
 #include "io/seekable_input_stream.h"
 
 namespace starrocks::io {
@@ -62,6 +63,7 @@ public:
     StatusOr<int64_t> position() override { return _offset; }
     StatusOr<int64_t> read(void* data, int64_t count) override;
     Status read_at_fully(int64_t offset, void* out, int64_t count) override;
+    Status prefetch(int64_t offset, int64_t count) override { return _stream->prefetch(offset, count); }
     StatusOr<int64_t> get_size() override;
     Status skip(int64_t count) override {
         _offset += count;
@@ -78,6 +80,11 @@ public:
     }
 
     Status set_io_ranges(const std::vector<IORange>& ranges, bool coalesce_lazy_column = true);
+    // Append the requests to read the shared buffers overlapping |ranges| which have not been read to
+    // |requests|, so that the shared buffers of several streams could be read in one batch by IoUringReader.
+    // The buffers are regarded as read after that, so the caller must issue the requests before reading from
+    // this stream. Do nothing if the underlying stream is not a local file.
+    Status collect_unread_buffers(const std::vector<IORange>& ranges, std::vector<IoUringReader::Request>* requests);
     void release_to_offset(int64_t offset);
     void release();
     void set_coalesce_options(const CoalesceOptions& options) { _options = options; }
@@ -542,7 +542,14 @@ Status ExecEnv::init(const std::vector<StorePath>& store_paths, bool as_cn) {
 
     _heartbeat_flags = new HeartbeatFlags();
     auto capacity = std::max<size_t>(config::query_cache_capacity, 4L * 1024 * 1024);
-    _cache_mgr = new query_cache::CacheManager(capacity);
+    _cache_mgr = new query_cache::CacheManager(capacity, cache_evict_policy_or_lru(config::query_cache_evict_policy));
+    if (!config::query_cache_disk_path.empty()) {
+        auto st = _cache_mgr->enable_disk_cache(config::query_cache_disk_path, config::query_cache_disk_capacity,
+                                                config::query_cache_disk_max_pending_bytes);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to enable the disk cache of query cache: " << st;
+        }
+    }
 
     _block_cache = BlockCache::instance();
 
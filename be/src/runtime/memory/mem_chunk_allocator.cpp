@@ -176,16 +176,23 @@ bool MemChunkAllocator::allocate(size_t size, MemChunk* chunk) {
         return ret;
     }
     if (_reserved_bytes > size) {
-        // try to allocate from other core's arena
-        ++core_id;
-        for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                _reserved_bytes.fetch_sub(size);
-                other_core_alloc_count.increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
-                ret = true;
-                return ret;
+        // try to allocate from other core's arena, and prefer the cores on the same NUMA node,
+        // whose free chunks are more likely to be in the local memory.
+        const int numa_node = CpuInfo::get_numa_node_of_core(core_id);
+        for (const bool same_numa_node : {true, false}) {
+            for (int i = 1; i < _arenas.size(); ++i) {
+                const int other_core_id = (core_id + i) % _arenas.size();
+                if ((CpuInfo::get_numa_node_of_core(other_core_id) == numa_node) != same_numa_node) {
+                    continue;
+                }
+                if (_arenas[other_core_id]->pop_free_chunk(size, &chunk->data)) {
+                    _reserved_bytes.fetch_sub(size);
+                    other_core_alloc_count.increment(1);
+                    // reset chunk's core_id to other
+                    chunk->core_id = other_core_id;
+                    ret = true;
+                    return ret;
+                }
             }
         }
     }
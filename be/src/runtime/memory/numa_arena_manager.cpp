@@ -0,0 +1,151 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/memory/numa_arena_manager.h"
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "jemalloc/jemalloc.h"
+#include "util/cpu_info.h"
+
+namespace starrocks {
+
+// The NUMA node bound to the current thread, and the arena used by it before the first binding.
+static thread_local int tls_numa_node = -1;
+static thread_local unsigned tls_default_arena_index = 0;
+
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+// The extent hooks of the arena of a NUMA node. The hooks are the default ones of jemalloc except alloc, which
+// mbind() the newly mapped extent to the node. jemalloc passes the address of hooks to each hook, so it must be
+// the first member.
+struct NumaExtentHooks {
+    extent_hooks_t hooks;
+    extent_hooks_t* default_hooks = nullptr;
+    // The node mask of mbind(), it is prepared in advance since the hook is called inside malloc.
+    std::vector<unsigned long> node_mask;
+};
+
+static constexpr size_t kBitsPerNodeMaskWord = sizeof(unsigned long) * 8;
+
+static void* numa_extent_alloc(extent_hooks_t* extent_hooks, void* new_addr, size_t size, size_t alignment,
+                               bool* zero, bool* commit, unsigned arena_ind) {
+    auto* numa_hooks = reinterpret_cast<NumaExtentHooks*>(extent_hooks);
+    void* addr = numa_hooks->default_hooks->alloc(numa_hooks->default_hooks, new_addr, size, alignment, zero,
+                                                  commit, arena_ind);
+    if (addr != nullptr) {
+        // It's only a placement hint, the allocation still succeeds if mbind() fails.
+        (void)syscall(SYS_mbind, addr, size, MPOL_PREFERRED, numa_hooks->node_mask.data(),
+                      numa_hooks->node_mask.size() * kBitsPerNodeMaskWord, 0);
+    }
+    return addr;
+}
+
+// Replace the extent hooks of the arena with the ones placing its pages on numa_node.
+static bool install_numa_extent_hooks(unsigned arena_index, int numa_node) {
+    const std::string name = "arena." + std::to_string(arena_index) + ".extent_hooks";
+    extent_hooks_t* default_hooks = nullptr;
+    size_t sz = sizeof(default_hooks);
+    if (je_mallctl(name.c_str(), &default_hooks, &sz, nullptr, 0) != 0 || default_hooks == nullptr) {
+        return false;
+    }
+
+    // The hooks are used by the arena until the process exits, so they are never freed.
+    auto* numa_hooks = new NumaExtentHooks();
+    numa_hooks->hooks = *default_hooks;
+    numa_hooks->hooks.alloc = numa_extent_alloc;
+    numa_hooks->default_hooks = default_hooks;
+    numa_hooks->node_mask.assign(numa_node / kBitsPerNodeMaskWord + 1, 0);
+    numa_hooks->node_mask[numa_node / kBitsPerNodeMaskWord] = 1UL << (numa_node % kBitsPerNodeMaskWord);
+
+    auto* new_hooks = &numa_hooks->hooks;
+    if (je_mallctl(name.c_str(), nullptr, nullptr, &new_hooks, sizeof(new_hooks)) != 0) {
+        delete numa_hooks;
+        return false;
+    }
+    return true;
+}
+#endif
+
+NumaArenaManager* NumaArenaManager::instance() {
+    static NumaArenaManager instance;
+    return &instance;
+}
+
+NumaArenaManager::NumaArenaManager() {
+    if (config::pipeline_enable_numa_aware_placement) {
+        _create_arenas(CpuInfo::get_max_num_numa_nodes());
+    }
+}
+
+void NumaArenaManager::_create_arenas(int num_numa_nodes) {
+#if defined(ADDRESS_SANITIZER) || defined(LEAK_SANITIZER) || defined(THREAD_SANITIZER)
+    return;
+#else
+    if (num_numa_nodes <= 1) {
+        return;
+    }
+
+    std::vector<unsigned> arena_indices;
+    for (int node = 0; node < num_numa_nodes; ++node) {
+        unsigned arena_index = 0;
+        size_t sz = sizeof(arena_index);
+        if (je_mallctl("arenas.create", &arena_index, &sz, nullptr, 0) != 0) {
+            LOG(WARNING) << "Failed to create jemalloc arena for NUMA node " << node
+                         << ", disable NUMA-aware memory allocation";
+            return;
+        }
+        if (!install_numa_extent_hooks(arena_index, node)) {
+            LOG(WARNING) << "Failed to install the extent hooks of jemalloc arena " << arena_index
+                         << " for NUMA node " << node << ", its pages are placed by first touch";
+        }
+        arena_indices.emplace_back(arena_index);
+    }
+    _arena_indices = std::move(arena_indices);
+    LOG(INFO) << "Create jemalloc arenas for " << num_numa_nodes << " NUMA nodes";
+#endif
+}
+
+int NumaArenaManager::next_numa_node() {
+    if (!enabled()) {
+        return -1;
+    }
+    return _next_numa_node.fetch_add(1, std::memory_order_relaxed) % _arena_indices.size();
+}
+
+int NumaArenaManager::bind_current_thread(int numa_node) {
+    const int prev_numa_node = tls_numa_node;
+    if (!enabled() || numa_node == tls_numa_node || numa_node >= num_numa_nodes()) {
+        return prev_numa_node;
+    }
+
+    unsigned old_arena_index = 0;
+    size_t sz = sizeof(old_arena_index);
+    unsigned new_arena_index = numa_node < 0 ? tls_default_arena_index : _arena_indices[numa_node];
+    if (je_mallctl("thread.arena", &old_arena_index, &sz, &new_arena_index, sizeof(new_arena_index)) != 0) {
+        return prev_numa_node;
+    }
+    if (tls_numa_node < 0) {
+        tls_default_arena_index = old_arena_index;
+    }
+    tls_numa_node = numa_node;
+    return prev_numa_node;
+}
+
+} // namespace starrocks
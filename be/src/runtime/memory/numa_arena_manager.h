@@ -0,0 +1,75 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace starrocks {
+
+// NumaArenaManager creates one jemalloc arena for each NUMA node, and binds the allocations of a thread to
+// the arena of a NUMA node. All the allocations of the thread go through the bound arena, including the ones
+// made by MemChunkAllocator and ColumnAllocator, since they both allocate memory from malloc.
+//
+// The threads are not pinned to the CPUs of the node, since an executor thread runs the drivers of all the nodes.
+// Instead, the extent hooks of the arena mbind() the pages it maps with MPOL_PREFERRED, so the pages are placed on
+// the node no matter which CPU first touches them, and fall back to the other nodes when the node is out of memory.
+//
+// It is enabled only when pipeline_enable_numa_aware_placement is true and there are more than one NUMA node.
+class NumaArenaManager {
+public:
+    static NumaArenaManager* instance();
+
+#ifdef BE_TEST
+    explicit NumaArenaManager(int num_numa_nodes) { _create_arenas(num_numa_nodes); }
+#endif
+
+    bool enabled() const { return !_arena_indices.empty(); }
+    int num_numa_nodes() const { return _arena_indices.size(); }
+
+    // Choose the NUMA node for a new fragment instance in round robin. Return -1 if it is disabled.
+    int next_numa_node();
+
+    // Bind the allocations of the current thread to the arena of *numa_node*,
+    // and -1 means to restore the arena used before the first binding.
+    // Return the NUMA node bound before this call.
+    int bind_current_thread(int numa_node);
+
+private:
+    NumaArenaManager();
+
+    void _create_arenas(int num_numa_nodes);
+
+    std::vector<unsigned> _arena_indices;
+    std::atomic<size_t> _next_numa_node = 0;
+};
+
+// Bind the current thread to the arena of a NUMA node in the scope, and restore the former binding at the end.
+// It is used by the threads shared by the fragment instances on different nodes, such as the scan threads.
+class ScopedNumaArenaBinding {
+public:
+    explicit ScopedNumaArenaBinding(int numa_node)
+            : _prev_numa_node(NumaArenaManager::instance()->bind_current_thread(numa_node)) {}
+    ~ScopedNumaArenaBinding() { NumaArenaManager::instance()->bind_current_thread(_prev_numa_node); }
+
+    ScopedNumaArenaBinding(const ScopedNumaArenaBinding&) = delete;
+    ScopedNumaArenaBinding& operator=(const ScopedNumaArenaBinding&) = delete;
+
+private:
+    const int _prev_numa_node;
+};
+
+} // namespace starrocks
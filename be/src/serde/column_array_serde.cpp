@@ -22,6 +22,7 @@
 
 #include "column/array_column.h"
 #include "column/binary_column.h"
+#include "column/column_hash.h"
 #include "column/column_visitor_adapter.h"
 #include "column/const_column.h"
 #include "column/decimalv3_column.h"
@@ -35,9 +36,11 @@
 #include "runtime/descriptors.h"
 #include "serde/protobuf_serde.h"
 #include "types/hll.h"
+#include "util/bit_packing.inline.h"
 #include "util/coding.h"
 #include "util/json.h"
 #include "util/percentile_value.h"
+#include "util/phmap/phmap.h"
 
 namespace starrocks::serde {
 namespace {
@@ -147,22 +150,184 @@ const uint8_t* decode_string_lz4(const uint8_t* buff, void* target, size_t size)
     return buff + encode_size;
 }
 
+// The codec of a column block chosen by the statistics when EncodeContext::enable_encode_adaptive.
+enum AdaptiveCodec : uint8_t {
+    // fall back to the layout without adaptive encoding
+    PLAIN = 0,
+    // frame of reference: the minimum value, the bit width, and the bit packed differences to the minimum
+    BIT_PACK = 1,
+    // the number of runs, and the value and length of each run
+    RLE = 2,
+    // the distinct values, the bit width, and the bit packed codes
+    DICT = 3,
+};
+
+inline int bit_width_of(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+inline size_t bit_packed_size(size_t num_values, int bit_width) {
+    return (num_values * bit_width + 7) / 8;
+}
+
+// Pack the differences of the values to `base` with `bit_width` bits from the lowest bit, which is the layout
+// read by BitPacking::UnpackValues.
+template <typename U>
+uint8_t* bit_pack_values(const U* values, size_t num_values, U base, int bit_width, uint8_t* buff) {
+    if (bit_width == 0) {
+        return buff;
+    }
+    uint64_t buffered = 0;
+    int bit_offset = 0;
+    for (size_t i = 0; i < num_values; i++) {
+        uint64_t value = static_cast<U>(values[i] - base);
+        buffered |= value << bit_offset;
+        bit_offset += bit_width;
+        if (bit_offset >= 64) {
+            buff = write_little_endian_64(buffered, buff);
+            bit_offset -= 64;
+            buffered = bit_offset == 0 ? 0 : value >> (bit_width - bit_offset);
+        }
+    }
+    uint8_t tail[sizeof(uint64_t)];
+    encode_fixed64_le(tail, buffered);
+    return write_raw(tail, (bit_offset + 7) / 8, buff);
+}
+
+template <typename U>
+const uint8_t* bit_unpack_values(const uint8_t* buff, size_t num_values, U base, int bit_width, U* target) {
+    const size_t packed_size = bit_packed_size(num_values, bit_width);
+    int64_t num_read = BitPacking::UnpackValues(bit_width, buff, packed_size, num_values, target).second;
+    if (UNLIKELY(num_read != static_cast<int64_t>(num_values))) {
+        throw std::runtime_error(fmt::format("bit unpack error, expect {} values, but get {} values with width {}.",
+                                             num_values, num_read, bit_width));
+    }
+    if (base != 0) {
+        for (size_t i = 0; i < num_values; i++) {
+            target[i] = static_cast<U>(target[i] + base);
+        }
+    }
+    return buff + packed_size;
+}
+
+template <typename T>
+uint8_t* encode_integers_adaptive(const T* data, size_t num_values, uint8_t* buff) {
+    using U = std::make_unsigned_t<T>;
+    T min_value = data[0];
+    T max_value = data[0];
+    uint32_t num_runs = 1;
+    for (size_t i = 1; i < num_values; i++) {
+        min_value = std::min(min_value, data[i]);
+        max_value = std::max(max_value, data[i]);
+        num_runs += data[i] != data[i - 1];
+    }
+    const int bit_width = bit_width_of(static_cast<U>(static_cast<U>(max_value) - static_cast<U>(min_value)));
+
+    const size_t plain_size = num_values * sizeof(T);
+    const size_t bit_pack_size = sizeof(T) + sizeof(uint8_t) + bit_packed_size(num_values, bit_width);
+    const size_t rle_size = sizeof(uint32_t) + num_runs * (sizeof(T) + sizeof(uint32_t));
+    if (std::min(bit_pack_size, rle_size) >= plain_size * EncodeRatioLimit) {
+        *buff++ = AdaptiveCodec::PLAIN;
+        return buff;
+    }
+
+    if (bit_pack_size <= rle_size) {
+        *buff++ = AdaptiveCodec::BIT_PACK;
+        buff = write_raw(&min_value, sizeof(T), buff);
+        *buff++ = static_cast<uint8_t>(bit_width);
+        buff = bit_pack_values(reinterpret_cast<const U*>(data), num_values, static_cast<U>(min_value), bit_width,
+                               buff);
+    } else {
+        *buff++ = AdaptiveCodec::RLE;
+        buff = write_little_endian_32(num_runs, buff);
+        uint32_t run_length = 1;
+        for (size_t i = 1; i <= num_values; i++) {
+            if (i == num_values || data[i] != data[i - 1]) {
+                buff = write_raw(&data[i - 1], sizeof(T), buff);
+                buff = write_little_endian_32(run_length, buff);
+                run_length = 1;
+            } else {
+                run_length++;
+            }
+        }
+    }
+    VLOG_ROW << fmt::format("raw size = {}, bit pack size = {}, rle size = {}", plain_size, bit_pack_size, rle_size);
+    return buff;
+}
+
+// Return nullptr if the codec is PLAIN, the caller should decode it by the layout without adaptive encoding.
+template <typename T>
+const uint8_t* decode_integers_adaptive(const uint8_t* buff, T* target, size_t num_values) {
+    using U = std::make_unsigned_t<T>;
+    const uint8_t codec = *buff++;
+    if (codec == AdaptiveCodec::PLAIN) {
+        return nullptr;
+    }
+    if (codec == AdaptiveCodec::BIT_PACK) {
+        T min_value;
+        buff = read_raw(buff, &min_value, sizeof(T));
+        const int bit_width = *buff++;
+        return bit_unpack_values(buff, num_values, static_cast<U>(min_value), bit_width, reinterpret_cast<U*>(target));
+    }
+    if (codec == AdaptiveCodec::RLE) {
+        uint32_t num_runs = 0;
+        buff = read_little_endian_32(buff, &num_runs);
+        size_t pos = 0;
+        for (uint32_t i = 0; i < num_runs; i++) {
+            T value;
+            uint32_t run_length = 0;
+            buff = read_raw(buff, &value, sizeof(T));
+            buff = read_little_endian_32(buff, &run_length);
+            if (UNLIKELY(pos + run_length > num_values)) {
+                throw std::runtime_error(fmt::format("rle decode error, runs exceed {} values.", num_values));
+            }
+            std::fill(target + pos, target + pos + run_length, value);
+            pos += run_length;
+        }
+        return buff;
+    }
+    throw std::runtime_error(fmt::format("unknown integer codec {}.", codec));
+}
+
+// The integer codecs are not used for the sorted columns, e.g. the offsets, which are better encoded by delta.
+template <typename T, bool sorted>
+constexpr bool support_adaptive_integers() {
+    return !sorted && std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(uint64_t);
+}
+
 template <typename T, bool sorted>
 class FixedLengthColumnSerde {
 public:
     static int64_t max_serialized_size(const FixedLengthColumnBase<T>& column, const int encode_level) {
         uint32_t size = sizeof(T) * column.size();
+        int64_t codec_size = 0;
+        if constexpr (support_adaptive_integers<T, sorted>()) {
+            codec_size = EncodeContext::enable_encode_adaptive(encode_level) ? sizeof(uint8_t) : 0;
+        }
         if (EncodeContext::enable_encode_integer(encode_level) && size >= ENCODE_SIZE_LIMIT) {
-            return sizeof(uint32_t) + sizeof(uint64_t) +
+            return sizeof(uint32_t) + sizeof(uint64_t) + codec_size +
                    std::max((int64_t)size, (int64_t)streamvbyte_max_compressedbytes(upper_int32(size)));
         } else {
-            return sizeof(uint32_t) + size;
+            return sizeof(uint32_t) + codec_size + size;
         }
     }
 
     static uint8_t* serialize(const FixedLengthColumnBase<T>& column, uint8_t* buff, const int encode_level) {
         uint32_t size = sizeof(T) * column.size();
         buff = write_little_endian_32(size, buff);
+        if constexpr (support_adaptive_integers<T, sorted>()) {
+            if (EncodeContext::enable_encode_adaptive(encode_level)) {
+                if (size >= ENCODE_SIZE_LIMIT) {
+                    uint8_t* codec = buff;
+                    buff = encode_integers_adaptive(column.get_data().data(), column.size(), buff);
+                    if (*codec != AdaptiveCodec::PLAIN) {
+                        return buff;
+                    }
+                } else {
+                    *buff++ = AdaptiveCodec::PLAIN;
+                }
+            }
+        }
         if (EncodeContext::enable_encode_integer(encode_level) && size >= ENCODE_SIZE_LIMIT) {
             if (sizeof(T) == 4 && sorted) { // only support sorted 32-bit integers
                 buff = encode_integers<true>(column.raw_data(), size, buff, encode_level);
@@ -180,6 +345,16 @@ public:
         buff = read_little_endian_32(buff, &size);
         auto& data = column->get_data();
         raw::make_room(&data, size / sizeof(T));
+        if constexpr (support_adaptive_integers<T, sorted>()) {
+            if (EncodeContext::enable_encode_adaptive(encode_level)) {
+                // decode straight into the column
+                const uint8_t* end = decode_integers_adaptive(buff, data.data(), size / sizeof(T));
+                if (end != nullptr) {
+                    return end;
+                }
+                buff += sizeof(uint8_t);
+            }
+        }
         if (EncodeContext::enable_encode_integer(encode_level) && size >= ENCODE_SIZE_LIMIT) {
             if (sizeof(T) == 4 && sorted) { // only support sorted 32-bit integers
                 buff = decode_integers<true>(buff, data.data(), size);
@@ -195,11 +370,20 @@ public:
 
 class BinaryColumnSerde {
 public:
+    // The dictionary is built only if the distinct values of the first kDictSampleRows rows are
+    // less than 1/kDictSampleRatio of them, and it's given up once it has more than kMaxDictSize values.
+    static constexpr size_t kDictSampleRows = 1024;
+    static constexpr size_t kDictSampleRatio = 4;
+    static constexpr size_t kMaxDictSize = 4096;
+
     template <typename T>
     static int64_t max_serialized_size(const BinaryColumnBase<T>& column, const int encode_level) {
         const auto& bytes = column.get_bytes();
         const auto& offsets = column.get_offset();
         int64_t res = sizeof(T) * 2;
+        if (EncodeContext::enable_encode_adaptive(encode_level)) {
+            res += sizeof(uint8_t);
+        }
         int64_t offsets_size = offsets.size() * sizeof(typename BinaryColumnBase<T>::Offset);
         if (EncodeContext::enable_encode_integer(encode_level) && offsets_size >= ENCODE_SIZE_LIMIT) {
             res += sizeof(uint64_t) +
@@ -220,6 +404,14 @@ public:
         const auto& bytes = column.get_bytes();
         const auto& offsets = column.get_offset();
 
+        if (EncodeContext::enable_encode_adaptive(encode_level)) {
+            uint8_t* end = _encode_dict(column, buff);
+            if (end != nullptr) {
+                return end;
+            }
+            *buff++ = AdaptiveCodec::PLAIN;
+        }
+
         T bytes_size = bytes.size() * sizeof(uint8_t);
         if constexpr (std::is_same_v<T, uint32_t>) {
             buff = write_little_endian_32(bytes_size, buff);
@@ -253,6 +445,16 @@ public:
 
     template <typename T>
     static const uint8_t* deserialize(const uint8_t* buff, BinaryColumnBase<T>* column, const int encode_level) {
+        if (EncodeContext::enable_encode_adaptive(encode_level)) {
+            const uint8_t codec = *buff++;
+            if (codec == AdaptiveCodec::DICT) {
+                return _decode_dict(buff, column);
+            }
+            if (UNLIKELY(codec != AdaptiveCodec::PLAIN)) {
+                throw std::runtime_error(fmt::format("unknown string codec {}.", codec));
+            }
+        }
+
         T bytes_size = 0;
         if constexpr (std::is_same_v<T, uint32_t>) {
             buff = read_little_endian_32(buff, &bytes_size);
@@ -284,6 +486,97 @@ public:
         }
         return buff;
     }
+
+private:
+    // Return nullptr if the column is not worth to be encoded by dictionary.
+    template <typename T>
+    static uint8_t* _encode_dict(const BinaryColumnBase<T>& column, uint8_t* buff) {
+        const size_t num_rows = column.size();
+        const size_t raw_size = column.get_bytes().size() + column.get_offset().size() * sizeof(T);
+        if (num_rows == 0 || raw_size < ENCODE_SIZE_LIMIT) {
+            return nullptr;
+        }
+
+        const size_t sample_rows = std::min(num_rows, kDictSampleRows);
+        phmap::flat_hash_map<Slice, uint32_t, SliceHash> dict;
+        std::vector<Slice> values;
+        std::vector<uint32_t> codes(num_rows);
+        size_t dict_bytes = 0;
+        for (size_t i = 0; i < num_rows; i++) {
+            if (i == sample_rows && values.size() * kDictSampleRatio > sample_rows) {
+                return nullptr;
+            }
+            Slice value = column.get_slice(i);
+            auto [iter, inserted] = dict.try_emplace(value, values.size());
+            if (inserted) {
+                if (values.size() == kMaxDictSize) {
+                    return nullptr;
+                }
+                values.emplace_back(value);
+                dict_bytes += value.size;
+            }
+            codes[i] = iter->second;
+        }
+
+        const int bit_width = bit_width_of(values.size() - 1);
+        const size_t dict_size = sizeof(uint32_t) * 2 + values.size() * sizeof(uint32_t) + dict_bytes +
+                                 sizeof(uint8_t) + bit_packed_size(num_rows, bit_width);
+        if (dict_size >= raw_size * EncodeRatioLimit) {
+            return nullptr;
+        }
+        VLOG_ROW << fmt::format("raw size = {}, dict size = {}, distinct values = {}", raw_size, dict_size,
+                                values.size());
+
+        *buff++ = AdaptiveCodec::DICT;
+        buff = write_little_endian_32(num_rows, buff);
+        buff = write_little_endian_32(values.size(), buff);
+        for (const auto& value : values) {
+            buff = write_little_endian_32(value.size, buff);
+        }
+        for (const auto& value : values) {
+            buff = write_raw(value.data, value.size, buff);
+        }
+        *buff++ = static_cast<uint8_t>(bit_width);
+        return bit_pack_values(codes.data(), num_rows, 0u, bit_width, buff);
+    }
+
+    template <typename T>
+    static const uint8_t* _decode_dict(const uint8_t* buff, BinaryColumnBase<T>* column) {
+        uint32_t num_rows = 0;
+        uint32_t num_values = 0;
+        buff = read_little_endian_32(buff, &num_rows);
+        buff = read_little_endian_32(buff, &num_values);
+        std::vector<Slice> values(num_values);
+        const uint8_t* data = buff + num_values * sizeof(uint32_t);
+        for (auto& value : values) {
+            uint32_t size = 0;
+            buff = read_little_endian_32(buff, &size);
+            value = Slice(data, size);
+            data += size;
+        }
+        buff = data;
+        const int bit_width = *buff++;
+        std::vector<uint32_t> codes(num_rows);
+        buff = bit_unpack_values(buff, num_rows, 0u, bit_width, codes.data());
+
+        // decode straight into the offsets and bytes of the column
+        auto& offsets = column->get_offset();
+        raw::make_room(&offsets, num_rows + 1);
+        offsets[0] = 0;
+        for (uint32_t i = 0; i < num_rows; i++) {
+            if (UNLIKELY(codes[i] >= num_values)) {
+                throw std::runtime_error(fmt::format("dict code {} exceeds {} values.", codes[i], num_values));
+            }
+            offsets[i + 1] = offsets[i] + values[codes[i]].size;
+        }
+        auto& bytes = column->get_bytes();
+        bytes.resize(offsets[num_rows]);
+        for (uint32_t i = 0; i < num_rows; i++) {
+            const Slice& value = values[codes[i]];
+            strings::memcpy_inlined(bytes.data() + offsets[i], value.data, value.size);
+        }
+        return buff;
+    }
 };
 
 template <typename T>
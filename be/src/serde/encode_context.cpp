@@ -23,6 +23,8 @@ EncodeContext::EncodeContext(const int col_num, const int encode_level) : _sessi
         _column_encode_level.emplace_back(_session_encode_level);
         _raw_bytes.emplace_back(0);
         _encoded_bytes.emplace_back(0);
+        _total_raw_bytes.emplace_back(0);
+        _total_encoded_bytes.emplace_back(0);
     }
     // the lowest bit is set and other bits are not zero, then enable adjust.
     if (_session_encode_level & 1 && (_session_encode_level >> 1)) {
@@ -31,6 +33,8 @@ EncodeContext::EncodeContext(const int col_num, const int encode_level) : _sessi
 }
 
 void EncodeContext::update(const int col_id, uint64_t mem_bytes, uint64_t encode_byte) {
+    _total_raw_bytes[col_id] += mem_bytes;
+    _total_encoded_bytes[col_id] += encode_byte;
     if (!_enable_adjust) {
         return;
     }
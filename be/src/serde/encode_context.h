@@ -33,6 +33,11 @@ constexpr uint32_t EncodeSamplingNum = 5;
 // EncodeContext adaptively adjusts encode_level according to the compression ratio. In detail,
 // for every _frequency chunks, if the compression ratio for the first EncodeSamplingNum chunks is less than
 // EncodeRatioLimit, then encode the rest chunks, otherwise not.
+//
+// If ENCODE_ADAPTIVE is set, the codec of each column is further chosen by the statistics of the column block
+// being serialized: frame-of-reference bit packing or run-length encoding for integers (including the null
+// flags of nullable columns), and dictionary encoding for low-cardinality strings. The chosen codec is written
+// with the block, so the receiver only needs the encode level to decode it.
 
 class EncodeContext {
 public:
@@ -51,6 +56,11 @@ public:
 
     void set_encode_levels_in_pb(ChunkPB* const res);
 
+    // the total bytes of the column in memory and after being encoded, used to report the saved bytes
+    uint64_t total_raw_bytes(const int col_id) const { return _total_raw_bytes[col_id]; }
+    uint64_t total_encoded_bytes(const int col_id) const { return _total_encoded_bytes[col_id]; }
+    size_t num_columns() const { return _column_encode_level.size(); }
+
     // adjust encode levels for each column,
     // it must be called once after each chunk is encoded
     void adjust_encode_levels();
@@ -61,9 +71,14 @@ public:
 
     static bool enable_encode_string(const int encode_level) { return encode_level & ENCODE_STRING; }
 
+    static bool enable_encode_adaptive(const int encode_level) { return encode_level & ENCODE_ADAPTIVE; }
+
 private:
     static constexpr int ENCODE_INTEGER = 2;
     static constexpr int ENCODE_STRING = 4;
+    // The lz4 acceleration is encoded as encode_level / 10000, which is a multiple of 16, so the bits under 16
+    // are free to be used as flags.
+    static constexpr int ENCODE_ADAPTIVE = 8;
 
     // if encode ratio < EncodeRatioLimit, encode it, otherwise not.
     void _adjust(const int col_id);
@@ -72,6 +87,7 @@ private:
     uint64_t _frequency = 64;
     bool _enable_adjust = false;
     std::vector<uint64_t> _raw_bytes, _encoded_bytes;
+    std::vector<uint64_t> _total_raw_bytes, _total_encoded_bytes;
     std::vector<uint32_t> _column_encode_level;
 };
 } // namespace starrocks::serde
\ No newline at end of file
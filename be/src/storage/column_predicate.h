@@ -79,6 +79,7 @@ enum class PredicateType {
     kExpr = 13,
     kTrue = 14,
     kMap = 15,
+    kRuntimeFilter = 16,
 };
 
 std::ostream& operator<<(std::ostream& os, PredicateType p);
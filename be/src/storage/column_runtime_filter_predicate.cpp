@@ -0,0 +1,117 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/column_runtime_filter_predicate.h"
+
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exprs/runtime_filter.h"
+#include "gutil/casts.h"
+
+namespace starrocks {
+
+ColumnRuntimeFilterPredicate::ColumnRuntimeFilterPredicate(TypeInfoPtr type_info, ColumnId column_id,
+                                                           const JoinRuntimeFilter* rf)
+        : ColumnPredicate(std::move(type_info), column_id), _rf(rf) {}
+
+ColumnRuntimeFilterPredicate* ColumnRuntimeFilterPredicate::create_for_dict_codes(TypeInfoPtr type_info,
+                                                                                  ColumnId column_id,
+                                                                                  const JoinRuntimeFilter* rf,
+                                                                                  const Column* dict_words) {
+    auto* pred = new ColumnRuntimeFilterPredicate(std::move(type_info), column_id, rf);
+    pred->_is_dict_codes = true;
+    pred->_code_mapping.resize(dict_words->size());
+    pred->_evaluate_rows(dict_words, pred->_code_mapping.data());
+    return pred;
+}
+
+void ColumnRuntimeFilterPredicate::_evaluate_rows(const Column* column, uint8_t* selection) const {
+    JoinRuntimeFilter::RunningContext ctx;
+    ctx.use_merged_selection = false;
+    // the runtime filter only reads the column
+    _rf->evaluate(const_cast<Column*>(column), &ctx);
+    memcpy(selection, ctx.selection.data(), column->size());
+}
+
+template <class Op>
+Status ColumnRuntimeFilterPredicate::_evaluate(const Column* column, uint8_t* selection, uint16_t from,
+                                               uint16_t to) const {
+    _tmp_select.resize(to);
+    uint8_t* tmp = _tmp_select.data();
+    if (_is_dict_codes) {
+        const Column* data_column = column;
+        const uint8_t* null_data = nullptr;
+        if (column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            data_column = nullable_column->data_column().get();
+            if (nullable_column->has_null()) {
+                null_data = nullable_column->immutable_null_column_data().data();
+            }
+        }
+        const int32_t* codes = down_cast<const Int32Column*>(data_column)->get_data().data();
+        for (uint16_t i = from; i < to; i++) {
+            DCHECK_LT(codes[i], _code_mapping.size());
+            tmp[i] = _code_mapping[codes[i]];
+        }
+        if (null_data != nullptr) {
+            const uint8_t has_null = _rf->has_null();
+            for (uint16_t i = from; i < to; i++) {
+                tmp[i] = null_data[i] ? has_null : tmp[i];
+            }
+        }
+    } else if (from == 0 && to == column->size()) {
+        _evaluate_rows(column, tmp);
+    } else {
+        auto range = column->clone_empty();
+        range->append(*column, from, to - from);
+        _evaluate_rows(range.get(), tmp + from);
+    }
+    for (uint16_t i = from; i < to; i++) {
+        selection[i] = Op::apply(selection[i], tmp[i]);
+    }
+    return Status::OK();
+}
+
+Status ColumnRuntimeFilterPredicate::evaluate(const Column* column, uint8_t* selection, uint16_t from,
+                                              uint16_t to) const {
+    return _evaluate<ColumnPredicateAssignOp>(column, selection, from, to);
+}
+
+Status ColumnRuntimeFilterPredicate::evaluate_and(const Column* column, uint8_t* selection, uint16_t from,
+                                                  uint16_t to) const {
+    return _evaluate<ColumnPredicateAndOp>(column, selection, from, to);
+}
+
+Status ColumnRuntimeFilterPredicate::evaluate_or(const Column* column, uint8_t* selection, uint16_t from,
+                                                 uint16_t to) const {
+    return _evaluate<ColumnPredicateOrOp>(column, selection, from, to);
+}
+
+Status ColumnRuntimeFilterPredicate::convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                                                ObjectPool* obj_pool) const {
+    return Status::NotSupported("Not support convert runtime filter predicate");
+}
+
+std::string ColumnRuntimeFilterPredicate::debug_string() const {
+    std::stringstream ss;
+    ss << "(ColumnRuntimeFilterPredicate: column_id=" << _column_id << ", dict_codes=" << _is_dict_codes << ", "
+       << _rf->debug_string() << ")";
+    return ss.str();
+}
+
+} // namespace starrocks
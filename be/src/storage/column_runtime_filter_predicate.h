@@ -0,0 +1,71 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "storage/column_predicate.h"
+
+namespace starrocks {
+
+class JoinRuntimeFilter;
+
+// ColumnRuntimeFilterPredicate evaluates a join runtime filter on the rows of a segment, so that the rows are
+// filtered before the other columns are late materialized, instead of after the whole chunk is produced by the scan.
+//
+// The column of a dictionary encoded segment column is read as the codes of its dictionary, and the runtime filter
+// is evaluated on each word of the dictionary only once, see create_for_dict_codes().
+//
+// The runtime filter is evaluated on a whole column, so a range of the column is copied before evaluation, but
+// SegmentIterator always evaluates it on the whole chunk. It's not thread-safe.
+class ColumnRuntimeFilterPredicate final : public ColumnPredicate {
+public:
+    ColumnRuntimeFilterPredicate(TypeInfoPtr type_info, ColumnId column_id, const JoinRuntimeFilter* rf);
+
+    // |dict_words| is the words of the dictionary of the column, the i-th of which is the word of code i.
+    static ColumnRuntimeFilterPredicate* create_for_dict_codes(TypeInfoPtr type_info, ColumnId column_id,
+                                                               const JoinRuntimeFilter* rf, const Column* dict_words);
+
+    Status evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override;
+    Status evaluate_and(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override;
+    Status evaluate_or(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override;
+
+    PredicateType type() const override { return PredicateType::kRuntimeFilter; }
+    bool can_vectorized() const override { return true; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override;
+    std::string debug_string() const override;
+
+    const JoinRuntimeFilter* runtime_filter() const { return _rf; }
+    bool is_dict_codes() const { return _is_dict_codes; }
+
+private:
+    template <class Op>
+    Status _evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const;
+
+    // Evaluate the runtime filter on |column|, the result of i-th row is put in |selection[i]|.
+    void _evaluate_rows(const Column* column, uint8_t* selection) const;
+
+    const JoinRuntimeFilter* _rf;
+    bool _is_dict_codes = false;
+    // the result of the runtime filter on the word of each code, only used if |_is_dict_codes| is true
+    std::vector<uint8_t> _code_mapping;
+    mutable std::vector<uint8_t> _tmp_select;
+};
+
+} // namespace starrocks
@@ -232,11 +232,15 @@ struct OlapReaderStatistics {
     int64_t raw_rows_read = 0;
 
     int64_t rows_vec_cond_filtered = 0;
+    // the part of rows_vec_cond_filtered filtered on the encoded pages before reading the columns
+    int64_t rows_encoded_cond_filtered = 0;
     int64_t vec_cond_ns = 0;
     int64_t vec_cond_evaluate_ns = 0;
     int64_t vec_cond_chunk_copy_ns = 0;
     int64_t branchless_cond_evaluate_ns = 0;
     int64_t expr_cond_evaluate_ns = 0;
+    // The number of times the expr predicates are reordered, see AdaptivePredicateOrder.
+    int64_t expr_cond_reorder_count = 0;
 
     int64_t get_rowsets_ns = 0;
     int64_t get_delvec_ns = 0;
@@ -271,8 +275,13 @@ struct OlapReaderStatistics {
     int64_t rowsets_read_count = 0;
     int64_t segments_read_count = 0;
     int64_t total_columns_data_page_count = 0;
+    // the bytes of the data pages prefetched for the next chunks, see PagePrefetcher
+    int64_t page_prefetch_bytes = 0;
 
     int64_t runtime_stats_filtered = 0;
+    // the rows filtered by the join runtime filters evaluated on the rows, see ColumnRuntimeFilterPredicate
+    int64_t rows_runtime_filter_filtered = 0;
+    int64_t runtime_filter_evaluate_ns = 0;
 
     int64_t read_pk_index_ns = 0;
 
@@ -20,6 +20,7 @@
 
 #include "common/status.h"
 #include "runtime/global_dict/types_fwd_decl.h"
+#include "storage/olap_common.h"
 #include "storage/range.h"
 
 namespace starrocks {
@@ -29,6 +30,7 @@ class RuntimeFilterProbeDescriptor;
 class PredicateParser;
 class ColumnPredicate;
 class RuntimeBloomFilterEvalContext;
+class JoinRuntimeFilter;
 
 struct UnarrivedRuntimeFilterList {
     std::vector<const RuntimeFilterProbeDescriptor*> unarrived_runtime_filters;
@@ -47,6 +49,9 @@ public:
     using PredicatesPtrs = std::vector<std::unique_ptr<ColumnPredicate>>;
     using PredicatesRawPtrs = std::vector<const ColumnPredicate*>;
     using RuntimeFilterArrivedCallBack = std::function<Status(int, const PredicatesRawPtrs&)>;
+    // Called with the column id, the type of the slot and the arrived runtime filter which could be evaluated on the
+    // rows of the column, see runtime_filter_column_ids().
+    using RuntimeFilterArrivedEvaluator = std::function<Status(int, LogicalType, const JoinRuntimeFilter*)>;
     static constexpr auto rf_update_threhold = 4096 * 10;
 
     OlapRuntimeScanRangePruner() = default;
@@ -58,11 +63,16 @@ public:
     void set_predicate_parser(PredicateParser* parser) { _parser = parser; }
 
     Status update_range_if_arrived(const ColumnIdToGlobalDictMap* global_dictmaps,
-                                   RuntimeFilterArrivedCallBack&& updater, size_t raw_read_rows) {
+                                   RuntimeFilterArrivedCallBack&& updater, size_t raw_read_rows,
+                                   RuntimeFilterArrivedEvaluator&& evaluator = nullptr) {
         if (_arrived_runtime_filters_masks.empty()) return Status::OK();
-        return _update(global_dictmaps, std::move(updater), raw_read_rows);
+        return _update(global_dictmaps, std::move(updater), raw_read_rows, std::move(evaluator));
     }
 
+    // The columns of the runtime filters which could be evaluated on the rows of the segments once they arrive,
+    // they are read along with the predicate columns before late materialization.
+    std::vector<ColumnId> runtime_filter_column_ids() const;
+
 private:
     std::vector<const RuntimeFilterProbeDescriptor*> _unarrived_runtime_filters;
     std::vector<const SlotDescriptor*> _slot_descs;
@@ -78,7 +88,12 @@ private:
     PredicatesRawPtrs _as_raw_predicates(const std::vector<std::unique_ptr<ColumnPredicate>>& predicates);
 
     Status _update(const ColumnIdToGlobalDictMap* global_dictmaps, RuntimeFilterArrivedCallBack&& updater,
-                   size_t raw_read_rows);
+                   size_t raw_read_rows, RuntimeFilterArrivedEvaluator&& evaluator);
+
+    // whether the runtime filter could be evaluated on the rows once it arrives
+    bool _is_evaluable(size_t idx) const;
+    // whether the arrived runtime filter is evaluated on the rows
+    bool _can_evaluate(size_t idx, const JoinRuntimeFilter* rf) const;
 
     void _init(const UnarrivedRuntimeFilterList& params);
 };
@@ -16,8 +16,10 @@
 
 #include <cstddef>
 #include <memory>
+#include <set>
 #include <utility>
 
+#include "common/config.h"
 #include "exec/olap_common.h"
 #include "exprs/runtime_filter_bank.h"
 #include "runtime/global_dict/config.h"
@@ -70,11 +72,14 @@ struct RuntimeColumnPredicateBuilder {
                 if (auto iter = global_dictmaps->find(cid); iter != global_dictmaps->end()) {
                     build_minmax_range<RangeType, value_type, LowCardDictType, GlobalDictCodeDecoder>(range, rf,
                                                                                                       iter->second);
+                    build_bitset_values<RangeType, value_type, LowCardDictType, GlobalDictCodeDecoder>(range, rf,
+                                                                                                       iter->second);
                 } else {
                     build_minmax_range<RangeType, value_type, mapping_type, DummyDecoder>(range, rf, nullptr);
                 }
             } else {
                 build_minmax_range<RangeType, value_type, mapping_type, DummyDecoder>(range, rf, nullptr);
+                build_bitset_values<RangeType, value_type, mapping_type, DummyDecoder>(range, rf, nullptr);
             }
 
             std::vector<TCondition> filters;
@@ -165,11 +170,31 @@ struct RuntimeColumnPredicateBuilder {
         auto max_value = parser.max_value();
         (void)range.add_range(max_op, static_cast<value_type>(max_value));
     }
+
+    // The values of an exact bitset filter are pushed down as an IN predicate if they're not too many,
+    // so that the rows could be filtered by the bitmap indexes of the segments.
+    template <class Range, class value_type, LogicalType mapping_type, template <class> class Decoder, class... Args>
+    static void build_bitset_values(Range& range, const JoinRuntimeFilter* rf, Args&&... args) {
+        if constexpr (RuntimeBloomFilter<mapping_type>::kCanUseBitset) {
+            const BitsetFilter& bitset = rf->bitset();
+            if (bitset.empty() || bitset.cardinality() > config::max_pushdown_conditions_per_column) {
+                return;
+            }
+            using CppType = typename RunTimeTypeTraits<mapping_type>::CppType;
+            Decoder<CppType> decoder(std::forward<Args>(args)...);
+            std::set<value_type> values;
+            bitset.for_each([&](int64_t value) {
+                values.insert(static_cast<value_type>(decoder.decode(static_cast<CppType>(value))));
+            });
+            (void)range.add_fixed_values(FILTER_IN, values);
+        }
+    }
 };
 } // namespace detail
 
 inline Status OlapRuntimeScanRangePruner::_update(const ColumnIdToGlobalDictMap* global_dictmaps,
-                                                  RuntimeFilterArrivedCallBack&& updater, size_t raw_read_rows) {
+                                                  RuntimeFilterArrivedCallBack&& updater, size_t raw_read_rows,
+                                                  RuntimeFilterArrivedEvaluator&& evaluator) {
     if (_arrived_runtime_filters_masks.empty()) {
         return Status::OK();
     }
@@ -186,6 +211,10 @@ inline Status OlapRuntimeScanRangePruner::_update(const ColumnIdToGlobalDictMap*
                 if (!raw_predicates.empty()) {
                     RETURN_IF_ERROR(updater(raw_predicates.front()->column_id(), raw_predicates));
                 }
+                if (evaluator != nullptr && _can_evaluate(i, rf)) {
+                    const SlotDescriptor* slot_desc = _slot_descs[i];
+                    RETURN_IF_ERROR(evaluator(_parser->column_id(*slot_desc), slot_desc->type().type, rf));
+                }
                 _arrived_runtime_filters_masks[i] = true;
                 _rf_versions[i] = rf_version;
                 _raw_read_rows = raw_read_rows;
@@ -196,6 +225,28 @@ inline Status OlapRuntimeScanRangePruner::_update(const ColumnIdToGlobalDictMap*
     return Status::OK();
 }
 
+inline std::vector<ColumnId> OlapRuntimeScanRangePruner::runtime_filter_column_ids() const {
+    std::vector<ColumnId> cids;
+    for (size_t i = 0; i < _unarrived_runtime_filters.size(); ++i) {
+        if (_is_evaluable(i)) {
+            cids.push_back(_parser->column_id(*_slot_descs[i]));
+        }
+    }
+    return cids;
+}
+
+// The min/max of the topn runtime filters are updated during the scan, they're only used by the zone maps.
+// The runtime filters partitioned by the shuffle of the join are not evaluated, because the partition of each row
+// is computed from the partition columns, which may not be read by the storage.
+inline bool OlapRuntimeScanRangePruner::_is_evaluable(size_t idx) const {
+    const RuntimeFilterProbeDescriptor* desc = _unarrived_runtime_filters[idx];
+    return !desc->is_topn_filter() && desc->partition_by_expr_contexts()->empty();
+}
+
+inline bool OlapRuntimeScanRangePruner::_can_evaluate(size_t idx, const JoinRuntimeFilter* rf) const {
+    return _is_evaluable(idx) && !rf->always_true() && rf->num_hash_partitions() == 0;
+}
+
 inline auto OlapRuntimeScanRangePruner::_get_predicates(const ColumnIdToGlobalDictMap* global_dictmaps, size_t idx)
         -> StatusOr<PredicatesPtrs> {
     auto rf = _unarrived_runtime_filters[idx]->runtime_filter(_driver_sequence);
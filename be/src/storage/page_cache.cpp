@@ -36,6 +36,7 @@
 
 #include <malloc.h>
 
+#include "common/config.h"
 #include "runtime/current_thread.h"
 #include "runtime/mem_tracker.h"
 #include "util/defer_op.h"
@@ -48,6 +49,8 @@ namespace starrocks {
 METRIC_DEFINE_UINT_GAUGE(page_cache_lookup_count, MetricUnit::OPERATIONS);
 METRIC_DEFINE_UINT_GAUGE(page_cache_hit_count, MetricUnit::OPERATIONS);
 METRIC_DEFINE_UINT_GAUGE(page_cache_capacity, MetricUnit::BYTES);
+METRIC_DEFINE_DOUBLE_GAUGE(page_cache_hit_ratio, MetricUnit::PERCENT);
+METRIC_DEFINE_UINT_GAUGE(page_cache_admission_reject_count, MetricUnit::OPERATIONS);
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
@@ -83,10 +86,26 @@ static void init_metrics() {
     StarRocksMetrics::instance()->metrics()->register_hook("page_cache_capacity", []() {
         page_cache_capacity.set_value(StoragePageCache::instance()->get_capacity());
     });
+
+    StarRocksMetrics::instance()->metrics()->register_metric("page_cache_hit_ratio", &page_cache_hit_ratio);
+    StarRocksMetrics::instance()->metrics()->register_hook("page_cache_hit_ratio", []() {
+        auto lookup_count = StoragePageCache::instance()->get_lookup_count();
+        auto hit_count = StoragePageCache::instance()->get_hit_count();
+        page_cache_hit_ratio.set_value(lookup_count == 0 ? 0.0 : 100.0 * double(hit_count) / double(lookup_count));
+    });
+
+    StarRocksMetrics::instance()->metrics()->register_metric("page_cache_admission_reject_count",
+                                                             &page_cache_admission_reject_count);
+    StarRocksMetrics::instance()->metrics()->register_hook("page_cache_admission_reject_count", []() {
+        page_cache_admission_reject_count.set_value(StoragePageCache::instance()->get_admission_reject_count());
+    });
 }
 
 StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity, ChargeMode::MEMSIZE)) {
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, ChargeMode::MEMSIZE,
+                               cache_evict_policy_or_lru(config::storage_page_cache_evict_policy),
+                               config::enable_storage_page_cache_read_mostly)) {
     init_metrics();
 }
 
@@ -111,6 +130,10 @@ uint64_t StoragePageCache::get_hit_count() {
     return _cache->get_hit_count();
 }
 
+uint64_t StoragePageCache::get_admission_reject_count() {
+    return _cache->get_admission_reject_count();
+}
+
 bool StoragePageCache::adjust_capacity(int64_t delta, size_t min_capacity) {
 #ifndef BE_TEST
     SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
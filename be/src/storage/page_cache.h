@@ -114,6 +114,8 @@ public:
 
     uint64_t get_hit_count();
 
+    uint64_t get_admission_reject_count();
+
     bool adjust_capacity(int64_t delta, size_t min_capacity = 0);
 
     void prune();
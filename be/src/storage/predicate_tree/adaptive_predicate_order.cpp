@@ -0,0 +1,72 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/predicate_tree/adaptive_predicate_order.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace starrocks {
+
+void AdaptivePredicateOrder::init(const PredicateTree& tree) {
+    _children.clear();
+    for (const auto& child : tree.root().children()) {
+        _children.emplace_back(child);
+    }
+    _stats.assign(_children.size(), ChildStats{});
+    _order.resize(_children.size());
+    for (size_t i = 0; i < _order.size(); i++) {
+        _order[i] = i;
+    }
+    _num_chunks = 0;
+}
+
+void AdaptivePredicateOrder::update(size_t i, int64_t cost_ns, size_t input_rows, size_t output_rows) {
+    DCHECK_LE(output_rows, input_rows);
+    auto& stats = _stats[_order[i]];
+    stats.cost_ns += cost_ns;
+    stats.input_rows += input_rows;
+    stats.output_rows += output_rows;
+}
+
+double AdaptivePredicateOrder::_rank(const ChildStats& stats) {
+    if (stats.input_rows == 0) {
+        // Not evaluated yet, since the previous children have filtered out all the rows.
+        return std::numeric_limits<double>::max();
+    }
+    const double cost_per_row = stats.cost_ns / stats.input_rows;
+    const double filter_ratio = 1 - stats.output_rows / stats.input_rows;
+    return cost_per_row / std::max(filter_ratio, 1e-6);
+}
+
+bool AdaptivePredicateOrder::finish_chunk() {
+    if (++_num_chunks % _reorder_interval != 0 || _order.size() <= 1) {
+        return false;
+    }
+
+    std::vector<size_t> new_order = _order;
+    std::stable_sort(new_order.begin(), new_order.end(),
+                     [&](size_t lhs, size_t rhs) { return _rank(_stats[lhs]) < _rank(_stats[rhs]); });
+    const bool changed = new_order != _order;
+    _order = std::move(new_order);
+
+    for (auto& stats : _stats) {
+        stats.cost_ns /= 2;
+        stats.input_rows /= 2;
+        stats.output_rows /= 2;
+    }
+    return changed;
+}
+
+} // namespace starrocks
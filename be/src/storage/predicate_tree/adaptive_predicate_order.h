@@ -0,0 +1,74 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "storage/predicate_tree/predicate_tree.h"
+
+namespace starrocks {
+
+/// Decides the order to evaluate the immediate children of the root of a PredicateTree by their cost and
+/// selectivity measured at runtime.
+///
+/// The children of the root are conjunctive. If each child only evaluates the rows passed by the previous ones,
+/// evaluating them in ascending order of `cost_per_row / (1 - pass_ratio)` minimizes the expected cost of
+/// independent predicates, so a cheap and selective predicate is moved before an expensive one, e.g. LIKE.
+///
+/// The statistics are collected for each chunk, and the children are reordered every `reorder_interval` chunks,
+/// after which the statistics are halved so that the order follows the change of the data.
+class AdaptivePredicateOrder {
+public:
+    static constexpr size_t kDefaultReorderInterval = 8;
+
+    explicit AdaptivePredicateOrder(size_t reorder_interval = kDefaultReorderInterval)
+            : _reorder_interval(reorder_interval) {}
+
+    /// Collect the immediate children of the root of `tree` in their original order.
+    /// The tree must outlive this object and must not be modified.
+    void init(const PredicateTree& tree);
+
+    size_t num_children() const { return _order.size(); }
+    /// The i-th child to evaluate in the current order.
+    const ConstPredicateNodePtr& child(size_t i) const { return _children[_order[i]]; }
+    /// The original indexes of the children in the current order.
+    const std::vector<size_t>& order() const { return _order; }
+
+    /// Record that the i-th child in the current order took `cost_ns` to evaluate `input_rows` rows,
+    /// and `output_rows` of them passed.
+    void update(size_t i, int64_t cost_ns, size_t input_rows, size_t output_rows);
+
+    /// Called after each chunk is evaluated. Return true if the order is changed.
+    bool finish_chunk();
+
+private:
+    struct ChildStats {
+        double cost_ns = 0;
+        double input_rows = 0;
+        double output_rows = 0;
+    };
+
+    static double _rank(const ChildStats& stats);
+
+    const size_t _reorder_interval;
+    std::vector<ConstPredicateNodePtr> _children;
+    // Indexed by the original index of the child.
+    std::vector<ChildStats> _stats;
+    std::vector<size_t> _order;
+    size_t _num_chunks = 0;
+};
+
+} // namespace starrocks
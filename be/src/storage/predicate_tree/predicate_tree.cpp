@@ -409,6 +409,11 @@ Status PredicateTree::evaluate(const Chunk* chunk, uint8_t* selection, uint16_t
 Status PredicateTree::evaluate(const Chunk* chunk, uint8_t* selection) const {
     return evaluate(chunk, selection, 0, chunk->num_rows());
 }
+Status PredicateTree::evaluate_child(const ConstPredicateNodePtr& child, const Chunk* chunk, uint8_t* selection,
+                                     uint16_t from, uint16_t to) const {
+    return child.visit(
+            [&](const auto& pred) { return pred.evaluate(_compound_node_contexts, chunk, selection, from, to); });
+}
 
 template <CompoundNodeType Type>
 static void collect_column_ids(const PredicateCompoundNode<Type>& node, std::unordered_set<ColumnId>& column_ids) {
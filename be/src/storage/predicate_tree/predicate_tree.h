@@ -320,6 +320,9 @@ public:
 
     Status evaluate(const Chunk* chunk, uint8_t* selection) const;
     Status evaluate(const Chunk* chunk, uint8_t* selection, uint16_t from, uint16_t to) const;
+    /// Evaluate a single immediate child of the root, which is got from `root().children()`.
+    Status evaluate_child(const ConstPredicateNodePtr& child, const Chunk* chunk, uint8_t* selection, uint16_t from,
+                          uint16_t to) const;
 
     const std::unordered_set<ColumnId>& column_ids() const;
     bool contains_column(ColumnId cid) const;
@@ -40,6 +40,7 @@
 #include "gutil/casts.h"
 #include "gutil/strings/substitute.h" // for Substitute
 #include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
 #include "storage/range.h"
 #include "storage/rowset/bitshuffle_page.h"
 #include "util/slice.h" // for Slice
@@ -279,6 +280,49 @@ Status BinaryDictPageDecoder<Type>::next_dict_codes(const SparseRange<>& range,
     return _data_page_decoder->next_batch(range, dst);
 }
 
+template <LogicalType Type>
+Status BinaryDictPageDecoder<Type>::evaluate_next_batch(const ColumnPredicate& predicate, size_t* n,
+                                                        uint8_t* selection) {
+    DCHECK(_parsed);
+    if (_encoding_type != DICT_ENCODING) {
+        return Status::NotSupported("evaluate_next_batch() not supported for plain encoded page");
+    }
+    DCHECK(_dict_decoder != nullptr) << "dict decoder pointer is nullptr";
+
+    if (_dict_predicate != &predicate) {
+        const uint32_t dict_size = _dict_decoder->count();
+        if (dict_size > count() - current_index() || dict_size > std::numeric_limits<uint16_t>::max()) {
+            return Status::NotSupported("dictionary is too large to evaluate");
+        }
+        std::vector<Slice> words;
+        raw::stl_vector_resize_uninitialized(&words, dict_size);
+        for (uint32_t i = 0; i < dict_size; ++i) {
+            words[i] = _dict_decoder->string_at_index(i);
+            if constexpr (Type == TYPE_CHAR) {
+                // Strip trailing '\x00'
+                words[i].size = strnlen(words[i].data, words[i].size);
+            }
+        }
+        auto dict_words = ChunkHelper::column_from_field_type(Type, false);
+        CHECK(dict_words->append_strings(words));
+        _dict_selection.resize(dict_size);
+        RETURN_IF_ERROR(predicate.evaluate(dict_words.get(), _dict_selection.data()));
+        _dict_predicate = &predicate;
+    }
+
+    if (_vec_code_buf == nullptr) {
+        _vec_code_buf = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    }
+    _vec_code_buf->resize(0);
+    RETURN_IF_ERROR(_data_page_decoder->next_batch(n, _vec_code_buf.get()));
+    using cast_type = CppTypeTraits<TYPE_INT>::CppType;
+    const auto* codewords = reinterpret_cast<const cast_type*>(_vec_code_buf->raw_data());
+    for (size_t i = 0; i < *n; ++i) {
+        selection[i] = _dict_selection[codewords[i]];
+    }
+    return Status::OK();
+}
+
 template class BinaryDictPageDecoder<TYPE_CHAR>;
 template class BinaryDictPageDecoder<TYPE_VARCHAR>;
 
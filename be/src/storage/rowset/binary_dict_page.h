@@ -145,6 +145,11 @@ public:
 
     Status next_dict_codes(const SparseRange<>& range, Column* dst) override;
 
+    // The predicate is evaluated on the dictionary words, and then the results are selected by the codes.
+    // NotSupported is returned if the page is not dictionary encoded, or the page has fewer remaining
+    // values than the dictionary words, in which case decoding the values is cheaper.
+    Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) override;
+
 private:
     Slice _data;
     std::unique_ptr<PageDecoder> _data_page_decoder;
@@ -153,6 +158,10 @@ private:
     EncodingTypePB _encoding_type;
     std::shared_ptr<Column> _vec_code_buf;
 
+    // The results of |_dict_predicate| on the dictionary words, indexed by the codes.
+    const ColumnPredicate* _dict_predicate = nullptr;
+    std::vector<uint8_t> _dict_selection;
+
     uint32_t _max_value_legth = 0;
 };
 
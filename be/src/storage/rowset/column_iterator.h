@@ -113,7 +113,13 @@ public:
             sharedBufferStream == nullptr) {
             return Status::OK();
         }
+        std::vector<io::SharedBufferedInputStream::IORange> result;
+        RETURN_IF_ERROR(get_io_ranges(range, &result));
+        return dynamic_cast<io::SharedBufferedInputStream*>(_opts.read_file)->set_io_ranges(result);
+    }
 
+    // Get the byte ranges of the data pages covering the rows of |range|, the adjacent pages are merged.
+    Status get_io_ranges(const SparseRange<>& range, std::vector<io::SharedBufferedInputStream::IORange>* result) {
         auto reader = get_column_reader();
         if (reader == nullptr) {
             // should't happen
@@ -121,7 +127,6 @@ public:
             return Status::OK();
         }
 
-        std::vector<io::SharedBufferedInputStream::IORange> result;
         std::vector<std::pair<int, int>> page_index;
         int prev_page_index = -1;
         for (auto index = 0; index < range.size(); index++) {
@@ -150,10 +155,9 @@ public:
             auto offset = iter_start.page().offset;
             auto size = iter_end.page().offset - offset + iter_end.page().size;
             io::SharedBufferedInputStream::IORange io_range(offset, size);
-            result.emplace_back(io_range);
+            result->emplace_back(io_range);
         }
-
-        return dynamic_cast<io::SharedBufferedInputStream*>(_opts.read_file)->set_io_ranges(result);
+        return Status::OK();
     }
 
     virtual ordinal_t get_current_ordinal() const = 0;
@@ -210,6 +214,13 @@ public:
 
     virtual Status next_dict_codes(const SparseRange<>& range, Column* dst) { return Status::NotSupported(""); }
 
+    // Evaluate |predicate| on the next |*n| rows, and write the result of the i-th row into |selection[i]|.
+    // The rows are not materialized if the encoding of the page has a fast path for |predicate|, see
+    // PageDecoder::evaluate_next_batch(). On success, |*n| is updated to the number of rows evaluated.
+    virtual Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) {
+        return Status::NotSupported("evaluate_next_batch() not supported");
+    }
+
     // given a list of dictionary codes, fill |dst| column with the decoded values.
     // |codes| pointer to the array of dictionary codes.
     // |size| size of dictionary code array.
@@ -876,7 +876,7 @@ inline EncodingTypePB StringColumnWriter::speculate_string_encoding(const Binary
             size_t hash = SliceHash()(bin_col.get_slice(i));
             hash_set.insert(hash);
             if (hash_set.size() > max_card) {
-                return PLAIN_ENCODING;
+                return config::enable_fsst_string_encoding ? FSST_ENCODING : PLAIN_ENCODING;
             }
         }
     }
@@ -0,0 +1,231 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "column/column.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "storage/type_traits.h"
+#include "util/delta_coding.h"
+
+namespace starrocks {
+
+// Delta page encoding for INT, BIGINT, DATE and DATETIME, see DeltaEncoder. It suits the sorted columns,
+// e.g. the sort keys and the event timestamps, which FOR encodes with the bit width of the whole range.
+template <LogicalType Type>
+class DeltaPageBuilder final : public PageBuilder {
+public:
+    explicit DeltaPageBuilder(const PageBuilderOptions& options) : _options(options), _encoder(&_buf) {}
+
+    ~DeltaPageBuilder() override = default;
+
+    bool is_page_full() override { return _encoder.len() >= _options.data_page_size; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        if (count == 0) {
+            return 0;
+        }
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        if (_count == 0) {
+            _first_val = *new_vals;
+        }
+        _encoder.put_batch(new_vals, count);
+        _count += count;
+        _last_val = new_vals[count - 1];
+        return count;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _encoder.flush();
+        return &_buf;
+    }
+
+    void reset() override {
+        _count = 0;
+        _finished = false;
+        _encoder.clear();
+    }
+
+    uint32_t count() const override { return _count; }
+
+    uint64_t size() const override { return _encoder.len(); }
+
+    Status get_first_value(void* value) const override {
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_val, sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_count == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_val, sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    PageBuilderOptions _options;
+    uint32_t _count{0};
+    bool _finished{false};
+    faststring _buf;
+    CppType _first_val;
+    CppType _last_val;
+    DeltaEncoder<CppType> _encoder;
+};
+
+template <LogicalType Type>
+class DeltaPageDecoder final : public PageDecoder {
+public:
+    DeltaPageDecoder(Slice data) : _data(data), _decoder((const uint8_t*)_data.data, _data.size) {}
+
+    ~DeltaPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (!_decoder.init()) {
+            return Status::Corruption("The delta page metadata maybe broken");
+        }
+        _num_elements = _decoder.count();
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements) << "Tried to seek to " << pos << " which is > number of elements ("
+                                      << _num_elements << ") in the block!";
+        _decoder.seek(pos);
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, Column* dst) override {
+        SparseRange<> read_range;
+        uint32_t begin = current_index();
+        read_range.add(Range<>(begin, begin + *n));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *n = current_index() - begin;
+        return Status::OK();
+    }
+
+    // The values are decoded into the column directly.
+    Status next_batch(const SparseRange<>& range, Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(range.span_size() == 0 || _cur_index >= _num_elements)) {
+            return Status::OK();
+        }
+
+        static_assert(Type == TYPE_INT || Type == TYPE_BIGINT || Type == TYPE_DATE || Type == TYPE_DATETIME,
+                      "unexpected field type");
+        size_t to_read =
+                std::min(static_cast<size_t>(range.span_size()), static_cast<size_t>(_num_elements - _cur_index));
+        SparseRangeIterator<> iter = range.new_iterator();
+        while (to_read > 0 && _cur_index < _num_elements) {
+            RETURN_IF_ERROR(seek_to_position_in_page(iter.begin()));
+            Range<> r = iter.next(to_read);
+            const size_t ori_size = dst->size();
+            dst->resize(ori_size + r.span_size());
+            auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+            if (PREDICT_FALSE(!_decoder.get_batch(p, r.span_size()))) {
+                return Status::Corruption("The delta page data maybe broken");
+            }
+            _cur_index += r.span_size();
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    // The blocks whose values all have the same result are skipped without being decoded, which is
+    // decided by the bounds of the block if the predicate is monotonic, e.g. `c > 10`.
+    Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(*n, std::numeric_limits<uint16_t>::max());
+        const size_t to_read = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        if (_values == nullptr) {
+            _values = ChunkHelper::column_from_field_type(Type, false);
+        }
+        const PredicateType type = predicate.type();
+        const bool is_monotonic = type == PredicateType::kGT || type == PredicateType::kGE ||
+                                  type == PredicateType::kLT || type == PredicateType::kLE ||
+                                  type == PredicateType::kIsNull || type == PredicateType::kNotNull;
+        size_t pos = 0;
+        while (pos < to_read) {
+            CppType bounds[2];
+            uint32_t num_remaining = 0;
+            if (PREDICT_FALSE(!_decoder.current_block_bounds(&bounds[0], &bounds[1], &num_remaining))) {
+                return Status::Corruption("The delta page data maybe broken");
+            }
+            const size_t len = std::min(static_cast<size_t>(num_remaining), to_read - pos);
+            if (is_monotonic || bounds[0] == bounds[1]) {
+                uint8_t results[2];
+                _values->resize(0);
+                [[maybe_unused]] int p = _values->append_numbers(bounds, sizeof(bounds));
+                DCHECK_EQ(2, p);
+                RETURN_IF_ERROR(predicate.evaluate(_values.get(), results));
+                if (results[0] == results[1]) {
+                    memset(selection + pos, results[0], len);
+                    _decoder.advance(len);
+                    pos += len;
+                    continue;
+                }
+            }
+            _values->resize(len);
+            auto* values = reinterpret_cast<CppType*>(_values->mutable_raw_data());
+            if (PREDICT_FALSE(!_decoder.get_batch(values, len))) {
+                return Status::Corruption("The delta page data maybe broken");
+            }
+            RETURN_IF_ERROR(predicate.evaluate(_values.get(), selection + pos));
+            pos += len;
+        }
+        _cur_index += to_read;
+        *n = to_read;
+        return Status::OK();
+    }
+
+    uint32_t count() const override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        return _num_elements;
+    }
+
+    uint32_t current_index() const override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        return _cur_index;
+    }
+
+    EncodingTypePB encoding_type() const override { return DELTA_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elements{0};
+    uint32_t _cur_index{0};
+    DeltaDecoder<CppType> _decoder;
+    // the values to evaluate the predicate on
+    ColumnPtr _values;
+};
+
+} // namespace starrocks
@@ -38,12 +38,15 @@
 
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/alp_page.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/binary_prefix_page.h"
 #include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/delta_page.h"
 #include "storage/rowset/dict_page.h"
 #include "storage/rowset/frame_of_reference_page.h"
+#include "storage/rowset/fsst_page.h"
 #include "storage/rowset/plain_page.h"
 #include "storage/rowset/rle_page.h"
 
@@ -168,6 +171,42 @@ struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     }
 };
 
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, ALP_ENCODING, CppType> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AlpPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new AlpPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_ENCODING, CppType> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type>
+struct TypeEncodingTraits<type, FSST_ENCODING, Slice> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new FsstPageBuilder(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new FsstPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
 template <LogicalType field_type, EncodingTypePB encoding_type>
 struct EncodingTraits : TypeEncodingTraits<field_type, encoding_type, typename CppTypeTraits<field_type>::CppType> {
     static const LogicalType type = field_type;
@@ -190,6 +229,14 @@ public:
             !optimize_value_seek) {
             return DICT_ENCODING;
         }
+        if (config::enable_alp_float_encoding && (type == TYPE_FLOAT || type == TYPE_DOUBLE) && !optimize_value_seek) {
+            return ALP_ENCODING;
+        }
+        if (config::enable_delta_integer_encoding &&
+            (type == TYPE_INT || type == TYPE_BIGINT || type == TYPE_DATE || type == TYPE_DATETIME) &&
+            !optimize_value_seek) {
+            return DELTA_ENCODING;
+        }
         auto& encoding_map = optimize_value_seek ? _value_seek_encoding_map : _default_encoding_type_map;
         auto it = encoding_map.find(delegate_type(type));
         if (it != encoding_map.end()) {
@@ -240,10 +287,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_INT, BIT_SHUFFLE>();
     _add_map<TYPE_INT, FOR_ENCODING, true>();
     _add_map<TYPE_INT, PLAIN_ENCODING>();
+    _add_map<TYPE_INT, DELTA_ENCODING>();
 
     _add_map<TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<TYPE_BIGINT, FOR_ENCODING, true>();
     _add_map<TYPE_BIGINT, PLAIN_ENCODING>();
+    _add_map<TYPE_BIGINT, DELTA_ENCODING>();
 
     _add_map<TYPE_LARGEINT, BIT_SHUFFLE>();
     _add_map<TYPE_LARGEINT, PLAIN_ENCODING>();
@@ -251,17 +300,21 @@ EncodingInfoResolver::EncodingInfoResolver() {
 
     _add_map<TYPE_FLOAT, BIT_SHUFFLE>();
     _add_map<TYPE_FLOAT, PLAIN_ENCODING>();
+    _add_map<TYPE_FLOAT, ALP_ENCODING>();
 
     _add_map<TYPE_DOUBLE, BIT_SHUFFLE>();
     _add_map<TYPE_DOUBLE, PLAIN_ENCODING>();
+    _add_map<TYPE_DOUBLE, ALP_ENCODING>();
 
     _add_map<TYPE_CHAR, DICT_ENCODING>();
     _add_map<TYPE_CHAR, PLAIN_ENCODING>();
     _add_map<TYPE_CHAR, PREFIX_ENCODING, true>();
+    _add_map<TYPE_CHAR, FSST_ENCODING>();
 
     _add_map<TYPE_VARCHAR, DICT_ENCODING>();
     _add_map<TYPE_VARCHAR, PLAIN_ENCODING>();
     _add_map<TYPE_VARCHAR, PREFIX_ENCODING, true>();
+    _add_map<TYPE_VARCHAR, FSST_ENCODING>();
 
     _add_map<TYPE_BOOLEAN, RLE>();
     _add_map<TYPE_BOOLEAN, BIT_SHUFFLE>();
@@ -274,6 +327,7 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATE, BIT_SHUFFLE>();
     _add_map<TYPE_DATE, PLAIN_ENCODING>();
     _add_map<TYPE_DATE, FOR_ENCODING, true>();
+    _add_map<TYPE_DATE, DELTA_ENCODING>();
 
     _add_map<TYPE_DATETIME_V1, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME_V1, PLAIN_ENCODING>();
@@ -282,6 +336,7 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<TYPE_DATETIME, PLAIN_ENCODING>();
     _add_map<TYPE_DATETIME, FOR_ENCODING, true>();
+    _add_map<TYPE_DATETIME, DELTA_ENCODING>();
 
     _add_map<TYPE_DECIMAL, BIT_SHUFFLE, true>();
     _add_map<TYPE_DECIMAL, PLAIN_ENCODING>();
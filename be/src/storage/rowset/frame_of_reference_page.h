@@ -35,6 +35,8 @@
 #pragma once
 
 #include "column/column.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
 #include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "storage/rowset/page_builder.h" // for PageBuilder
 #include "storage/rowset/page_decoder.h" // for PageDecoder
@@ -204,6 +206,51 @@ public:
         return Status::OK();
     }
 
+    // The frames whose values all have the same result are skipped without being decoded, which is
+    // decided by the bounds of the frame if the predicate is monotonic, e.g. `c > 10`.
+    Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(*n, std::numeric_limits<uint16_t>::max());
+        const size_t to_read = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        if (_values == nullptr) {
+            _values = ChunkHelper::column_from_field_type(Type, false);
+        }
+        const PredicateType type = predicate.type();
+        const bool is_monotonic = type == PredicateType::kGT || type == PredicateType::kGE ||
+                                  type == PredicateType::kLT || type == PredicateType::kLE ||
+                                  type == PredicateType::kIsNull || type == PredicateType::kNotNull;
+        size_t pos = 0;
+        while (pos < to_read) {
+            CppType bounds[2];
+            uint32_t num_remaining = 0;
+            const bool has_bounds = _decoder.current_frame_bounds(&bounds[0], &bounds[1], &num_remaining);
+            const size_t len = std::min(static_cast<size_t>(num_remaining), to_read - pos);
+            if (has_bounds && (is_monotonic || bounds[0] == bounds[1])) {
+                uint8_t results[2];
+                _values->resize(0);
+                [[maybe_unused]] int p = _values->append_numbers(bounds, sizeof(bounds));
+                DCHECK_EQ(2, p);
+                RETURN_IF_ERROR(predicate.evaluate(_values.get(), results));
+                if (results[0] == results[1]) {
+                    memset(selection + pos, results[0], len);
+                    _decoder.advance(len);
+                    pos += len;
+                    continue;
+                }
+            }
+            _values->resize(len);
+            auto* values = reinterpret_cast<CppType*>(_values->mutable_raw_data());
+            if (PREDICT_FALSE(!_decoder.get_batch(values, len))) {
+                return Status::Corruption("The frame of reference page data maybe broken");
+            }
+            RETURN_IF_ERROR(predicate.evaluate(_values.get(), selection + pos));
+            pos += len;
+        }
+        _cur_index += to_read;
+        *n = to_read;
+        return Status::OK();
+    }
+
     uint32_t count() const override { return _num_elements; }
 
     uint32_t current_index() const override { return _cur_index; }
@@ -218,6 +265,8 @@ private:
     uint32_t _num_elements{0};
     uint32_t _cur_index{0};
     ForDecoder<CppType> _decoder;
+    // the values to evaluate the predicate on
+    ColumnPtr _values;
 };
 
 } // namespace starrocks
@@ -0,0 +1,222 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/fsst_page.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "storage/column_predicate.h"
+
+namespace starrocks {
+
+faststring* FsstPageBuilder::finish() {
+    DCHECK(!_finished);
+    const size_t num_elems = _raw_offsets.size();
+    std::vector<Slice> strings;
+    strings.reserve(num_elems);
+    for (size_t i = 0; i < num_elems; i++) {
+        strings.emplace_back(_raw_value(i));
+    }
+
+    FsstSymbolTable symbol_table;
+    symbol_table.build(strings.data(), strings.size());
+    symbol_table.serialize(&_buffer);
+
+    std::vector<uint32_t> offsets;
+    offsets.reserve(num_elems);
+    _buffer.reserve(_buffer.size() + FsstSymbolTable::max_compressed_size(_raw_data.size()) +
+                    (num_elems + 1) * sizeof(uint32_t));
+    for (const Slice& s : strings) {
+        const size_t old_size = _buffer.size();
+        offsets.push_back(old_size);
+        _buffer.resize(old_size + FsstSymbolTable::max_compressed_size(s.size));
+        _buffer.resize(old_size + symbol_table.compress(s, _buffer.data() + old_size));
+    }
+
+    // Set up trailer
+    for (uint32_t offset : offsets) {
+        put_fixed32_le(&_buffer, offset);
+    }
+    put_fixed32_le(&_buffer, num_elems);
+    _finished = true;
+    return &_buffer;
+}
+
+template <LogicalType Type>
+Status FsstPageDecoder<Type>::init() {
+    RETURN_IF(_parsed, Status::OK());
+
+    if (_data.size < sizeof(uint32_t)) {
+        return Status::Corruption(strings::Substitute(
+                "file corruption: not enough bytes for trailer in FsstPageDecoder. invalid data size: $0", _data.size));
+    }
+    _num_elems = decode_fixed32_le((const uint8_t*)&_data[_data.get_size() - sizeof(uint32_t)]);
+    const size_t trailer_size = (static_cast<size_t>(_num_elems) + 1) * sizeof(uint32_t);
+    if (_data.size < trailer_size) {
+        return Status::Corruption(strings::Substitute(
+                "file corruption: invalid number of elements in FsstPageDecoder: $0, data size: $1", _num_elems,
+                _data.size));
+    }
+    _offsets_pos = static_cast<uint32_t>(_data.get_size() - trailer_size);
+    _offsets_ptr = (const uint8_t*)&_data[_offsets_pos];
+
+    ASSIGN_OR_RETURN(size_t table_size, _symbol_table.deserialize(Slice(_data.data, _offsets_pos)));
+    if (_num_elems > 0 && _offset(0) != table_size) {
+        return Status::Corruption("file corruption: FSST strings do not follow the symbol table");
+    }
+
+    _parsed = true;
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status FsstPageDecoder<Type>::next_batch(size_t* count, Column* dst) {
+    SparseRange<> read_range;
+    uint32_t begin = current_index();
+    read_range.add(Range<>(begin, begin + *count));
+    RETURN_IF_ERROR(next_batch(read_range, dst));
+    *count = current_index() - begin;
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status FsstPageDecoder<Type>::next_batch(const SparseRange<>& range, Column* dst) {
+    DCHECK(_parsed);
+    if (PREDICT_FALSE(_cur_idx >= _num_elems)) {
+        return Status::OK();
+    }
+
+    size_t to_read = std::min(range.span_size(), _num_elems - _cur_idx);
+    SparseRangeIterator<> iter = range.new_iterator();
+    while (to_read > 0) {
+        _cur_idx = iter.begin();
+        Range<> r = iter.next(to_read);
+        size_t end = _cur_idx + r.span_size();
+        RETURN_IF_ERROR(_decompress_range(_cur_idx, end, dst));
+        to_read -= r.span_size();
+        _cur_idx = end;
+    }
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status FsstPageDecoder<Type>::_decompress_range(uint32_t idx, uint32_t end, Column* dst) {
+    const size_t max_size = FsstSymbolTable::max_decompressed_size(_offset(end) - _offset(idx));
+    if constexpr (Type == TYPE_VARCHAR) {
+        // decompress the strings into the column directly
+        auto data_column = ColumnHelper::get_data_column(dst);
+        auto& bytes = down_cast<BinaryColumn*>(data_column)->get_bytes();
+        auto& offsets = down_cast<BinaryColumn*>(data_column)->get_offset();
+        DCHECK_GE(offsets.size(), 1);
+
+        size_t bytes_size = bytes.size();
+        bytes.resize(bytes_size + max_size);
+        for (uint32_t i = idx; i < end; i++) {
+            bytes_size += _symbol_table.decompress(compressed_string_at_index(i), bytes.data() + bytes_size);
+            offsets.push_back(bytes_size);
+        }
+        bytes.resize(bytes_size);
+
+        if (dst->is_nullable()) {
+            auto& null_data = down_cast<NullableColumn*>(dst)->null_column_data();
+            null_data.resize(null_data.size() + end - idx, 0);
+        }
+
+#ifndef NDEBUG
+        dst->check_or_die();
+#endif
+        return Status::OK();
+    } else {
+        _buffer.resize(max_size);
+        _slices.clear();
+        size_t size = 0;
+        for (uint32_t i = idx; i < end; i++) {
+            const size_t length = _symbol_table.decompress(compressed_string_at_index(i), _buffer.data() + size);
+            // Strip trailing '\x00'
+            _slices.emplace_back(_buffer.data() + size, strnlen((const char*)_buffer.data() + size, length));
+            size += length;
+        }
+        if (!dst->append_strings(_slices)) {
+            return Status::InvalidArgument("Column::append_strings() not supported");
+        }
+        return Status::OK();
+    }
+}
+
+template <LogicalType Type>
+Status FsstPageDecoder<Type>::evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) {
+    DCHECK(_parsed);
+    // The trailing zeros of CHAR are stripped after being decompressed, so the compressed strings could not
+    // be compared directly.
+    if constexpr (Type != TYPE_VARCHAR) {
+        return Status::NotSupported("evaluate_next_batch() not supported for CHAR");
+    }
+    const PredicateType type = predicate.type();
+    if (type != PredicateType::kEQ && type != PredicateType::kNE && type != PredicateType::kInList &&
+        type != PredicateType::kNotInList) {
+        return Status::NotSupported("evaluate_next_batch() only supports equality predicates");
+    }
+
+    if (_predicate != &predicate) {
+        const std::vector<Datum> values = predicate.values();
+        if (values.empty()) {
+            return Status::NotSupported("predicate without values");
+        }
+        std::vector<std::string> operands;
+        operands.reserve(values.size());
+        for (const Datum& value : values) {
+            if (value.is_null()) {
+                return Status::NotSupported("predicate with null values");
+            }
+            const Slice s = value.get_slice();
+            std::string compressed(FsstSymbolTable::max_compressed_size(s.size), '\0');
+            compressed.resize(_symbol_table.compress(s, reinterpret_cast<uint8_t*>(compressed.data())));
+            operands.emplace_back(std::move(compressed));
+        }
+        std::sort(operands.begin(), operands.end());
+        _compressed_operands = std::move(operands);
+        _predicate = &predicate;
+    }
+
+    const size_t to_read = std::min<size_t>(*n, _num_elems - _cur_idx);
+    const bool negative = type == PredicateType::kNE || type == PredicateType::kNotInList;
+    if (_compressed_operands.size() == 1) {
+        const Slice operand(_compressed_operands[0]);
+        for (size_t i = 0; i < to_read; i++) {
+            selection[i] = (compressed_string_at_index(_cur_idx + i) == operand) != negative;
+        }
+    } else {
+        for (size_t i = 0; i < to_read; i++) {
+            const Slice s = compressed_string_at_index(_cur_idx + i);
+            const bool found = std::binary_search(
+                    _compressed_operands.begin(), _compressed_operands.end(), s,
+                    [](const auto& lhs, const auto& rhs) { return Slice(lhs).compare(Slice(rhs)) < 0; });
+            selection[i] = found != negative;
+        }
+    }
+    _cur_idx += to_read;
+    *n = to_read;
+    return Status::OK();
+}
+
+template class FsstPageDecoder<TYPE_CHAR>;
+template class FsstPageDecoder<TYPE_VARCHAR>;
+
+} // namespace starrocks
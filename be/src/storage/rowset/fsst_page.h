@@ -0,0 +1,185 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// FSST page encoding for strings, see FsstSymbolTable.
+//
+// The page consists of:
+// Symbol table:
+//   built from the strings of the page, see FsstSymbolTable::serialize()
+// Strings:
+//   strings compressed by the symbol table
+// Trailer
+//  Offsets:
+//    offsets pointing to the beginning of each compressed string
+//  num_elems (32-bit fixed)
+//
+// Unlike the plain page compressed as a whole, each string could be decompressed individually, and the
+// equality predicates are evaluated by comparing the compressed strings without decompressing them.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/logging.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/fsst.h"
+
+namespace starrocks {
+
+class FsstPageBuilder final : public PageBuilder {
+public:
+    explicit FsstPageBuilder(const PageBuilderOptions& options) : _options(options) { reset(); }
+
+    // The strings are compressed in finish(), so the page is full when the size of the uncompressed
+    // strings exceeds the page size.
+    bool is_page_full() override {
+        // data_page_size is 0, do not limit the page size
+        return (_options.data_page_size != 0) & (_size_estimate > _options.data_page_size);
+    }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        const auto* slices = reinterpret_cast<const Slice*>(vals);
+        for (uint32_t i = 0; i < count; i++) {
+            if (is_page_full()) {
+                return i;
+            }
+            _raw_offsets.push_back(_raw_data.size());
+            _raw_data.append(slices[i].data, slices[i].size);
+            _size_estimate += slices[i].size + sizeof(uint32_t);
+        }
+        return count;
+    }
+
+    faststring* finish() override;
+
+    void reset() override {
+        _raw_data.clear();
+        _raw_offsets.clear();
+        _buffer.clear();
+        _size_estimate = sizeof(uint32_t);
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _raw_offsets.size(); }
+
+    uint64_t size() const override { return _size_estimate; }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (_raw_offsets.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = _raw_value(0);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (_raw_offsets.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = _raw_value(_raw_offsets.size() - 1);
+        return Status::OK();
+    }
+
+private:
+    Slice _raw_value(size_t idx) const {
+        size_t end = (idx + 1) < _raw_offsets.size() ? _raw_offsets[idx + 1] : _raw_data.size();
+        return {_raw_data.data() + _raw_offsets[idx], end - _raw_offsets[idx]};
+    }
+
+    PageBuilderOptions _options;
+    // the uncompressed strings added to the page
+    faststring _raw_data;
+    std::vector<uint32_t> _raw_offsets;
+    faststring _buffer;
+    size_t _size_estimate{0};
+    bool _finished{false};
+};
+
+template <LogicalType Type>
+class FsstPageDecoder final : public PageDecoder {
+public:
+    explicit FsstPageDecoder(Slice data) : _data(data) {}
+
+    Status init() override;
+
+    Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* count, Column* dst) override;
+
+    Status next_batch(const SparseRange<>& range, Column* dst) override;
+
+    // The equality predicates on VARCHAR, i.e. EQ, NE, IN and NOT IN, are evaluated by comparing the
+    // compressed strings with the operands compressed by the symbol table of the page.
+    Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) override;
+
+    uint32_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    uint32_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+    EncodingTypePB encoding_type() const override { return FSST_ENCODING; }
+
+    Slice compressed_string_at_index(uint32_t idx) const {
+        const uint32_t start_offset = _offset(idx);
+        return {&_data[start_offset], _offset(idx + 1) - start_offset};
+    }
+
+private:
+    // Return the offset within '_data' where the compressed string with index 'idx' can be found.
+    uint32_t _offset(uint32_t idx) const {
+        return idx < _num_elems ? decode_fixed32_le(_offsets_ptr + idx * sizeof(uint32_t)) : _offsets_pos;
+    }
+
+    // Decompress the strings in [begin, end) and append them to |dst|.
+    Status _decompress_range(uint32_t begin, uint32_t end, Column* dst);
+
+    Slice _data;
+    bool _parsed{false};
+    uint32_t _num_elems{0};
+    uint32_t _offsets_pos{0};
+    const uint8_t* _offsets_ptr{nullptr};
+    // Index of the currently seeked element in the page.
+    uint32_t _cur_idx{0};
+
+    FsstSymbolTable _symbol_table;
+    // the decompressed strings to append to the column
+    std::vector<uint8_t> _buffer;
+    std::vector<Slice> _slices;
+
+    // The operands of |_predicate| compressed by the symbol table, in ascending order.
+    const ColumnPredicate* _predicate{nullptr};
+    std::vector<std::string> _compressed_operands;
+};
+
+} // namespace starrocks
@@ -42,6 +42,7 @@
 
 namespace starrocks {
 class Column;
+class ColumnPredicate;
 }
 
 namespace starrocks {
@@ -114,6 +115,17 @@ public:
 
     virtual const PageDecoder* dict_page_decoder() const { return nullptr; }
 
+    // Evaluate |predicate| on the next |*n| values without materializing them into a column where
+    // the encoding allows, e.g. once for each RLE run or once for each dictionary word.
+    // On success, the result of the i-th value is written into |selection[i]|, |*n| is updated to
+    // the number of values evaluated, and the decoder is advanced by this number like next_batch().
+    // Return NotSupported without advancing the decoder if the encoding has no fast path for
+    // |predicate|, and the caller should decode the values and evaluate the predicate on them.
+    // |*n| must be less than 65536, since ColumnPredicate evaluates at most that many values at once.
+    virtual Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) {
+        return Status::NotSupported("evaluate_next_batch() not supported");
+    }
+
 private:
     PageDecoder(const PageDecoder&) = delete;
     const PageDecoder& operator=(const PageDecoder&) = delete;
@@ -0,0 +1,89 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/page_prefetcher.h"
+
+#include <vector>
+
+#include "column/schema.h"
+#include "io/seekable_input_stream.h"
+#include "io/shared_buffered_input_stream.h"
+#include "storage/rowset/column_iterator.h"
+
+namespace starrocks {
+
+void PagePrefetcher::add_column(ColumnId cid, ColumnIterator* iter, io::SeekableInputStream* file) {
+    PrefetchColumn& column = _columns[cid];
+    column.iter = iter;
+    column.file = file;
+}
+
+Status PagePrefetcher::prefetch(const Schema& schema, const SparseRangeIterator<>& iter, size_t chunk_size) {
+    if (!iter.has_more()) {
+        return Status::OK();
+    }
+    SparseRangeIterator<> ahead_iter = iter;
+    SparseRange<> ahead_range;
+    ahead_iter.next_range(chunk_size * (_depth + 1), &ahead_range);
+
+    std::vector<io::SharedBufferedInputStream::IORange> io_ranges;
+    for (const FieldPtr& f : schema.fields()) {
+        auto it = _columns.find(f->id());
+        if (it == _columns.end()) {
+            continue;
+        }
+        io_ranges.clear();
+        RETURN_IF_ERROR(it->second.iter->get_io_ranges(ahead_range, &io_ranges));
+        for (const auto& r : io_ranges) {
+            RETURN_IF_ERROR(_prefetch(&it->second, r.offset, r.size));
+        }
+    }
+    return Status::OK();
+}
+
+Status PagePrefetcher::_prefetch(PrefetchColumn* column, int64_t offset, int64_t size) {
+    int64_t end = offset + size;
+    if (offset < column->end && end > column->begin) {
+        if (offset >= column->begin && end <= column->end) {
+            // all prefetched
+            return Status::OK();
+        }
+        if (offset >= column->begin) {
+            // only prefetch the part after the prefetched range, which is the common case of ascending scans
+            offset = column->end;
+            column->end = end;
+        } else {
+            column->begin = offset;
+            column->end = std::max(column->end, end);
+        }
+    } else {
+        column->begin = offset;
+        column->end = end;
+    }
+    _stats->page_prefetch_bytes += end - offset;
+    return column->file->prefetch(offset, end - offset);
+}
+
+void PagePrefetcher::update(int64_t io_ns, int64_t io_count) {
+    if (io_count <= 0) {
+        return;
+    }
+    if (io_ns / io_count > kDeviceReadNs) {
+        _depth = std::min(_depth * 2, _max_depth);
+    } else {
+        _depth = std::max(_depth - 1, 1);
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,82 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+#include "storage/range.h"
+
+namespace starrocks {
+
+class ColumnIterator;
+class Schema;
+
+namespace io {
+class SeekableInputStream;
+}
+
+// Prefetches the data pages of the next chunks of all the columns read by a SegmentIterator, so that the
+// device loads the pages of the different columns concurrently, and ahead of the decoding of the current chunk,
+// instead of one page read after another.
+//
+// The pages are located by the ordinal index of each column and the rows left in the scan range, which has been
+// pruned by the zone maps and the indexes. They are hinted to the file, e.g. by posix_fadvise(WILLNEED) to load
+// them into the page cache of the OS, and the reads of the column iterators are not changed.
+//
+// The number of chunks prefetched ahead starts from 1. It's doubled when the page reads of a chunk still wait for
+// the device, and decreased by 1 when they don't, up to |max_depth|.
+class PagePrefetcher {
+public:
+    // The average time of a page read above which the page is considered read from the device.
+    static constexpr int64_t kDeviceReadNs = 100 * 1000;
+
+    PagePrefetcher(OlapReaderStatistics* stats, int max_depth) : _stats(stats), _max_depth(std::max(max_depth, 1)) {}
+
+    void add_column(ColumnId cid, ColumnIterator* iter, io::SeekableInputStream* file);
+
+    bool empty() const { return _columns.empty(); }
+
+    int depth() const { return _depth; }
+
+    // Prefetch the pages of the columns in |schema| covering the rows of the current chunk and the next
+    // depth() chunks, which are the rows that |iter| would return next, |chunk_size| rows each chunk.
+    // The pages prefetched before are skipped.
+    Status prefetch(const Schema& schema, const SparseRangeIterator<>& iter, size_t chunk_size);
+
+    // Called after each chunk is read, |io_ns| is the time spent on the |io_count| page reads of the chunk.
+    void update(int64_t io_ns, int64_t io_count);
+
+private:
+    struct PrefetchColumn {
+        ColumnIterator* iter = nullptr;
+        io::SeekableInputStream* file = nullptr;
+        // the contiguous byte range [begin, end) of the file prefetched most recently
+        int64_t begin = 0;
+        int64_t end = 0;
+    };
+
+    Status _prefetch(PrefetchColumn* column, int64_t offset, int64_t size);
+
+    OlapReaderStatistics* _stats;
+    const int _max_depth;
+    int _depth = 1;
+    std::unordered_map<ColumnId, PrefetchColumn> _columns;
+};
+
+} // namespace starrocks
@@ -154,6 +154,16 @@ public:
         return Status::OK();
     }
 
+    Status evaluate(const ColumnPredicate& predicate, size_t* count, uint8_t* selection) override {
+        if (_has_null) {
+            return Status::NotSupported("evaluate() not supported for page with null");
+        }
+        *count = std::min(*count, remaining());
+        RETURN_IF_ERROR(_data_decoder->evaluate_next_batch(predicate, count, selection));
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
     Status read_dict_codes(Column* column, size_t* count) override {
         *count = std::min(*count, remaining());
         size_t nrows_to_read = *count;
@@ -265,6 +275,16 @@ public:
         return Status::OK();
     }
 
+    Status evaluate(const ColumnPredicate& predicate, size_t* count, uint8_t* selection) override {
+        DCHECK_EQ(_offset_in_page, _data_decoder->current_index());
+        if (_null_flags.size() != 0) {
+            return Status::NotSupported("evaluate() not supported for page with null");
+        }
+        RETURN_IF_ERROR(_data_decoder->evaluate_next_batch(predicate, count, selection));
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
     Status read_dict_codes(Column* column, size_t* count) override {
         if (_null_flags.size() == 0) {
             RETURN_IF_ERROR(_data_decoder->next_dict_codes(count, column));
@@ -112,6 +112,14 @@ public:
 
     virtual Status read_dict_codes(Column* column, const SparseRange<>& range) = 0;
 
+    // Attempts to evaluate |predicate| on up to |*count| records from this page without reading them,
+    // see PageDecoder::evaluate_next_batch().
+    // On success, the result of each record is written into |selection|, the number of records evaluated
+    // will be updated to |count|, and the page offset is advanced by this number too.
+    // NotSupported is returned without advancing the page offset if the page has null records or the
+    // encoding of the page has no fast path for |predicate|.
+    virtual Status evaluate(const ColumnPredicate& predicate, size_t* count, uint8_t* selection) = 0;
+
 protected:
     uint32_t _page_index{0};
     uint64_t _num_rows{0};
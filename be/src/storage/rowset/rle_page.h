@@ -35,6 +35,8 @@
 #pragma once
 
 #include "column/column.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
 #include "storage/range.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/page_builder.h"
@@ -240,6 +242,42 @@ public:
         return Status::OK();
     }
 
+    // The predicate is evaluated only once for each repeated run.
+    Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) override {
+        DCHECK(_parsed);
+        DCHECK_LE(*n, std::numeric_limits<uint16_t>::max());
+        const size_t to_read = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        if (_values == nullptr) {
+            _values = ChunkHelper::column_from_field_type(Type, false);
+        }
+        size_t pos = 0;
+        while (pos < to_read) {
+            const size_t run_length = std::min(_rle_decoder.repeated_count(), to_read - pos);
+            if (run_length > 0) {
+                CppType value = _rle_decoder.get_repeated_value(run_length);
+                uint8_t result = 0;
+                _values->resize(0);
+                [[maybe_unused]] int p = _values->append_numbers(&value, sizeof(value));
+                DCHECK_EQ(1, p);
+                RETURN_IF_ERROR(predicate.evaluate(_values.get(), &result));
+                memset(selection + pos, result, run_length);
+                pos += run_length;
+                continue;
+            }
+            const size_t num_literals = std::min(_rle_decoder.literal_count(), to_read - pos);
+            _values->resize(num_literals);
+            auto* values = reinterpret_cast<CppType*>(_values->mutable_raw_data());
+            if (PREDICT_FALSE(num_literals == 0 || _rle_decoder.GetBatch(values, num_literals) != num_literals)) {
+                return Status::Corruption("RLE decode failed");
+            }
+            RETURN_IF_ERROR(predicate.evaluate(_values.get(), selection + pos));
+            pos += num_literals;
+        }
+        _cur_index += to_read;
+        *n = to_read;
+        return Status::OK();
+    }
+
     uint32_t count() const override { return _num_elements; }
 
     uint32_t current_index() const override { return _cur_index; }
@@ -256,6 +294,8 @@ private:
     uint32_t _cur_index{0};
     int _bit_width{0};
     RleDecoder<CppType> _rle_decoder;
+    // the values to evaluate the predicate on
+    ColumnPtr _values;
 };
 
 } // namespace starrocks
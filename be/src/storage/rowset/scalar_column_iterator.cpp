@@ -34,6 +34,7 @@
 
 #include "storage/rowset/scalar_column_iterator.h"
 
+#include "storage/chunk_helper.h"
 #include "storage/column_predicate.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/bitshuffle_page.h"
@@ -208,7 +209,7 @@ Status ScalarColumnIterator::next_batch(size_t* n, Column* dst) {
             RETURN_IF_ERROR(_load_next_page(&eos));
             if (eos) {
                 // release shareBufferStream
-                if (config::io_coalesce_lake_read_enable && _opts.is_io_coalesce) {
+                if (_opts.is_io_coalesce) {
                     auto shared_buffer_stream = dynamic_cast<io::SharedBufferedInputStream*>(_opts.read_file);
                     if (shared_buffer_stream != nullptr) {
                         shared_buffer_stream->release();
@@ -252,7 +253,7 @@ Status ScalarColumnIterator::next_batch(const SparseRange<>& range, Column* dst)
             RETURN_IF_ERROR(_load_next_page(&eos));
             if (eos) {
                 // release shareBufferStream
-                if (config::io_coalesce_lake_read_enable && _opts.is_io_coalesce) {
+                if (_opts.is_io_coalesce) {
                     auto shared_buffer_stream = dynamic_cast<io::SharedBufferedInputStream*>(_opts.read_file);
                     if (shared_buffer_stream != nullptr) {
                         shared_buffer_stream->release();
@@ -453,6 +454,40 @@ Status ScalarColumnIterator::next_dict_codes(const SparseRange<>& range, Column*
     return (this->*_next_batch_dict_codes_func)(range, dst);
 }
 
+Status ScalarColumnIterator::evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) {
+    size_t remaining = *n;
+    while (remaining > 0) {
+        if (_page->remaining() == 0) {
+            bool eos = false;
+            RETURN_IF_ERROR(_load_next_page(&eos));
+            if (eos) {
+                break;
+            }
+        }
+
+        uint8_t* page_selection = selection + (*n - remaining);
+        size_t nread = remaining;
+        Status st = _page->evaluate(predicate, &nread, page_selection);
+        if (st.is_not_supported()) {
+            // fallback to read the values and evaluate the predicate on them
+            if (_predicate_values == nullptr) {
+                _predicate_values = ChunkHelper::column_from_field_type(_reader->column_type(), is_nullable());
+            }
+            _predicate_values->reset_column();
+            nread = remaining;
+            RETURN_IF_ERROR(_page->read(_predicate_values.get(), &nread));
+            RETURN_IF_ERROR(predicate.evaluate(_predicate_values.get(), page_selection));
+            _opts.stats->bytes_read += static_cast<int64_t>(_predicate_values->byte_size());
+        } else if (!st.ok()) {
+            return st;
+        }
+        _current_ordinal += nread;
+        remaining -= nread;
+    }
+    *n -= remaining;
+    return Status::OK();
+}
+
 Status ScalarColumnIterator::decode_dict_codes(const int32_t* codes, size_t size, Column* words) {
     DCHECK(all_page_dict_encoded());
     return (this->*_decode_dict_codes_func)(codes, size, words);
@@ -84,6 +84,8 @@ public:
 
     Status next_dict_codes(const SparseRange<>& range, Column* dst) override;
 
+    Status evaluate_next_batch(const ColumnPredicate& predicate, size_t* n, uint8_t* selection) override;
+
     Status decode_dict_codes(const int32_t* codes, size_t size, Column* words) override;
 
     Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) override;
@@ -173,6 +175,9 @@ private:
     int64_t _element_ordinal = 0;
 
     UInt32Column _array_size;
+
+    // the values of the pages which can't be evaluated without being read, see evaluate_next_batch()
+    ColumnPtr _predicate_values;
 };
 
 } // namespace starrocks
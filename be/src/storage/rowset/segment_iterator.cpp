@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <stack>
 #include <unordered_map>
 
@@ -29,6 +30,7 @@
 #include "glog/logging.h"
 #include "gutil/casts.h"
 #include "gutil/stl_util.h"
+#include "io/io_uring_reader.h"
 #include "io/shared_buffered_input_stream.h"
 #include "segment_options.h"
 #include "simd/simd.h"
@@ -38,20 +40,25 @@
 #include "storage/column_or_predicate.h"
 #include "storage/column_predicate.h"
 #include "storage/column_predicate_rewriter.h"
+#include "storage/column_runtime_filter_predicate.h"
 #include "storage/del_vector.h"
 #include "storage/index/index_descriptor.h"
 #include "storage/lake/update_manager.h"
 #include "storage/olap_runtime_range_pruner.hpp"
+#include "storage/predicate_tree/adaptive_predicate_order.h"
 #include "storage/projection_iterator.h"
 #include "storage/range.h"
 #include "storage/roaring2range.h"
 #include "storage/rowset/bitmap_index_evaluator.h"
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/column_decoder.h"
+#include "storage/rowset/column_reader.h"
 #include "storage/rowset/common.h"
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/dictcode_column_iterator.h"
+#include "storage/rowset/encoding_info.h"
 #include "storage/rowset/fill_subfield_iterator.h"
+#include "storage/rowset/page_prefetcher.h"
 #include "storage/rowset/rowid_column_iterator.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/short_key_range_option.h"
@@ -200,10 +207,15 @@ private:
         // for inverted index.
         std::unordered_set<size_t> _prune_cols;
         bool _prune_column_after_index_filter = false;
+
+        // the index of the column of |_encoded_pred| in |_read_schema|, or -1 if it's not evaluated on the
+        // encoded pages in this context.
+        int _encoded_pred_index = -1;
     };
 
     Status _init();
     Status _try_to_update_ranges_by_runtime_filter();
+    Status _add_runtime_filter_predicate(ColumnId cid, LogicalType slot_type, const JoinRuntimeFilter* rf);
     Status _do_get_next(Chunk* result, vector<rowid_t>* rowid);
 
     template <bool check_global_dict>
@@ -223,11 +235,16 @@ private:
                            rowid_t* rowid);
     Status _seek_columns(const Schema& schema, rowid_t pos);
     Status _read_columns(const Schema& schema, Chunk* chunk, size_t nrows);
+    Status _read_pages_in_batch(const SparseRange<>& range);
+    StatusOr<bool> _filter_by_encoded_predicate(const SparseRange<>& range, SparseRange<>* selected);
 
     StatusOr<uint16_t> _filter_by_non_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to);
     StatusOr<uint16_t> _filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid);
+    StatusOr<uint16_t> _filter_by_runtime_filter_predicates(Chunk* chunk, vector<rowid_t>* rowid);
+    StatusOr<uint16_t> _filter_by_expr_predicates_adaptively(Chunk* chunk, vector<rowid_t>* rowid);
 
     void _init_column_predicates();
+    void _init_encoded_predicate();
 
     Status _init_context();
 
@@ -258,6 +275,9 @@ private:
     bool _can_using_global_dict(const FieldPtr& field) const;
 
     Status _apply_bitmap_index();
+    Status _new_bitmap_index_iterator(ColumnId cid, ColumnUID ucid, BitmapIndexIterator** iter);
+    Status _get_row_ranges_by_runtime_bitmap_index(ColumnId cid, const PredicateList& predicates,
+                                                   SparseRange<>* row_ranges);
 
     Status _apply_del_vector();
 
@@ -294,6 +314,10 @@ private:
     SegmentReadOptions _opts;
     RawColumnIterators _column_iterators;
     std::vector<int> _io_coalesce_column_index;
+    // the local column files whose pages needed by the next chunk are read in one batch, see _read_pages_in_batch()
+    std::unordered_map<ColumnId, io::SharedBufferedInputStream*> _batch_read_files;
+    // prefetch the pages of the next chunks of the local column files, nullptr if not enabled
+    std::unique_ptr<PagePrefetcher> _page_prefetcher;
     ColumnDecoders _column_decoders;
     BitmapIndexEvaluator _bitmap_index_evaluator;
     // delete predicates
@@ -311,7 +335,14 @@ private:
     SparseRangeIterator<> _range_iter;
 
     PredicateTree _non_expr_pred_tree;
+    // The only predicate of |_non_expr_pred_tree| if there is one, which is evaluated on the encoded pages of its
+    // column before reading the columns, see _filter_by_encoded_predicate().
+    const ColumnPredicate* _encoded_pred = nullptr;
+    // whether the rows read by the last _read() are filtered by |_encoded_pred|
+    bool _encoded_pred_applied = false;
     PredicateTree _expr_pred_tree;
+    // The order to evaluate the immediate children of |_expr_pred_tree|, only used when there are more than one.
+    AdaptivePredicateOrder _expr_pred_order;
 
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
@@ -330,9 +361,16 @@ private:
 
     ObjectPool _obj_pool;
 
-    // initial number of columns of |_opts.pred_tree|.
+    // initial number of columns of |_opts.pred_tree| and |_runtime_filter_columns|, which are read before the
+    // other columns in the late materialization.
     int _predicate_columns = 0;
 
+    // The columns of the runtime filters which are not in |_opts.pred_tree|, they're read along with the predicate
+    // columns, so that the runtime filters could be evaluated on them before late materialization once they arrive.
+    std::unordered_set<ColumnId> _runtime_filter_columns;
+    // The predicates of the arrived runtime filters, at most one for each column.
+    std::map<ColumnId, const ColumnPredicate*> _runtime_filter_predicates;
+
     // the next rowid to read
     rowid_t _cur_rowid = 0;
 
@@ -351,12 +389,31 @@ private:
     std::unordered_set<ColumnId> _prune_cols_candidate_by_inverted_index;
 };
 
+// The columns of |schema| which are the columns of the runtime filters but not the predicate columns.
+static std::unordered_set<ColumnId> get_runtime_filter_columns(const Schema& schema,
+                                                               const SegmentReadOptions& options) {
+    std::unordered_set<ColumnId> columns;
+    if (!config::enable_segment_runtime_filter_predicate) {
+        return columns;
+    }
+    std::vector<ColumnId> cids = options.runtime_range_pruner.runtime_filter_column_ids();
+    for (const auto& field : schema.fields()) {
+        const ColumnId cid = field->id();
+        if (std::find(cids.begin(), cids.end(), cid) != cids.end() && !options.pred_tree.contains_column(cid)) {
+            columns.insert(cid);
+        }
+    }
+    return columns;
+}
+
 SegmentIterator::SegmentIterator(std::shared_ptr<Segment> segment, Schema schema, SegmentReadOptions options)
         : ChunkIterator(std::move(schema), options.chunk_size),
           _segment(std::move(segment)),
           _opts(std::move(options)),
           _bitmap_index_evaluator(_schema, _opts.pred_tree),
-          _predicate_columns(_opts.pred_tree.num_columns()) {
+          _predicate_columns(_opts.pred_tree.num_columns()),
+          _runtime_filter_columns(get_runtime_filter_columns(_schema, _opts)) {
+    _predicate_columns += static_cast<int>(_runtime_filter_columns.size());
     // For small segment file (the number of rows is less than chunk_size),
     // the segment iterator will reserve a large amount of memory,
     // especially when there are many columns, many small files, many versions,
@@ -454,6 +511,7 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_rewrite_predicates());
     RETURN_IF_ERROR(_init_context());
     _init_column_predicates();
+    _init_encoded_predicate();
 
     // reverse scan_range
     if (!_opts.asc_hint) {
@@ -480,6 +538,7 @@ Status SegmentIterator::_try_to_update_ranges_by_runtime_filter() {
 
                 RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(predicates, del_pred, &r,
                                                                                    CompoundNodeType::AND));
+                RETURN_IF_ERROR(_get_row_ranges_by_runtime_bitmap_index(cid, predicates, &r));
                 size_t prev_size = _scan_range.span_size();
                 SparseRange<> res;
                 res.set_sorted(_scan_range.is_sorted());
@@ -489,7 +548,57 @@ Status SegmentIterator::_try_to_update_ranges_by_runtime_filter() {
                 _opts.stats->runtime_stats_filtered += (prev_size - _scan_range.span_size());
                 return Status::OK();
             },
-            _opts.stats->raw_rows_read);
+            _opts.stats->raw_rows_read,
+            [this](auto cid, LogicalType slot_type, const JoinRuntimeFilter* rf) {
+                return _add_runtime_filter_predicate(cid, slot_type, rf);
+            });
+}
+
+// Make a predicate of the arrived runtime filter, which is evaluated on the column read before late materialization,
+// i.e. on the dictionary codes of the column if it's read as codes, see _build_context().
+Status SegmentIterator::_add_runtime_filter_predicate(ColumnId cid, LogicalType slot_type, const JoinRuntimeFilter* rf) {
+    RETURN_IF(!config::enable_segment_runtime_filter_predicate, Status::OK());
+    // the column is not read, or it's not read before late materialization
+    RETURN_IF(!_runtime_filter_columns.count(cid) && !_opts.pred_tree.contains_column(cid), Status::OK());
+    RETURN_IF(_prune_cols_candidate_by_inverted_index.count(cid), Status::OK());
+
+    const FieldPtr* field = nullptr;
+    for (const auto& f : _schema.fields()) {
+        if (f->id() == cid) {
+            field = &f;
+            break;
+        }
+    }
+    RETURN_IF(field == nullptr, Status::OK());
+
+    const LogicalType field_type = (*field)->type()->type();
+    ColumnPredicate* pred = nullptr;
+    if (_can_using_global_dict(*field)) {
+        // the runtime filter of the column of the global dictionary is built on the codes of the global dictionary,
+        // which are read by GlobalDictCodeColumnIterator
+        pred = new ColumnRuntimeFilterPredicate(get_type_info(kDictCodeType), cid, rf);
+    } else if (_opts.global_dictmaps->count(cid)) {
+        // the words are read and encoded to the codes of the global dictionary after late materialization
+        return Status::OK();
+    } else if (_can_using_dict_code(*field)) {
+        RETURN_IF(!is_string_type(slot_type), Status::OK());
+        ColumnIterator* iter = _column_iterators[cid].get();
+        const int dict_size = iter->dict_size();
+        std::vector<int32_t> codes(dict_size);
+        std::iota(codes.begin(), codes.end(), 0);
+        auto dict_words = BinaryColumn::create();
+        RETURN_IF_ERROR(iter->decode_dict_codes(codes.data(), codes.size(), dict_words.get()));
+        pred = ColumnRuntimeFilterPredicate::create_for_dict_codes(get_type_info(kDictCodeType), cid, rf,
+                                                                   dict_words.get());
+    } else if (field_type == slot_type || (is_string_type(field_type) && is_string_type(slot_type))) {
+        pred = new ColumnRuntimeFilterPredicate((*field)->type(), cid, rf);
+    } else {
+        return Status::OK();
+    }
+    _obj_pool.add(pred);
+    _runtime_filter_predicates[cid] = pred;
+    VLOG(2) << "evaluate runtime filter on segment " << segment_id() << ": " << pred->debug_string();
+    return Status::OK();
 }
 
 StatusOr<std::shared_ptr<Segment>> SegmentIterator::_get_dcg_segment(uint32_t ucid) {
@@ -574,8 +683,11 @@ Status SegmentIterator::_init_column_iterator_by_cid(const ColumnId cid, const C
             opts.encryption_info = *encryption_info;
         }
         ASSIGN_OR_RETURN(auto rfile, _opts.fs->new_random_access_file(opts, _segment->file_info()));
-        if (config::io_coalesce_lake_read_enable && !_segment->is_default_column(col) &&
-            _segment->lake_tablet_manager() != nullptr) {
+        const bool is_lake = _segment->lake_tablet_manager() != nullptr;
+        // Read the pages of the local segments in batches only if they are not served by the page cache.
+        const bool batch_read = !is_lake && config::io_uring_segment_read_enable && !iter_opts.use_page_cache;
+        if (!_segment->is_default_column(col) &&
+            ((config::io_coalesce_lake_read_enable && is_lake) || batch_read)) {
             ASSIGN_OR_RETURN(auto file_size, rfile->get_size());
             auto shared_buffered_input_stream =
                     std::make_unique<io::SharedBufferedInputStream>(rfile->stream(), _segment->file_name(), file_size);
@@ -585,10 +697,20 @@ Status SegmentIterator::_init_column_iterator_by_cid(const ColumnId cid, const C
             shared_buffered_input_stream->set_coalesce_options(options);
             iter_opts.read_file = shared_buffered_input_stream.get();
             iter_opts.is_io_coalesce = true;
+            if (batch_read) {
+                _batch_read_files[cid] = shared_buffered_input_stream.get();
+            }
             _column_files[cid] = std::move(shared_buffered_input_stream);
             _io_coalesce_column_index.emplace_back(cid);
         } else {
             iter_opts.read_file = rfile.get();
+            if (!is_lake && config::enable_segment_page_prefetch && !_segment->is_default_column(col)) {
+                if (_page_prefetcher == nullptr) {
+                    _page_prefetcher = std::make_unique<PagePrefetcher>(_opts.stats,
+                                                                        config::segment_page_prefetch_max_depth);
+                }
+                _page_prefetcher->add_column(cid, _column_iterators[cid].get(), rfile.get());
+            }
             _column_files[cid] = std::move(rfile);
         }
     } else {
@@ -629,7 +751,7 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
                 // we will try to load the dictionary code
                 check_dict_enc = _predicate_need_rewrite[cid];
             } else {
-                check_dict_enc = has_predicate;
+                check_dict_enc = has_predicate || _runtime_filter_columns.count(cid);
             }
 
             RETURN_IF_ERROR(_init_column_iterator_by_cid(cid, f->uid(), check_dict_enc));
@@ -700,6 +822,62 @@ void SegmentIterator::_init_column_predicates() {
                                   &non_expr_pred_root);
     _expr_pred_tree = PredicateTree::create(std::move(expr_pred_root));
     _non_expr_pred_tree = PredicateTree::create(std::move(non_expr_pred_root));
+    if (config::enable_adaptive_predicate_order) {
+        _expr_pred_order.init(_expr_pred_tree);
+    }
+}
+
+// Whether the pages of the column have a fast path to evaluate a predicate on the encoded values, see
+// PageDecoder::evaluate_next_batch(). The other pages, e.g. BIT_SHUFFLE ones and the ones with null, are decoded to
+// evaluate the predicate and decoded again to read the selected rows, which costs more than filtering the rows read.
+static bool has_encoded_predicate_fast_path(ColumnIterator* iter) {
+    const ColumnReader* reader = iter->get_column_reader();
+    if (reader == nullptr || reader->encoding_info() == nullptr) {
+        return false;
+    }
+    if (reader->is_nullable()) {
+        const ZoneMapPB* zone_map = reader->segment_zone_map();
+        if (zone_map == nullptr || !zone_map->has_has_null() || zone_map->has_null()) {
+            return false;
+        }
+    }
+    switch (reader->encoding_info()->encoding()) {
+    case RLE:
+    case FOR_ENCODING:
+    case FSST_ENCODING:
+    case DELTA_ENCODING:
+        return true;
+    case DICT_ENCODING:
+        // only the binary dictionary pages evaluate the predicate on the dictionary words
+        return is_string_type(reader->column_type());
+    default:
+        return false;
+    }
+}
+
+void SegmentIterator::_init_encoded_predicate() {
+    if (!config::enable_segment_encoded_predicate || _non_expr_pred_tree.size() != 1 ||
+        !_non_expr_pred_tree.root().compound_children().empty()) {
+        return;
+    }
+    const auto& [cid, preds] = *_non_expr_pred_tree.get_immediate_column_predicate_map().begin();
+    DCHECK_EQ(1, preds.size());
+    if (!preds[0]->can_vectorized()) {
+        return;
+    }
+    _encoded_pred = preds[0];
+    for (auto& ctx : _context_list) {
+        for (size_t i = 0; i < ctx._column_iterators.size(); i++) {
+            // the dictionary codes are read for the dict columns, and the predicate is rewritten on them
+            if (ctx._read_schema.field(i)->id() == cid && !ctx._is_dict_column[i] &&
+                !(ctx._prune_column_after_index_filter && ctx._prune_cols.count(i))) {
+                if (has_encoded_predicate_fast_path(ctx._column_iterators[i])) {
+                    ctx._encoded_pred_index = static_cast<int>(i);
+                }
+                break;
+            }
+        }
+    }
 }
 
 Status SegmentIterator::_get_row_ranges_by_keys() {
@@ -1080,6 +1258,7 @@ Status SegmentIterator::_read_columns(const Schema& schema, Chunk* chunk, size_t
 inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size_t n) {
     size_t read_num = 0;
     SparseRange<> range;
+    SparseRange<> selected_range;
 
     if (_cur_rowid != _range_iter.begin() || _cur_rowid == 0) {
         _cur_rowid = _range_iter.begin();
@@ -1088,19 +1267,45 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
         RETURN_IF_ERROR(_context->seek_columns(_cur_rowid));
     }
 
+    if (_page_prefetcher != nullptr) {
+        auto st = _page_prefetcher->prefetch(_context->_read_schema, _range_iter, n);
+        if (!st.ok()) {
+            // prefetch is only a hint, stop prefetching and read the pages as usual
+            VLOG(2) << "prefetch pages of segment " << _segment->file_name() << " failed: " << st;
+            _page_prefetcher.reset();
+        }
+    }
+
     _range_iter.next_range(n, &range);
     read_num += range.span_size();
 
     {
         _opts.stats->blocks_load += 1;
         SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
-        RETURN_IF_ERROR(_context->read_columns(chunk, range));
+        if (!_batch_read_files.empty()) {
+            RETURN_IF_ERROR(_read_pages_in_batch(range));
+        }
+        const int64_t prev_io_ns = _opts.stats->io_ns;
+        const int64_t prev_io_count = _opts.stats->io_count_request;
+        _encoded_pred_applied = false;
+        if (_context->_encoded_pred_index >= 0) {
+            ASSIGN_OR_RETURN(_encoded_pred_applied, _filter_by_encoded_predicate(range, &selected_range));
+        }
+        if (!_encoded_pred_applied) {
+            RETURN_IF_ERROR(_context->read_columns(chunk, range));
+        } else if (!selected_range.empty()) {
+            RETURN_IF_ERROR(_context->read_columns(chunk, selected_range));
+        }
+        if (_page_prefetcher != nullptr) {
+            _page_prefetcher->update(_opts.stats->io_ns - prev_io_ns, _opts.stats->io_count_request - prev_io_count);
+        }
         chunk->check_or_die();
     }
 
+    const SparseRange<>& read_range = _encoded_pred_applied ? selected_range : range;
     if (rowids != nullptr) {
         rowids->reserve(rowids->size() + n);
-        SparseRangeIterator<> iter = range.new_iterator();
+        SparseRangeIterator<> iter = read_range.new_iterator();
         while (iter.has_more()) {
             Range<> r = iter.next(n);
             for (uint32_t i = r.begin(); i < r.end(); i++) {
@@ -1109,12 +1314,111 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
         }
     }
 
-    _cur_rowid = range.end();
+    if (!_encoded_pred_applied) {
+        _cur_rowid = range.end();
+    } else if (!selected_range.empty()) {
+        // the columns are sought again by the next _read() if they are not at the beginning of the next range
+        _cur_rowid = selected_range.end();
+    } else {
+        // only the column of the predicate is moved to the end of |range|, make the next _read() seek the columns
+        _cur_rowid = range.begin();
+    }
     _opts.stats->raw_rows_read += read_num;
     chunk->check_or_die();
     return Status::OK();
 }
 
+// Evaluate |_encoded_pred| on the rows of |range| by the column iterator of its column, which evaluates it on the
+// encoded values of the pages if the encoding supports it, e.g. once for each run of RLE pages, and decodes the values
+// otherwise. The selected rows are put into |selected|, and the columns are positioned at its beginning to read them.
+// Return false if the column iterator does not support it, and the columns are not moved then.
+StatusOr<bool> SegmentIterator::_filter_by_encoded_predicate(const SparseRange<>& range, SparseRange<>* selected) {
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
+    ColumnIterator* iter = _context->_column_iterators[_context->_encoded_pred_index];
+    DCHECK_LE(range.span_size(), _selection.size());
+    {
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+        size_t offset = 0;
+        for (size_t i = 0; i < range.size(); i++) {
+            const Range<>& r = range[i];
+            if (i > 0) {
+                RETURN_IF_ERROR(iter->seek_to_ordinal(r.begin()));
+            }
+            size_t nread = r.span_size();
+            auto st = iter->evaluate_next_batch(*_encoded_pred, &nread, _selection.data() + offset);
+            if (st.is_not_supported()) {
+                DCHECK_EQ(0, i);
+                _context->_encoded_pred_index = -1;
+                return false;
+            }
+            RETURN_IF_ERROR(st);
+            DCHECK_EQ(r.span_size(), nread);
+            offset += nread;
+        }
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < range.size(); i++) {
+        const Range<>& r = range[i];
+        size_t begin = 0;
+        while (begin < r.span_size()) {
+            while (begin < r.span_size() && !_selection[offset + begin]) {
+                begin++;
+            }
+            size_t end = begin;
+            while (end < r.span_size() && _selection[offset + end]) {
+                end++;
+            }
+            if (begin < end) {
+                selected->add(Range<>(r.begin() + begin, r.begin() + end));
+            }
+            begin = end;
+        }
+        offset += r.span_size();
+    }
+
+    const size_t filtered = range.span_size() - selected->span_size();
+    _opts.stats->rows_vec_cond_filtered += filtered;
+    _opts.stats->rows_encoded_cond_filtered += filtered;
+    if (!selected->empty()) {
+        if (selected->begin() != range.begin()) {
+            RETURN_IF_ERROR(_context->seek_columns(selected->begin()));
+        } else {
+            RETURN_IF_ERROR(iter->seek_to_ordinal(selected->begin()));
+        }
+    }
+    return true;
+}
+
+// Read the pages of |range| of all the columns to be read by the current context in one batch, instead of
+// reading them one by one when each column iterator loads its next page. The late materialized columns are
+// not included, as their pages may not be needed at all.
+Status SegmentIterator::_read_pages_in_batch(const SparseRange<>& range) {
+    std::vector<io::IoUringReader::Request> requests;
+    std::vector<io::SharedBufferedInputStream::IORange> io_ranges;
+    for (const FieldPtr& f : _context->_read_schema.fields()) {
+        auto iter = _batch_read_files.find(f->id());
+        if (iter == _batch_read_files.end()) {
+            continue;
+        }
+        io_ranges.clear();
+        RETURN_IF_ERROR(_column_iterators[f->id()]->get_io_ranges(range, &io_ranges));
+        if (io_ranges.empty()) {
+            continue;
+        }
+        if (_opts.asc_hint) {
+            // the pages before this chunk would not be read again
+            iter->second->release_to_offset(io_ranges.front().offset);
+        }
+        RETURN_IF_ERROR(iter->second->collect_unread_buffers(io_ranges, &requests));
+    }
+    if (requests.empty()) {
+        return Status::OK();
+    }
+    SCOPED_RAW_TIMER(&_opts.stats->io_ns);
+    return io::IoUringReader::read(requests);
+}
+
 Status SegmentIterator::do_get_next(Chunk* chunk) {
     if (!_inited) {
         RETURN_IF_ERROR(_init());
@@ -1198,7 +1502,7 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
         chunk->check_or_die();
         size_t next_start = chunk->num_rows();
 
-        if (has_non_expr_predicate) {
+        if (has_non_expr_predicate && !_encoded_pred_applied) {
             ASSIGN_OR_RETURN(next_start, _filter_by_non_expr_predicates(chunk, rowid, chunk_start, next_start));
             chunk->check_or_die();
         }
@@ -1212,6 +1516,9 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
     size_t raw_chunk_size = chunk->num_rows();
 
+    if (!_runtime_filter_predicates.empty()) {
+        RETURN_IF_ERROR(_filter_by_runtime_filter_predicates(chunk, rowid));
+    }
     ASSIGN_OR_RETURN(size_t chunk_size, _filter_by_expr_predicates(chunk, rowid));
 
     _opts.stats->block_load_ns += sw.elapsed_time();
@@ -1386,6 +1693,9 @@ StatusOr<uint16_t> SegmentIterator::_filter_by_non_expr_predicates(Chunk* chunk,
 
 StatusOr<uint16_t> SegmentIterator::_filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid) {
     size_t chunk_size = chunk->num_rows();
+    if (chunk_size > 0 && _expr_pred_order.num_children() > 1) {
+        return _filter_by_expr_predicates_adaptively(chunk, rowid);
+    }
     if (chunk_size > 0 && !_expr_pred_tree.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->expr_cond_evaluate_ns);
         RETURN_IF_ERROR(_expr_pred_tree.evaluate(chunk, _selection.data(), 0, chunk_size));
@@ -1411,6 +1721,80 @@ StatusOr<uint16_t> SegmentIterator::_filter_by_expr_predicates(Chunk* chunk, vec
     return chunk_size;
 }
 
+StatusOr<uint16_t> SegmentIterator::_filter_by_runtime_filter_predicates(Chunk* chunk, vector<rowid_t>* rowid) {
+    size_t chunk_size = chunk->num_rows();
+    if (chunk_size == 0) {
+        return chunk_size;
+    }
+    SCOPED_RAW_TIMER(&_opts.stats->runtime_filter_evaluate_ns);
+    bool first = true;
+    for (const auto& [cid, pred] : _runtime_filter_predicates) {
+        const Column* column = chunk->get_column_by_id(cid).get();
+        if (first) {
+            RETURN_IF_ERROR(pred->evaluate(column, _selection.data(), 0, chunk_size));
+            first = false;
+        } else {
+            RETURN_IF_ERROR(pred->evaluate_and(column, _selection.data(), 0, chunk_size));
+        }
+    }
+
+    size_t hit_count = SIMD::count_nonzero(_selection.data(), chunk_size);
+    size_t new_size = chunk_size;
+    if (hit_count == 0) {
+        chunk->set_num_rows(0);
+        new_size = 0;
+        if (rowid != nullptr) {
+            rowid->resize(0);
+        }
+    } else if (hit_count != chunk_size) {
+        new_size = chunk->filter_range(_selection, 0, chunk_size);
+        if (rowid != nullptr) {
+            auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), 0, chunk_size);
+            rowid->resize(size);
+        }
+    }
+    _opts.stats->rows_runtime_filter_filtered += (chunk_size - new_size);
+    return new_size;
+}
+
+// Evaluate the expr predicates one by one in the order decided by |_expr_pred_order|, and filter the chunk after
+// each of them, so that the expensive predicates only evaluate the rows passed by the cheap and selective ones.
+StatusOr<uint16_t> SegmentIterator::_filter_by_expr_predicates_adaptively(Chunk* chunk, vector<rowid_t>* rowid) {
+    SCOPED_RAW_TIMER(&_opts.stats->expr_cond_evaluate_ns);
+    const size_t raw_chunk_size = chunk->num_rows();
+    size_t chunk_size = raw_chunk_size;
+    for (size_t i = 0; i < _expr_pred_order.num_children() && chunk_size > 0; i++) {
+        int64_t cost_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&cost_ns);
+            RETURN_IF_ERROR(_expr_pred_tree.evaluate_child(_expr_pred_order.child(i), chunk, _selection.data(), 0,
+                                                           chunk_size));
+        }
+        const size_t hit_count = SIMD::count_nonzero(_selection.data(), chunk_size);
+        _expr_pred_order.update(i, cost_ns, chunk_size, hit_count);
+
+        if (hit_count == 0) {
+            chunk->set_num_rows(0);
+            if (rowid != nullptr) {
+                rowid->resize(0);
+            }
+        } else if (hit_count != chunk_size) {
+            chunk->filter_range(_selection, 0, chunk_size);
+            if (rowid != nullptr) {
+                auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), 0, chunk_size);
+                rowid->resize(size);
+            }
+        }
+        chunk_size = hit_count;
+        DCHECK_EQ(chunk_size, chunk->num_rows());
+    }
+    _opts.stats->rows_vec_cond_filtered += (raw_chunk_size - chunk_size);
+    if (_expr_pred_order.finish_chunk()) {
+        _opts.stats->expr_cond_reorder_count++;
+    }
+    return chunk_size;
+}
+
 inline bool SegmentIterator::_can_using_dict_code(const FieldPtr& field) const {
     if (field->type()->type() == TYPE_ARRAY) {
         return false;
@@ -1418,7 +1802,8 @@ inline bool SegmentIterator::_can_using_dict_code(const FieldPtr& field) const {
     if (_opts.pred_tree.contains_column(field->id())) {
         return _predicate_need_rewrite[field->id()];
     } else {
-        return (_bitmap_index_evaluator.has_bitmap_index() || !_opts.pred_tree.empty()) &&
+        return (_bitmap_index_evaluator.has_bitmap_index() || !_opts.pred_tree.empty() ||
+                _runtime_filter_columns.count(field->id())) &&
                _column_iterators[field->id()]->all_page_dict_encoded();
     }
 }
@@ -1592,10 +1977,19 @@ Status SegmentIterator::_init_context() {
 
     RETURN_IF_ERROR(_init_global_dict_decoder());
 
-    if (_predicate_columns == 0 || _opts.pred_tree.empty() ||
+    if (_predicate_columns == 0 || (_opts.pred_tree.empty() && _runtime_filter_columns.empty()) ||
         (_predicate_columns >= _schema.num_fields() && _predicate_column_access_paths.empty())) {
         // non or all field has predicate, disable late materialization.
         RETURN_IF_ERROR(_build_context<false>(&_context_list[0]));
+    } else if (_opts.pred_tree.empty()) {
+        // Only the runtime filters, which may not arrive, could filter the rows, so start without late
+        // materialization, and switch to it once the runtime filters arrive and filter enough rows.
+        RETURN_IF_ERROR(_build_context<false>(&_context_list[0]));
+        if (_late_materialization_ratio > 0) {
+            RETURN_IF_ERROR(_build_context<true>(&_context_list[1]));
+            _context_list[0]._next = &_context_list[1];
+            _context_list[1]._next = &_context_list[0];
+        }
     } else {
         // metric column default enable late materialization
         for (const auto& field : _schema.fields()) {
@@ -1703,7 +2097,8 @@ Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
 
 Status SegmentIterator::_check_low_cardinality_optimization() {
     _predicate_need_rewrite.resize(1 + ChunkHelper::max_column_id(_schema), false);
-    const size_t n = _opts.pred_tree.num_columns();
+    // the predicate columns may be mixed with the columns of the runtime filters
+    const size_t n = _predicate_columns;
     for (size_t i = 0; i < n; i++) {
         const FieldPtr& field = _schema.field(i);
         const LogicalType type = field->type()->type();
@@ -1807,7 +2202,7 @@ static void erase_column_pred_from_pred_tree(PredicateTree& pred_tree,
 Status SegmentIterator::_apply_bitmap_index() {
     RETURN_IF(!config::enable_index_bitmap_filter, Status::OK());
     RETURN_IF(_scan_range.empty(), Status::OK());
-    DCHECK_EQ(_predicate_columns, _opts.pred_tree.num_columns());
+    DCHECK_LE(_opts.pred_tree.num_columns(), _predicate_columns);
 
     {
         SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_iterator_init_ns);
@@ -1819,24 +2214,8 @@ Status SegmentIterator::_apply_bitmap_index() {
 
         RETURN_IF_ERROR(
                 _bitmap_index_evaluator.init([&cid_2_ucid, this](ColumnId cid) -> StatusOr<BitmapIndexIterator*> {
-                    const ColumnUID ucid = cid_2_ucid[cid];
-                    // the column's index in this segment file
-                    ASSIGN_OR_RETURN(std::shared_ptr<Segment> segment_ptr, _get_dcg_segment(ucid));
-                    if (segment_ptr == nullptr) {
-                        // find segment from delta column group failed, using main segment
-                        segment_ptr = _segment;
-                    }
-
-                    IndexReadOptions opts;
-                    opts.use_page_cache = !_opts.temporary_data && (config::enable_bitmap_index_memory_page_cache ||
-                                                                    !config::disable_storage_page_cache);
-                    opts.kept_in_memory = !_opts.temporary_data && config::enable_bitmap_index_memory_page_cache;
-                    opts.lake_io_opts = _opts.lake_io_opts;
-                    opts.read_file = _column_files[cid].get();
-                    opts.stats = _opts.stats;
-
                     BitmapIndexIterator* bitmap_iter = nullptr;
-                    RETURN_IF_ERROR(segment_ptr->new_bitmap_index_iterator(ucid, opts, &bitmap_iter));
+                    RETURN_IF_ERROR(_new_bitmap_index_iterator(cid, cid_2_ucid[cid], &bitmap_iter));
                     return bitmap_iter;
                 }));
 
@@ -1853,6 +2232,74 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+Status SegmentIterator::_new_bitmap_index_iterator(ColumnId cid, ColumnUID ucid, BitmapIndexIterator** iter) {
+    // the column's index in this segment file
+    ASSIGN_OR_RETURN(std::shared_ptr<Segment> segment_ptr, _get_dcg_segment(ucid));
+    if (segment_ptr == nullptr) {
+        // find segment from delta column group failed, using main segment
+        segment_ptr = _segment;
+    }
+
+    IndexReadOptions opts;
+    opts.use_page_cache = !_opts.temporary_data &&
+                          (config::enable_bitmap_index_memory_page_cache || !config::disable_storage_page_cache);
+    opts.kept_in_memory = !_opts.temporary_data && config::enable_bitmap_index_memory_page_cache;
+    opts.lake_io_opts = _opts.lake_io_opts;
+    opts.read_file = _column_files[cid].get();
+    opts.stats = _opts.stats;
+
+    return segment_ptr->new_bitmap_index_iterator(ucid, opts, iter);
+}
+
+// filter rows by the bitmap index with the predicates of a runtime filter. it's only used for the IN predicate of an
+// exact bitset filter, the zone map is good enough for the min/max predicates.
+Status SegmentIterator::_get_row_ranges_by_runtime_bitmap_index(ColumnId cid, const PredicateList& predicates,
+                                                                SparseRange<>* row_ranges) {
+    RETURN_IF(!config::enable_index_bitmap_filter, Status::OK());
+    const bool has_in_predicate = std::any_of(predicates.begin(), predicates.end(), [](const ColumnPredicate* pred) {
+        return pred->type() == PredicateType::kInList;
+    });
+    const bool support_bitmap_filter =
+            std::all_of(predicates.begin(), predicates.end(),
+                        [](const ColumnPredicate* pred) { return pred->support_bitmap_filter(); });
+    RETURN_IF(!has_in_predicate || !support_bitmap_filter, Status::OK());
+
+    const auto& fields = _schema.fields();
+    auto field = std::find_if(fields.begin(), fields.end(), [cid](const FieldPtr& f) { return f->id() == cid; });
+    RETURN_IF(field == fields.end(), Status::OK());
+
+    SCOPED_RAW_TIMER(&_opts.stats->bitmap_index_filter_timer);
+    BitmapIndexIterator* iter = nullptr;
+    RETURN_IF_ERROR(_new_bitmap_index_iterator(cid, (*field)->uid(), &iter));
+    RETURN_IF(iter == nullptr, Status::OK());
+    std::unique_ptr<BitmapIndexIterator> bitmap_iter(iter);
+
+    SparseRange<> dict_ranges;
+    for (size_t i = 0; i < predicates.size(); i++) {
+        SparseRange<> r;
+        const Status st = predicates[i]->seek_bitmap_dictionary(bitmap_iter.get(), &r);
+        // the predicate can't be evaluated by the bitmap index
+        RETURN_IF(st.is_cancelled(), Status::OK());
+        RETURN_IF_ERROR(st);
+        if (i == 0) {
+            dict_ranges = std::move(r);
+        } else {
+            dict_ranges &= r;
+        }
+    }
+
+    Roaring roaring;
+    RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(dict_ranges, &roaring));
+    // the predicates are not pushed down if the runtime filter has null, so the null rows never pass
+    if (bitmap_iter->has_null_bitmap()) {
+        Roaring null_bitmap;
+        RETURN_IF_ERROR(bitmap_iter->read_null_bitmap(&null_bitmap));
+        roaring -= null_bitmap;
+    }
+    *row_ranges &= roaring2range(roaring);
+    return Status::OK();
+}
+
 Status SegmentIterator::_apply_del_vector() {
     RETURN_IF(_scan_range.empty(), Status::OK());
     if (_opts.is_primary_keys && _opts.version > 0 && _del_vec && !_del_vec->empty()) {
@@ -2170,20 +2617,24 @@ void SegmentIterator::close() {
     }
 }
 
-// put the field that has predicated on it ahead of those without one, for handle late
+// put the field that has predicated on it, or the runtime filter on it, ahead of those without one, for handle late
 // materialization easier.
-inline Schema reorder_schema(const Schema& input, const PredicateTree& pred_tree) {
+inline Schema reorder_schema(const Schema& input, const PredicateTree& pred_tree,
+                             const std::unordered_set<ColumnId>& runtime_filter_columns) {
     const std::vector<FieldPtr>& fields = input.fields();
+    auto read_first = [&](const FieldPtr& field) {
+        return pred_tree.contains_column(field->id()) || runtime_filter_columns.count(field->id());
+    };
 
     Schema output;
     output.reserve(fields.size());
     for (const auto& field : fields) {
-        if (pred_tree.contains_column(field->id())) {
+        if (read_first(field)) {
             output.append(field);
         }
     }
     for (const auto& field : fields) {
-        if (!pred_tree.contains_column(field->id())) {
+        if (!read_first(field)) {
             output.append(field);
         }
     }
@@ -2192,10 +2643,12 @@ inline Schema reorder_schema(const Schema& input, const PredicateTree& pred_tree
 
 ChunkIteratorPtr new_segment_iterator(const std::shared_ptr<Segment>& segment, const Schema& schema,
                                       const SegmentReadOptions& options) {
-    if (options.pred_tree.empty() || options.pred_tree.num_columns() >= schema.num_fields()) {
+    const std::unordered_set<ColumnId> runtime_filter_columns = get_runtime_filter_columns(schema, options);
+    const size_t read_first_columns = options.pred_tree.num_columns() + runtime_filter_columns.size();
+    if (read_first_columns == 0 || read_first_columns >= schema.num_fields()) {
         return std::make_shared<SegmentIterator>(segment, schema, options);
     } else {
-        Schema ordered_schema = reorder_schema(schema, options.pred_tree);
+        Schema ordered_schema = reorder_schema(schema, options.pred_tree, runtime_filter_columns);
         auto seg_iter = std::make_shared<SegmentIterator>(segment, ordered_schema, options);
         return new_projection_iterator(schema, seg_iter);
     }
@@ -132,7 +132,10 @@ DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
     case DICT_ENCODING: {
         return &g_binary_dict_decoder;
     }
+    case ALP_ENCODING:
+    case DELTA_ENCODING:
     case FOR_ENCODING:
+    case FSST_ENCODING:
     case PLAIN_ENCODING:
     case PREFIX_ENCODING:
     case RLE: {
@@ -0,0 +1,440 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/alp_coding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/logging.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+template <typename T>
+struct AlpTraits;
+
+template <>
+struct AlpTraits<double> {
+    using UInt = uint64_t;
+    static constexpr int kMaxExponent = 18;
+    // The number of bits to store the leading zeros and the length of the meaningful bits of XOR.
+    static constexpr int kXorLengthBits = 6;
+};
+
+template <>
+struct AlpTraits<float> {
+    using UInt = uint32_t;
+    static constexpr int kMaxExponent = 10;
+    static constexpr int kXorLengthBits = 5;
+};
+
+// The floats are scaled in double, so that the product rounded to float is the closest one to the decimal.
+static constexpr double kExp10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+static constexpr double kFrac10[] = {1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+                                     1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+
+// The scaled values out of this range are exceptions, which keeps the conversion to int64_t defined.
+static constexpr double kMaxEncodable = static_cast<double>(1LL << 62);
+// The number of values sampled from a vector to choose the exponent and factor of ALP.
+static constexpr size_t kAlpSampleSize = 32;
+// scheme (8-bit) + exponent (8-bit) + factor (8-bit) + bit width (8-bit) + base (64-bit) + num_exceptions (16-bit)
+static constexpr size_t kAlpHeaderSize = 14;
+
+template <typename T>
+static inline T alp_decode_value(int64_t encoded, double exp10_factor, double frac10_exponent) {
+    return static_cast<T>(static_cast<double>(encoded) * exp10_factor * frac10_exponent);
+}
+
+// Return false if |value| could not be restored from the encoded integer.
+template <typename T>
+static inline bool alp_encode_value(T value, int exponent, int factor, int64_t* encoded) {
+    const double scaled = static_cast<double>(value) * kExp10[exponent] * kFrac10[factor];
+    if (!(scaled >= -kMaxEncodable && scaled <= kMaxEncodable)) {
+        return false;
+    }
+    *encoded = static_cast<int64_t>(std::nearbyint(scaled));
+    const T decoded = alp_decode_value<T>(*encoded, kExp10[factor], kFrac10[exponent]);
+    // compare the bits to tell -0.0 from 0.0
+    return memcmp(&decoded, &value, sizeof(T)) == 0;
+}
+
+static inline int bit_width(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+template <typename T>
+void AlpEncoder<T>::put_batch(const T* values, size_t count) {
+    _num_values += count;
+    if (_values.empty()) {
+        // encode the full vectors directly
+        while (count >= kAlpVectorSize) {
+            _encode_vector(values, kAlpVectorSize);
+            values += kAlpVectorSize;
+            count -= kAlpVectorSize;
+        }
+    }
+    while (count > 0) {
+        const size_t n = std::min(count, kAlpVectorSize - _values.size());
+        _values.insert(_values.end(), values, values + n);
+        values += n;
+        count -= n;
+        if (_values.size() == kAlpVectorSize) {
+            _encode_vector(_values.data(), _values.size());
+            _values.clear();
+        }
+    }
+}
+
+template <typename T>
+void AlpEncoder<T>::flush() {
+    if (!_values.empty()) {
+        _encode_vector(_values.data(), _values.size());
+        _values.clear();
+    }
+    put_fixed32_le(_buffer, _num_values);
+}
+
+template <typename T>
+void AlpEncoder<T>::_encode_vector(const T* values, size_t count) {
+    _encode_alp(values, count, &_alp_buffer);
+    const faststring* best = &_alp_buffer;
+    // Try XOR only if ALP does not compress the values well.
+    if (_alp_buffer.size() > count * sizeof(T) / 2) {
+        _encode_xor(values, count, &_xor_buffer);
+        if (_xor_buffer.size() < best->size()) {
+            best = &_xor_buffer;
+        }
+    }
+    if (best->size() >= 1 + count * sizeof(T)) {
+        put_fixed32_le(_buffer, 1 + count * sizeof(T));
+        _buffer->push_back(static_cast<uint8_t>(AlpScheme::PLAIN));
+        _buffer->append(values, count * sizeof(T));
+    } else {
+        put_fixed32_le(_buffer, best->size());
+        _buffer->append(best->data(), best->size());
+    }
+}
+
+template <typename T>
+void AlpEncoder<T>::_encode_alp(const T* values, size_t count, faststring* output) {
+    using Traits = AlpTraits<T>;
+    // Choose the exponent and factor with the smallest estimated size on the sample.
+    const size_t step = std::max<size_t>(1, count / kAlpSampleSize);
+    int best_exponent = 0;
+    int best_factor = 0;
+    uint64_t best_cost = std::numeric_limits<uint64_t>::max();
+    for (int exponent = 0; exponent <= Traits::kMaxExponent; exponent++) {
+        for (int factor = 0; factor <= exponent; factor++) {
+            size_t num_exceptions = 0;
+            size_t num_samples = 0;
+            int64_t min = std::numeric_limits<int64_t>::max();
+            int64_t max = std::numeric_limits<int64_t>::min();
+            for (size_t i = 0; i < count; i += step) {
+                int64_t encoded;
+                if (alp_encode_value<T>(values[i], exponent, factor, &encoded)) {
+                    min = std::min(min, encoded);
+                    max = std::max(max, encoded);
+                } else {
+                    num_exceptions++;
+                }
+                num_samples++;
+            }
+            const int width = min <= max ? bit_width(static_cast<uint64_t>(max) - static_cast<uint64_t>(min)) : 0;
+            const uint64_t cost = num_samples * width + num_exceptions * (sizeof(T) + sizeof(uint16_t)) * 8;
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_exponent = exponent;
+                best_factor = factor;
+            }
+        }
+    }
+
+    _ints.resize(count);
+    _exception_positions.clear();
+    int64_t min = std::numeric_limits<int64_t>::max();
+    int64_t max = std::numeric_limits<int64_t>::min();
+    for (size_t i = 0; i < count; i++) {
+        if (alp_encode_value<T>(values[i], best_exponent, best_factor, &_ints[i])) {
+            min = std::min(min, _ints[i]);
+            max = std::max(max, _ints[i]);
+        } else {
+            _exception_positions.push_back(i);
+        }
+    }
+    if (min > max) {
+        // all values are exceptions
+        min = max = 0;
+    }
+    // The exceptions are filled with the base, which does not widen the bit width.
+    for (uint16_t pos : _exception_positions) {
+        _ints[pos] = min;
+    }
+    const int width = bit_width(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+
+    output->clear();
+    output->push_back(static_cast<uint8_t>(AlpScheme::ALP));
+    output->push_back(static_cast<uint8_t>(best_exponent));
+    output->push_back(static_cast<uint8_t>(best_factor));
+    output->push_back(static_cast<uint8_t>(width));
+    put_fixed64_le(output, static_cast<uint64_t>(min));
+    uint8_t num_exceptions[sizeof(uint16_t)];
+    encode_fixed16_le(num_exceptions, _exception_positions.size());
+    output->append(num_exceptions, sizeof(num_exceptions));
+    if (width > 0) {
+        faststring packed;
+        BitWriter writer(&packed);
+        for (size_t i = 0; i < count; i++) {
+            writer.PutValue(static_cast<uint64_t>(_ints[i]) - static_cast<uint64_t>(min), width);
+        }
+        writer.Flush();
+        output->append(packed.data(), packed.size());
+    }
+    for (uint16_t pos : _exception_positions) {
+        uint8_t buf[sizeof(uint16_t)];
+        encode_fixed16_le(buf, pos);
+        output->append(buf, sizeof(buf));
+    }
+    for (uint16_t pos : _exception_positions) {
+        output->append(&values[pos], sizeof(T));
+    }
+}
+
+template <typename T>
+void AlpEncoder<T>::_encode_xor(const T* values, size_t count, faststring* output) {
+    using Traits = AlpTraits<T>;
+    using UInt = typename Traits::UInt;
+    constexpr int kBits = sizeof(T) * 8;
+
+    faststring bits;
+    BitWriter writer(&bits);
+    UInt prev;
+    memcpy(&prev, &values[0], sizeof(T));
+    writer.PutValue(prev, kBits);
+    // the window of the meaningful bits of the previous XOR
+    int prev_leading = -1;
+    int prev_trailing = 0;
+    for (size_t i = 1; i < count; i++) {
+        UInt cur;
+        memcpy(&cur, &values[i], sizeof(T));
+        const UInt x = cur ^ prev;
+        prev = cur;
+        if (x == 0) {
+            writer.PutValue(0, 1);
+            continue;
+        }
+        writer.PutValue(1, 1);
+        const int leading = __builtin_clzll(x) - (64 - kBits);
+        const int trailing = __builtin_ctzll(x);
+        if (prev_leading >= 0 && leading >= prev_leading && trailing >= prev_trailing) {
+            // reuse the window of the previous XOR
+            writer.PutValue(0, 1);
+            writer.PutValue(x >> prev_trailing, kBits - prev_leading - prev_trailing);
+        } else {
+            const int length = kBits - leading - trailing;
+            writer.PutValue(1, 1);
+            writer.PutValue(leading, Traits::kXorLengthBits);
+            writer.PutValue(length - 1, Traits::kXorLengthBits);
+            writer.PutValue(x >> trailing, length);
+            prev_leading = leading;
+            prev_trailing = trailing;
+        }
+    }
+    writer.Flush();
+
+    output->clear();
+    output->push_back(static_cast<uint8_t>(AlpScheme::XOR));
+    output->append(bits.data(), bits.size());
+}
+
+template <typename T>
+bool AlpDecoder<T>::init() {
+    if (_size < sizeof(uint32_t)) {
+        return false;
+    }
+    _num_values = decode_fixed32_le(_data + _size - sizeof(uint32_t));
+    const size_t num_vectors = (static_cast<size_t>(_num_values) + kAlpVectorSize - 1) / kAlpVectorSize;
+    const size_t end = _size - sizeof(uint32_t);
+    _vector_offsets.clear();
+    _vector_offsets.reserve(num_vectors + 1);
+    size_t offset = 0;
+    for (size_t i = 0; i < num_vectors; i++) {
+        if (offset + sizeof(uint32_t) + 1 > end) {
+            return false;
+        }
+        _vector_offsets.push_back(offset);
+        offset += sizeof(uint32_t) + decode_fixed32_le(_data + offset);
+    }
+    if (offset != end) {
+        return false;
+    }
+    _vector_offsets.push_back(offset);
+    _cur_index = 0;
+    _cached_vector = -1;
+    return true;
+}
+
+template <typename T>
+bool AlpDecoder<T>::get_batch(T* output, size_t count) {
+    if (_cur_index + count > _num_values) {
+        return false;
+    }
+    while (count > 0) {
+        const size_t idx = _cur_index / kAlpVectorSize;
+        const size_t pos = _cur_index % kAlpVectorSize;
+        const size_t vector_size = std::min<size_t>(kAlpVectorSize, _num_values - idx * kAlpVectorSize);
+        const size_t n = std::min(count, vector_size - pos);
+        if (pos == 0 && n == vector_size) {
+            if (!_decode_vector(idx, output)) {
+                return false;
+            }
+        } else {
+            if (_cached_vector != static_cast<int64_t>(idx)) {
+                _vector_values.resize(vector_size);
+                if (!_decode_vector(idx, _vector_values.data())) {
+                    _cached_vector = -1;
+                    return false;
+                }
+                _cached_vector = idx;
+            }
+            memcpy(output, _vector_values.data() + pos, n * sizeof(T));
+        }
+        output += n;
+        count -= n;
+        _cur_index += n;
+    }
+    return true;
+}
+
+template <typename T>
+bool AlpDecoder<T>::_decode_vector(size_t idx, T* output) {
+    const size_t count = std::min<size_t>(kAlpVectorSize, _num_values - idx * kAlpVectorSize);
+    const uint8_t* data = _data + _vector_offsets[idx] + sizeof(uint32_t);
+    const size_t size = _vector_offsets[idx + 1] - _vector_offsets[idx] - sizeof(uint32_t);
+    switch (static_cast<AlpScheme>(data[0])) {
+    case AlpScheme::ALP:
+        return _decode_alp(data, size, count, output);
+    case AlpScheme::XOR:
+        return _decode_xor(data + 1, size - 1, count, output);
+    case AlpScheme::PLAIN:
+        if (size != 1 + count * sizeof(T)) {
+            return false;
+        }
+        memcpy(output, data + 1, count * sizeof(T));
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <typename T>
+bool AlpDecoder<T>::_decode_alp(const uint8_t* data, size_t size, size_t count, T* output) {
+    using Traits = AlpTraits<T>;
+    if (size < kAlpHeaderSize) {
+        return false;
+    }
+    const int exponent = data[1];
+    const int factor = data[2];
+    const int width = data[3];
+    const int64_t base = static_cast<int64_t>(decode_fixed64_le(data + 4));
+    const size_t num_exceptions = decode_fixed16_le(data + 12);
+    const size_t packed_size = (count * width + 7) / 8;
+    if (exponent > Traits::kMaxExponent || factor > exponent || width > 64 ||
+        size != kAlpHeaderSize + packed_size + num_exceptions * (sizeof(uint16_t) + sizeof(T))) {
+        return false;
+    }
+
+    const uint8_t* packed = data + kAlpHeaderSize;
+    _ints.resize(count);
+    if (width == 0) {
+        std::fill(_ints.begin(), _ints.end(), 0);
+    } else if (BitPacking::UnpackValues(width, packed, packed_size, count, _ints.data()).second !=
+               static_cast<int64_t>(count)) {
+        return false;
+    }
+    const double exp10_factor = kExp10[factor];
+    const double frac10_exponent = kFrac10[exponent];
+    const uint64_t* ints = _ints.data();
+    for (size_t i = 0; i < count; i++) {
+        output[i] = alp_decode_value<T>(static_cast<int64_t>(ints[i] + static_cast<uint64_t>(base)), exp10_factor,
+                                        frac10_exponent);
+    }
+
+    const uint8_t* positions = packed + packed_size;
+    const uint8_t* exceptions = positions + num_exceptions * sizeof(uint16_t);
+    for (size_t i = 0; i < num_exceptions; i++) {
+        const uint16_t pos = decode_fixed16_le(positions + i * sizeof(uint16_t));
+        if (pos >= count) {
+            return false;
+        }
+        memcpy(&output[pos], exceptions + i * sizeof(T), sizeof(T));
+    }
+    return true;
+}
+
+template <typename T>
+bool AlpDecoder<T>::_decode_xor(const uint8_t* data, size_t size, size_t count, T* output) {
+    using Traits = AlpTraits<T>;
+    using UInt = typename Traits::UInt;
+    constexpr int kBits = sizeof(T) * 8;
+
+    BitReader reader(data, size);
+    UInt prev;
+    if (!reader.GetValue(kBits, &prev)) {
+        return false;
+    }
+    memcpy(&output[0], &prev, sizeof(T));
+    int leading = 0;
+    int trailing = 0;
+    for (size_t i = 1; i < count; i++) {
+        uint8_t flag;
+        if (!reader.GetValue(1, &flag)) {
+            return false;
+        }
+        if (flag != 0) {
+            if (!reader.GetValue(1, &flag)) {
+                return false;
+            }
+            if (flag != 0) {
+                int length;
+                if (!reader.GetValue(Traits::kXorLengthBits, &leading) ||
+                    !reader.GetValue(Traits::kXorLengthBits, &length)) {
+                    return false;
+                }
+                trailing = kBits - leading - length - 1;
+                if (trailing < 0) {
+                    return false;
+                }
+            }
+            UInt x;
+            if (!reader.GetValue(kBits - leading - trailing, &x)) {
+                return false;
+            }
+            prev ^= x << trailing;
+        }
+        memcpy(&output[i], &prev, sizeof(T));
+    }
+    return true;
+}
+
+template class AlpEncoder<float>;
+template class AlpEncoder<double>;
+template class AlpDecoder<float>;
+template class AlpDecoder<double>;
+
+} // namespace starrocks
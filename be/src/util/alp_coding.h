@@ -0,0 +1,120 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// Lossless floating-point encoding, see "ALP: Adaptive Lossless floating-Point Compression" (SIGMOD 2024).
+//
+// The values are encoded by vectors of kAlpVectorSize values, and each vector picks one of the schemes:
+//  - ALP: most doubles derived from decimals, e.g. prices and sensor readings, are turned into integers
+//    exactly by d = round(v * 10^e / 10^f), which are encoded by frame of reference and bit packing.
+//    The values which could not be restored from d are stored as exceptions.
+//  - XOR: the values are XORed with the previous ones and the leading and trailing zeros are removed like
+//    Gorilla, which suits the truly random doubles close to each other.
+//  - PLAIN: the values are stored as is, if none of the above saves space.
+//
+// The encoded data consists of:
+//  Vectors:
+//    size of the vector (32-bit fixed), scheme (8-bit), encoded vector
+//  num_values (32-bit fixed)
+static constexpr size_t kAlpVectorSize = 1024;
+
+enum class AlpScheme : uint8_t { ALP = 0, XOR = 1, PLAIN = 2 };
+
+template <typename T>
+class AlpEncoder {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "unexpected type");
+
+public:
+    explicit AlpEncoder(faststring* buffer) : _buffer(buffer) {}
+
+    void put_batch(const T* values, size_t count);
+
+    // Encode the buffered values and append the trailer.
+    void flush();
+
+    // Return the size of the encoded data, including the buffered values as is.
+    size_t len() const { return _buffer->size() + _values.size() * sizeof(T); }
+
+    uint32_t count() const { return _num_values; }
+
+    void clear() {
+        _buffer->clear();
+        _values.clear();
+        _num_values = 0;
+    }
+
+private:
+    void _encode_vector(const T* values, size_t count);
+    void _encode_alp(const T* values, size_t count, faststring* output);
+    void _encode_xor(const T* values, size_t count, faststring* output);
+
+    faststring* _buffer;
+    // the values of the vector not full yet
+    std::vector<T> _values;
+    uint32_t _num_values{0};
+    faststring _alp_buffer;
+    faststring _xor_buffer;
+    std::vector<int64_t> _ints;
+    std::vector<uint16_t> _exception_positions;
+};
+
+template <typename T>
+class AlpDecoder {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "unexpected type");
+
+public:
+    AlpDecoder(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    // Parse the trailer and the sizes of the vectors, return false if the data is corrupted.
+    bool init();
+
+    uint32_t count() const { return _num_values; }
+
+    uint32_t current_index() const { return _cur_index; }
+
+    void seek(uint32_t pos) { _cur_index = pos; }
+
+    // Decode the next |count| values into |output|, return false if the data is corrupted.
+    bool get_batch(T* output, size_t count);
+
+private:
+    // Decode the |idx|-th vector into |output|.
+    bool _decode_vector(size_t idx, T* output);
+    bool _decode_alp(const uint8_t* data, size_t size, size_t count, T* output);
+    bool _decode_xor(const uint8_t* data, size_t size, size_t count, T* output);
+
+    const uint8_t* _data;
+    size_t _size;
+    uint32_t _num_values{0};
+    uint32_t _cur_index{0};
+    // the offsets of the vectors, and the end of the last one
+    std::vector<uint32_t> _vector_offsets;
+
+    // the cached vector to read a part of it
+    std::vector<T> _vector_values;
+    int64_t _cached_vector{-1};
+    std::vector<uint64_t> _ints;
+};
+
+} // namespace starrocks
@@ -80,6 +80,16 @@ public:
     /// remain stable.
     static int get_current_core();
 
+    /// Returns the maximum number of NUMA nodes that will be online in the system.
+    static int get_max_num_numa_nodes() { return max_num_numa_nodes_; }
+
+    /// Returns the NUMA node of the core with index 'core'.
+    static int get_numa_node_of_core(int core) {
+        DCHECK_LE(0, core);
+        DCHECK_LT(core, max_num_cores_);
+        return core_to_numa_node_[core];
+    }
+
     static std::string debug_string();
 
     static const std::vector<long>& get_cache_sizes() {
@@ -0,0 +1,277 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/delta_coding.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/logging.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+static inline uint64_t zigzag_encode(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+static inline int64_t zigzag_decode(uint64_t v) {
+    return static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+template <typename T>
+void DeltaEncoder<T>::put_batch(const T* values, size_t count) {
+    _num_values += count;
+    if (!_values.empty()) {
+        size_t n = std::min(count, kDeltaBlockSize - _values.size());
+        _values.insert(_values.end(), values, values + n);
+        values += n;
+        count -= n;
+        if (_values.size() < kDeltaBlockSize) {
+            return;
+        }
+        _encode_block(_values.data(), _values.size());
+        _values.clear();
+    }
+    while (count >= kDeltaBlockSize) {
+        _encode_block(values, kDeltaBlockSize);
+        values += kDeltaBlockSize;
+        count -= kDeltaBlockSize;
+    }
+    _values.insert(_values.end(), values, values + count);
+}
+
+template <typename T>
+void DeltaEncoder<T>::flush() {
+    if (!_values.empty()) {
+        _encode_block(_values.data(), _values.size());
+        _values.clear();
+    }
+    for (uint32_t offset : _block_offsets) {
+        put_fixed32_le(_buffer, offset);
+    }
+    _block_offsets.clear();
+    put_fixed32_le(_buffer, _num_values);
+}
+
+template <typename T>
+void DeltaEncoder<T>::_encode_block(const T* values, size_t count) {
+    using U = std::make_unsigned_t<T>;
+    DCHECK(count > 0 && count <= kDeltaBlockSize);
+    _block_offsets.push_back(_buffer->size());
+
+    // The deltas wrap around, so do the packed values, which are always less than 2^(bits of T).
+    T deltas[kDeltaBlockSize];
+    const size_t num_deltas = count - 1;
+    T min_value = values[0];
+    T max_value = values[0];
+    T min_delta = 0;
+    for (size_t i = 0; i < num_deltas; i++) {
+        deltas[i] = static_cast<T>(static_cast<U>(values[i + 1]) - static_cast<U>(values[i]));
+        min_value = std::min(min_value, values[i + 1]);
+        max_value = std::max(max_value, values[i + 1]);
+    }
+    if (num_deltas > 0) {
+        min_delta = *std::min_element(deltas, deltas + num_deltas);
+    }
+
+    uint8_t buf[sizeof(T)];
+    memcpy(buf, &values[0], sizeof(T));
+    _buffer->append(buf, sizeof(T));
+    put_varint64(_buffer, zigzag_encode(min_delta));
+    put_varint64(_buffer, static_cast<U>(static_cast<U>(values[0]) - static_cast<U>(min_value)));
+    put_varint64(_buffer, static_cast<U>(static_cast<U>(max_value) - static_cast<U>(values[0])));
+
+    U packed[kDeltaBlockSize];
+    for (size_t i = 0; i < num_deltas; i++) {
+        packed[i] = static_cast<U>(deltas[i]) - static_cast<U>(min_delta);
+    }
+    const size_t num_mini_blocks = (num_deltas + kDeltaMiniBlockSize - 1) / kDeltaMiniBlockSize;
+    uint8_t widths[kDeltaMiniBlocks] = {0};
+    for (size_t m = 0; m < num_mini_blocks; m++) {
+        const size_t end = std::min(num_deltas, (m + 1) * kDeltaMiniBlockSize);
+        U bits = 0;
+        for (size_t i = m * kDeltaMiniBlockSize; i < end; i++) {
+            bits |= packed[i];
+        }
+        widths[m] = bits == 0 ? 0 : 64 - __builtin_clzll(static_cast<uint64_t>(bits));
+    }
+    _buffer->append(widths, kDeltaMiniBlocks);
+
+    faststring mini_block;
+    for (size_t m = 0; m < num_mini_blocks; m++) {
+        if (widths[m] == 0) {
+            continue;
+        }
+        // the last miniblock is padded with zeros, so every miniblock is 4 * width bytes
+        BitWriter writer(&mini_block);
+        const size_t begin = m * kDeltaMiniBlockSize;
+        for (size_t i = begin; i < begin + kDeltaMiniBlockSize; i++) {
+            writer.PutValue(i < num_deltas ? packed[i] : 0, widths[m]);
+        }
+        writer.Flush();
+        _buffer->append(mini_block.data(), mini_block.size());
+    }
+}
+
+template <typename T>
+bool DeltaDecoder<T>::init() {
+    if (_size < sizeof(uint32_t)) {
+        return false;
+    }
+    _num_values = decode_fixed32_le(_data + _size - sizeof(uint32_t));
+    const size_t num_blocks = (static_cast<size_t>(_num_values) + kDeltaBlockSize - 1) / kDeltaBlockSize;
+    if (num_blocks * sizeof(uint32_t) + sizeof(uint32_t) > _size) {
+        return false;
+    }
+    _block_offsets = _data + _size - sizeof(uint32_t) - num_blocks * sizeof(uint32_t);
+    size_t prev = 0;
+    for (size_t i = 0; i < num_blocks; i++) {
+        size_t offset = decode_fixed32_le(_block_offsets + i * sizeof(uint32_t));
+        if (offset < prev || (i == 0 && offset != 0)) {
+            return false;
+        }
+        prev = offset;
+    }
+    if (num_blocks > 0 && _block_offsets - _data < static_cast<ptrdiff_t>(prev + sizeof(T) + 3 + kDeltaMiniBlocks)) {
+        return false;
+    }
+    _cur_index = 0;
+    _cached_block = -1;
+    return true;
+}
+
+template <typename T>
+bool DeltaDecoder<T>::get_batch(T* output, size_t count) {
+    if (_cur_index + count > _num_values) {
+        return false;
+    }
+    while (count > 0) {
+        const size_t idx = _cur_index / kDeltaBlockSize;
+        const size_t pos = _cur_index % kDeltaBlockSize;
+        const size_t block_size = std::min<size_t>(kDeltaBlockSize, _num_values - idx * kDeltaBlockSize);
+        const size_t n = std::min(count, block_size - pos);
+        if (pos == 0 && n == block_size) {
+            if (!_decode_block(idx, output)) {
+                return false;
+            }
+        } else {
+            if (_cached_block != static_cast<int64_t>(idx)) {
+                if (!_decode_block(idx, _block_values)) {
+                    _cached_block = -1;
+                    return false;
+                }
+                _cached_block = idx;
+            }
+            memcpy(output, _block_values + pos, n * sizeof(T));
+        }
+        output += n;
+        count -= n;
+        _cur_index += n;
+    }
+    return true;
+}
+
+template <typename T>
+bool DeltaDecoder<T>::current_block_bounds(T* min, T* max, uint32_t* num_remaining) {
+    using U = std::make_unsigned_t<T>;
+    if (_cur_index >= _num_values) {
+        return false;
+    }
+    const size_t idx = _cur_index / kDeltaBlockSize;
+    const size_t block_size = std::min<size_t>(kDeltaBlockSize, _num_values - idx * kDeltaBlockSize);
+    const uint8_t* p = _data + decode_fixed32_le(_block_offsets + idx * sizeof(uint32_t));
+    const uint8_t* limit = _block_offsets;
+    T first;
+    memcpy(&first, p, sizeof(T));
+    p += sizeof(T);
+    uint64_t min_delta;
+    uint64_t below;
+    uint64_t above;
+    if ((p = decode_varint64_ptr(p, limit, &min_delta)) == nullptr ||
+        (p = decode_varint64_ptr(p, limit, &below)) == nullptr ||
+        (p = decode_varint64_ptr(p, limit, &above)) == nullptr) {
+        return false;
+    }
+    *min = static_cast<T>(static_cast<U>(first) - static_cast<U>(below));
+    *max = static_cast<T>(static_cast<U>(first) + static_cast<U>(above));
+    *num_remaining = block_size - _cur_index % kDeltaBlockSize;
+    return true;
+}
+
+template <typename T>
+bool DeltaDecoder<T>::_decode_block(size_t idx, T* output) {
+    using U = std::make_unsigned_t<T>;
+    const size_t count = std::min<size_t>(kDeltaBlockSize, _num_values - idx * kDeltaBlockSize);
+    const uint8_t* p = _data + decode_fixed32_le(_block_offsets + idx * sizeof(uint32_t));
+    const uint8_t* limit = idx + 1 < (_num_values + kDeltaBlockSize - 1) / kDeltaBlockSize
+                                   ? _data + decode_fixed32_le(_block_offsets + (idx + 1) * sizeof(uint32_t))
+                                   : _block_offsets;
+    if (p + sizeof(T) > limit) {
+        return false;
+    }
+    T first;
+    memcpy(&first, p, sizeof(T));
+    p += sizeof(T);
+    uint64_t zigzag_min_delta;
+    uint64_t unused;
+    if ((p = decode_varint64_ptr(p, limit, &zigzag_min_delta)) == nullptr ||
+        (p = decode_varint64_ptr(p, limit, &unused)) == nullptr ||
+        (p = decode_varint64_ptr(p, limit, &unused)) == nullptr || p + kDeltaMiniBlocks > limit) {
+        return false;
+    }
+    const U min_delta = static_cast<U>(zigzag_decode(zigzag_min_delta));
+    const uint8_t* widths = p;
+    p += kDeltaMiniBlocks;
+
+    // Unpack the deltas of each miniblock right after its first value, then restore the values by the
+    // prefix sum, which is a single pass over the block in the cache.
+    const size_t num_deltas = count - 1;
+    const size_t num_mini_blocks = (num_deltas + kDeltaMiniBlockSize - 1) / kDeltaMiniBlockSize;
+    U packed[kDeltaBlockSize];
+    for (size_t m = 0; m < num_mini_blocks; m++) {
+        const int width = widths[m];
+        U* out = packed + m * kDeltaMiniBlockSize;
+        if (width == 0) {
+            std::fill(out, out + kDeltaMiniBlockSize, 0);
+            continue;
+        }
+        const size_t bytes = width * kDeltaMiniBlockSize / 8;
+        if (width > static_cast<int>(sizeof(T) * 8) || p + bytes > limit ||
+            BitPacking::UnpackValues(width, p, bytes, kDeltaMiniBlockSize, out).second !=
+                    static_cast<int64_t>(kDeltaMiniBlockSize)) {
+            return false;
+        }
+        p += bytes;
+    }
+    if (p != limit) {
+        return false;
+    }
+
+    U value = static_cast<U>(first);
+    output[0] = first;
+    for (size_t i = 0; i < num_deltas; i++) {
+        value += packed[i] + min_delta;
+        output[i + 1] = static_cast<T>(value);
+    }
+    return true;
+}
+
+template class DeltaEncoder<int32_t>;
+template class DeltaEncoder<int64_t>;
+template class DeltaDecoder<int32_t>;
+template class DeltaDecoder<int64_t>;
+
+} // namespace starrocks
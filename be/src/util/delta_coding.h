@@ -0,0 +1,121 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// Delta encoding with bit packing for the integers, like DELTA_BINARY_PACKED of Parquet, which suits the
+// sorted and nearly monotonic values, e.g. sort keys and event timestamps.
+//
+// The values are divided into blocks of kDeltaBlockSize values, and each block is decoded independently
+// so that seeking to an ordinal only decodes one block. The deltas between the adjacent values of a block
+// minus the min delta of the block are bit packed by miniblocks of kDeltaMiniBlockSize, each with its own
+// bit width. The arithmetic wraps around, so any values including the overflowing deltas are supported.
+//
+// The encoded data consists of:
+//  Blocks:
+//    first value (fixed), min delta (zigzag varint),
+//    first value - min value (varint), max value - first value (varint),
+//    bit width of each miniblock (8-bit each), bit packed miniblocks
+//  Block offsets (32-bit fixed each)
+//  num_values (32-bit fixed)
+static constexpr size_t kDeltaBlockSize = 256;
+static constexpr size_t kDeltaMiniBlockSize = 32;
+static constexpr size_t kDeltaMiniBlocks = kDeltaBlockSize / kDeltaMiniBlockSize;
+
+template <typename T>
+class DeltaEncoder {
+    static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>, "unexpected type");
+
+public:
+    explicit DeltaEncoder(faststring* buffer) : _buffer(buffer) {}
+
+    void put_batch(const T* values, size_t count);
+
+    // Encode the buffered values and append the block offsets and the trailer.
+    void flush();
+
+    // Return the size of the encoded data, including the buffered values as is.
+    size_t len() const {
+        return _buffer->size() + _values.size() * sizeof(T) + _block_offsets.size() * sizeof(uint32_t);
+    }
+
+    uint32_t count() const { return _num_values; }
+
+    void clear() {
+        _buffer->clear();
+        _values.clear();
+        _block_offsets.clear();
+        _num_values = 0;
+    }
+
+private:
+    void _encode_block(const T* values, size_t count);
+
+    faststring* _buffer;
+    // the values of the block not full yet
+    std::vector<T> _values;
+    std::vector<uint32_t> _block_offsets;
+    uint32_t _num_values{0};
+};
+
+template <typename T>
+class DeltaDecoder {
+    static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>, "unexpected type");
+
+public:
+    DeltaDecoder(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    // Parse the trailer and the block offsets, return false if the data is corrupted.
+    bool init();
+
+    uint32_t count() const { return _num_values; }
+
+    uint32_t current_index() const { return _cur_index; }
+
+    void seek(uint32_t pos) { _cur_index = pos; }
+
+    // Decode the next |count| values into |output|, return false if the data is corrupted.
+    bool get_batch(T* output, size_t count);
+
+    // Get the min and max values of the block of the current position without decoding it, and the number
+    // of values remaining in the block. Return false if the data is corrupted.
+    bool current_block_bounds(T* min, T* max, uint32_t* num_remaining);
+
+    void advance(uint32_t num) { _cur_index += num; }
+
+private:
+    // Decode the |idx|-th block into |output|.
+    bool _decode_block(size_t idx, T* output);
+
+    const uint8_t* _data;
+    size_t _size;
+    uint32_t _num_values{0};
+    uint32_t _cur_index{0};
+    const uint8_t* _block_offsets{nullptr};
+
+    // the cached block to read a part of it
+    T _block_values[kDeltaBlockSize];
+    int64_t _cached_block{-1};
+};
+
+} // namespace starrocks
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <type_traits>
 
 #include "util/bit_util.h"
 #include "util/coding.h"
@@ -368,6 +369,32 @@ T ForDecoder<T>::decode_frame_min_value(uint32_t frame_index) {
     return min;
 }
 
+template <typename T>
+bool ForDecoder<T>::current_frame_bounds(T* min, T* max, uint32_t* num_remaining) {
+    DCHECK_LT(_current_index, _values_num);
+    uint32_t frame_index = _current_index / _max_frame_size;
+    *num_remaining = frame_index * _max_frame_size + frame_size(frame_index) - _current_index;
+    if constexpr (!std::is_integral_v<T> || sizeof(T) > sizeof(int64_t)) {
+        return false;
+    } else {
+        uint8_t storage_format = _storage_formats[frame_index];
+        uint8_t bit_width = _bit_widths[frame_index];
+        if (storage_format == 2 || bit_width >= 64) {
+            return false;
+        }
+        // The values are min + delta, and each delta is packed in bit_width bits. For the ascending frame,
+        // the deltas are between the adjacent values, so the last value is at most min + (n - 1) * max_delta.
+        int128_t max_delta = (static_cast<int128_t>(1) << bit_width) - 1;
+        if (storage_format == 1) {
+            max_delta *= frame_size(frame_index) - 1;
+        }
+        *min = decode_frame_min_value(frame_index);
+        int128_t upper = static_cast<int128_t>(*min) + max_delta;
+        *max = static_cast<T>(std::min(upper, static_cast<int128_t>(std::numeric_limits<T>::max())));
+        return true;
+    }
+}
+
 template <typename T>
 T* ForDecoder<T>::copy_value(T* val, size_t count) {
     memcpy(val, &_out_buffer[_current_index % _max_frame_size], sizeof(T) * count);
@@ -163,6 +163,17 @@ public:
 
     uint32_t count() const { return _values_num; }
 
+    // Get the lower and upper bounds of the values in the frame of the current value without decoding
+    // the frame, and the number of values from the current one to the end of the frame.
+    // Return false if the bounds are unknown, e.g. the frame keeps the original values.
+    bool current_frame_bounds(T* min, T* max, uint32_t* num_remaining);
+
+    // Move forwards |num| values, unlike skip(), the end could be reached.
+    void advance(uint32_t num) {
+        DCHECK_LE(_current_index + num, _values_num);
+        _current_index += num;
+    }
+
 private:
     void bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output);
 
@@ -0,0 +1,230 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/fsst.h"
+
+#include <algorithm>
+#include <map>
+
+#include "common/logging.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+// The number of rounds to refine the symbol table.
+static constexpr int kNumGenerations = 5;
+// While building the symbol table, the bytes not covered by any symbol are counted as the pseudo symbols
+// numbered from kNumCodes.
+static constexpr size_t kNumCodes = FsstSymbolTable::kMaxSymbols + 1;
+static constexpr size_t kNumPseudoCodes = kNumCodes + 256;
+
+static inline uint64_t load_bytes(const uint8_t* data, size_t size) {
+    uint64_t word = 0;
+    memcpy(&word, data, std::min(size, FsstSymbolTable::kMaxSymbolLength));
+    return word;
+}
+
+static inline uint64_t symbol_mask(size_t length) {
+    return length >= FsstSymbolTable::kMaxSymbolLength ? ~0ULL : (1ULL << (length * 8)) - 1;
+}
+
+void FsstSymbolTable::_reset() {
+    _num_symbols = 0;
+    for (auto& codes : _codes_by_first_byte) {
+        codes.clear();
+    }
+}
+
+void FsstSymbolTable::_add_symbol(uint64_t symbol, uint8_t length) {
+    DCHECK_LT(_num_symbols, kMaxSymbols);
+    DCHECK(length > 0 && length <= kMaxSymbolLength);
+    _symbols[_num_symbols] = symbol & symbol_mask(length);
+    _lengths[_num_symbols] = length;
+    _num_symbols++;
+}
+
+void FsstSymbolTable::_build_index() {
+    for (auto& codes : _codes_by_first_byte) {
+        codes.clear();
+    }
+    for (size_t code = 0; code < _num_symbols; code++) {
+        _codes_by_first_byte[_symbols[code] & 0xFF].push_back(static_cast<uint8_t>(code));
+    }
+    for (auto& codes : _codes_by_first_byte) {
+        std::stable_sort(codes.begin(), codes.end(),
+                         [this](uint8_t lhs, uint8_t rhs) { return _lengths[lhs] > _lengths[rhs]; });
+    }
+}
+
+int FsstSymbolTable::_find_longest_symbol(const uint8_t* data, size_t size) const {
+    const uint64_t word = load_bytes(data, size);
+    for (uint8_t code : _codes_by_first_byte[data[0]]) {
+        const size_t length = _lengths[code];
+        if (length <= size && (word & symbol_mask(length)) == _symbols[code]) {
+            return code;
+        }
+    }
+    return -1;
+}
+
+void FsstSymbolTable::build(const Slice* strings, size_t num_strings) {
+    size_t total_size = 0;
+    for (size_t i = 0; i < num_strings; i++) {
+        total_size += strings[i].size;
+    }
+    // sample the strings evenly
+    const size_t step = std::max<size_t>(1, (total_size + kMaxSampleSize - 1) / kMaxSampleSize);
+    std::vector<Slice> samples;
+    for (size_t i = 0; i < num_strings; i += step) {
+        if (strings[i].size > 0) {
+            samples.emplace_back(strings[i]);
+        }
+    }
+
+    // Each generation compresses the sample with the current symbol table, and counts the symbols and the
+    // adjacent pairs of symbols. The next symbol table consists of the symbols and the concatenations of the
+    // pairs which save the most bytes, i.e. count * length.
+    // The sample is bounded, so the pairs are collected and sorted to count them instead of a dense
+    // kNumPseudoCodes^2 matrix, which would be cleared and scanned in every generation.
+    size_t sample_size = 0;
+    for (const Slice& sample : samples) {
+        sample_size += sample.size;
+    }
+    std::vector<uint32_t> counts(kNumPseudoCodes);
+    std::vector<uint32_t> pairs;
+    pairs.reserve(sample_size);
+    std::vector<uint64_t> symbols(kNumPseudoCodes);
+    std::vector<uint8_t> lengths(kNumPseudoCodes);
+    _reset();
+    for (int generation = 0; generation < kNumGenerations; generation++) {
+        std::fill(counts.begin(), counts.end(), 0);
+        pairs.clear();
+        for (size_t code = 0; code < _num_symbols; code++) {
+            symbols[code] = _symbols[code];
+            lengths[code] = _lengths[code];
+        }
+        for (size_t byte = 0; byte < 256; byte++) {
+            symbols[kNumCodes + byte] = byte;
+            lengths[kNumCodes + byte] = 1;
+        }
+
+        for (const Slice& sample : samples) {
+            const auto* data = reinterpret_cast<const uint8_t*>(sample.data);
+            size_t pos = 0;
+            size_t prev = kNumPseudoCodes;
+            while (pos < sample.size) {
+                const int code = _find_longest_symbol(data + pos, sample.size - pos);
+                const size_t current = code >= 0 ? code : kNumCodes + data[pos];
+                counts[current]++;
+                if (prev != kNumPseudoCodes) {
+                    pairs.push_back(static_cast<uint32_t>(prev * kNumPseudoCodes + current));
+                }
+                prev = current;
+                pos += lengths[current];
+            }
+        }
+
+        // The same symbol could be both an existing one and a concatenation, so their gains are merged.
+        std::map<std::pair<uint64_t, uint8_t>, uint64_t> gains;
+        for (size_t code = 0; code < kNumPseudoCodes; code++) {
+            if (counts[code] > 0) {
+                gains[{symbols[code], lengths[code]}] += static_cast<uint64_t>(counts[code]) * lengths[code];
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+        for (size_t i = 0; i < pairs.size();) {
+            size_t j = i + 1;
+            while (j < pairs.size() && pairs[j] == pairs[i]) {
+                j++;
+            }
+            const size_t count = j - i;
+            const size_t first = pairs[i] / kNumPseudoCodes;
+            const size_t second = pairs[i] % kNumPseudoCodes;
+            i = j;
+            if (lengths[first] >= kMaxSymbolLength) {
+                continue;
+            }
+            // the concatenation is truncated to 8 bytes
+            const size_t truncated_length = std::min<size_t>(lengths[first] + lengths[second], kMaxSymbolLength);
+            const uint64_t symbol =
+                    (symbols[first] | (symbols[second] << (lengths[first] * 8))) & symbol_mask(truncated_length);
+            gains[{symbol, truncated_length}] += static_cast<uint64_t>(count) * truncated_length;
+        }
+
+        std::vector<std::pair<uint64_t, std::pair<uint64_t, uint8_t>>> candidates;
+        candidates.reserve(gains.size());
+        for (const auto& [symbol, gain] : gains) {
+            candidates.emplace_back(gain, symbol);
+        }
+        const size_t num_symbols = std::min(candidates.size(), kMaxSymbols);
+        std::partial_sort(candidates.begin(), candidates.begin() + num_symbols, candidates.end(),
+                          [](const auto& lhs, const auto& rhs) {
+                              return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+                          });
+        _reset();
+        for (size_t i = 0; i < num_symbols; i++) {
+            _add_symbol(candidates[i].second.first, candidates[i].second.second);
+        }
+        _build_index();
+    }
+}
+
+size_t FsstSymbolTable::compress(const Slice& input, uint8_t* output) const {
+    const auto* data = reinterpret_cast<const uint8_t*>(input.data);
+    uint8_t* out = output;
+    size_t pos = 0;
+    while (pos < input.size) {
+        const int code = _find_longest_symbol(data + pos, input.size - pos);
+        if (code >= 0) {
+            *out++ = static_cast<uint8_t>(code);
+            pos += _lengths[code];
+        } else {
+            *out++ = kEscapeCode;
+            *out++ = data[pos++];
+        }
+    }
+    return out - output;
+}
+
+void FsstSymbolTable::serialize(faststring* output) const {
+    output->push_back(static_cast<uint8_t>(_num_symbols));
+    output->append(_lengths, _num_symbols);
+    for (size_t code = 0; code < _num_symbols; code++) {
+        put_fixed64_le(output, _symbols[code]);
+    }
+}
+
+StatusOr<size_t> FsstSymbolTable::deserialize(const Slice& input) {
+    if (input.size < 1) {
+        return Status::Corruption("not enough bytes for FSST symbol table");
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(input.data);
+    const size_t num_symbols = data[0];
+    const size_t size = 1 + num_symbols + num_symbols * sizeof(uint64_t);
+    if (num_symbols > kMaxSymbols || input.size < size) {
+        return Status::Corruption("invalid FSST symbol table");
+    }
+    _reset();
+    for (size_t code = 0; code < num_symbols; code++) {
+        const uint8_t length = data[1 + code];
+        if (length == 0 || length > kMaxSymbolLength) {
+            return Status::Corruption("invalid FSST symbol length");
+        }
+        _add_symbol(decode_fixed64_le(data + 1 + num_symbols + code * sizeof(uint64_t)), length);
+    }
+    _build_index();
+    return size;
+}
+
+} // namespace starrocks
@@ -0,0 +1,110 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common/statusor.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// FSST (Fast Static Symbol Table) compression for short strings, see
+// "FSST: Fast Random Access String Compression" (VLDB 2020).
+//
+// A symbol table maps up to 255 one-byte codes to symbols of 1 to 8 bytes, which is built from a sample of
+// the strings. Each string is compressed independently by replacing its longest prefix found in the table
+// with the code repeatedly, and a byte not covered by any symbol is escaped by kEscapeCode followed by the
+// byte itself. So a single string could be decompressed without the others, and two strings compressed by
+// the same table are equal if and only if their compressed bytes are equal.
+class FsstSymbolTable {
+public:
+    static constexpr size_t kMaxSymbols = 255;
+    static constexpr size_t kMaxSymbolLength = 8;
+    static constexpr uint8_t kEscapeCode = 255;
+    // The symbol table is built from a sample of at most this many bytes.
+    static constexpr size_t kMaxSampleSize = 16 * 1024;
+
+    FsstSymbolTable() = default;
+
+    // Build the symbol table from a sample of |strings|.
+    void build(const Slice* strings, size_t num_strings);
+
+    // Return the max size of a compressed string of |size| bytes.
+    static size_t max_compressed_size(size_t size) { return size * 2; }
+
+    // Compress |input| into |output|, which must have room for max_compressed_size(input.size) bytes.
+    // Return the size of the compressed string.
+    size_t compress(const Slice& input, uint8_t* output) const;
+
+    // Return the max size of a decompressed string of |size| bytes, including the extra bytes written
+    // by decompress().
+    static size_t max_decompressed_size(size_t size) { return size * kMaxSymbolLength + kMaxSymbolLength; }
+
+    // Decompress |input| into |output|, which must have room for max_decompressed_size(input.size) bytes.
+    // Return the size of the decompressed string.
+    size_t decompress(const Slice& input, uint8_t* output) const {
+        const auto* in = reinterpret_cast<const uint8_t*>(input.data);
+        const uint8_t* end = in + input.size;
+        uint8_t* out = output;
+        while (in < end) {
+            const uint8_t code = *in++;
+            if (code != kEscapeCode) {
+                // always copy 8 bytes, the bytes after the symbol are overwritten by the next one
+                memcpy(out, &_symbols[code], kMaxSymbolLength);
+                out += _lengths[code];
+            } else if (in < end) {
+                *out++ = *in++;
+            }
+        }
+        return out - output;
+    }
+
+    // The serialized symbol table consists of:
+    //   num_symbols (8-bit)
+    //   length of each symbol (8-bit each)
+    //   each symbol padded with zeros (64-bit little endian each)
+    void serialize(faststring* output) const;
+
+    // Return the size of the serialized symbol table at the beginning of |input|.
+    StatusOr<size_t> deserialize(const Slice& input);
+
+    size_t num_symbols() const { return _num_symbols; }
+
+    Slice symbol(uint8_t code) const {
+        return {reinterpret_cast<const char*>(&_symbols[code]), static_cast<size_t>(_lengths[code])};
+    }
+
+private:
+    void _reset();
+    void _add_symbol(uint64_t symbol, uint8_t length);
+    // Build the index to find the symbols by their first byte.
+    void _build_index();
+    // Return the code of the longest symbol which is a prefix of |data|, or -1 if there is none.
+    int _find_longest_symbol(const uint8_t* data, size_t size) const;
+
+    size_t _num_symbols = 0;
+    // The symbols are padded with zeros to 8 bytes in little endian.
+    uint64_t _symbols[kMaxSymbols + 1] = {};
+    uint8_t _lengths[kMaxSymbols + 1] = {};
+    // The codes of the symbols starting with each byte, the longer symbols first.
+    std::vector<uint8_t> _codes_by_first_byte[256];
+};
+
+} // namespace starrocks
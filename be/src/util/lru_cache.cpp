@@ -6,6 +6,7 @@
 
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <sstream>
@@ -150,29 +151,143 @@ bool HandleTable::_resize() {
     return true;
 }
 
-LRUCache::LRUCache() {
+bool parse_cache_evict_policy(std::string_view name, CacheEvictPolicy* policy) {
+    if (name == "lru") {
+        *policy = CacheEvictPolicy::LRU;
+    } else if (name == "2q") {
+        *policy = CacheEvictPolicy::TWO_QUEUE;
+    } else if (name == "w-tinylfu") {
+        *policy = CacheEvictPolicy::W_TINY_LFU;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+CacheEvictPolicy cache_evict_policy_or_lru(std::string_view name) {
+    CacheEvictPolicy policy = CacheEvictPolicy::LRU;
+    LOG_IF(WARNING, !parse_cache_evict_policy(name, &policy)) << "Unknown cache evict policy " << name << ", use lru";
+    return policy;
+}
+
+void FrequencySketch::ensure_capacity(size_t num_entries) {
+    // One word, i.e. 16 counters, for each key, as the counters are shared by the keys.
+    if (num_entries <= _table.size()) {
+        return;
+    }
+    size_t num_words = std::max<size_t>(64, _table.size() * 2);
+    while (num_words < num_entries) {
+        num_words *= 2;
+    }
+    // The word of a key in the enlarged table is the one in the old table plus a multiple of the old size,
+    // so the frequencies are kept by tiling the old table.
+    const size_t old_num_words = _table.size();
+    _table.resize(num_words, 0);
+    for (size_t i = old_num_words; old_num_words > 0 && i < num_words; i++) {
+        _table[i] = _table[i & (old_num_words - 1)];
+    }
+    _sample_size = 10 * num_words;
+}
+
+std::pair<size_t, int> FrequencySketch::_position(uint32_t hash, int i) const {
+    // The top bits of the hash are used to choose the shard, so remix it for each hash function.
+    static constexpr uint64_t kSeeds[kNumHashes] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                                                    0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+    uint64_t h = (static_cast<uint64_t>(hash) + kSeeds[i]) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 29;
+    return {h & (_table.size() - 1), static_cast<int>((h >> 59) & (kCountersPerWord - 1))};
+}
+
+void FrequencySketch::increment(uint32_t hash) {
+    if (_table.empty()) {
+        return;
+    }
+    bool incremented = false;
+    for (int i = 0; i < kNumHashes; i++) {
+        auto [word, counter] = _position(hash, i);
+        const int shift = counter * 4;
+        if (((_table[word] >> shift) & 0xf) < 0xf) {
+            _table[word] += 1ULL << shift;
+            incremented = true;
+        }
+    }
+    if (incremented && ++_num_increments >= _sample_size) {
+        _reset();
+    }
+}
+
+uint32_t FrequencySketch::frequency(uint32_t hash) const {
+    if (_table.empty()) {
+        return 0;
+    }
+    uint32_t frequency = 0xf;
+    for (int i = 0; i < kNumHashes; i++) {
+        auto [word, counter] = _position(hash, i);
+        frequency = std::min(frequency, static_cast<uint32_t>((_table[word] >> (counter * 4)) & 0xf));
+    }
+    return frequency;
+}
+
+void FrequencySketch::_reset() {
+    for (auto& word : _table) {
+        word = (word >> 1) & 0x7777777777777777ULL;
+    }
+    _num_increments /= 2;
+}
+
+template <bool ReadMostly>
+BasicLRUCache<ReadMostly>::BasicLRUCache() {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected.next = &_protected;
+    _protected.prev = &_protected;
+    _window.next = &_window;
+    _window.prev = &_window;
 }
 
-LRUCache::~LRUCache() noexcept {
+template <bool ReadMostly>
+BasicLRUCache<ReadMostly>::~BasicLRUCache() noexcept {
     prune();
 }
 
-bool LRUCache::_unref(LRUHandle* e) {
-    DCHECK(e->refs > 0);
-    e->refs--;
-    return e->refs == 0;
+template <bool ReadMostly>
+uint32_t BasicLRUCache<ReadMostly>::_refs(LRUHandle* e) {
+    if constexpr (ReadMostly) {
+        return std::atomic_ref<uint32_t>(e->refs).load();
+    } else {
+        return e->refs;
+    }
 }
 
-void LRUCache::_lru_remove(LRUHandle* e) {
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_ref(LRUHandle* e) {
+    if constexpr (ReadMostly) {
+        std::atomic_ref<uint32_t>(e->refs).fetch_add(1);
+    } else {
+        e->refs++;
+    }
+}
+
+template <bool ReadMostly>
+bool BasicLRUCache<ReadMostly>::_unref(LRUHandle* e) {
+    DCHECK(_refs(e) > 0);
+    if constexpr (ReadMostly) {
+        return std::atomic_ref<uint32_t>(e->refs).fetch_sub(1) == 1;
+    } else {
+        return --e->refs == 0;
+    }
+}
+
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_lru_remove(LRUHandle* e) {
     e->next->prev = e->prev;
     e->prev->next = e->next;
     e->prev = e->next = nullptr;
 }
 
-void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_lru_append(LRUHandle* list, LRUHandle* e) {
     // Make "e" newest entry by inserting just before *list
     e->next = list;
     e->prev = list->prev;
@@ -180,10 +295,59 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->next->prev = e;
 }
 
-void LRUCache::set_capacity(size_t capacity) {
+template <bool ReadMostly>
+LRUHandle* BasicLRUCache<ReadMostly>::_queue_head(LRUQueue queue) {
+    switch (queue) {
+    case LRUQueue::PROTECTED:
+        return &_protected;
+    case LRUQueue::WINDOW:
+        return &_window;
+    default:
+        return &_lru;
+    }
+}
+
+// Move the entry in cache to the given queue, and append it to the queue if it's not in use or in read mostly mode.
+// The entry must have been removed from its old queue.
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_move_to_queue(LRUHandle* e, LRUQueue queue) {
+    _queue_usage[static_cast<int>(e->queue)] -= e->charge;
+    e->queue = queue;
+    _queue_usage[static_cast<int>(e->queue)] += e->charge;
+    if (ReadMostly || e->refs == 1) {
+        _lru_append(_queue_head(queue), e);
+    }
+}
+
+// Promote the probation entry being hit to the protected queue, and demote the least recently used entries of
+// the protected queue to the probation queue if it overflows.
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_promote(LRUHandle* e) {
+    _move_to_queue(e, LRUQueue::PROTECTED);
+    const size_t protected_capacity = _protected_capacity();
+    while (_queue_usage[static_cast<int>(LRUQueue::PROTECTED)] > protected_capacity && _protected.next != &_protected) {
+        LRUHandle* old = _protected.next;
+        _lru_remove(old);
+        _move_to_queue(old, LRUQueue::PROBATION);
+    }
+}
+
+template <bool ReadMostly>
+size_t BasicLRUCache<ReadMostly>::_window_capacity() const {
+    return _evict_policy == CacheEvictPolicy::W_TINY_LFU ? _capacity / 100 : 0;
+}
+
+template <bool ReadMostly>
+size_t BasicLRUCache<ReadMostly>::_protected_capacity() const {
+    return _evict_policy == CacheEvictPolicy::LRU ? 0 : (_capacity - _window_capacity()) * 4 / 5;
+}
+
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::set_capacity(size_t capacity) {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
+        _drain_read_buffer();
         _capacity = capacity;
         _evict_from_lru(0, &last_ref_list);
     }
@@ -193,33 +357,54 @@ void LRUCache::set_capacity(size_t capacity) {
     }
 }
 
-void LRUCache::set_charge_mode(ChargeMode charge_mode) {
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::set_charge_mode(ChargeMode charge_mode) {
     _charge_mode = charge_mode;
 }
 
-uint64_t LRUCache::get_lookup_count() const {
-    std::lock_guard l(_mutex);
-    return _lookup_count;
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::set_evict_policy(CacheEvictPolicy evict_policy) {
+    _evict_policy = evict_policy;
 }
 
-uint64_t LRUCache::get_hit_count() const {
-    std::lock_guard l(_mutex);
-    return _hit_count;
+template <bool ReadMostly>
+uint64_t BasicLRUCache<ReadMostly>::get_lookup_count() const {
+    return _lookup_count.load(std::memory_order_relaxed);
 }
 
-size_t LRUCache::get_usage() const {
-    std::lock_guard l(_mutex);
+template <bool ReadMostly>
+uint64_t BasicLRUCache<ReadMostly>::get_hit_count() const {
+    return _hit_count.load(std::memory_order_relaxed);
+}
+
+template <bool ReadMostly>
+uint64_t BasicLRUCache<ReadMostly>::get_admission_reject_count() const {
+    ReadLock l(_mutex);
+    return _admission_reject_count;
+}
+
+template <bool ReadMostly>
+size_t BasicLRUCache<ReadMostly>::get_usage() const {
+    ReadLock l(_mutex);
     return _usage;
 }
 
-size_t LRUCache::get_capacity() const {
-    std::lock_guard l(_mutex);
+template <bool ReadMostly>
+size_t BasicLRUCache<ReadMostly>::get_capacity() const {
+    ReadLock l(_mutex);
     return _capacity;
 }
 
-Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
+template <bool ReadMostly>
+Cache::Handle* BasicLRUCache<ReadMostly>::lookup(const CacheKey& key, uint32_t hash) {
+    if constexpr (ReadMostly) {
+        return _lookup_read_mostly(key, hash);
+    }
     std::lock_guard l(_mutex);
     ++_lookup_count;
+    if (_evict_policy == CacheEvictPolicy::W_TINY_LFU) {
+        _sketch.increment(hash);
+    }
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
@@ -228,17 +413,94 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
             // only in LRU free list, remove it from list
             _lru_remove(e);
         }
-        e->refs++;
+        _ref(e);
         ++_hit_count;
+        if (_evict_policy != CacheEvictPolicy::LRU && e->queue == LRUQueue::PROBATION) {
+            _promote(e);
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
 
-void LRUCache::release(Cache::Handle* handle) {
+// The hit only pins the entry under the shared lock, and records the entry in the read buffer, which is applied to
+// the queues by whoever fills the buffer if the exclusive lock is free at that moment, or by the next writer.
+template <bool ReadMostly>
+Cache::Handle* BasicLRUCache<ReadMostly>::_lookup_read_mostly(const CacheKey& key, uint32_t hash) {
+    LRUHandle* e = nullptr;
+    bool buffer_full = false;
+    {
+        ReadLock l(_mutex);
+        _lookup_count.fetch_add(1, std::memory_order_relaxed);
+        e = _table.lookup(key, hash);
+        if (e != nullptr) {
+            DCHECK(e->in_cache);
+            _ref(e);
+            _hit_count.fetch_add(1, std::memory_order_relaxed);
+            const size_t pos = _read_buffer_size.fetch_add(1, std::memory_order_relaxed);
+            if (pos < kReadBufferSize) {
+                _read_buffer[pos] = e;
+            }
+            // Retry the drain once per kReadBufferSize hits if the exclusive lock was busy.
+            buffer_full = (pos + 1) % kReadBufferSize == 0;
+        }
+    }
+    if (buffer_full) {
+        std::unique_lock l(_mutex, std::try_to_lock);
+        if (l.owns_lock()) {
+            _drain_read_buffer();
+        }
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+// Must be called with the exclusive lock held, and before removing any entry from the cache.
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_drain_read_buffer() {
+    const size_t size = std::min(_read_buffer_size.load(std::memory_order_relaxed), kReadBufferSize);
+    for (size_t i = 0; i < size; i++) {
+        _apply_access(_read_buffer[i]);
+    }
+    _read_buffer_size.store(0, std::memory_order_relaxed);
+}
+
+// Apply a recorded hit of the entry in cache, which is always in its queue in read mostly mode.
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_apply_access(LRUHandle* e) {
+    DCHECK(e->in_cache);
+    if (_evict_policy == CacheEvictPolicy::W_TINY_LFU) {
+        _sketch.increment(e->hash);
+    }
+    _lru_remove(e);
+    if (_evict_policy != CacheEvictPolicy::LRU && e->queue == LRUQueue::PROBATION) {
+        _promote(e);
+    } else {
+        _lru_append(_queue_head(e->queue), e);
+    }
+}
+
+// The entry in cache is never removed from its queue in read mostly mode, so only the last reference of an entry
+// out of cache needs the lock.
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_release_read_mostly(LRUHandle* e) {
+    if (_unref(e)) {
+        {
+            std::lock_guard l(_mutex);
+            _usage -= e->charge;
+        }
+        e->free();
+    }
+}
+
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::release(Cache::Handle* handle) {
     if (handle == nullptr) {
         return;
     }
     auto* e = reinterpret_cast<LRUHandle*>(handle);
+    if constexpr (ReadMostly) {
+        _release_read_mostly(e);
+        return;
+    }
     bool last_ref = false;
     {
         std::lock_guard l(_mutex);
@@ -251,12 +513,13 @@ void LRUCache::release(Cache::Handle* handle) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
+                _queue_usage[static_cast<int>(e->queue)] -= e->charge;
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
             } else {
                 // put it to LRU free list
-                _lru_append(&_lru, e);
+                _lru_append(_queue_head(e->queue), e);
             }
         }
     }
@@ -267,38 +530,88 @@ void LRUCache::release(Cache::Handle* handle) {
     }
 }
 
-void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
-    // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
-        LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
-            cur = cur->next;
-            continue;
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
+    if (_evict_policy == CacheEvictPolicy::W_TINY_LFU) {
+        _evict_from_window(charge, deleted);
+    }
+    LRUHandle* const heads[] = {&_lru, &_protected, &_window};
+    // 1. evict normal cache entries, from the probation queue to the protected queue
+    // The entries in use are only in the queues in read mostly mode, and they are skipped.
+    for (LRUHandle* head : heads) {
+        LRUHandle* cur = head;
+        while (_usage + charge > _capacity && cur->next != head) {
+            LRUHandle* old = cur->next;
+            if (old->priority == CachePriority::DURABLE || _refs(old) > 1) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
         }
-        _evict_one_entry(old);
-        deleted->push_back(old);
     }
     // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
+    for (LRUHandle* head : heads) {
+        LRUHandle* cur = head;
+        while (_usage + charge > _capacity && cur->next != head) {
+            LRUHandle* old = cur->next;
+            if (_refs(old) > 1) {
+                cur = cur->next;
+                continue;
+            }
+            DCHECK(old->priority == CachePriority::DURABLE);
+            _evict_one_entry(old);
+            deleted->push_back(old);
+        }
+    }
+}
+
+// Make room in the window for the entry to be inserted. The entries evicted from the window are moved to the
+// probation queue, and if the cache is full, each of them is compared with the least recently used entry of the
+// probation queue, and the less frequently accessed one is evicted.
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_evict_from_window(size_t charge, std::vector<LRUHandle*>* deleted) {
+    const size_t window_capacity = _window_capacity();
+    while (_queue_usage[static_cast<int>(LRUQueue::WINDOW)] + charge > window_capacity && _window.next != &_window) {
+        LRUHandle* candidate = _window.next;
+        _lru_remove(candidate);
+        _move_to_queue(candidate, LRUQueue::PROBATION);
+        if (_usage + charge <= _capacity || candidate->priority == CachePriority::DURABLE || _refs(candidate) > 1) {
+            continue;
+        }
+
+        LRUHandle* victim = _lru.next;
+        while (victim != candidate && (victim->priority == CachePriority::DURABLE || _refs(victim) > 1)) {
+            victim = victim->next;
+        }
+        if (victim == candidate) {
+            continue;
+        }
+        if (_sketch.frequency(candidate->hash) > _sketch.frequency(victim->hash)) {
+            _evict_one_entry(victim);
+            deleted->push_back(victim);
+        } else {
+            _evict_one_entry(candidate);
+            deleted->push_back(candidate);
+            ++_admission_reject_count;
+        }
     }
 }
 
-void LRUCache::_evict_one_entry(LRUHandle* e) {
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::_evict_one_entry(LRUHandle* e) {
     DCHECK(e->in_cache);
-    DCHECK(e->refs == 1); // LRU list contains elements which may be evicted
+    DCHECK(_refs(e) == 1); // LRU list contains elements which may be evicted
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
+    _queue_usage[static_cast<int>(e->queue)] -= e->charge;
     _unref(e);
     _usage -= e->charge;
 }
 
-Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+template <bool ReadMostly>
+Cache::Handle* BasicLRUCache<ReadMostly>::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                                 void (*deleter)(const CacheKey& key, void* value), CachePriority priority,
                                 size_t value_size) {
     auto* e = reinterpret_cast<LRUHandle*>(malloc(sizeof(LRUHandle) - 1 + key.size()));
@@ -311,11 +624,17 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->next = e->prev = nullptr;
     e->in_cache = true;
     e->priority = priority;
+    e->queue = _evict_policy == CacheEvictPolicy::W_TINY_LFU ? LRUQueue::WINDOW : LRUQueue::PROBATION;
     e->value_size = value_size;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
+        _drain_read_buffer();
+        if (_evict_policy == CacheEvictPolicy::W_TINY_LFU) {
+            _sketch.ensure_capacity(_table.size() + 1);
+            _sketch.increment(hash);
+        }
 
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
@@ -326,13 +645,24 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // space was freed
         auto old = _table.insert(e);
         _usage += charge;
+        _queue_usage[static_cast<int>(e->queue)] += charge;
+        if constexpr (ReadMostly) {
+            _lru_append(_queue_head(e->queue), e);
+        }
         if (old != nullptr) {
             old->in_cache = false;
+            _queue_usage[static_cast<int>(old->queue)] -= old->charge;
+            if constexpr (ReadMostly) {
+                // the entries in cache are always in the queues in read mostly mode
+                _lru_remove(old);
+            }
             if (_unref(old)) {
                 _usage -= old->charge;
-                // old is on LRU because it's in cache and its reference count
-                // was just 1 (Unref returned 0)
-                _lru_remove(old);
+                if constexpr (!ReadMostly) {
+                    // old is on LRU because it's in cache and its reference count
+                    // was just 1 (Unref returned 0)
+                    _lru_remove(old);
+                }
                 last_ref_list.push_back(old);
             }
         }
@@ -347,17 +677,24 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     return reinterpret_cast<Cache::Handle*>(e);
 }
 
-void LRUCache::erase(const CacheKey& key, uint32_t hash) {
+template <bool ReadMostly>
+void BasicLRUCache<ReadMostly>::erase(const CacheKey& key, uint32_t hash) {
     LRUHandle* e = nullptr;
     bool last_ref = false;
     {
         std::lock_guard l(_mutex);
+        _drain_read_buffer();
         e = _table.remove(key, hash);
         if (e != nullptr) {
+            _queue_usage[static_cast<int>(e->queue)] -= e->charge;
+            if constexpr (ReadMostly) {
+                // the entries in cache are always in the queues in read mostly mode
+                _lru_remove(e);
+            }
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->charge;
-                if (e->in_cache) {
+                if (e->in_cache && !ReadMostly) {
                     // locate in free list
                     _lru_remove(e);
                 }
@@ -371,20 +708,24 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
     }
 }
 
-int LRUCache::prune() {
+template <bool ReadMostly>
+int BasicLRUCache<ReadMostly>::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        _drain_read_buffer();
+        for (LRUHandle* head : {&_lru, &_protected, &_window}) {
+            LRUHandle* cur = head;
+            while (cur->next != head) {
+                LRUHandle* old = cur->next;
+                if (_refs(old) > 1) {
+                    // in use, only in read mostly mode
+                    cur = cur->next;
+                    continue;
+                }
+                _evict_one_entry(old);
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -393,24 +734,30 @@ int LRUCache::prune() {
     return last_ref_list.size();
 }
 
-inline uint32_t ShardedLRUCache::_hash_slice(const CacheKey& s) {
+template <bool ReadMostly>
+inline uint32_t BasicShardedLRUCache<ReadMostly>::_hash_slice(const CacheKey& s) {
     return s.hash(s.data(), s.size(), 0);
 }
 
-uint32_t ShardedLRUCache::_shard(uint32_t hash) {
+template <bool ReadMostly>
+uint32_t BasicShardedLRUCache<ReadMostly>::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity, ChargeMode charge_mode)
+template <bool ReadMostly>
+BasicShardedLRUCache<ReadMostly>::BasicShardedLRUCache(size_t capacity, ChargeMode charge_mode,
+                                                       CacheEvictPolicy evict_policy)
         : _last_id(0), _capacity(capacity), _charge_mode(charge_mode) {
     const size_t per_shard = (_capacity + (kNumShards - 1)) / kNumShards;
     for (auto& _shard : _shards) {
+        _shard.set_evict_policy(evict_policy);
         _shard.set_capacity(per_shard);
         _shard.set_charge_mode(_charge_mode);
     }
 }
 
-void ShardedLRUCache::_set_capacity(size_t capacity) {
+template <bool ReadMostly>
+void BasicShardedLRUCache<ReadMostly>::_set_capacity(size_t capacity) {
     const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
     for (auto& _shard : _shards) {
         _shard.set_capacity(per_shard);
@@ -418,13 +765,15 @@ void ShardedLRUCache::_set_capacity(size_t capacity) {
     _capacity = capacity;
 }
 
-void ShardedLRUCache::set_capacity(size_t capacity) {
+template <bool ReadMostly>
+void BasicShardedLRUCache<ReadMostly>::set_capacity(size_t capacity) {
     // Maybe multi client try to set capactity, we protect it using mutex.
     std::lock_guard l(_mutex);
     _set_capacity(capacity);
 }
 
-bool ShardedLRUCache::adjust_capacity(int64_t delta, size_t min_capacity) {
+template <bool ReadMostly>
+bool BasicShardedLRUCache<ReadMostly>::adjust_capacity(int64_t delta, size_t min_capacity) {
     std::lock_guard l(_mutex);
     int64_t new_capacity = _capacity + delta;
     if (new_capacity < static_cast<int64_t>(min_capacity)) {
@@ -434,55 +783,65 @@ bool ShardedLRUCache::adjust_capacity(int64_t delta, size_t min_capacity) {
     return true;
 }
 
-Cache::Handle* ShardedLRUCache::insert(const CacheKey& key, void* value, size_t charge,
+template <bool ReadMostly>
+Cache::Handle* BasicShardedLRUCache<ReadMostly>::insert(const CacheKey& key, void* value, size_t charge,
                                        void (*deleter)(const CacheKey& key, void* value), CachePriority priority,
                                        size_t value_size) {
     const uint32_t hash = _hash_slice(key);
     return _shards[_shard(hash)].insert(key, hash, value, charge, deleter, priority, value_size);
 }
 
-Cache::Handle* ShardedLRUCache::lookup(const CacheKey& key) {
+template <bool ReadMostly>
+Cache::Handle* BasicShardedLRUCache<ReadMostly>::lookup(const CacheKey& key) {
     const uint32_t hash = _hash_slice(key);
     return _shards[_shard(hash)].lookup(key, hash);
 }
 
-void ShardedLRUCache::release(Handle* handle) {
+template <bool ReadMostly>
+void BasicShardedLRUCache<ReadMostly>::release(Handle* handle) {
     auto* h = reinterpret_cast<LRUHandle*>(handle);
     _shards[_shard(h->hash)].release(handle);
 }
 
-void ShardedLRUCache::erase(const CacheKey& key) {
+template <bool ReadMostly>
+void BasicShardedLRUCache<ReadMostly>::erase(const CacheKey& key) {
     const uint32_t hash = _hash_slice(key);
     _shards[_shard(hash)].erase(key, hash);
 }
 
-void* ShardedLRUCache::value(Handle* handle) {
+template <bool ReadMostly>
+void* BasicShardedLRUCache<ReadMostly>::value(Handle* handle) {
     return reinterpret_cast<LRUHandle*>(handle)->value;
 }
 
-Slice ShardedLRUCache::value_slice(Handle* handle) {
+template <bool ReadMostly>
+Slice BasicShardedLRUCache<ReadMostly>::value_slice(Handle* handle) {
     auto lru_handle = reinterpret_cast<LRUHandle*>(handle);
     size_t record_size = _charge_mode == ChargeMode::VALUESIZE ? lru_handle->charge : lru_handle->value_size;
     return {(char*)lru_handle->value, record_size};
 }
 
-uint64_t ShardedLRUCache::new_id() {
+template <bool ReadMostly>
+uint64_t BasicShardedLRUCache<ReadMostly>::new_id() {
     std::lock_guard l(_mutex);
     return ++(_last_id);
 }
 
-size_t ShardedLRUCache::_get_stat(size_t (LRUCache::*mem_fun)() const) const {
+template <bool ReadMostly>
+size_t BasicShardedLRUCache<ReadMostly>::_get_stat(size_t (BasicLRUCache<ReadMostly>::*mem_fun)() const) const {
     size_t n = 0;
     for (auto& shard : _shards) {
         n += (shard.*mem_fun)();
     }
     return n;
 }
-size_t ShardedLRUCache::get_capacity() const {
-    return _get_stat(&LRUCache::get_capacity);
+template <bool ReadMostly>
+size_t BasicShardedLRUCache<ReadMostly>::get_capacity() const {
+    return _get_stat(&BasicLRUCache<ReadMostly>::get_capacity);
 }
 
-void ShardedLRUCache::prune() {
+template <bool ReadMostly>
+void BasicShardedLRUCache<ReadMostly>::prune() {
     int num_prune = 0;
     for (auto& _shard : _shards) {
         num_prune += _shard.prune();
@@ -490,20 +849,29 @@ void ShardedLRUCache::prune() {
     VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
 }
 
-size_t ShardedLRUCache::get_memory_usage() const {
-    return _get_stat(&LRUCache::get_usage);
+template <bool ReadMostly>
+size_t BasicShardedLRUCache<ReadMostly>::get_memory_usage() const {
+    return _get_stat(&BasicLRUCache<ReadMostly>::get_usage);
 }
 
-size_t ShardedLRUCache::get_lookup_count() const {
-    return _get_stat(&LRUCache::get_lookup_count);
+template <bool ReadMostly>
+size_t BasicShardedLRUCache<ReadMostly>::get_lookup_count() const {
+    return _get_stat(&BasicLRUCache<ReadMostly>::get_lookup_count);
 }
 
-size_t ShardedLRUCache::get_hit_count() const {
-    return _get_stat(&LRUCache::get_hit_count);
+template <bool ReadMostly>
+size_t BasicShardedLRUCache<ReadMostly>::get_hit_count() const {
+    return _get_stat(&BasicLRUCache<ReadMostly>::get_hit_count);
 }
 
-void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
-    size_t shard_count = sizeof(_shards) / sizeof(LRUCache);
+template <bool ReadMostly>
+size_t BasicShardedLRUCache<ReadMostly>::get_admission_reject_count() const {
+    return _get_stat(&BasicLRUCache<ReadMostly>::get_admission_reject_count);
+}
+
+template <bool ReadMostly>
+void BasicShardedLRUCache<ReadMostly>::get_cache_status(rapidjson::Document* document) {
+    size_t shard_count = sizeof(_shards) / sizeof(_shards[0]);
 
     for (uint32_t i = 0; i < shard_count; ++i) {
         size_t capacity = _shards[i].get_capacity();
@@ -532,12 +900,22 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
         }
 
         shard_info.AddMember("hit_ratio", hit_ratio, document->GetAllocator());
+        shard_info.AddMember("admission_reject_count",
+                             static_cast<double>(_shards[i].get_admission_reject_count()), document->GetAllocator());
         document->PushBack(shard_info, document->GetAllocator());
     }
 }
 
-Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode) {
-    return new ShardedLRUCache(capacity, charge_mode);
+template class BasicLRUCache<false>;
+template class BasicLRUCache<true>;
+template class BasicShardedLRUCache<false>;
+template class BasicShardedLRUCache<true>;
+
+Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode, CacheEvictPolicy evict_policy, bool read_mostly) {
+    if (read_mostly) {
+        return new BasicShardedLRUCache<true>(capacity, charge_mode, evict_policy);
+    }
+    return new ShardedLRUCache(capacity, charge_mode, evict_policy);
 }
 
 } // namespace starrocks
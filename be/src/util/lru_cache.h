@@ -6,11 +6,15 @@
 
 #include <rapidjson/document.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "util/slice.h"
@@ -27,9 +31,30 @@ enum class ChargeMode {
     MEMSIZE = 1
 };
 
+enum class CacheEvictPolicy {
+    // evict the least recently used entry
+    LRU = 0,
+    // a segmented LRU in the manner of 2Q, which is scan resistant: new entries are put into the probation queue,
+    // and promoted to the protected queue once they are hit, so the entries only accessed once (e.g. by a full
+    // table scan) are evicted from the probation queue before the ones accessed repeatedly
+    TWO_QUEUE = 1,
+    // W-TinyLFU: new entries are put into a small LRU window, an entry evicted from the window is admitted into the
+    // segmented LRU main space only if it's accessed more frequently than the victim of the main space, and the
+    // frequencies are estimated by a count-min sketch
+    W_TINY_LFU = 2,
+};
+
+// Parse the policy from "lru", "2q" or "w-tinylfu", return false if the name is unknown.
+bool parse_cache_evict_policy(std::string_view name, CacheEvictPolicy* policy);
+
+// Like parse_cache_evict_policy, but fall back to LRU with a warning if the name is unknown, used to parse the configs.
+CacheEvictPolicy cache_evict_policy_or_lru(std::string_view name);
+
 // Create a new cache with a fixed size capacity.  This implementation
-// of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE);
+// of Cache uses a least-recently-used eviction policy by default.
+// If `read_mostly` is true, the lookups of a shard don't block each other, see BasicShardedLRUCache.
+extern Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE,
+                            CacheEvictPolicy evict_policy = CacheEvictPolicy::LRU, bool read_mostly = false);
 
 class CacheKey {
 public:
@@ -190,6 +215,8 @@ public:
     virtual size_t get_memory_usage() const = 0;
     virtual size_t get_lookup_count() const = 0;
     virtual size_t get_hit_count() const = 0;
+    // The number of entries rejected by the admission policy, see CacheEvictPolicy::W_TINY_LFU.
+    virtual size_t get_admission_reject_count() const { return 0; }
 
     //  Decrease or increase cache capacity.
     virtual bool adjust_capacity(int64_t delta, size_t min_capacity = 0) = 0;
@@ -199,6 +226,10 @@ private:
     const Cache& operator=(const Cache&) = delete;
 };
 
+// The queues of a LRUCache shard, only PROBATION is used by CacheEvictPolicy::LRU.
+enum class LRUQueue : uint8_t { PROBATION = 0, PROTECTED = 1, WINDOW = 2 };
+static constexpr int kNumLRUQueues = 3;
+
 // An entry is a variable length heap-allocated structure.  Entries
 // are kept in a circular doubly linked list ordered by access time.
 typedef struct LRUHandle {
@@ -210,9 +241,11 @@ typedef struct LRUHandle {
     size_t charge;
     size_t key_length;
     bool in_cache; // Whether entry is in the cache.
+    // Only accessed by std::atomic_ref in read mostly mode, see BasicLRUCache.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
+    LRUQueue queue = LRUQueue::PROBATION; // The queue the entry belongs to.
     size_t value_size;
     char key_data[1]; // Beginning of key
 
@@ -251,6 +284,8 @@ public:
 
     LRUHandle* remove(const CacheKey& key, uint32_t hash);
 
+    uint32_t size() const { return _elems; }
+
 private:
     // The tablet consists of an array of buckets where each bucket is
     // a linked list of cache entries that hash into the bucket.
@@ -265,17 +300,51 @@ private:
     bool _resize();
 };
 
+// A count-min sketch of 4-bit counters estimating the access frequencies of the keys. All the counters are
+// halved once the number of increments reaches ten times of the number of keys, so that the history
+// fades away.
+class FrequencySketch {
+public:
+    // Enlarge the sketch to count the frequencies of about `num_entries` keys.
+    void ensure_capacity(size_t num_entries);
+
+    void increment(uint32_t hash);
+
+    uint32_t frequency(uint32_t hash) const;
+
+private:
+    static constexpr int kNumHashes = 4;
+    static constexpr int kCountersPerWord = 16;
+
+    // Return the index of the word and the index of the counter in the word for the i-th hash function.
+    std::pair<size_t, int> _position(uint32_t hash, int i) const;
+    void _reset();
+
+    std::vector<uint64_t> _table;
+    size_t _num_increments = 0;
+    size_t _sample_size = 0;
+};
+
 // A single shard of sharded cache.
-class LRUCache {
+//
+// In read mostly mode, the lookups only take the shared lock of _mutex, and the reference counts of the entries are
+// updated atomically. The entries in cache are kept in the queues even when they are in use, the eviction skips the
+// ones in use, and the hits are recorded in _read_buffer and applied to the queues in batches under the exclusive
+// lock. The recorded hits may be dropped when the buffer is full, which only makes the order of the queues less
+// accurate. Otherwise, it's protected by a plain mutex, and the reference counts are plain integers.
+template <bool ReadMostly>
+class BasicLRUCache {
 public:
-    LRUCache();
-    ~LRUCache() noexcept;
+    BasicLRUCache();
+    ~BasicLRUCache() noexcept;
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity);
 
     void set_charge_mode(ChargeMode charge_mode);
 
+    void set_evict_policy(CacheEvictPolicy evict_policy);
+
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                           void (*deleter)(const CacheKey& key, void* value),
@@ -287,43 +356,80 @@ public:
 
     uint64_t get_lookup_count() const;
     uint64_t get_hit_count() const;
+    uint64_t get_admission_reject_count() const;
     size_t get_usage() const;
     size_t get_capacity() const;
 
 private:
+    using Mutex = std::conditional_t<ReadMostly, std::shared_mutex, std::mutex>;
+    using ReadLock = std::conditional_t<ReadMostly, std::shared_lock<Mutex>, std::lock_guard<Mutex>>;
+
+    Cache::Handle* _lookup_read_mostly(const CacheKey& key, uint32_t hash);
+    void _release_read_mostly(LRUHandle* e);
+    void _drain_read_buffer();
+    void _apply_access(LRUHandle* e);
     void _lru_remove(LRUHandle* e);
     void _lru_append(LRUHandle* list, LRUHandle* e);
-    bool _unref(LRUHandle* e);
+    LRUHandle* _queue_head(LRUQueue queue);
+    void _move_to_queue(LRUHandle* e, LRUQueue queue);
+    void _promote(LRUHandle* e);
+    size_t _window_capacity() const;
+    size_t _protected_capacity() const;
+    static uint32_t _refs(LRUHandle* e);
+    static void _ref(LRUHandle* e);
+    static bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
+    void _evict_from_window(size_t charge, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
 
     // Initialized before use.
     size_t _capacity{0};
 
     ChargeMode _charge_mode;
+    CacheEvictPolicy _evict_policy{CacheEvictPolicy::LRU};
 
     // _mutex protects the following state.
-    mutable std::mutex _mutex;
+    mutable Mutex _mutex;
     size_t _usage{0};
 
-    // Dummy head of LRU list.
+    // Dummy head of LRU list, which is the probation queue for TWO_QUEUE and W_TINY_LFU.
     // lru.prev is newest entry, lru.next is oldest entry.
-    // Entries have refs==1 and in_cache==true.
+    // Entries have refs==1 and in_cache==true, or in_cache==true in read mostly mode.
     LRUHandle _lru;
+    // Dummy heads of the protected queue and the window queue, see CacheEvictPolicy.
+    LRUHandle _protected;
+    LRUHandle _window;
+    // The charges of the entries in cache of each queue, including the ones in use.
+    size_t _queue_usage[kNumLRUQueues] = {0};
 
     HandleTable _table;
+    FrequencySketch _sketch;
+
+    // The entries hit by the lookups in read mostly mode, which are always in cache since the buffer is drained
+    // before any entry is removed from the cache.
+    static constexpr size_t kReadBufferSize = 128;
+    LRUHandle* _read_buffer[kReadBufferSize];
+    std::atomic<size_t> _read_buffer_size{0};
 
-    uint64_t _lookup_count{0};
-    uint64_t _hit_count{0};
+    std::atomic<uint64_t> _lookup_count{0};
+    std::atomic<uint64_t> _hit_count{0};
+    uint64_t _admission_reject_count{0};
 };
 
+using LRUCache = BasicLRUCache<false>;
+
 static const int kNumShardBits = 5;
 static const int kNumShards = 1 << kNumShardBits;
 
-class ShardedLRUCache : public Cache {
+// In read mostly mode, the lookups of a shard only take the shared lock, so the hits of the hot entries from many
+// threads don't block each other, at the cost of a less accurate eviction order and the atomic reference counts.
+// It's suitable for the caches with a high hit ratio and heavy concurrent lookups, e.g. the page cache.
+template <bool ReadMostly>
+class BasicShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE);
-    ~ShardedLRUCache() override = default;
+    explicit BasicShardedLRUCache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE,
+                                  CacheEvictPolicy evict_policy = CacheEvictPolicy::LRU);
+    ~BasicShardedLRUCache() override = default;
     Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
                    CachePriority priority = CachePriority::NORMAL, size_t value_size = 0) override;
     Handle* lookup(const CacheKey& key) override;
@@ -339,19 +445,22 @@ public:
     size_t get_capacity() const override;
     uint64_t get_lookup_count() const override;
     uint64_t get_hit_count() const override;
+    uint64_t get_admission_reject_count() const override;
     bool adjust_capacity(int64_t delta, size_t min_capacity = 0) override;
 
 private:
     static uint32_t _hash_slice(const CacheKey& s);
     static uint32_t _shard(uint32_t hash);
     void _set_capacity(size_t capacity);
-    size_t _get_stat(size_t (LRUCache::*mem_fun)() const) const;
+    size_t _get_stat(size_t (BasicLRUCache<ReadMostly>::*mem_fun)() const) const;
 
-    LRUCache _shards[kNumShards];
+    BasicLRUCache<ReadMostly> _shards[kNumShards];
     std::mutex _mutex;
     uint64_t _last_id;
     size_t _capacity;
     ChargeMode _charge_mode;
 };
 
+using ShardedLRUCache = BasicShardedLRUCache<false>;
+
 } // namespace starrocks
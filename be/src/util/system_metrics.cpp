@@ -119,6 +119,7 @@ public:
     METRIC_DEFINE_INT_GAUGE(query_cache_lookup_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_INT_GAUGE(query_cache_hit_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_DOUBLE_GAUGE(query_cache_hit_ratio, MetricUnit::PERCENT);
+    METRIC_DEFINE_INT_GAUGE(query_cache_admission_reject_count, MetricUnit::NOUNIT);
 };
 
 class VectorIndexCacheMetrics {
@@ -667,6 +668,7 @@ void SystemMetrics::_update_query_cache_metrics() {
     _query_cache_metrics->query_cache_lookup_count.set_value(lookup_count);
     _query_cache_metrics->query_cache_hit_count.set_value(hit_count);
     _query_cache_metrics->query_cache_hit_ratio.set_value(hit_ratio);
+    _query_cache_metrics->query_cache_admission_reject_count.set_value(cache_mgr->admission_reject_count());
 }
 
 void SystemMetrics::_install_vector_index_cache_metrics(MetricRegistry* registry) {
@@ -738,6 +740,8 @@ void SystemMetrics::_install_query_cache_metrics(starrocks::MetricRegistry* regi
     registry->register_metric("query_cache_lookup_count", &_query_cache_metrics->query_cache_lookup_count);
     registry->register_metric("query_cache_hit_count", &_query_cache_metrics->query_cache_hit_count);
     registry->register_metric("query_cache_hit_ratio", &_query_cache_metrics->query_cache_hit_ratio);
+    registry->register_metric("query_cache_admission_reject_count",
+                              &_query_cache_metrics->query_cache_admission_reject_count);
 }
 
 void SystemMetrics::_install_runtime_filter_metrics(starrocks::MetricRegistry* registry) {
@@ -0,0 +1,124 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+#include "common/compiler_util.h"
+#include "glog/logging.h"
+
+namespace starrocks {
+
+// A bounded lock-free single-producer multi-consumer deque (Chase-Lev deque), following
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al., PPoPP'13).
+//
+// Only the owner thread may call push() and pop(), which work on the bottom end.
+// Any thread may call steal(), which takes the element from the top end, so the elements
+// are stolen in FIFO order.
+//
+// The capacity is fixed and must be a power of two, push() returns false when the deque is full.
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque only supports trivially copyable elements");
+
+public:
+    explicit WorkStealingDeque(size_t capacity)
+            : _capacity(capacity), _mask(capacity - 1), _buffer(new std::atomic<T>[capacity]) {
+        DCHECK(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    bool push(T item) {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        if (UNLIKELY(b - t >= static_cast<int64_t>(_capacity))) {
+            return false;
+        }
+        _buffer[b & _mask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only. Take the most recently pushed element.
+    std::optional<T> pop() {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty.
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        T item = _buffer[b & _mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // The last element, race with the thieves.
+            const bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return item;
+    }
+
+    // Any thread. Take the least recently pushed element.
+    // Return std::nullopt if the deque is empty or the race with another thief or the owner is lost.
+    std::optional<T> steal() {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return std::nullopt;
+        }
+
+        T item = _buffer[t & _mask].load(std::memory_order_relaxed);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return item;
+    }
+
+    // The result is only a snapshot when called by the non-owner threads.
+    size_t size() const {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return _capacity; }
+
+private:
+    const size_t _capacity;
+    const int64_t _mask;
+    std::unique_ptr<std::atomic<T>[]> _buffer;
+
+    // _top and _bottom are modified by the thieves and the owner respectively, keep them in different cache lines.
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+};
+
+} // namespace starrocks
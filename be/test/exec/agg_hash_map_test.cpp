@@ -154,6 +154,68 @@ TEST(HashMapTest, Insert) {
     }
 }
 
+TEST(HashMapTest, InsertWideFixedSizeKey) {
+    const int chunk_size = 64;
+    using TestAggHashMap = FixedSize32SliceAggHashMap<PhmapSeed1>;
+    using TestAggHashMapKey = AggHashMapWithSerializedKeyFixedSize<TestAggHashMap>;
+    RuntimeProfile profile("dummy");
+    AggStatistics statis(&profile);
+    TestAggHashMapKey key(chunk_size, &statis);
+    // (int, bigint, bigint, nullable bigint) takes 4 + 8 + 8 + 9 = 29 bytes.
+    key.has_null_column = true;
+    key.fixed_byte_size = 0;
+    MemPool pool;
+    const int num_rows = 48;
+    std::vector<std::pair<LogicalType, bool>> types = {
+            {TYPE_INT, false}, {TYPE_BIGINT, false}, {TYPE_BIGINT, false}, {TYPE_BIGINT, true}};
+    Columns key_columns;
+    Buffer<AggDataPtr> agg_states(chunk_size);
+    for (auto type : types) {
+        key_columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(type.first), type.second));
+    }
+    // Every distinct key appears 3 times, and the keys only differ in the last 8 bytes.
+    for (int i = 0; i < num_rows; ++i) {
+        key_columns[0]->append_datum(Datum(int32_t(1)));
+        key_columns[1]->append_datum(Datum(int64_t(2)));
+        key_columns[2]->append_datum(Datum(int64_t(3)));
+        if (i % 16 == 15) {
+            key_columns[3]->append_nulls(1);
+        } else {
+            key_columns[3]->append_datum(Datum(int64_t(i % 16)));
+        }
+    }
+    auto allocate_func = [&pool](auto& key) { return pool.allocate(16); };
+    key.build_hash_map(num_rows, key_columns, &pool, allocate_func, &agg_states);
+    ASSERT_EQ(16, key.hash_map.size());
+    for (int i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(agg_states[i], agg_states[i % 16]);
+    }
+
+    using TestHashMapKey = TestAggHashMap::key_type;
+    std::vector<TestHashMapKey> resv;
+    for (auto [key, _] : key.hash_map) {
+        resv.emplace_back(key);
+    }
+    Columns res_columns;
+    for (auto type : types) {
+        res_columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(type.first), type.second));
+    }
+    key.insert_keys_to_columns(resv, res_columns, resv.size());
+    ASSERT_EQ(16, res_columns[3]->size());
+    auto* nullable_column = down_cast<NullableColumn*>(res_columns[3].get());
+    ASSERT_EQ(1, nullable_column->null_count());
+    std::set<int64_t> res_sets;
+    auto* data_column = nullable_column->data_column().get();
+    for (size_t i = 0; i < res_columns[3]->size(); ++i) {
+        ASSERT_EQ(1, res_columns[0]->get(i).get_int32());
+        ASSERT_EQ(3, res_columns[2]->get(i).get_int64());
+        if (!res_columns[3]->is_null(i)) {
+            res_sets.insert(down_cast<Int64Column*>(data_column)->get_data()[i]);
+        }
+    }
+    ASSERT_EQ(15, res_sets.size());
+}
+
 TEST(HashMapTest, TwoLevelConvert) {
     std::vector<std::string> keys(1000);
     for (int i = 0; i < 1000; i++) {
@@ -222,8 +284,7 @@ public:
         Filter not_founds;
 
         // For fixed size key, need set key's fixed size
-        if constexpr (std::is_same_v<TestAggHashMapKey,
-                                     AggHashMapWithSerializedKeyFixedSize<FixedSize16SliceAggHashMap<PhmapSeed1>>>) {
+        if constexpr (is_combined_fixed_size_key<TestAggHashMapKey>) {
             key.fixed_byte_size = sizeof(CppType);
             key.has_null_column = nullable;
         }
@@ -326,4 +387,10 @@ TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_FixedSize16Sl
     TestAggHashMapKeyWithIntType<TestAggHashMapKey>(true);
 }
 
+TEST_F(AggHashMapKeyNotFoundsTest, TestAllocateAndComputeNonFounds_FixedSize32SliceAggHashMap) {
+    using TestAggHashMap = FixedSize32SliceAggHashMap<PhmapSeed1>;
+    using TestAggHashMapKey = AggHashMapWithSerializedKeyFixedSize<TestAggHashMap>;
+    TestAggHashMapKeyWithIntType<TestAggHashMapKey>(true);
+}
+
 } // namespace starrocks
@@ -0,0 +1,164 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/hash_joiner.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "util/defer_op.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+class HashJoinerTest : public ::testing::Test {
+public:
+    void SetUp() override { _old_min_build_bytes = config::auto_partition_hash_join_min_build_bytes; }
+    void TearDown() override { config::auto_partition_hash_join_min_build_bytes = _old_min_build_bytes; }
+
+protected:
+    static HashJoinBuildOptions build_options(const THashJoinNode& hash_join_node, bool enable_partition_hash_join,
+                                              bool enable_late_materialization, bool mor_reader_mode) {
+        ObjectPool pool;
+        RowDescriptor row_desc;
+        HashJoinerParam param(&pool, hash_join_node, {}, {}, {}, {}, {}, row_desc, row_desc,
+                              TPlanNodeType::OLAP_SCAN_NODE, TPlanNodeType::OLAP_SCAN_NODE, true, {}, {}, {},
+                              TJoinDistributionMode::PARTITIONED, mor_reader_mode, enable_late_materialization,
+                              enable_partition_hash_join);
+        return HashJoiner::build_options(param);
+    }
+
+    int64_t _old_min_build_bytes = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinerTest, test_auto_enable_partition_hash_join) {
+    config::auto_partition_hash_join_min_build_bytes = 16 * 1024 * 1024;
+
+    // not set by the planner, turned on for the build sides larger than the threshold
+    THashJoinNode unset_node;
+    auto options = build_options(unset_node, false, false, false);
+    ASSERT_TRUE(options.enable_partitioned_hash_join);
+    ASSERT_EQ(16 * 1024 * 1024, options.partition_join_min_build_bytes);
+
+    // left to the planner with late materialization or in MOR reader mode
+    options = build_options(unset_node, false, true, false);
+    ASSERT_FALSE(options.enable_partitioned_hash_join);
+    options = build_options(unset_node, false, false, true);
+    ASSERT_FALSE(options.enable_partitioned_hash_join);
+
+    // an explicit false of the planner is respected
+    THashJoinNode disabled_node;
+    disabled_node.__set_enable_partition_hash_join(false);
+    options = build_options(disabled_node, false, false, false);
+    ASSERT_FALSE(options.enable_partitioned_hash_join);
+
+    // an explicit true of the planner has no threshold
+    THashJoinNode enabled_node;
+    enabled_node.__set_enable_partition_hash_join(true);
+    options = build_options(enabled_node, true, false, false);
+    ASSERT_TRUE(options.enable_partitioned_hash_join);
+    ASSERT_EQ(0, options.partition_join_min_build_bytes);
+
+    // 0 disables turning it on automatically
+    config::auto_partition_hash_join_min_build_bytes = 0;
+    options = build_options(unset_node, false, false, false);
+    ASSERT_FALSE(options.enable_partitioned_hash_join);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinerTest, test_auto_enable_partition_hash_join_from_planner) {
+    config::auto_partition_hash_join_min_build_bytes = 16 * 1024 * 1024;
+    // the same as HashJoinNode of the planner, which sets enable_partition_hash_join only if it's forced by the
+    // session variables, or for late materialization
+    auto plan = [](bool enable_partition_hash_join, bool enable_auto_partition_hash_join, bool late_materialization) {
+        THashJoinNode node;
+        node.__set_join_op(TJoinOp::INNER_JOIN);
+        node.__set_is_push_down(false);
+        node.__set_distribution_mode(TJoinDistributionMode::PARTITIONED);
+        node.__set_build_runtime_filters_from_planner(true);
+        node.__set_late_materialization(late_materialization);
+        if (late_materialization || enable_partition_hash_join || !enable_auto_partition_hash_join) {
+            node.__set_enable_partition_hash_join(enable_partition_hash_join);
+        }
+        return node;
+    };
+    // the same as HashJoinNode of the backend
+    auto build = [](const THashJoinNode& node) {
+        const bool enable_partition_hash_join =
+                node.__isset.enable_partition_hash_join && node.enable_partition_hash_join;
+        return build_options(node, enable_partition_hash_join, node.late_materialization, false);
+    };
+
+    // the default session variables
+    auto options = build(plan(false, true, false));
+    ASSERT_TRUE(options.enable_partitioned_hash_join);
+    ASSERT_EQ(16 * 1024 * 1024, options.partition_join_min_build_bytes);
+
+    // set enable_partition_hash_join = true
+    options = build(plan(true, true, false));
+    ASSERT_TRUE(options.enable_partitioned_hash_join);
+    ASSERT_EQ(0, options.partition_join_min_build_bytes);
+
+    // set enable_auto_partition_hash_join = false
+    options = build(plan(false, false, false));
+    ASSERT_FALSE(options.enable_partitioned_hash_join);
+
+    // late materialization
+    options = build(plan(false, true, true));
+    ASSERT_FALSE(options.enable_partitioned_hash_join);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinerTest, test_partition_hash_join_min_rows) {
+    const size_t l2_cache_size = 1024 * 1024;
+    // bounded by the L2 cache without the threshold
+    ASSERT_EQ(64 * 1024, partition_hash_join_min_rows(l2_cache_size, 0, 16));
+    // the threshold larger than the L2 cache
+    ASSERT_EQ(1024 * 1024, partition_hash_join_min_rows(l2_cache_size, 16 * 1024 * 1024, 16));
+    // the threshold smaller than the L2 cache
+    ASSERT_EQ(64 * 1024, partition_hash_join_min_rows(l2_cache_size, 512 * 1024, 16));
+    // the row size is at least 4 bytes
+    ASSERT_EQ(256 * 1024, partition_hash_join_min_rows(l2_cache_size, 0, 0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinerTest, test_partition_skew_counters) {
+    RuntimeProfile profile("HashJoinerTest");
+    HashJoinBuildMetrics metrics;
+    metrics.prepare(&profile);
+
+    metrics.update_partition_stats({100, 100, 100, 100});
+    ASSERT_EQ(4, metrics.partition_nums->value());
+    ASSERT_EQ(100, metrics.partition_max_rows->value());
+    ASSERT_EQ(100, metrics.partition_skew->value());
+
+    // all the rows in one partition
+    metrics.update_partition_stats({0, 400, 0, 0});
+    ASSERT_EQ(4, metrics.partition_nums->value());
+    ASSERT_EQ(400, metrics.partition_max_rows->value());
+    ASSERT_EQ(400, metrics.partition_skew->value());
+
+    metrics.update_partition_stats({10, 30});
+    ASSERT_EQ(2, metrics.partition_nums->value());
+    ASSERT_EQ(30, metrics.partition_max_rows->value());
+    ASSERT_EQ(150, metrics.partition_skew->value());
+
+    // no rows
+    metrics.update_partition_stats({0, 0});
+    ASSERT_EQ(0, metrics.partition_max_rows->value());
+    ASSERT_EQ(100, metrics.partition_skew->value());
+}
+
+} // namespace starrocks
@@ -1339,6 +1339,126 @@ TEST_F(JoinHashMapTest, FixedSizeJoinBuildProbeFuncNullable) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LinearProbingJoinBuildProbeFunc) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+
+    // every key appears twice in the build side
+    auto type = TypeDescriptor::from_logical_type(LogicalType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, false);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 0), 0, 10);
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 0), 0, 10);
+    auto probe_column = JoinHashMapTest::create_int32_column(20, 0);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.row_count = 20;
+    probe_state.probe_row_count = 20;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    LinearProbingJoinBuildFunc<TYPE_INT>::prepare(_runtime_state.get(), &table_items);
+    LinearProbingJoinProbeFunc<TYPE_INT>::prepare(_runtime_state.get(), &probe_state);
+    LinearProbingJoinBuildFunc<TYPE_INT>::construct_hash_table(_runtime_state.get(), &table_items, &probe_state);
+    LinearProbingJoinProbeFunc<TYPE_INT>::lookup_init(table_items, &probe_state);
+
+    ASSERT_EQ(64, table_items.bucket_size);
+    ASSERT_EQ(10, table_items.used_buckets);
+    auto data = ColumnHelper::as_raw_column<Int32Column>(table_items.key_columns[0])->get_data();
+    for (size_t i = 0; i < 20; i++) {
+        size_t found_count = 0;
+        size_t probe_index = probe_state.next[i];
+        while (probe_index != 0) {
+            // a chain only holds the rows of the same key
+            ASSERT_EQ(static_cast<int32_t>(i), data[probe_index]);
+            found_count++;
+            probe_index = table_items.next[probe_index];
+        }
+        ASSERT_EQ(found_count, i < 10 ? 2 : 0);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LinearProbingJoinBuildProbeFuncNullable) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+
+    auto type = TypeDescriptor::from_logical_type(LogicalType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, true);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_nullable_column(10, 0), 0, 10);
+    auto probe_column = JoinHashMapTest::create_int32_nullable_column(10, 0);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.row_count = 10;
+    probe_state.probe_row_count = 10;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    LinearProbingJoinBuildFunc<TYPE_INT>::prepare(_runtime_state.get(), &table_items);
+    LinearProbingJoinProbeFunc<TYPE_INT>::prepare(_runtime_state.get(), &probe_state);
+    LinearProbingJoinBuildFunc<TYPE_INT>::construct_hash_table(_runtime_state.get(), &table_items, &probe_state);
+    LinearProbingJoinProbeFunc<TYPE_INT>::lookup_init(table_items, &probe_state);
+
+    for (size_t i = 0; i < 10; i++) {
+        if (i % 2 == 1) {
+            ASSERT_EQ(0, probe_state.next[i]);
+        } else {
+            ASSERT_EQ(i + 1, probe_state.next[i]);
+            ASSERT_EQ(0, table_items.next[probe_state.next[i]]);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, FixedSizeLinearProbingJoinBuildProbeFuncNullable) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+
+    auto build_column1 = ColumnHelper::create_column(_int_type, true);
+    build_column1->append_default();
+    build_column1->append(*JoinHashMapTest::create_int32_nullable_column(10, 0), 0, 10);
+
+    auto build_column2 = ColumnHelper::create_column(_int_type, true);
+    build_column2->append_default();
+    build_column2->append(*JoinHashMapTest::create_int32_nullable_column(10, 100), 0, 10);
+
+    auto probe_column1 = JoinHashMapTest::create_int32_nullable_column(10, 0);
+    auto probe_column2 = JoinHashMapTest::create_int32_nullable_column(10, 100);
+
+    table_items.key_columns.emplace_back(build_column1);
+    table_items.key_columns.emplace_back(build_column2);
+    table_items.row_count = 10;
+    table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+    table_items.join_keys.emplace_back(JoinKeyDesc{&_int_type, false, nullptr});
+    probe_state.probe_row_count = 10;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column1, probe_column2};
+    probe_state.key_columns = &probe_columns;
+
+    FixedSizeLinearProbingJoinBuildFunc<TYPE_BIGINT>::prepare(_runtime_state.get(), &table_items);
+    FixedSizeLinearProbingJoinProbeFunc<TYPE_BIGINT>::prepare(_runtime_state.get(), &probe_state);
+    FixedSizeLinearProbingJoinBuildFunc<TYPE_BIGINT>::construct_hash_table(_runtime_state.get(), &table_items,
+                                                                          &probe_state);
+    FixedSizeLinearProbingJoinProbeFunc<TYPE_BIGINT>::lookup_init(table_items, &probe_state);
+
+    auto* data_column = ColumnHelper::as_raw_column<Int64Column>(table_items.build_key_column);
+    auto data = data_column->get_data();
+    for (size_t i = 0; i < 10; i++) {
+        size_t probe_index = probe_state.next[i];
+        if (i % 2 == 0) {
+            ASSERT_EQ(i + 1, probe_index);
+            ASSERT_EQ((100 + i) * (1ul << 32ul) + i, data[probe_index]);
+        } else {
+            ASSERT_EQ(0, probe_index);
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
     JoinHashTableItems table_items;
@@ -0,0 +1,204 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/aggregate/aggregate_streaming_sink_operator.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "exec/pipeline/aggregate/aggregate_streaming_source_operator.h"
+#include "exec/pipeline/query_context.h"
+#include "gutil/casts.h"
+#include "testutil/assert.h"
+#include "testutil/desc_tbl_helper.h"
+#include "testutil/exprs_test_helper.h"
+
+namespace starrocks::pipeline {
+
+// The streaming aggregate of "select k, sum(v) from t group by k" in AUTO mode, the value of each row is 1.
+class AggregateStreamingSinkOperatorTest : public testing::Test {
+public:
+    void SetUp() override {
+        _enable_cache_preagg = config::enable_streaming_agg_cache_preaggregation;
+        _cache_preagg_ht_size = config::streaming_agg_cache_preaggregation_ht_size;
+        config::enable_streaming_agg_cache_preaggregation = true;
+        // Much smaller than the hash table of a chunk with distinct keys, so that it is full after one chunk.
+        config::streaming_agg_cache_preaggregation_ht_size = 16 * 1024;
+
+        _runtime_state = _obj_pool.add(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr));
+        _runtime_state->set_query_ctx(_query_ctx.get());
+        _runtime_state->set_chunk_size(kChunkSize);
+
+        // The slots of tuple 0 (input) are 0 and 1, tuple 1 (intermediate and output) 2 and 3.
+        std::vector<SlotTypeInfoArray> slot_infos = {
+                {{"k", TYPE_BIGINT, false}, {"v", TYPE_BIGINT, false}},
+                {{"k", TYPE_BIGINT, false}, {"sum_v", TYPE_BIGINT, true}},
+        };
+        auto* desc_tbl = DescTblHelper::generate_desc_tbl(
+                _runtime_state, _obj_pool, DescTblHelper::create_slot_type_desc_info_arrays(slot_infos));
+        _runtime_state->set_desc_tbl(desc_tbl);
+
+        auto bigint_type = ExprsTestHelper::create_scalar_type_desc(TPrimitiveType::BIGINT);
+        auto key = ExprsTestHelper::create_slot_expr_node(0, 0, bigint_type, false);
+        auto value = ExprsTestHelper::create_slot_expr_node(0, 1, bigint_type, false);
+        auto sum_fn = ExprsTestHelper::create_builtin_function("sum", {bigint_type}, bigint_type, bigint_type);
+
+        _tnode.node_id = 1;
+        _tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        _tnode.limit = -1;
+        _tnode.agg_node.__set_grouping_exprs({ExprsTestHelper::create_slot_expr(key)});
+        _tnode.agg_node.aggregate_functions = {ExprsTestHelper::create_aggregate_expr(sum_fn, {value})};
+        _tnode.agg_node.intermediate_tuple_id = 1;
+        _tnode.agg_node.output_tuple_id = 1;
+        _tnode.agg_node.need_finalize = false;
+        _tnode.agg_node.__set_streaming_preaggregation_mode(TStreamingPreaggregationMode::AUTO);
+
+        _aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+        _sink_factory = std::make_unique<AggregateStreamingSinkOperatorFactory>(1, 1, _aggregator_factory);
+        _source_factory = std::make_unique<AggregateStreamingSourceOperatorFactory>(2, 1, _aggregator_factory);
+        _sink = _sink_factory->create(1, 0);
+        _source = _source_factory->create(1, 0);
+        ASSERT_OK(_sink->prepare(_runtime_state));
+        ASSERT_OK(_source->prepare(_runtime_state));
+    }
+
+    void TearDown() override {
+        _sink->close(_runtime_state);
+        _source->close(_runtime_state);
+        config::enable_streaming_agg_cache_preaggregation = _enable_cache_preagg;
+        config::streaming_agg_cache_preaggregation_ht_size = _cache_preagg_ht_size;
+    }
+
+protected:
+    static constexpr size_t kChunkSize = 4096;
+
+    AggrAutoState auto_state() { return down_cast<AggregateStreamingSinkOperator*>(_sink.get())->auto_state(); }
+
+    // Push a chunk whose key of the j-th row is key_of(j), and pull all the output of the source operator.
+    template <typename KeyOf>
+    void push(KeyOf key_of) {
+        auto keys = Int64Column::create();
+        auto values = Int64Column::create();
+        for (size_t j = 0; j < kChunkSize; j++) {
+            const int64_t key = key_of(j);
+            keys->append(key);
+            values->append(1);
+            _expected[key]++;
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(std::move(keys), 0);
+        chunk->append_column(std::move(values), 1);
+
+        ASSERT_TRUE(_sink->need_input());
+        ASSERT_OK(_sink->push_chunk(_runtime_state, chunk));
+        while (_source->has_output()) {
+            ASSERT_NO_FATAL_FAILURE(pull());
+        }
+    }
+
+    void pull() {
+        ASSIGN_OR_ABORT(auto chunk, _source->pull_chunk(_runtime_state));
+        if (chunk == nullptr) {
+            return;
+        }
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            const int64_t key = chunk->get_column_by_index(0)->get(i).get_int64();
+            _actual[key] += chunk->get_column_by_index(1)->get(i).get_int64();
+        }
+    }
+
+    // The partial results of the streaming aggregate sum up to the results of the input.
+    void finish_and_check() {
+        ASSERT_OK(_sink->set_finishing(_runtime_state));
+        while (!_source->is_finished()) {
+            ASSERT_NO_FATAL_FAILURE(pull());
+        }
+        ASSERT_EQ(_expected, _actual);
+    }
+
+    // Push the chunks of distinct keys until the hash table is too large to leave INIT_PREAGG, it is the keys
+    // [0, _next_key) in the hash table after that.
+    void enter_adjust() {
+        for (int i = 0; i < 64 && auto_state() == AggrAutoState::INIT_PREAGG; i++) {
+            ASSERT_NO_FATAL_FAILURE(push([this](size_t) { return _next_key++; }));
+        }
+        ASSERT_EQ(AggrAutoState::ADJUST, auto_state());
+    }
+
+    // Push the chunks whose half rows hit the hash table, neither high nor low reduction.
+    void push_middle_reduction_chunks(AggrAutoState expected_state) {
+        for (int i = 0; i < 2 * AggrAutoContext::StableLimit && auto_state() == AggrAutoState::ADJUST; i++) {
+            ASSERT_NO_FATAL_FAILURE(push([this](size_t j) {
+                return j < kChunkSize / 2 ? static_cast<int64_t>(j % 1000) : _next_key++;
+            }));
+        }
+        ASSERT_EQ(expected_state, auto_state());
+    }
+
+    ObjectPool _obj_pool;
+    std::shared_ptr<QueryContext> _query_ctx = std::make_shared<QueryContext>();
+    RuntimeState* _runtime_state = nullptr;
+    TPlanNode _tnode;
+    AggregatorFactoryPtr _aggregator_factory;
+    std::unique_ptr<AggregateStreamingSinkOperatorFactory> _sink_factory;
+    std::unique_ptr<AggregateStreamingSourceOperatorFactory> _source_factory;
+    OperatorPtr _sink;
+    OperatorPtr _source;
+
+    int64_t _next_key = 0;
+    std::map<int64_t, int64_t> _expected;
+    std::map<int64_t, int64_t> _actual;
+
+    bool _enable_cache_preagg = false;
+    int64_t _cache_preagg_ht_size = 0;
+};
+
+TEST_F(AggregateStreamingSinkOperatorTest, test_cache_preagg_to_pass_through) {
+    ASSERT_NO_FATAL_FAILURE(enter_adjust());
+    ASSERT_NO_FATAL_FAILURE(push_middle_reduction_chunks(AggrAutoState::CACHE_PREAGG));
+
+    // High cardinality input, none of the rows hits the hash table once it is full.
+    for (int i = 0; i < 2 * AggrAutoContext::StableLimit && auto_state() == AggrAutoState::CACHE_PREAGG; i++) {
+        ASSERT_NO_FATAL_FAILURE(push([this](size_t) { return _next_key++; }));
+    }
+    ASSERT_EQ(AggrAutoState::PASS_THROUGH, auto_state());
+    ASSERT_NO_FATAL_FAILURE(finish_and_check());
+}
+
+TEST_F(AggregateStreamingSinkOperatorTest, test_cache_preagg_to_adjust) {
+    ASSERT_NO_FATAL_FAILURE(enter_adjust());
+    ASSERT_NO_FATAL_FAILURE(push_middle_reduction_chunks(AggrAutoState::CACHE_PREAGG));
+
+    // Low cardinality input, the hash table is flushed when entering CACHE_PREAGG, the first chunk fills it with the
+    // hot keys, then all the rows hit it.
+    const int64_t hot_key_base = _next_key;
+    for (int i = 0; i < 2 * AggrAutoContext::StableLimit && auto_state() == AggrAutoState::CACHE_PREAGG; i++) {
+        ASSERT_NO_FATAL_FAILURE(push([hot_key_base](size_t j) { return hot_key_base + j; }));
+    }
+    ASSERT_EQ(AggrAutoState::ADJUST, auto_state());
+    ASSERT_NO_FATAL_FAILURE(finish_and_check());
+}
+
+TEST_F(AggregateStreamingSinkOperatorTest, test_cache_preagg_disabled) {
+    config::enable_streaming_agg_cache_preaggregation = false;
+    ASSERT_NO_FATAL_FAILURE(enter_adjust());
+    ASSERT_NO_FATAL_FAILURE(push_middle_reduction_chunks(AggrAutoState::SELECTIVE_PREAGG));
+    ASSERT_NO_FATAL_FAILURE(finish_and_check());
+}
+
+} // namespace starrocks::pipeline
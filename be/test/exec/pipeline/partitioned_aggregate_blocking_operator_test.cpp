@@ -0,0 +1,231 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/pipeline/aggregate/partitioned_aggregate_blocking_operator.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "exec/pipeline/query_context.h"
+#include "testutil/assert.h"
+#include "testutil/desc_tbl_helper.h"
+#include "testutil/exprs_test_helper.h"
+
+namespace starrocks::pipeline {
+
+// The result of "select k, sum(v) from t group by k".
+using AggResult = std::map<int64_t, int64_t>;
+
+class PartitionedAggregateBlockingOperatorTest : public testing::Test {
+public:
+    void SetUp() override {
+        _runtime_state = _obj_pool.add(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr));
+        _runtime_state->set_query_ctx(_query_ctx.get());
+        _runtime_state->set_chunk_size(kChunkSize);
+
+        // The slots of tuple 0 (input) are 0 and 1, tuple 1 (intermediate) 2 and 3, tuple 2 (output) 4 and 5.
+        std::vector<SlotTypeInfoArray> slot_infos = {
+                {{"k", TYPE_BIGINT, false}, {"v", TYPE_BIGINT, false}},
+                {{"k", TYPE_BIGINT, false}, {"sum_v", TYPE_BIGINT, true}},
+                {{"k", TYPE_BIGINT, false}, {"sum_v", TYPE_BIGINT, true}},
+        };
+        auto* desc_tbl = DescTblHelper::generate_desc_tbl(
+                _runtime_state, _obj_pool, DescTblHelper::create_slot_type_desc_info_arrays(slot_infos));
+        _runtime_state->set_desc_tbl(desc_tbl);
+
+        auto bigint_type = ExprsTestHelper::create_scalar_type_desc(TPrimitiveType::BIGINT);
+        auto key = ExprsTestHelper::create_slot_expr_node(0, 0, bigint_type, false);
+        auto value = ExprsTestHelper::create_slot_expr_node(0, 1, bigint_type, false);
+        auto sum_fn = ExprsTestHelper::create_builtin_function("sum", {bigint_type}, bigint_type, bigint_type);
+
+        _tnode.node_id = 1;
+        _tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        _tnode.limit = -1;
+        _tnode.agg_node.__set_grouping_exprs({ExprsTestHelper::create_slot_expr(key)});
+        _tnode.agg_node.aggregate_functions = {ExprsTestHelper::create_aggregate_expr(sum_fn, {value})};
+        _tnode.agg_node.intermediate_tuple_id = 1;
+        _tnode.agg_node.output_tuple_id = 2;
+        _tnode.agg_node.need_finalize = true;
+    }
+
+protected:
+    static constexpr int kChunkSize = 64;
+
+    // Generate num_chunks chunks, the key of a row is picked by key_of(row index).
+    template <typename KeyOf>
+    Chunks make_input(size_t num_chunks, KeyOf key_of) {
+        Chunks chunks;
+        size_t row = 0;
+        for (size_t i = 0; i < num_chunks; i++) {
+            auto keys = Int64Column::create();
+            auto values = Int64Column::create();
+            for (size_t j = 0; j < kChunkSize; j++, row++) {
+                keys->append(key_of(row));
+                values->append(static_cast<int64_t>(row % 7));
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(std::move(keys), 0);
+            chunk->append_column(std::move(values), 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    static void collect(const ChunkPtr& chunk, AggResult* result) {
+        if (chunk == nullptr) {
+            return;
+        }
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            const int64_t key = chunk->get_column_by_index(0)->get(i).get_int64();
+            ASSERT_EQ(0, result->count(key)) << "duplicated key " << key;
+            (*result)[key] = chunk->get_column_by_index(1)->get(i).get_int64();
+        }
+    }
+
+    // Aggregate all the input by a single AggregateBlockingSinkOperator and AggregateBlockingSourceOperator.
+    AggResult run_non_partitioned(const Chunks& input) {
+        AggResult result;
+        auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+        AggregateBlockingSinkOperatorFactory sink_factory(1, 1, aggregator_factory, nullptr);
+        AggregateBlockingSourceOperatorFactory source_factory(2, 1, aggregator_factory);
+        auto sink = sink_factory.create(1, 0);
+        auto source = source_factory.create(1, 0);
+        EXPECT_OK(sink->prepare(_runtime_state));
+        EXPECT_OK(source->prepare(_runtime_state));
+
+        for (const auto& chunk : input) {
+            EXPECT_OK(sink->push_chunk(_runtime_state, chunk));
+        }
+        EXPECT_OK(sink->set_finishing(_runtime_state));
+        while (!source->is_finished()) {
+            auto chunk_or = source->pull_chunk(_runtime_state);
+            EXPECT_OK(chunk_or.status());
+            collect(chunk_or.value(), &result);
+        }
+
+        sink->close(_runtime_state);
+        source->close(_runtime_state);
+        return result;
+    }
+
+    AggResult run_partitioned(const Chunks& input, size_t num_sinkers, size_t num_sources,
+                              size_t partitions_per_source) {
+        AggResult result;
+        const size_t num_partitions = num_sources * partitions_per_source;
+        auto context = std::make_shared<PartitionedAggregateContext>(num_sinkers, num_partitions);
+        auto aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+        auto merge_aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+        PartitionedAggregateBlockingSinkOperatorFactory sink_factory(1, 1, aggregator_factory, context);
+        PartitionedAggregateBlockingSourceOperatorFactory source_factory(2, 1, merge_aggregator_factory, context);
+
+        Operators sinks;
+        for (size_t i = 0; i < num_sinkers; i++) {
+            sinks.emplace_back(sink_factory.create(num_sinkers, i));
+            EXPECT_OK(sinks.back()->prepare(_runtime_state));
+        }
+        Operators sources;
+        for (size_t i = 0; i < num_sources; i++) {
+            sources.emplace_back(source_factory.create(num_sources, i));
+            EXPECT_OK(sources.back()->prepare(_runtime_state));
+        }
+
+        for (size_t i = 0; i < input.size(); i++) {
+            EXPECT_OK(sinks[i % num_sinkers]->push_chunk(_runtime_state, input[i]));
+        }
+        for (size_t i = 0; i < num_sinkers; i++) {
+            EXPECT_FALSE(context->is_sink_complete());
+            for (const auto& source : sources) {
+                EXPECT_FALSE(source->has_output());
+            }
+            EXPECT_OK(sinks[i]->set_finishing(_runtime_state));
+            // The hash map of the sink operator is released once its states are scattered into the partitions.
+            EXPECT_EQ(0, aggregator_factory->get_or_create(i)->hash_map_variant().size());
+        }
+        EXPECT_TRUE(context->is_sink_complete());
+
+        bool all_finished = false;
+        while (!all_finished) {
+            all_finished = true;
+            for (const auto& source : sources) {
+                if (source->is_finished()) {
+                    continue;
+                }
+                all_finished = false;
+                EXPECT_TRUE(source->has_output());
+                auto chunk_or = source->pull_chunk(_runtime_state);
+                EXPECT_OK(chunk_or.status());
+                collect(chunk_or.value(), &result);
+            }
+        }
+
+        // All the partition chunks have been merged and released, and so have the merged states of each partition.
+        for (size_t i = 0; i < num_sinkers; i++) {
+            for (size_t j = 0; j < num_partitions; j++) {
+                EXPECT_TRUE(context->partition_chunks(i, j).empty());
+            }
+        }
+        for (size_t i = 0; i < num_sources; i++) {
+            EXPECT_EQ(0, merge_aggregator_factory->get_or_create(i)->hash_map_variant().size());
+        }
+        EXPECT_EQ(-1, context->claim_partition());
+
+        for (const auto& sink : sinks) {
+            sink->close(_runtime_state);
+        }
+        for (const auto& source : sources) {
+            source->close(_runtime_state);
+        }
+        return result;
+    }
+
+    ObjectPool _obj_pool;
+    std::shared_ptr<QueryContext> _query_ctx = std::make_shared<QueryContext>();
+    RuntimeState* _runtime_state = nullptr;
+    TPlanNode _tnode;
+};
+
+TEST_F(PartitionedAggregateBlockingOperatorTest, test_uniform_keys) {
+    auto input = make_input(40, [](size_t row) { return static_cast<int64_t>(row % 1000); });
+    auto expected = run_non_partitioned(input);
+    ASSERT_EQ(1000, expected.size());
+
+    for (size_t partitions_per_source : {1, 4}) {
+        auto actual = run_partitioned(input, 3, 2, partitions_per_source);
+        ASSERT_EQ(expected, actual) << "partitions_per_source=" << partitions_per_source;
+    }
+}
+
+TEST_F(PartitionedAggregateBlockingOperatorTest, test_skewed_keys) {
+    // 90% of the rows have the key 0, so one partition is much larger than the others.
+    auto input = make_input(50, [](size_t row) { return row % 10 == 0 ? static_cast<int64_t>(row) : 0; });
+    auto expected = run_non_partitioned(input);
+
+    auto actual = run_partitioned(input, 4, 3, 4);
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(PartitionedAggregateBlockingOperatorTest, test_more_sources_than_keys) {
+    // Most of the partitions are empty.
+    auto input = make_input(10, [](size_t row) { return static_cast<int64_t>(row % 3); });
+    auto expected = run_non_partitioned(input);
+    ASSERT_EQ(3, expected.size());
+
+    auto actual = run_partitioned(input, 2, 4, 4);
+    ASSERT_EQ(expected, actual);
+}
+
+} // namespace starrocks::pipeline
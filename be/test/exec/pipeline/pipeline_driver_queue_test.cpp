@@ -21,6 +21,7 @@
 #include "exec/pipeline/pipeline_fwd.h"
 #include "exec/workgroup/work_group.h"
 #include "testutil/parallel_test.h"
+#include "util/cpu_info.h"
 
 namespace starrocks::pipeline {
 
@@ -165,6 +166,104 @@ PARALLEL_TEST(QuerySharedDriverQueueTest, test_take_close) {
     consumer_thread->join();
 }
 
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_local_and_steal) {
+    auto shared_queue = std::make_unique<QuerySharedDriverQueue>();
+    auto* shared_queue_ptr = shared_queue.get();
+    WorkStealingDriverQueue queue(std::move(shared_queue), 2);
+
+    QueryContext query_context;
+    std::vector<std::shared_ptr<PipelineDriver>> drivers;
+    for (int i = 0; i < 4; i++) {
+        drivers.emplace_back(std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, nullptr, -1));
+        _set_driver_level(drivers.back().get(), 0);
+    }
+
+    // The threads without a deque put back the drivers to the shared queue.
+    queue.put_back_from_executor(drivers[0].get());
+    ASSERT_EQ(1, shared_queue_ptr->size());
+    ASSERT_EQ(drivers[0].get(), queue.take(false).value());
+
+    // The worker keeps the yielded drivers in its deque, and takes them in FIFO order.
+    queue.register_worker();
+    for (auto& driver : drivers) {
+        queue.put_back_from_executor(driver.get());
+    }
+    ASSERT_EQ(0, shared_queue_ptr->size());
+    ASSERT_EQ(4, queue.size());
+    ASSERT_EQ(drivers[0].get(), queue.take(false).value());
+
+    // The other worker steals from the top of the deque.
+    std::thread thief([&] {
+        queue.register_worker();
+        auto maybe_driver = queue.take(false);
+        ASSERT_TRUE(maybe_driver.ok());
+        ASSERT_EQ(drivers[1].get(), maybe_driver.value());
+        queue.unregister_worker();
+    });
+    thief.join();
+    ASSERT_EQ(1, queue.num_steals());
+    ASSERT_EQ(drivers[2].get(), queue.take(false).value());
+
+    // The remaining drivers are moved to the shared queue when the worker exits.
+    queue.unregister_worker();
+    ASSERT_EQ(1, shared_queue_ptr->size());
+    ASSERT_EQ(drivers[3].get(), queue.take(false).value());
+    ASSERT_EQ(nullptr, queue.take(false).value());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_close) {
+    WorkStealingDriverQueue queue(std::make_unique<QuerySharedDriverQueue>(), 1);
+
+    auto consumer_thread = std::make_shared<std::thread>([&queue] {
+        queue.register_worker();
+        auto maybe_driver = queue.take(true);
+        ASSERT_TRUE(maybe_driver.status().is_cancelled());
+        queue.unregister_worker();
+    });
+
+    sleep(1);
+    queue.close();
+
+    consumer_thread->join();
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_numa_inbox) {
+    auto shared_queue = std::make_unique<QuerySharedDriverQueue>();
+    auto* shared_queue_ptr = shared_queue.get();
+    WorkStealingDriverQueue queue(std::move(shared_queue), 2, 2);
+
+    QueryContext query_context;
+    FragmentContext fragment_ctx0;
+    fragment_ctx0.set_numa_node(0);
+    FragmentContext fragment_ctx1;
+    fragment_ctx1.set_numa_node(1);
+    auto driver0 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, &fragment_ctx0, nullptr, -1);
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, &fragment_ctx1, nullptr, -1);
+
+    // Both the nodes have no executor threads.
+    queue.put_back(driver0.get());
+    ASSERT_EQ(1, shared_queue_ptr->size());
+    ASSERT_EQ(driver0.get(), queue.take(false).value());
+
+    queue.register_worker();
+    const int numa_node = CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core()) == 0 ? 0 : 1;
+    auto* local_driver = numa_node == 0 ? driver0.get() : driver1.get();
+    auto* remote_driver = numa_node == 0 ? driver1.get() : driver0.get();
+
+    // The driver preferring the node of this thread is sent to the inbox.
+    queue.put_back(local_driver);
+    ASSERT_EQ(0, shared_queue_ptr->size());
+    ASSERT_EQ(1, queue.size());
+    ASSERT_EQ(local_driver, queue.take(false).value());
+
+    // The other node has no executor threads, so the driver preferring it goes to the shared queue.
+    queue.put_back_from_executor(remote_driver);
+    ASSERT_EQ(1, shared_queue_ptr->size());
+    ASSERT_EQ(remote_driver, queue.take(false).value());
+
+    queue.unregister_worker();
+}
+
 class WorkGroupDriverQueueTest : public ::testing::Test {
 public:
     void SetUp() override {
@@ -30,11 +30,15 @@
 #include "exec/query_cache/cache_operator.h"
 #include "exec/query_cache/cache_param.h"
 #include "exec/query_cache/conjugate_operator.h"
+#include "exec/query_cache/disk_cache.h"
 #include "exec/query_cache/lane_arbiter.h"
 #include "exec/query_cache/multilane_operator.h"
 #include "exec/query_cache/ticket_checker.h"
 #include "exec/query_cache/transform_operator.h"
+#include "fs/fs_util.h"
 #include "gutil/strings/substitute.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -160,6 +164,100 @@ TEST_F(QueryCacheTest, testCacheManager) {
     ASSERT_GE(cache_mgr->memory_usage(), 0);
 }
 
+TEST_F(QueryCacheTest, testDiskCache) {
+    const std::string dir = "./query_cache_test_disk_cache";
+    ASSERT_OK(fs::remove_all(dir));
+    DeferOp defer([&]() { ASSERT_OK(fs::remove_all(dir)); });
+
+    auto create_cache_value = [](int64_t version, double first, size_t num_rows) {
+        auto chk = std::make_shared<Chunk>();
+        auto col = DoubleColumn::create();
+        for (size_t i = 0; i < num_rows; ++i) {
+            col->append(first + i);
+        }
+        chk->append_column(col, SlotId(1));
+        chk->owner_info().set_owner_id(1, false);
+        auto last_chk = std::make_shared<Chunk>();
+        last_chk->owner_info().set_owner_id(1, true);
+        query_cache::CacheValue value(0, version, {chk, last_chk});
+        value.slot_types[1] = TypeDescriptor(TYPE_DOUBLE);
+        return value;
+    };
+    auto check_cache_value = [](const query_cache::CacheValue& value, int64_t version, double first, size_t num_rows) {
+        ASSERT_EQ(version, value.version);
+        ASSERT_EQ(2, value.result.size());
+        const auto& chk = value.result[0];
+        ASSERT_EQ(num_rows, chk->num_rows());
+        ASSERT_EQ(1, chk->owner_info().owner_id());
+        ASSERT_FALSE(chk->owner_info().is_last_chunk());
+        auto* col = down_cast<DoubleColumn*>(chk->get_column_by_slot_id(1).get());
+        for (size_t i = 0; i < num_rows; ++i) {
+            ASSERT_EQ(first + i, col->get_data()[i]);
+        }
+        ASSERT_EQ(0, value.result[1]->num_columns());
+        ASSERT_TRUE(value.result[1]->owner_info().is_last_chunk());
+    };
+
+    // serde
+    {
+        auto value = create_cache_value(3, 10, 100);
+        ASSIGN_OR_ABORT(auto buffer, query_cache::DiskCache::serialize("key", value));
+        ASSIGN_OR_ABORT(auto res, query_cache::DiskCache::deserialize("key", buffer));
+        check_cache_value(res, 3, 10, 100);
+        ASSERT_TRUE(query_cache::DiskCache::deserialize("other_key", buffer).status().is_not_found());
+        buffer[buffer.size() / 2] ^= 0x1;
+        ASSERT_TRUE(query_cache::DiskCache::deserialize("key", buffer).status().is_corruption());
+    }
+
+    // the entries evicted from the memory are persisted, and promoted when hit
+    {
+        auto cache_mgr = std::make_shared<query_cache::CacheManager>(4096);
+        ASSERT_OK(cache_mgr->enable_disk_cache(dir, 1024 * 1024, 1024 * 1024));
+        for (auto i = 0; i < 10; ++i) {
+            cache_mgr->populate(strings::Substitute("key_$0", i), create_cache_value(i, i * 100, 100));
+        }
+        cache_mgr->disk_cache()->flush();
+        size_t num_memory_hits = 0;
+        for (auto i = 0; i < 10; ++i) {
+            const auto key = strings::Substitute("key_$0", i);
+            if (cache_mgr->probe(key).ok()) {
+                num_memory_hits++;
+            } else {
+                // the entry on the disk is promoted into the memory in the background
+                cache_mgr->disk_cache()->flush();
+            }
+            ASSIGN_OR_ABORT(auto value, cache_mgr->probe(key));
+            check_cache_value(value, i, i * 100, 100);
+        }
+        ASSERT_EQ(10 - num_memory_hits, cache_mgr->disk_hit_count());
+        ASSERT_FALSE(cache_mgr->probe("key_10").ok());
+        cache_mgr->disk_cache()->flush();
+        ASSERT_FALSE(cache_mgr->probe("key_10").ok());
+    }
+
+    // the entries left in the memory are persisted when the cache is destroyed, and loaded after restart
+    {
+        auto cache_mgr = std::make_shared<query_cache::CacheManager>(4096);
+        ASSERT_OK(cache_mgr->enable_disk_cache(dir, 1024 * 1024, 1024 * 1024));
+        ASSERT_EQ(10, cache_mgr->disk_cache()->num_entries());
+        for (auto i = 0; i < 10; ++i) {
+            const auto key = strings::Substitute("key_$0", i);
+            // probe does not wait for the disk
+            ASSERT_TRUE(cache_mgr->probe(key).status().is_not_found());
+            cache_mgr->disk_cache()->flush();
+            ASSIGN_OR_ABORT(auto value, cache_mgr->probe(key));
+            check_cache_value(value, i, i * 100, 100);
+        }
+        ASSERT_EQ(10, cache_mgr->disk_hit_count());
+
+        cache_mgr->invalidate_all();
+        cache_mgr->disk_cache()->flush();
+        ASSERT_EQ(0, cache_mgr->disk_cache()->num_entries());
+        ASSERT_EQ(0, cache_mgr->disk_cache()->usage());
+        ASSERT_FALSE(cache_mgr->probe("key_0").ok());
+    }
+}
+
 ChunkPtr create_test_chunk(query_cache::LaneOwnerType owner, long from, long to, bool is_last_chunk) {
     ChunkPtr chunk = std::make_shared<Chunk>();
     chunk->owner_info().set_owner_id(owner, is_last_chunk);
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <random>
+#include <set>
 #include <utility>
 
 #include "column/chunk.h"
@@ -25,6 +26,8 @@
 #include "column/vectorized_fwd.h"
 #include "exec/sorting/merge.h"
 #include "exec/sorting/merge_path.h"
+#include "exec/sorting/normalized_key.h"
+#include "exec/sorting/radix_sort.h"
 #include "exec/sorting/sort_helper.h"
 #include "exec/sorting/sort_permute.h"
 #include "exprs/column_ref.h"
@@ -247,6 +250,108 @@ TEST(SortingTest, materialize_by_permutation_int) {
     ASSERT_EQ(2048, merged->get(1).get_int32());
 }
 
+TEST(SortingTest, radix_sort_column) {
+    std::mt19937 rng(0);
+    // Cover the buckets sorted by pdqsort and by multiple radix passes, and the bytes shared by all the keys.
+    std::uniform_int_distribution<int64_t> dist(-100000, 100000);
+    const std::atomic<bool> cancel = false;
+
+    for (LogicalType ltype : {TYPE_INT, TYPE_BIGINT, TYPE_DATE}) {
+        for (bool nullable : {false, true}) {
+            TypeDescriptor type_desc(ltype);
+            ColumnPtr column = ColumnHelper::create_column(type_desc, nullable);
+            ASSERT_TRUE(is_radix_sortable_column(column.get()));
+            for (int i = 0; i < 10000; i++) {
+                int64_t value = dist(rng);
+                if (nullable && value % 7 == 0) {
+                    column->append_nulls(1);
+                } else if (ltype == TYPE_INT) {
+                    column->append_datum(Datum(static_cast<int32_t>(value)));
+                } else if (ltype == TYPE_BIGINT) {
+                    column->append_datum(Datum(value));
+                } else {
+                    DateValue date = DateValue::create(2000, 1, 1).add<TimeUnit::DAY>(value % 20000);
+                    column->append_datum(Datum(date));
+                }
+            }
+
+            for (bool is_asc : {true, false}) {
+                for (bool null_first : {true, false}) {
+                    SortDesc sort_desc(is_asc, null_first);
+                    SmallPermutation perm;
+                    ASSERT_OK(radix_sort_column(cancel, column.get(), sort_desc, &perm));
+                    ASSERT_EQ(column->size(), perm.size());
+
+                    std::set<uint32_t> indexes;
+                    for (size_t i = 0; i < perm.size(); i++) {
+                        indexes.insert(perm[i].index_in_chunk);
+                        if (i > 0) {
+                            int x = column->compare_at(perm[i - 1].index_in_chunk, perm[i].index_in_chunk, *column,
+                                                       sort_desc.nan_direction());
+                            ASSERT_LE(x * sort_desc.sort_order, 0);
+                        }
+                    }
+                    ASSERT_EQ(column->size(), indexes.size());
+                }
+            }
+        }
+    }
+
+    ASSERT_FALSE(is_radix_sortable_column(ColumnHelper::create_column(TypeDescriptor(TYPE_VARCHAR), false).get()));
+    ASSERT_FALSE(is_radix_sortable_column(ColumnHelper::create_column(TypeDescriptor(TYPE_DOUBLE), true).get()));
+}
+
+TEST(SortingTest, sort_by_normalized_keys) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int32_t> dist(0, 20);
+    const std::atomic<bool> cancel = false;
+
+    // The strings share long prefixes, so that the truncated prefixes tie and fall back to the full comparison.
+    const std::vector<std::string> prefixes = {"", "a", "starrocks", "starrocks_starrocks_", "starrocks_starrocks_x"};
+    Columns columns;
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_DATE), true));
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_BIGINT), false));
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor::create_varchar_type(64), true));
+    columns.emplace_back(ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false));
+    std::vector<std::string> strings;
+    for (int i = 0; i < 2000; i++) {
+        int32_t value = dist(rng);
+        if (value == 0) {
+            columns[0]->append_nulls(1);
+        } else {
+            columns[0]->append_datum(Datum(DateValue::create(2000, 1, 1).add<TimeUnit::DAY>(value % 3)));
+        }
+        columns[1]->append_datum(Datum(static_cast<int64_t>(value % 4) - 2));
+        if (value == 1) {
+            columns[2]->append_nulls(1);
+        } else {
+            strings.emplace_back(prefixes[value % prefixes.size()] + std::to_string(value % 3));
+            columns[2]->append_datum(Datum(Slice(strings.back())));
+        }
+        columns[3]->append_datum(Datum(value));
+    }
+
+    ASSERT_EQ(3, NormalizedSortKeys::num_normalizable_columns(columns, 16));
+    ASSERT_EQ(2, NormalizedSortKeys::num_normalizable_columns(columns, 64));
+
+    for (bool is_asc : {true, false}) {
+        for (bool null_first : {true, false}) {
+            SortDescs sort_desc(std::vector<bool>(columns.size(), is_asc),
+                                std::vector<bool>(columns.size(), null_first));
+            for (size_t prefix_length : {1, 8, 16}) {
+                SmallPermutation perm;
+                ASSERT_OK(sort_by_normalized_keys(cancel, columns, sort_desc, prefix_length, &perm));
+                ASSERT_EQ(columns[0]->size(), perm.size());
+                for (size_t i = 1; i < perm.size(); i++) {
+                    ASSERT_LE(compare_chunk_row(sort_desc, columns, columns, perm[i - 1].index_in_chunk,
+                                                perm[i].index_in_chunk),
+                              0);
+                }
+            }
+        }
+    }
+}
+
 TEST(SortingTest, steal_chunk) {
     ColumnPtr col1 = build_sorted_column(TypeDescriptor(TYPE_INT), 0, 100, 1);
     ColumnPtr col2 = build_sorted_column(TypeDescriptor(TYPE_INT), 0, 100, 1);
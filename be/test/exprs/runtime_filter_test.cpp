@@ -17,12 +17,18 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <random>
+#include <set>
 #include <utility>
 
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exprs/runtime_filter_bank.h"
+#include "runtime/current_thread.h"
+#include "runtime/mem_tracker.h"
 #include "simd/simd.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -89,6 +95,83 @@ TEST_F(RuntimeFilterTest, TestSimdBlockFilterMerge) {
         EXPECT_FALSE(bf2.test_hash(i + 2));
     }
 }
+
+TEST_F(RuntimeFilterTest, TestBinaryFuseFilter) {
+    std::mt19937_64 rng(1234);
+    const size_t num_keys = 100000;
+    std::vector<uint64_t> keys;
+    BinaryFuseFilter bf;
+    for (size_t i = 0; i < num_keys; i++) {
+        keys.push_back(rng());
+        bf.add_hash(keys.back());
+    }
+    // duplicated hashes
+    bf.add_hash(keys[0]);
+    bf.add_hash(keys[1]);
+    ASSERT_TRUE(bf.build());
+    ASSERT_TRUE(bf.built());
+    ASSERT_TRUE(bf.hashes().empty());
+    for (uint64_t key : keys) {
+        ASSERT_TRUE(bf.test_hash(key));
+    }
+    size_t false_positives = 0;
+    const size_t num_tests = 1000000;
+    for (size_t i = 0; i < num_tests; i++) {
+        false_positives += bf.test_hash(rng());
+    }
+    EXPECT_LT(false_positives * 1.0 / num_tests, 0.005);
+    EXPECT_LT(bf.get_alloc_size() * 8.0 / num_keys, 10);
+
+    BinaryFuseFilter empty_bf;
+    ASSERT_TRUE(empty_bf.build());
+    false_positives = 0;
+    for (size_t i = 0; i < 1000; i++) {
+        false_positives += empty_bf.test_hash(rng());
+    }
+    EXPECT_LT(false_positives, 20);
+}
+
+TEST_F(RuntimeFilterTest, TestSimdBlockFilterBinaryFuse) {
+    SimdBlockFilter bf0;
+    bf0.init_binary_fuse();
+    ASSERT_TRUE(bf0.is_binary_fuse());
+    ASSERT_TRUE(bf0.can_use());
+    for (int i = 1; i <= 200; i += 17) {
+        bf0.insert_hash(i);
+    }
+    bf0.finish_build();
+    ASSERT_TRUE(bf0.is_binary_fuse());
+    for (int i = 1; i <= 200; i += 17) {
+        EXPECT_TRUE(bf0.test_hash(i));
+    }
+
+    size_t ser_size = bf0.max_serialized_size();
+    std::vector<uint8_t> buf(ser_size, 0);
+    EXPECT_EQ(bf0.serialize(buf.data()), ser_size);
+    SimdBlockFilter bf1;
+    EXPECT_EQ(bf1.deserialize(buf.data()), ser_size);
+    ASSERT_TRUE(bf1.is_binary_fuse());
+    EXPECT_TRUE(bf0.check_equal(bf1));
+    for (int i = 1; i <= 200; i += 17) {
+        EXPECT_TRUE(bf1.test_hash(i));
+    }
+
+    // a built binary fuse filter can't be merged into
+    SimdBlockFilter bf2;
+    bf2.init(100);
+    bf2.insert_hash(2);
+    bf1.merge(bf2);
+    EXPECT_FALSE(bf1.can_use());
+
+    // the hashes of an unfinished binary fuse filter are merged
+    SimdBlockFilter bf3;
+    bf3.init_binary_fuse();
+    bf3.insert_hash(3);
+    bf2.merge(bf3);
+    EXPECT_TRUE(bf2.test_hash(2));
+    EXPECT_TRUE(bf2.test_hash(3));
+}
+
 static std::string alphabet0 =
         "abcdefgh"
         "igklmnop"
@@ -250,6 +333,295 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize2) {
     EXPECT_TRUE(rf3->check_equal(*rf1));
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterBinaryFuse) {
+    auto old_min_rows = config::runtime_filter_binary_fuse_min_rows;
+    auto old_max_bits = config::runtime_filter_bitset_max_bits;
+    DeferOp defer([&]() {
+        config::runtime_filter_binary_fuse_min_rows = old_min_rows;
+        config::runtime_filter_bitset_max_bits = old_max_bits;
+    });
+    config::runtime_filter_binary_fuse_min_rows = 100;
+    config::runtime_filter_bitset_max_bits = 0;
+
+    RuntimeBloomFilter<TYPE_INT> bf;
+    bf.init(50);
+    EXPECT_FALSE(bf.has_binary_fuse());
+
+    RuntimeBloomFilter<TYPE_INT> bf0;
+    JoinRuntimeFilter* rf0 = &bf0;
+    bf0.init(1000);
+    for (int i = 0; i < 1000; i++) {
+        bf0.insert(i * 3);
+    }
+    bf0.finish_build();
+    EXPECT_TRUE(rf0->has_binary_fuse());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(bf0._test_data(i * 3));
+    }
+
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(rf0);
+    std::vector<uint8_t> buffer(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(RF_VERSION_V2, rf0, buffer.data());
+    buffer.resize(actual_size);
+
+    JoinRuntimeFilter* rf1 = nullptr;
+    ObjectPool pool;
+    EXPECT_EQ(RF_VERSION_V3, RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf1, buffer.data(), actual_size));
+    ASSERT_TRUE(rf1 != nullptr);
+    EXPECT_TRUE(rf1->has_binary_fuse());
+    EXPECT_TRUE(rf1->check_equal(*rf0));
+
+    // test evaluate.
+    TypeDescriptor type_desc(TYPE_INT);
+    ColumnPtr column = ColumnHelper::create_column(type_desc, false);
+    auto* col = ColumnHelper::as_raw_column<RunTimeTypeTraits<TYPE_INT>::ColumnType>(column);
+    for (int i = 0; i < 3000; i++) {
+        col->append(i);
+    }
+    JoinRuntimeFilter::RunningContext ctx;
+    ctx.use_merged_selection = false;
+    ctx.selection.assign(column->size(), 1);
+    RuntimeFilterLayout layout;
+    layout.init(1, {});
+    rf1->compute_partition_index(layout, {column.get()}, &ctx);
+    rf1->evaluate(column.get(), &ctx);
+    size_t num_selected = 0;
+    for (int i = 0; i < 3000; i++) {
+        if (i % 3 == 0) {
+            EXPECT_TRUE(ctx.selection[i]);
+        }
+        num_selected += ctx.selection[i];
+    }
+    EXPECT_LT(num_selected, 1100);
+}
+
+TEST_F(RuntimeFilterTest, TestBitsetFilter) {
+    BitsetFilter bf;
+    std::set<int64_t> values;
+    // descending and ascending values
+    for (int64_t v = 1000; v >= -1000; v -= 3) {
+        ASSERT_TRUE(bf.reserve(v, 1 << 20));
+        bf.insert(v);
+        values.insert(v);
+    }
+    for (int64_t v = 1000; v < 5000; v += 7) {
+        ASSERT_TRUE(bf.reserve(v, 1 << 20));
+        bf.insert(v);
+        values.insert(v);
+    }
+    ASSERT_FALSE(bf.reserve(1 << 30, 1 << 20));
+    ASSERT_EQ(values.size(), bf.cardinality());
+    bf.shrink_to_fit();
+    EXPECT_LE(bf.min_value(), -998);
+    EXPECT_GE(bf.max_value(), 4999);
+    EXPECT_LT(bf.num_bits(), 6000 + 128);
+    for (int64_t v = -2000; v < 6000; v++) {
+        ASSERT_EQ(values.count(v) > 0, bf.test(v));
+    }
+    std::vector<int64_t> iterated;
+    bf.for_each([&](int64_t v) { iterated.push_back(v); });
+    ASSERT_EQ(std::vector<int64_t>(values.begin(), values.end()), iterated);
+
+    std::vector<uint8_t> buffer(bf.max_serialized_size());
+    size_t size = bf.serialize(buffer.data());
+    BitsetFilter bf1;
+    ASSERT_EQ(size, bf1.deserialize(buffer.data()));
+    ASSERT_TRUE(bf1.check_equal(bf));
+
+    // the limits of int64
+    BitsetFilter bf2;
+    ASSERT_TRUE(bf2.reserve(std::numeric_limits<int64_t>::max(), 1024));
+    bf2.insert(std::numeric_limits<int64_t>::max());
+    ASSERT_TRUE(bf2.reserve(std::numeric_limits<int64_t>::max() - 100, 1024));
+    bf2.insert(std::numeric_limits<int64_t>::max() - 100);
+    EXPECT_TRUE(bf2.test(std::numeric_limits<int64_t>::max()));
+    EXPECT_TRUE(bf2.test(std::numeric_limits<int64_t>::max() - 100));
+    EXPECT_FALSE(bf2.test(std::numeric_limits<int64_t>::min()));
+    EXPECT_FALSE(bf2.test(0));
+
+    // the union is too wide
+    ASSERT_FALSE(bf2.merge(bf, 1 << 20));
+    ASSERT_TRUE(bf2.test(std::numeric_limits<int64_t>::max()));
+    BitsetFilter bf3;
+    ASSERT_TRUE(bf3.reserve(10000, 1 << 20));
+    bf3.insert(10000);
+    ASSERT_TRUE(bf3.merge(bf, 1 << 20));
+    EXPECT_TRUE(bf3.test(10000));
+    EXPECT_TRUE(bf3.test(-998));
+    EXPECT_FALSE(bf3.test(-997));
+    EXPECT_EQ(values.size() + 1, bf3.cardinality());
+}
+
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterBitset) {
+    RuntimeBloomFilter<TYPE_INT> bf0;
+    JoinRuntimeFilter* rf0 = &bf0;
+    bf0.init(1000);
+    for (int i = 0; i < 1000; i++) {
+        bf0.insert(i * 3 - 1500);
+    }
+    bf0.finish_build();
+    ASSERT_TRUE(rf0->is_bitset());
+    EXPECT_TRUE(rf0->can_use_bf());
+    EXPECT_EQ(1000, rf0->bitset().cardinality());
+    for (int i = -1500; i < 1500; i++) {
+        EXPECT_EQ(i % 3 == 0, bf0._test_data(i));
+    }
+
+    size_t max_size = RuntimeFilterHelper::max_runtime_filter_serialized_size(rf0);
+    std::vector<uint8_t> buffer(max_size, 0);
+    size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(RF_VERSION_V2, rf0, buffer.data());
+    buffer.resize(actual_size);
+
+    JoinRuntimeFilter* rf1 = nullptr;
+    ObjectPool pool;
+    EXPECT_EQ(RF_VERSION_V3, RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf1, buffer.data(), actual_size));
+    ASSERT_TRUE(rf1 != nullptr);
+    EXPECT_TRUE(rf1->is_bitset());
+    EXPECT_TRUE(rf1->check_equal(*rf0));
+
+    // test evaluate, there is no false positive.
+    TypeDescriptor type_desc(TYPE_INT);
+    ColumnPtr column = ColumnHelper::create_column(type_desc, false);
+    auto* col = ColumnHelper::as_raw_column<RunTimeTypeTraits<TYPE_INT>::ColumnType>(column);
+    for (int i = -3000; i < 3000; i++) {
+        col->append(i);
+    }
+    JoinRuntimeFilter::RunningContext ctx;
+    ctx.use_merged_selection = false;
+    ctx.selection.assign(column->size(), 1);
+    RuntimeFilterLayout layout;
+    layout.init(1, {});
+    rf1->compute_partition_index(layout, {column.get()}, &ctx);
+    rf1->evaluate(column.get(), &ctx);
+    EXPECT_EQ(1000, SIMD::count_nonzero(ctx.selection));
+
+    // the sparse values fall back to the bloom filter
+    RuntimeBloomFilter<TYPE_BIGINT> bf2;
+    bf2.init(10);
+    bf2.insert(0);
+    bf2.insert(1L << 40);
+    bf2.finish_build();
+    EXPECT_FALSE(bf2.is_bitset());
+    EXPECT_TRUE(bf2.can_use_bf());
+    EXPECT_TRUE(bf2._test_data(0));
+    EXPECT_TRUE(bf2._test_data(1L << 40));
+
+    // no value is inserted
+    RuntimeBloomFilter<TYPE_INT> bf3;
+    bf3.init(10);
+    bf3.finish_build();
+    EXPECT_FALSE(bf3.is_bitset());
+    EXPECT_TRUE(bf3.can_use_bf());
+
+    auto old_max_bits = config::runtime_filter_bitset_max_bits;
+    DeferOp defer([&]() { config::runtime_filter_bitset_max_bits = old_max_bits; });
+    config::runtime_filter_bitset_max_bits = 0;
+    RuntimeBloomFilter<TYPE_INT> bf4;
+    bf4.init(10);
+    bf4.insert(1);
+    bf4.finish_build();
+    EXPECT_FALSE(bf4.is_bitset());
+}
+
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterBitsetConcat) {
+    ObjectPool pool;
+    RuntimeBloomFilter<TYPE_INT> prototype;
+    auto* global = prototype.create_empty(&pool);
+    for (int i = 0; i < 3; i++) {
+        RuntimeBloomFilter<TYPE_INT> local;
+        local.init(10);
+        for (int j = 0; j < 4; j++) {
+            local.insert((i + 1) * 10 + j);
+        }
+        local.finish_build();
+        global->concat(&local);
+    }
+    ASSERT_TRUE(global->is_bitset());
+    EXPECT_EQ(0, global->num_hash_partitions());
+    EXPECT_EQ(30, global->size());
+    for (int v = 0; v < 40; v++) {
+        EXPECT_EQ(v >= 10 && v % 10 < 4, global->_test_data(v));
+    }
+
+    // concatenated with a bloom filter, the bitset is converted into the bloom filters of the 3 partitions
+    RuntimeBloomFilter<TYPE_INT> sparse;
+    sparse.init(10);
+    sparse.insert(100);
+    sparse.insert(1 << 30);
+    sparse.finish_build();
+    ASSERT_FALSE(sparse.is_bitset());
+    global->concat(&sparse);
+    EXPECT_FALSE(global->is_bitset());
+    EXPECT_EQ(4, global->num_hash_partitions());
+    EXPECT_TRUE(global->can_use_bf());
+    EXPECT_EQ(10, global->min_value());
+    EXPECT_EQ(1 << 30, global->max_value());
+
+    // clear_bf() drops the bitset but keeps min/max
+    RuntimeBloomFilter<TYPE_INT> bf;
+    bf.init(10);
+    bf.insert(1);
+    bf.finish_build();
+    bf.clear_bf();
+    EXPECT_FALSE(bf.is_bitset());
+    EXPECT_FALSE(bf.can_use_bf());
+    EXPECT_EQ(1, bf.min_value());
+}
+
+TEST_F(RuntimeFilterTest, TestBinaryFuseFilterLimit) {
+    auto old_min_rows = config::runtime_filter_binary_fuse_min_rows;
+    auto old_max_rows = config::runtime_filter_binary_fuse_max_rows;
+    DeferOp defer([&]() {
+        config::runtime_filter_binary_fuse_min_rows = old_min_rows;
+        config::runtime_filter_binary_fuse_max_rows = old_max_rows;
+    });
+    config::runtime_filter_binary_fuse_min_rows = 100;
+    config::runtime_filter_binary_fuse_max_rows = 1000;
+
+    EXPECT_TRUE(SimdBlockFilter::should_use_binary_fuse(1000));
+    // too many rows
+    EXPECT_FALSE(SimdBlockFilter::should_use_binary_fuse(1001));
+    {
+        // exceed the memory limit of the current thread
+        MemTracker mem_tracker(1000, "binary_fuse");
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(&mem_tracker);
+        EXPECT_FALSE(SimdBlockFilter::should_use_binary_fuse(1000));
+    }
+
+    // the unfinished filters are merged into a filter with too many hashes, it falls back to the bloom filter
+    SimdBlockFilter bf0;
+    bf0.init_binary_fuse();
+    SimdBlockFilter bf1;
+    bf1.init_binary_fuse();
+    for (int i = 0; i < 800; i++) {
+        bf0.insert_hash(i * 2);
+        bf1.insert_hash(i * 2 + 1);
+    }
+    bf0.merge(bf1);
+    bf0.finish_build();
+    EXPECT_FALSE(bf0.is_binary_fuse());
+    ASSERT_TRUE(bf0.can_use());
+    for (int i = 0; i < 1600; i++) {
+        EXPECT_TRUE(bf0.test_hash(i));
+    }
+
+    // the memory limit is exceeded when it's built
+    SimdBlockFilter bf2;
+    bf2.init_binary_fuse();
+    for (int i = 0; i < 500; i++) {
+        bf2.insert_hash(i);
+    }
+    {
+        MemTracker mem_tracker(1000, "binary_fuse");
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(&mem_tracker);
+        bf2.finish_build();
+    }
+    EXPECT_FALSE(bf2.is_binary_fuse());
+    for (int i = 0; i < 500; i++) {
+        EXPECT_TRUE(bf2.test_hash(i));
+    }
+}
+
 TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterMerge) {
     RuntimeBloomFilter<TYPE_INT> bf0;
     JoinRuntimeFilter* rf0 = &bf0;
@@ -117,6 +117,24 @@ PARALLEL_TEST(FdInputStreamTest, test_read_at) {
     ASSERT_EQ(0, in.get_errno());
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(FdInputStreamTest, test_prefetch) {
+    int fd = open_temp_file();
+    pwrite_or_die(fd, "0123456789", 10, 0);
+
+    FdInputStream in(fd);
+    in.set_close_on_delete(true);
+    ASSERT_OK(in.prefetch(0, 10));
+    // the range past the end of the file is ignored
+    ASSERT_OK(in.prefetch(5, 100));
+
+    char buff[10];
+    ASSERT_EQ(10, *in.read_at(0, buff, 10));
+    ASSERT_EQ("0123456789", std::string_view(buff, 10));
+    ASSERT_OK(in.close());
+    ASSERT_ERROR(in.prefetch(0, 10));
+}
+
 // NOLINTNEXTLINE
 PARALLEL_TEST(FdInputStreamTest, test_seek) {
     int fd = open_temp_file();
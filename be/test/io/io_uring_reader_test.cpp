@@ -0,0 +1,135 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io/io_uring_reader.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "testutil/assert.h"
+#include "util/failpoint/fail_point.h"
+
+namespace starrocks::io {
+
+class IoUringReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        char tmpl[] = "/tmp/io_uring_reader_testXXXXXX";
+        _fd = ::mkstemp(tmpl);
+        PCHECK(_fd >= 0) << "mkstemp() failed";
+        PCHECK(::unlink(tmpl) == 0) << "unlink() failed";
+        for (int i = 0; i < 1024 * 1024; i++) {
+            _content.push_back(static_cast<char>('a' + i % 26));
+        }
+        PCHECK(::pwrite(_fd, _content.data(), _content.size(), 0) == _content.size()) << "pwrite() failed";
+    }
+
+    void TearDown() override { ::close(_fd); }
+
+    // Read |n| ranges of the file scattered across it in one batch, and check the content.
+    void check_read(size_t n, bool use_pread) {
+        std::vector<std::string> buffers(n);
+        std::vector<IoUringReader::Request> requests;
+        for (size_t i = 0; i < n; i++) {
+            int64_t offset = (i * 7919 * 13) % (_content.size() - 5000);
+            int64_t count = 1 + (i * 31) % 5000;
+            buffers[i].resize(count);
+            requests.push_back({_fd, offset, count, buffers[i].data()});
+        }
+        if (use_pread) {
+            ASSERT_OK(IoUringReader::pread(requests));
+        } else {
+            ASSERT_OK(IoUringReader::read(requests));
+        }
+        for (size_t i = 0; i < n; i++) {
+            ASSERT_EQ(_content.substr(requests[i].offset, requests[i].count), buffers[i]) << i;
+        }
+    }
+
+protected:
+    int _fd = -1;
+    std::string _content;
+};
+
+TEST_F(IoUringReaderTest, test_read) {
+    for (size_t n : {0, 1, 10, 1000}) {
+        check_read(n, false);
+        check_read(n, true);
+    }
+}
+
+TEST_F(IoUringReaderTest, test_more_than_queue_depth) {
+    int32_t old_depth = config::io_uring_queue_depth;
+    config::io_uring_queue_depth = 4;
+    // the ring of a new thread is created with the new queue depth
+    std::thread thread([&]() { check_read(100, false); });
+    thread.join();
+    config::io_uring_queue_depth = old_depth;
+}
+
+TEST_F(IoUringReaderTest, test_end_of_file) {
+    char buffer[10];
+    std::vector<IoUringReader::Request> requests;
+    requests.push_back({_fd, 0, 10, buffer});
+    requests.push_back({_fd, static_cast<int64_t>(_content.size()) - 5, 10, buffer});
+    ASSERT_TRUE(IoUringReader::read(requests).is_end_of_file());
+    ASSERT_TRUE(IoUringReader::pread(requests).is_end_of_file());
+}
+
+TEST_F(IoUringReaderTest, test_bad_fd) {
+    char buffer[10];
+    std::vector<IoUringReader::Request> requests;
+    requests.push_back({-1, 0, 10, buffer});
+    ASSERT_TRUE(IoUringReader::read(requests).is_io_error());
+}
+
+TEST_F(IoUringReaderTest, test_io_uring_enter_failed) {
+    if (!IoUringReader::is_supported()) {
+        GTEST_SKIP() << "io_uring is not supported";
+    }
+    int32_t old_depth = config::io_uring_queue_depth;
+    config::io_uring_queue_depth = 4;
+    auto fp = failpoint::FailPointRegistry::GetInstance()->get("io_uring_enter_failed");
+    ASSERT_TRUE(fp != nullptr);
+    PFailPointTriggerMode trigger_mode;
+    // some batches are read by io_uring before the failure, the rest of them are read by pread
+    trigger_mode.set_mode(FailPointTriggerModeType::PROBABILITY_ENABLE);
+    trigger_mode.set_probability(0.2);
+    fp->setMode(trigger_mode);
+    std::thread thread([&]() {
+        for (int i = 0; i < 20; i++) {
+            check_read(100, false);
+        }
+        // all the requests are read by pread
+        PFailPointTriggerMode always;
+        always.set_mode(FailPointTriggerModeType::ENABLE);
+        fp->setMode(always);
+        check_read(100, false);
+    });
+    thread.join();
+    trigger_mode.set_mode(FailPointTriggerModeType::DISABLE);
+    fp->setMode(trigger_mode);
+    config::io_uring_queue_depth = old_depth;
+    check_read(100, false);
+}
+
+} // namespace starrocks::io
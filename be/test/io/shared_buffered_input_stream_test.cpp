@@ -15,7 +15,9 @@
 #include "io/shared_buffered_input_stream.h"
 
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include "io/fd_input_stream.h"
 #include "io_test_base.h"
 #include "testutil/assert.h"
 #include "testutil/parallel_test.h"
@@ -179,4 +181,52 @@ TEST_F(SharedBufferedInputStreamTest, test_orc) {
             sb.value()->debug_string());
 }
 
+PARALLEL_TEST(SharedBufferedInputStreamTest, test_collect_unread_buffers) {
+    size_t len = 1024 * 1024;
+    const std::string rand_string = random_string(len);
+    char tmpl[] = "/tmp/shared_buffered_input_stream_testXXXXXX";
+    int fd = ::mkstemp(tmpl);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, ::unlink(tmpl));
+    ASSERT_EQ(len, ::pwrite(fd, rand_string.data(), len, 0));
+    auto in = std::make_shared<FdInputStream>(fd);
+    in->set_close_on_delete(true);
+
+    auto sb_stream = std::make_shared<io::SharedBufferedInputStream>(in, "test", len);
+    sb_stream->set_coalesce_options({.max_dist_size = 1024, .max_buffer_size = 64 * 1024});
+    std::vector<io::SharedBufferedInputStream::IORange> ranges;
+    ranges.emplace_back(1000, 2000);
+    ranges.emplace_back(100 * 1024, 5000);
+    ranges.emplace_back(500 * 1024, 5000);
+    ASSERT_OK(sb_stream->set_io_ranges(ranges));
+
+    // the first two ranges are read in one batch
+    std::vector<IoUringReader::Request> requests;
+    ASSERT_OK(sb_stream->collect_unread_buffers({{0, 200 * 1024}}, &requests));
+    ASSERT_EQ(2, requests.size());
+    ASSERT_OK(IoUringReader::read(requests));
+    ASSERT_EQ(2, sb_stream->shared_io_count());
+
+    std::string buffer(5000, 0);
+    ASSERT_OK(sb_stream->read_at_fully(100 * 1024, buffer.data(), 5000));
+    ASSERT_EQ(rand_string.substr(100 * 1024, 5000), buffer);
+    ASSERT_EQ(2, sb_stream->shared_io_count());
+    // the third one is read on demand
+    ASSERT_OK(sb_stream->read_at_fully(500 * 1024, buffer.data(), 5000));
+    ASSERT_EQ(rand_string.substr(500 * 1024, 5000), buffer);
+    ASSERT_EQ(3, sb_stream->shared_io_count());
+
+    // all of them have been read
+    requests.clear();
+    ASSERT_OK(sb_stream->collect_unread_buffers({{0, static_cast<int64_t>(len)}}, &requests));
+    ASSERT_TRUE(requests.empty());
+
+    // not a local file
+    auto test_stream = std::make_shared<io::SharedBufferedInputStream>(
+            std::make_shared<TestInputStream>(rand_string, len), "test", len);
+    ASSERT_OK(test_stream->set_io_ranges(ranges));
+    ASSERT_OK(test_stream->collect_unread_buffers({{0, static_cast<int64_t>(len)}}, &requests));
+    ASSERT_TRUE(requests.empty());
+}
+
 } // namespace starrocks::io
\ No newline at end of file
@@ -44,6 +44,7 @@
 #include "exec/spill/hybird_block_manager.h"
 #include "exec/spill/log_block_manager.h"
 #include "exec/spill/mem_table.h"
+#include "exec/spill/query_spill_manager.h"
 #include "exec/spill/spill_components.h"
 #include "exec/spill/spiller.h"
 #include "exec/spill/spiller.hpp"
@@ -53,6 +54,7 @@
 #include "exprs/expr_context.h"
 #include "fmt/format.h"
 #include "fs/fs.h"
+#include "fs/fs_memory.h"
 #include "gen_cpp/Exprs_types.h"
 #include "gen_cpp/Types_types.h"
 #include "runtime/mem_tracker.h"
@@ -323,4 +325,121 @@ TEST_F(SpillBlockManagerTest, hybird_block_allocation_test) {
         ASSERT_EQ(block->debug_string(), expected);
     }
 }
+
+TEST_F(SpillBlockManagerTest, log_block_prefetch_test) {
+    auto log_block_mgr = std::make_shared<spill::LogBlockManager>(dummy_query_id, local_dir_mgr.get());
+    ASSERT_OK(log_block_mgr->open());
+
+    spill::AcquireBlockOptions opts{.query_id = dummy_query_id,
+                                    .fragment_instance_id = dummy_query_id,
+                                    .plan_node_id = 1,
+                                    .name = "node1",
+                                    .block_size = 10};
+    ASSIGN_OR_ABORT(auto block, log_block_mgr->acquire_block(opts));
+    std::string data = "0123456789";
+    ASSERT_OK(block->append({Slice(data)}));
+    ASSERT_OK(block->flush());
+    ASSERT_OK(log_block_mgr->release_block(block));
+
+    // prefetch is only a hint, the data could be read as usual
+    ASSERT_OK(block->prefetch());
+    auto reader = block->get_reader(spill::BlockReaderOptions());
+    std::string result(data.size(), '\0');
+    ASSERT_OK(reader->read_fully(result.data(), result.size()));
+    ASSERT_EQ(data, result);
+}
+
+TEST_F(SpillBlockManagerTest, tiered_block_offload_test) {
+    auto old_watermark = config::spill_local_offload_watermark;
+    auto old_object_bytes = config::spill_offload_object_bytes;
+    auto old_range_bytes = config::spill_remote_read_range_bytes;
+    auto old_parallelism = config::spill_remote_read_parallelism;
+    auto old_offload_threads = config::spill_offload_threads;
+    DeferOp defer([&]() {
+        config::spill_offload_threads = old_offload_threads;
+        config::spill_local_offload_watermark = old_watermark;
+        config::spill_offload_object_bytes = old_object_bytes;
+        config::spill_remote_read_range_bytes = old_range_bytes;
+        config::spill_remote_read_parallelism = old_parallelism;
+    });
+    config::spill_local_offload_watermark = 0.5;
+    config::spill_offload_object_bytes = 25;
+    config::spill_remote_read_range_bytes = 4;
+    config::spill_remote_read_parallelism = 3;
+    // offload the objects one by one
+    config::spill_offload_threads = 1;
+
+    // the remote storage is a stand-in on memory
+    std::shared_ptr<FileSystem> memory_fs = std::make_shared<MemoryFileSystem>();
+    ASSERT_OK(memory_fs->create_dir_recursive("/remote"));
+    auto remote_dir = std::make_shared<spill::RemoteDir>("/remote", memory_fs, nullptr, INT64_MAX);
+    auto tiered_remote_dir_mgr = create_spill_dir_manager({remote_dir});
+    auto local_dir = create_spill_dir(local_path, 60);
+    auto tiered_local_dir_mgr = create_spill_dir_manager({local_dir});
+
+    spill::QuerySpillManager query_spill_mgr(dummy_query_id);
+    query_spill_mgr.set_local_dir_manager(tiered_local_dir_mgr.get());
+    auto hybird_block_mgr = std::make_shared<spill::HyBirdBlockManager>(
+            dummy_query_id, std::make_unique<spill::LogBlockManager>(dummy_query_id, tiered_local_dir_mgr.get()),
+            std::make_unique<spill::FileBlockManager>(dummy_query_id, tiered_remote_dir_mgr.get()), &query_spill_mgr);
+    ASSERT_OK(hybird_block_mgr->open());
+    DeferOp close_block_mgr([&]() { hybird_block_mgr->close(); });
+
+    // 1. write 4 exclusive blocks, the local disk exceeds the watermark after the last one is sealed
+    std::vector<spill::BlockPtr> blocks;
+    std::vector<std::string> data;
+    for (int i = 0; i < 4; i++) {
+        spill::AcquireBlockOptions opts{.query_id = dummy_query_id,
+                                        .fragment_instance_id = dummy_query_id,
+                                        .plan_node_id = 1,
+                                        .name = "node1",
+                                        .exclusive = true,
+                                        .block_size = 10};
+        ASSIGN_OR_ABORT(auto block, hybird_block_mgr->acquire_block(opts));
+        ASSERT_FALSE(block->is_remote());
+        data.emplace_back(fmt::format("block-{:04}", i));
+        ASSERT_OK(block->append({Slice(data.back())}));
+        ASSERT_OK(block->flush());
+        ASSERT_OK(hybird_block_mgr->release_block(block));
+        blocks.emplace_back(std::move(block));
+    }
+
+    // 2. the excess is 10 bytes, and an object of 25 bytes at least is offloaded, so the earliest 3 blocks are
+    // offloaded into 2 objects in the background
+    hybird_block_mgr->flush();
+    ASSERT_EQ(30, query_spill_mgr.offloaded_bytes());
+    ASSERT_EQ(10, query_spill_mgr.local_spill_bytes());
+    ASSERT_EQ(10, local_dir->get_current_size());
+    ASSERT_EQ(30, remote_dir->get_current_size());
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(blocks[i]->is_remote());
+        std::string expected = fmt::format("FileBlock[container=/remote/{}/{}-node1-1-{}]", print_id(dummy_query_id),
+                                           print_id(dummy_query_id), i < 2 ? 0 : 1);
+        ASSERT_EQ(blocks[i]->debug_string(), expected);
+    }
+    ASSERT_FALSE(blocks[3]->is_remote());
+
+    // 3. the blocks are restored as usual, the remote ones are read in ranges of 4 bytes in parallel
+    for (int i = 0; i < 4; i++) {
+        auto reader = blocks[i]->get_reader(spill::BlockReaderOptions());
+        std::string result(data[i].size(), '\0');
+        ASSERT_OK(reader->read_fully(result.data(), result.size()));
+        ASSERT_EQ(data[i], result);
+        ASSERT_TRUE(reader->read_fully(result.data(), 1).is_end_of_file());
+    }
+
+    // 4. the copying of the blocks is cancelled once it's stopped, e.g. the query ends during the offloading
+    spill::FileBlockManager remote_block_mgr(dummy_query_id, tiered_remote_dir_mgr.get());
+    ASSERT_OK(remote_block_mgr.open());
+    DeferOp close_remote_block_mgr([&]() { remote_block_mgr.close(); });
+    spill::AcquireBlockOptions opts{.query_id = dummy_query_id,
+                                    .fragment_instance_id = dummy_query_id,
+                                    .plan_node_id = 1,
+                                    .name = "node1",
+                                    .exclusive = true,
+                                    .block_size = 10};
+    std::atomic_bool stopped = true;
+    auto copied = remote_block_mgr.copy_blocks(opts, {blocks[3]}, &stopped);
+    ASSERT_TRUE(copied.status().is_cancelled()) << copied.status();
+}
 } // namespace starrocks::vectorized
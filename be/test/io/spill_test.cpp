@@ -392,6 +392,7 @@ TEST_F(SpillTest, unsorted_process) {
             output_rows += chunk->num_rows();
         }
         ASSERT_EQ(input_rows, output_rows);
+        ASSERT_GT(metrics.compression_ratio_percent->value(), 0);
     }
 
     // test 2
@@ -0,0 +1,91 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runtime/memory/numa_arena_manager.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "jemalloc/jemalloc.h"
+
+namespace starrocks {
+
+static unsigned current_thread_arena() {
+    unsigned arena_index = 0;
+    size_t sz = sizeof(arena_index);
+    EXPECT_EQ(0, je_mallctl("thread.arena", &arena_index, &sz, nullptr, 0));
+    return arena_index;
+}
+
+static extent_hooks_t* arena_extent_hooks(unsigned arena_index) {
+    const std::string name = "arena." + std::to_string(arena_index) + ".extent_hooks";
+    extent_hooks_t* hooks = nullptr;
+    size_t sz = sizeof(hooks);
+    EXPECT_EQ(0, je_mallctl(name.c_str(), &hooks, &sz, nullptr, 0));
+    return hooks;
+}
+
+// NOLINTNEXTLINE
+TEST(NumaArenaManagerTest, test_disabled) {
+    NumaArenaManager manager(1);
+    ASSERT_FALSE(manager.enabled());
+    ASSERT_EQ(-1, manager.next_numa_node());
+
+    const unsigned default_arena = current_thread_arena();
+    ASSERT_EQ(-1, manager.bind_current_thread(0));
+    ASSERT_EQ(default_arena, current_thread_arena());
+}
+
+// NOLINTNEXTLINE
+TEST(NumaArenaManagerTest, test_bind_current_thread) {
+    NumaArenaManager manager(2);
+#if defined(ADDRESS_SANITIZER) || defined(LEAK_SANITIZER) || defined(THREAD_SANITIZER)
+    ASSERT_FALSE(manager.enabled());
+#else
+    ASSERT_TRUE(manager.enabled());
+    ASSERT_EQ(2, manager.num_numa_nodes());
+
+    // round robin
+    ASSERT_EQ(0, manager.next_numa_node());
+    ASSERT_EQ(1, manager.next_numa_node());
+    ASSERT_EQ(0, manager.next_numa_node());
+
+    const unsigned default_arena = current_thread_arena();
+    ASSERT_EQ(-1, manager.bind_current_thread(0));
+    const unsigned node0_arena = current_thread_arena();
+    ASSERT_NE(default_arena, node0_arena);
+    ASSERT_EQ(0, manager.bind_current_thread(1));
+    const unsigned node1_arena = current_thread_arena();
+    ASSERT_NE(default_arena, node1_arena);
+    ASSERT_NE(node0_arena, node1_arena);
+
+    // the arenas of the nodes place their pages by the extent hooks of their own
+    ASSERT_NE(arena_extent_hooks(default_arena), arena_extent_hooks(node0_arena));
+    ASSERT_NE(arena_extent_hooks(node0_arena), arena_extent_hooks(node1_arena));
+    void* ptr = malloc(1024 * 1024);
+    ASSERT_NE(nullptr, ptr);
+    free(ptr);
+
+    // an invalid node is ignored
+    ASSERT_EQ(1, manager.bind_current_thread(2));
+    ASSERT_EQ(node1_arena, current_thread_arena());
+
+    // restore the arena used before the first binding
+    ASSERT_EQ(1, manager.bind_current_thread(-1));
+    ASSERT_EQ(default_arena, current_thread_arena());
+#endif
+}
+
+} // namespace starrocks
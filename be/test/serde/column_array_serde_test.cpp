@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+
 #include "column/array_column.h"
 #include "column/binary_column.h"
 #include "column/column_visitor.h"
@@ -269,6 +271,88 @@ PARALLEL_TEST(ColumnArraySerdeTest, large_binary_column) {
     }
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnArraySerdeTest, adaptive_encode_integer_column) {
+    // small range values are bit packed, long runs are run length encoded, and random values are not encoded
+    std::vector<std::function<int64_t(size_t)>> generators{
+            [](size_t i) { return 1000000 + static_cast<int64_t>(i % 100); },
+            [](size_t i) { return static_cast<int64_t>(i / 500) - 3; },
+            [](size_t i) { return static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL); }};
+    for (size_t g = 0; g < generators.size(); g++) {
+        auto c1 = Int64Column::create();
+        for (size_t i = 0; i < 4096; i++) {
+            c1->append(generators[g](i));
+        }
+        for (auto level : {-1, 8, 9, 14, 10014}) {
+            auto c2 = Int64Column::create();
+            std::vector<uint8_t> buffer(ColumnArraySerde::max_serialized_size(*c1, level));
+            uint8_t* end = ColumnArraySerde::serialize(*c1, buffer.data(), false, level);
+            ASSERT_LE(end, buffer.data() + buffer.size());
+            if (g < 2) {
+                ASSERT_LT(end - buffer.data(), c1->byte_size() / 4);
+            }
+            ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c2.get(), false, level));
+            ASSERT_EQ(c1->size(), c2->size());
+            for (size_t i = 0; i < c1->size(); i++) {
+                ASSERT_EQ(c1->get_data()[i], c2->get_data()[i]);
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnArraySerdeTest, adaptive_encode_nullable_column) {
+    auto c1 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int32_t i = 0; i < 4096; i++) {
+        if (i % 1000 < 100) {
+            c1->append_nulls(1);
+        } else {
+            c1->append_datum(Datum(i));
+        }
+    }
+    for (auto level : {-1, 8, 14}) {
+        auto c2 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+        std::vector<uint8_t> buffer(ColumnArraySerde::max_serialized_size(*c1, level));
+        uint8_t* end = ColumnArraySerde::serialize(*c1, buffer.data(), false, level);
+        ASSERT_LE(end, buffer.data() + buffer.size());
+        ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c2.get(), false, level));
+        ASSERT_EQ(c1->size(), c2->size());
+        ASSERT_TRUE(c2->has_null());
+        for (size_t i = 0; i < c1->size(); i++) {
+            ASSERT_EQ(c1->is_null(i), c2->is_null(i));
+            if (!c1->is_null(i)) {
+                ASSERT_EQ(c1->get(i).get_int32(), c2->get(i).get_int32());
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnArraySerdeTest, adaptive_encode_binary_column) {
+    for (size_t num_distinct : {1, 16, 4096}) {
+        auto c1 = BinaryColumn::create();
+        for (size_t i = 0; i < 8192; i++) {
+            std::string value = strings::Substitute("value_of_string_$0", i % num_distinct);
+            c1->append(Slice(value));
+        }
+        for (auto level : {-1, 8, 12, 14}) {
+            auto c2 = BinaryColumn::create();
+            std::vector<uint8_t> buffer(ColumnArraySerde::max_serialized_size(*c1, level));
+            uint8_t* end = ColumnArraySerde::serialize(*c1, buffer.data(), false, level);
+            ASSERT_LE(end, buffer.data() + buffer.size());
+            if (num_distinct <= 16) {
+                // encoded by dictionary
+                ASSERT_LT(end - buffer.data(), c1->size());
+            }
+            ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c2.get(), false, level));
+            ASSERT_EQ(c1->size(), c2->size());
+            for (size_t i = 0; i < c1->size(); i++) {
+                ASSERT_EQ(c1->get_slice(i), c2->get_slice(i));
+            }
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 PARALLEL_TEST(ColumnArraySerdeTest, const_column) {
     auto create_const_column = [](int32_t value, size_t size) {
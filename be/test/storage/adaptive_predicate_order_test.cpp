@@ -0,0 +1,101 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/predicate_tree/adaptive_predicate_order.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "column/chunk.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+
+namespace starrocks {
+
+using PredicatePtr = std::unique_ptr<ColumnPredicate>;
+
+class AdaptivePredicateOrderTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // c0 > 0 and c1 > 90
+        _p0.reset(new_column_gt_predicate(get_type_info(TYPE_INT), 0, "0"));
+        _p1.reset(new_column_gt_predicate(get_type_info(TYPE_INT), 1, "90"));
+        PredicateAndNode root;
+        root.add_child(PredicateColumnNode{_p0.get()});
+        root.add_child(PredicateColumnNode{_p1.get()});
+        _tree = PredicateTree::create(std::move(root));
+    }
+
+    PredicatePtr _p0;
+    PredicatePtr _p1;
+    PredicateTree _tree;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AdaptivePredicateOrderTest, reorder_by_cost_and_selectivity) {
+    AdaptivePredicateOrder order(2);
+    order.init(_tree);
+    ASSERT_EQ(2, order.num_children());
+    ASSERT_EQ((std::vector<size_t>{0, 1}), order.order());
+
+    // The first child is expensive and passes all the rows, the second one is cheap and selective.
+    for (int i = 0; i < 2; i++) {
+        order.update(0, 100000, 1000, 1000);
+        order.update(1, 1000, 1000, 10);
+        ASSERT_EQ(i == 1, order.finish_chunk());
+    }
+    ASSERT_EQ((std::vector<size_t>{1, 0}), order.order());
+
+    // The order is stable if the statistics are not changed, and the second child only evaluates the rows
+    // passed by the first one now.
+    for (int i = 0; i < 4; i++) {
+        order.update(0, 1000, 1000, 10);
+        order.update(1, 1000, 10, 10);
+        ASSERT_FALSE(order.finish_chunk());
+    }
+    ASSERT_EQ((std::vector<size_t>{1, 0}), order.order());
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdaptivePredicateOrderTest, evaluate_child) {
+    auto c0_field = std::make_shared<Field>(0, "c0", TYPE_INT, false);
+    auto c1_field = std::make_shared<Field>(1, "c1", TYPE_INT, false);
+    SchemaPtr schema(new Schema());
+    schema->append(c0_field);
+    schema->append(c1_field);
+    auto c0 = ChunkHelper::column_from_field(*c0_field);
+    auto c1 = ChunkHelper::column_from_field(*c1_field);
+    for (int i = 0; i < 100; i++) {
+        c0->append_datum(Datum(i % 2));
+        c1->append_datum(Datum(i));
+    }
+    auto chunk = std::make_shared<Chunk>(Columns{c0, c1}, schema);
+
+    AdaptivePredicateOrder order;
+    order.init(_tree);
+    std::vector<uint8_t> selection(chunk->num_rows());
+    std::vector<size_t> hit_counts;
+    for (size_t i = 0; i < order.num_children(); i++) {
+        ASSERT_TRUE(_tree.evaluate_child(order.child(i), chunk.get(), selection.data(), 0, chunk->num_rows()).ok());
+        hit_counts.emplace_back(std::count(selection.begin(), selection.end(), 1));
+    }
+    // the children of the root are not ordered by column id
+    std::sort(hit_counts.begin(), hit_counts.end());
+    ASSERT_EQ((std::vector<size_t>{9, 50}), hit_counts);
+}
+
+} // namespace starrocks
@@ -16,9 +16,11 @@
 
 #include <vector>
 
+#include "exprs/runtime_filter.h"
 #include "gtest/gtest.h"
 #include "storage/chunk_helper.h"
 #include "storage/column_or_predicate.h"
+#include "storage/column_runtime_filter_predicate.h"
 #include "testutil/assert.h"
 
 namespace starrocks {
@@ -2291,4 +2293,72 @@ TEST(ColumnPredicateTest, test_convert_cmp_binary_predicate) {
         EXPECT_EQ(new_p->type(), p->type());
     }
 }
+
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, test_runtime_filter) {
+    RuntimeBloomFilter<TYPE_INT> rf;
+    rf.init(100);
+    for (int i = 0; i < 100; i += 3) {
+        rf.insert(i);
+    }
+    ColumnRuntimeFilterPredicate p(get_type_info(TYPE_INT), 0, &rf);
+    EXPECT_EQ(PredicateType::kRuntimeFilter, p.type());
+
+    auto c = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    c->append_datum(Datum((int32_t)0));
+    c->append_datum(Datum((int32_t)1));
+    c->append_datum(Datum((int32_t)3));
+    c->append_datum(Datum((int32_t)200));
+    std::vector<uint8_t> buff(4);
+    ASSERT_OK(p.evaluate(c.get(), buff.data(), 0, 4));
+    EXPECT_EQ("1,0,1,0", to_string(buff));
+
+    buff.assign(4, 1);
+    buff[2] = 0;
+    ASSERT_OK(p.evaluate_and(c.get(), buff.data(), 0, 4));
+    EXPECT_EQ("1,0,0,0", to_string(buff));
+
+    buff.assign(4, 0);
+    buff[1] = 1;
+    ASSERT_OK(p.evaluate_or(c.get(), buff.data(), 0, 4));
+    EXPECT_EQ("1,1,1,0", to_string(buff));
+
+    // range
+    buff.assign(4, 0);
+    ASSERT_OK(p.evaluate(c.get(), buff.data(), 1, 3));
+    EXPECT_EQ("0,0,1,0", to_string(buff));
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, test_runtime_filter_dict_codes) {
+    RuntimeBloomFilter<TYPE_VARCHAR> rf;
+    rf.init(100);
+    std::vector<std::string> values = {"bb", "dd"};
+    for (const auto& v : values) {
+        rf.insert(Slice(v));
+    }
+
+    auto words = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    words->append_datum(Datum(Slice("aa")));
+    words->append_datum(Datum(Slice("bb")));
+    words->append_datum(Datum(Slice("cc")));
+    words->append_datum(Datum(Slice("dd")));
+    std::unique_ptr<ColumnRuntimeFilterPredicate> p(
+            ColumnRuntimeFilterPredicate::create_for_dict_codes(get_type_info(TYPE_INT), 0, &rf, words.get()));
+    EXPECT_TRUE(p->is_dict_codes());
+
+    auto codes = ChunkHelper::column_from_field_type(TYPE_INT, true);
+    codes->append_datum(Datum((int32_t)0));
+    codes->append_datum(Datum((int32_t)1));
+    (void)codes->append_nulls(1);
+    codes->append_datum(Datum((int32_t)3));
+    codes->append_datum(Datum((int32_t)1));
+    std::vector<uint8_t> buff(5);
+    ASSERT_OK(p->evaluate(codes.get(), buff.data(), 0, 5));
+    EXPECT_EQ("0,1,0,1,1", to_string(buff));
+
+    rf.insert_null();
+    ASSERT_OK(p->evaluate(codes.get(), buff.data(), 0, 5));
+    EXPECT_EQ("0,1,1,1,1", to_string(buff));
+}
 } // namespace starrocks
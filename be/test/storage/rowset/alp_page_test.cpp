@@ -0,0 +1,123 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "storage/chunk_helper.h"
+#include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/storage_page_decoder.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class AlpPageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    static void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        AlpPageBuilder<Type> builder(options);
+        ASSERT_EQ(src.size(), builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size()));
+        OwnedSlice page = builder.finish()->build();
+        ASSERT_EQ(src.size(), builder.count());
+
+        CppType value;
+        ASSERT_OK(builder.get_first_value(&value));
+        ASSERT_EQ(src.front(), value);
+        ASSERT_OK(builder.get_last_value(&value));
+        ASSERT_EQ(src.back(), value);
+
+        AlpPageDecoder<Type> decoder(page.slice());
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(src.size(), decoder.count());
+        ASSERT_EQ(ALP_ENCODING, decoder.encoding_type());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_OK(decoder.next_batch(&n, column.get()));
+        ASSERT_EQ(src.size(), n);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(src[i], values[i]);
+        }
+
+        // read the ranges across the vectors
+        SparseRange<> range;
+        range.add(Range<>(3, 10));
+        range.add(Range<>(1000, 1100));
+        range.add(Range<>(src.size() - 5, src.size()));
+        column->reset_column();
+        ASSERT_OK(decoder.seek_to_position_in_page(3));
+        ASSERT_OK(decoder.next_batch(range, column.get()));
+        ASSERT_EQ(range.span_size(), column->size());
+        values = reinterpret_cast<const CppType*>(column->raw_data());
+        size_t idx = 0;
+        SparseRangeIterator<> iter = range.new_iterator();
+        while (iter.has_more()) {
+            Range<> r = iter.next(range.span_size());
+            for (ordinal_t row = r.begin(); row < r.end(); row++) {
+                ASSERT_EQ(src[row], values[idx++]);
+            }
+        }
+        ASSERT_EQ(src.size(), decoder.current_index());
+
+        // smaller than the bitshuffle page
+        BitshufflePageBuilder<Type> bitshuffle_builder(options);
+        bitshuffle_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        ASSERT_LT(page.slice().size, bitshuffle_builder.finish()->size());
+    }
+};
+
+TEST_F(AlpPageTest, test_double) {
+    std::mt19937_64 rng(1);
+    std::vector<double> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(static_cast<double>(rng() % 10000000) / 1000);
+    }
+    test_encode_decode<TYPE_DOUBLE>(src);
+}
+
+TEST_F(AlpPageTest, test_float) {
+    std::mt19937 rng(1);
+    std::vector<float> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(static_cast<float>(rng() % 100000) / 10);
+    }
+    test_encode_decode<TYPE_FLOAT>(src);
+}
+
+TEST_F(AlpPageTest, test_encoding_info) {
+    for (LogicalType type : {TYPE_FLOAT, TYPE_DOUBLE}) {
+        const EncodingInfo* info = nullptr;
+        ASSERT_OK(EncodingInfo::get(type, ALP_ENCODING, &info));
+        ASSERT_EQ(ALP_ENCODING, info->encoding());
+        ASSERT_EQ(BIT_SHUFFLE, EncodingInfo::get_default_encoding(type, false));
+
+        config::enable_alp_float_encoding = true;
+        ASSERT_EQ(ALP_ENCODING, EncodingInfo::get_default_encoding(type, false));
+        config::enable_alp_float_encoding = false;
+    }
+    ASSERT_NE(nullptr, DataDecoder::get_data_decoder(ALP_ENCODING));
+}
+
+} // namespace starrocks
@@ -0,0 +1,140 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/delta_page.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "storage/chunk_helper.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/frame_of_reference_page.h"
+#include "storage/rowset/storage_page_decoder.h"
+#include "testutil/assert.h"
+#include "types/timestamp_value.h"
+
+namespace starrocks {
+
+class DeltaPageTest : public testing::Test {
+public:
+    template <LogicalType Type>
+    static void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        DeltaPageBuilder<Type> builder(options);
+        ASSERT_EQ(src.size(), builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size()));
+        OwnedSlice page = builder.finish()->build();
+        ASSERT_EQ(src.size(), builder.count());
+
+        CppType value;
+        ASSERT_OK(builder.get_first_value(&value));
+        ASSERT_EQ(src.front(), value);
+        ASSERT_OK(builder.get_last_value(&value));
+        ASSERT_EQ(src.back(), value);
+
+        DeltaPageDecoder<Type> decoder(page.slice());
+        ASSERT_OK(decoder.init());
+        ASSERT_EQ(src.size(), decoder.count());
+        ASSERT_EQ(DELTA_ENCODING, decoder.encoding_type());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size();
+        ASSERT_OK(decoder.next_batch(&n, column.get()));
+        ASSERT_EQ(src.size(), n);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            ASSERT_EQ(src[i], values[i]);
+        }
+
+        // read the ranges across the blocks
+        SparseRange<> range;
+        range.add(Range<>(3, 10));
+        range.add(Range<>(1000, 1100));
+        range.add(Range<>(src.size() - 5, src.size()));
+        column->reset_column();
+        ASSERT_OK(decoder.seek_to_position_in_page(3));
+        ASSERT_OK(decoder.next_batch(range, column.get()));
+        ASSERT_EQ(range.span_size(), column->size());
+        values = reinterpret_cast<const CppType*>(column->raw_data());
+        size_t idx = 0;
+        SparseRangeIterator<> iter = range.new_iterator();
+        while (iter.has_more()) {
+            Range<> r = iter.next(range.span_size());
+            for (ordinal_t row = r.begin(); row < r.end(); row++) {
+                ASSERT_EQ(src[row], values[idx++]);
+            }
+        }
+        ASSERT_EQ(src.size(), decoder.current_index());
+
+        // smaller than the frame of reference page
+        FrameOfReferencePageBuilder<Type> for_builder(options);
+        for_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        ASSERT_LT(page.slice().size, for_builder.finish()->size());
+    }
+};
+
+TEST_F(DeltaPageTest, test_bigint) {
+    std::mt19937_64 rng(1);
+    std::vector<int64_t> src;
+    int64_t value = 1700000000000000L;
+    for (int i = 0; i < 10000; i++) {
+        value += rng() % 1000;
+        src.push_back(value);
+    }
+    test_encode_decode<TYPE_BIGINT>(src);
+}
+
+TEST_F(DeltaPageTest, test_int) {
+    std::mt19937 rng(1);
+    std::vector<int32_t> src;
+    for (int i = 0; i < 10000; i++) {
+        // nearly sorted
+        src.push_back(i * 100 + static_cast<int32_t>(rng() % 50));
+    }
+    test_encode_decode<TYPE_INT>(src);
+}
+
+TEST_F(DeltaPageTest, test_datetime) {
+    std::vector<int64_t> src;
+    // event times in seconds
+    int64_t value = TimestampValue::create(2024, 1, 1, 0, 0, 0).timestamp();
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(value);
+        value += (i % 7) * 1000000L;
+    }
+    test_encode_decode<TYPE_DATETIME>(src);
+}
+
+TEST_F(DeltaPageTest, test_encoding_info) {
+    for (LogicalType type : {TYPE_INT, TYPE_BIGINT, TYPE_DATE, TYPE_DATETIME}) {
+        const EncodingInfo* info = nullptr;
+        ASSERT_OK(EncodingInfo::get(type, DELTA_ENCODING, &info));
+        ASSERT_EQ(DELTA_ENCODING, info->encoding());
+        ASSERT_EQ(BIT_SHUFFLE, EncodingInfo::get_default_encoding(type, false));
+        ASSERT_EQ(FOR_ENCODING, EncodingInfo::get_default_encoding(type, true));
+
+        config::enable_delta_integer_encoding = true;
+        ASSERT_EQ(DELTA_ENCODING, EncodingInfo::get_default_encoding(type, false));
+        ASSERT_EQ(FOR_ENCODING, EncodingInfo::get_default_encoding(type, true));
+        config::enable_delta_integer_encoding = false;
+    }
+    ASSERT_NE(nullptr, DataDecoder::get_data_decoder(DELTA_ENCODING));
+}
+
+} // namespace starrocks
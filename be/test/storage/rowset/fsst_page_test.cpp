@@ -0,0 +1,227 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/fsst_page.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/nullable_column.h"
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/encoding_info.h"
+#include "testutil/assert.h"
+#include "util/fsst.h"
+
+namespace starrocks {
+
+class FsstPageTest : public testing::Test {
+public:
+    static std::vector<std::string> gen_strings(size_t num_rows) {
+        static const std::vector<std::string> words = {"starrocks", "http://", "www.", ".com", "/index", "?id=", ""};
+        std::mt19937 rng(7);
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < num_rows; i++) {
+            std::string s;
+            const size_t num_words = rng() % 5;
+            for (size_t j = 0; j < num_words; j++) {
+                s += words[rng() % words.size()];
+            }
+            // bytes not covered by the symbols
+            s += std::to_string(rng() % 100);
+            s.push_back(static_cast<char>(rng() % 256));
+            strings.emplace_back(std::move(s));
+        }
+        return strings;
+    }
+
+    static OwnedSlice encode(const std::vector<std::string>& strings) {
+        std::vector<Slice> slices(strings.begin(), strings.end());
+        PageBuilderOptions options;
+        options.data_page_size = 1024 * 1024;
+        FsstPageBuilder builder(options);
+        EXPECT_EQ(slices.size(), builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size()));
+        OwnedSlice page = builder.finish()->build();
+
+        Slice value;
+        EXPECT_OK(builder.get_first_value(&value));
+        EXPECT_EQ(strings.front(), value.to_string());
+        EXPECT_OK(builder.get_last_value(&value));
+        EXPECT_EQ(strings.back(), value.to_string());
+        return page;
+    }
+};
+
+TEST_F(FsstPageTest, test_symbol_table) {
+    const auto strings = gen_strings(1000);
+    std::vector<Slice> slices(strings.begin(), strings.end());
+    FsstSymbolTable table;
+    table.build(slices.data(), slices.size());
+    ASSERT_GT(table.num_symbols(), 0);
+
+    faststring buf;
+    table.serialize(&buf);
+    FsstSymbolTable deserialized;
+    ASSIGN_OR_ABORT(size_t size, deserialized.deserialize(Slice(buf.data(), buf.size())));
+    ASSERT_EQ(buf.size(), size);
+    ASSERT_EQ(table.num_symbols(), deserialized.num_symbols());
+
+    size_t raw_size = 0;
+    size_t compressed_size = 0;
+    for (const auto& s : strings) {
+        std::vector<uint8_t> compressed(FsstSymbolTable::max_compressed_size(s.size()));
+        const size_t length = table.compress(s, compressed.data());
+        std::vector<uint8_t> decompressed(FsstSymbolTable::max_decompressed_size(length));
+        const size_t decompressed_size = deserialized.decompress(Slice(compressed.data(), length), decompressed.data());
+        ASSERT_EQ(s, std::string(reinterpret_cast<const char*>(decompressed.data()), decompressed_size));
+        raw_size += s.size();
+        compressed_size += length;
+    }
+    ASSERT_LT(compressed_size, raw_size);
+
+    ASSERT_FALSE(deserialized.deserialize(Slice(buf.data(), buf.size() - 1)).ok());
+}
+
+TEST_F(FsstPageTest, test_empty_page) {
+    OwnedSlice page = FsstPageBuilder(PageBuilderOptions()).finish()->build();
+    FsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    ASSERT_EQ(0, decoder.count());
+}
+
+TEST_F(FsstPageTest, test_varchar) {
+    const auto strings = gen_strings(5000);
+    OwnedSlice page = encode(strings);
+    FsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    ASSERT_EQ(strings.size(), decoder.count());
+    ASSERT_EQ(FSST_ENCODING, decoder.encoding_type());
+
+    for (bool nullable : {false, true}) {
+        auto column = ChunkHelper::column_from_field_type(TYPE_VARCHAR, nullable);
+        ASSERT_OK(decoder.seek_to_position_in_page(0));
+        while (decoder.current_index() < decoder.count()) {
+            size_t n = 1000;
+            ASSERT_OK(decoder.next_batch(&n, column.get()));
+        }
+        ASSERT_EQ(strings.size(), column->size());
+        for (size_t i = 0; i < strings.size(); i++) {
+            ASSERT_EQ(strings[i], column->get(i).get_slice().to_string());
+        }
+    }
+
+    SparseRange<> range;
+    range.add(Range<>(10, 20));
+    range.add(Range<>(100, 101));
+    range.add(Range<>(4990, 5000));
+    auto column = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    ASSERT_OK(decoder.seek_to_position_in_page(10));
+    ASSERT_OK(decoder.next_batch(range, column.get()));
+    ASSERT_EQ(21, column->size());
+    size_t i = 0;
+    SparseRangeIterator<> iter = range.new_iterator();
+    while (iter.has_more()) {
+        Range<> r = iter.next(range.span_size());
+        for (ordinal_t row = r.begin(); row < r.end(); row++) {
+            ASSERT_EQ(strings[row], column->get(i++).get_slice().to_string());
+        }
+    }
+    ASSERT_EQ(5000, decoder.current_index());
+}
+
+TEST_F(FsstPageTest, test_char) {
+    std::vector<std::string> strings;
+    for (const auto& s : gen_strings(100)) {
+        // CHAR is padded with zeros
+        std::string padded = s;
+        padded.resize(64, '\0');
+        strings.emplace_back(std::move(padded));
+    }
+    OwnedSlice page = encode(strings);
+    FsstPageDecoder<TYPE_CHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    auto column = ChunkHelper::column_from_field_type(TYPE_CHAR, false);
+    size_t n = strings.size();
+    ASSERT_OK(decoder.next_batch(&n, column.get()));
+    ASSERT_EQ(strings.size(), n);
+    for (size_t i = 0; i < strings.size(); i++) {
+        ASSERT_EQ(std::string(strings[i].c_str(), strnlen(strings[i].data(), strings[i].size())),
+                  column->get(i).get_slice().to_string());
+    }
+
+    std::unique_ptr<ColumnPredicate> predicate(new_column_eq_predicate(get_type_info(TYPE_CHAR), 0, "starrocks"));
+    ASSERT_OK(decoder.seek_to_position_in_page(0));
+    uint8_t selection[1];
+    n = 1;
+    ASSERT_TRUE(decoder.evaluate_next_batch(*predicate, &n, selection).is_not_supported());
+}
+
+TEST_F(FsstPageTest, test_evaluate) {
+    const auto strings = gen_strings(5000);
+    OwnedSlice page = encode(strings);
+    FsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    auto values = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    size_t n = strings.size();
+    ASSERT_OK(decoder.next_batch(&n, values.get()));
+
+    const auto type_info = get_type_info(TYPE_VARCHAR);
+    std::vector<std::unique_ptr<ColumnPredicate>> predicates;
+    predicates.emplace_back(new_column_eq_predicate(type_info, 0, strings[42]));
+    predicates.emplace_back(new_column_ne_predicate(type_info, 0, strings[7]));
+    predicates.emplace_back(new_column_eq_predicate(type_info, 0, "not exist"));
+    predicates.emplace_back(new_column_in_predicate(type_info, 0, {strings[1], strings[100], "not exist"}));
+    predicates.emplace_back(new_column_not_in_predicate(type_info, 0, {strings[3], strings[4000]}));
+    for (const auto& predicate : predicates) {
+        std::vector<uint8_t> expected(strings.size());
+        ASSERT_OK(predicate->evaluate(values.get(), expected.data()));
+
+        ASSERT_OK(decoder.seek_to_position_in_page(0));
+        std::vector<uint8_t> selection(strings.size());
+        size_t pos = 0;
+        while (pos < strings.size()) {
+            size_t batch_size = 4096;
+            ASSERT_OK(decoder.evaluate_next_batch(*predicate, &batch_size, selection.data() + pos));
+            pos += batch_size;
+            ASSERT_EQ(pos, decoder.current_index());
+        }
+        ASSERT_EQ(expected, selection);
+    }
+
+    std::unique_ptr<ColumnPredicate> predicate(new_column_gt_predicate(type_info, 0, "a"));
+    ASSERT_OK(decoder.seek_to_position_in_page(0));
+    std::vector<uint8_t> selection(1);
+    n = 1;
+    ASSERT_TRUE(decoder.evaluate_next_batch(*predicate, &n, selection.data()).is_not_supported());
+    ASSERT_EQ(0, decoder.current_index());
+}
+
+TEST_F(FsstPageTest, test_encoding_info) {
+    for (LogicalType type : {TYPE_CHAR, TYPE_VARCHAR}) {
+        const EncodingInfo* info = nullptr;
+        ASSERT_OK(EncodingInfo::get(type, FSST_ENCODING, &info));
+        ASSERT_EQ(FSST_ENCODING, info->encoding());
+        // FSST is never the default encoding
+        ASSERT_NE(FSST_ENCODING, EncodingInfo::get_default_encoding(type, false));
+    }
+}
+
+} // namespace starrocks
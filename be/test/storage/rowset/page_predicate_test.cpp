@@ -0,0 +1,256 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/binary_dict_page.h"
+#include "storage/rowset/binary_plain_page.h"
+#include "storage/rowset/delta_page.h"
+#include "storage/rowset/frame_of_reference_page.h"
+#include "storage/rowset/rle_page.h"
+#include "storage/rowset/storage_page_decoder.h"
+#include "storage/types.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class PagePredicateTest : public testing::Test {
+public:
+    // Evaluate |predicate| on the page by batches of |batch_size|, and check the results with the ones
+    // evaluated on the decoded |values|.
+    static void check_evaluate(PageDecoder* decoder, const ColumnPredicate& predicate, const Column& values,
+                               size_t batch_size) {
+        std::vector<uint8_t> expected(values.size());
+        ASSERT_OK(predicate.evaluate(&values, expected.data()));
+
+        ASSERT_OK(decoder->seek_to_position_in_page(0));
+        std::vector<uint8_t> selection(values.size());
+        size_t pos = 0;
+        while (pos < values.size()) {
+            size_t n = batch_size;
+            ASSERT_OK(decoder->evaluate_next_batch(predicate, &n, selection.data() + pos));
+            ASSERT_GT(n, 0);
+            pos += n;
+            ASSERT_EQ(pos, decoder->current_index());
+        }
+        ASSERT_EQ(values.size(), pos);
+        ASSERT_EQ(expected, selection);
+    }
+
+    template <LogicalType Type, class PageBuilderType>
+    static OwnedSlice encode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        PageBuilderType builder(options);
+        size_t size = builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), size);
+        return builder.finish()->build();
+    }
+
+    static std::vector<std::unique_ptr<ColumnPredicate>> int_predicates() {
+        const auto type_info = get_type_info(TYPE_INT);
+        std::vector<std::unique_ptr<ColumnPredicate>> predicates;
+        predicates.emplace_back(new_column_gt_predicate(type_info, 0, "5000"));
+        predicates.emplace_back(new_column_le_predicate(type_info, 0, "100"));
+        predicates.emplace_back(new_column_lt_predicate(type_info, 0, "-1"));
+        predicates.emplace_back(new_column_ge_predicate(type_info, 0, "0"));
+        predicates.emplace_back(new_column_eq_predicate(type_info, 0, "4242"));
+        predicates.emplace_back(new_column_ne_predicate(type_info, 0, "7"));
+        predicates.emplace_back(new_column_in_predicate(type_info, 0, {"3", "700", "9999"}));
+        predicates.emplace_back(new_column_null_predicate(type_info, 0, false));
+        return predicates;
+    }
+};
+
+TEST_F(PagePredicateTest, test_rle_page) {
+    // runs of the same values mixed with the literals
+    std::vector<int32_t> src;
+    for (int32_t i = 0; i < 10000; i++) {
+        src.push_back((i / 1000) % 2 == 0 ? (i / 100) * 100 : i);
+    }
+    OwnedSlice page = encode<TYPE_INT, RlePageBuilder<TYPE_INT>>(src);
+    RlePageDecoder<TYPE_INT> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    auto values = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    values->append_numbers(src.data(), src.size() * sizeof(int32_t));
+    for (const auto& predicate : int_predicates()) {
+        for (size_t batch_size : {1, 7, 1000, 4096}) {
+            check_evaluate(&decoder, *predicate, *values, batch_size);
+        }
+    }
+}
+
+TEST_F(PagePredicateTest, test_rle_page_boolean) {
+    std::vector<bool> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(i < 3000 || i % 3 == 0);
+    }
+    std::unique_ptr<bool[]> bools(new bool[src.size()]);
+    std::copy(src.begin(), src.end(), bools.get());
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    RlePageBuilder<TYPE_BOOLEAN> builder(options);
+    builder.add(reinterpret_cast<const uint8_t*>(bools.get()), src.size());
+    OwnedSlice page = builder.finish()->build();
+    RlePageDecoder<TYPE_BOOLEAN> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    auto values = ChunkHelper::column_from_field_type(TYPE_BOOLEAN, false);
+    values->append_numbers(bools.get(), src.size());
+    std::unique_ptr<ColumnPredicate> predicate(new_column_eq_predicate(get_type_info(TYPE_BOOLEAN), 0, "1"));
+    check_evaluate(&decoder, *predicate, *values, 4096);
+}
+
+TEST_F(PagePredicateTest, test_for_page) {
+    for (int round = 0; round < 3; round++) {
+        std::vector<int32_t> src;
+        for (int32_t i = 0; i < 10000; i++) {
+            if (round == 0) {
+                // ascending frames
+                src.push_back(i);
+            } else if (round == 1) {
+                // unordered frames with small deltas
+                src.push_back((i / 128) * 128 + (i * 37) % 128);
+            } else {
+                // frames with wide ranges
+                src.push_back(i % 2 == 0 ? std::numeric_limits<int32_t>::max() - i : i);
+            }
+        }
+        OwnedSlice page = encode<TYPE_INT, FrameOfReferencePageBuilder<TYPE_INT>>(src);
+        FrameOfReferencePageDecoder<TYPE_INT> decoder(page.slice());
+        ASSERT_OK(decoder.init());
+
+        auto values = ChunkHelper::column_from_field_type(TYPE_INT, false);
+        values->append_numbers(src.data(), src.size() * sizeof(int32_t));
+        for (const auto& predicate : int_predicates()) {
+            for (size_t batch_size : {1, 100, 1000, 4096}) {
+                check_evaluate(&decoder, *predicate, *values, batch_size);
+            }
+        }
+    }
+}
+
+TEST_F(PagePredicateTest, test_for_page_read_after_evaluate) {
+    std::vector<int64_t> src;
+    for (int64_t i = 0; i < 1000; i++) {
+        src.push_back(i * 3);
+    }
+    OwnedSlice page = encode<TYPE_BIGINT, FrameOfReferencePageBuilder<TYPE_BIGINT>>(src);
+    FrameOfReferencePageDecoder<TYPE_BIGINT> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    // the first frames are skipped without being decoded
+    std::unique_ptr<ColumnPredicate> predicate(new_column_gt_predicate(get_type_info(TYPE_BIGINT), 0, "2000"));
+    std::vector<uint8_t> selection(500);
+    size_t n = selection.size();
+    ASSERT_OK(decoder.evaluate_next_batch(*predicate, &n, selection.data()));
+    ASSERT_EQ(500, n);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(src[i] > 2000, selection[i]);
+    }
+
+    auto column = ChunkHelper::column_from_field_type(TYPE_BIGINT, false);
+    n = 500;
+    ASSERT_OK(decoder.next_batch(&n, column.get()));
+    ASSERT_EQ(500, n);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(src[500 + i], column->get(i).get_int64());
+    }
+    ASSERT_EQ(1000, decoder.current_index());
+}
+
+TEST_F(PagePredicateTest, test_delta_page) {
+    for (int round = 0; round < 2; round++) {
+        std::vector<int32_t> src;
+        for (int32_t i = 0; i < 10000; i++) {
+            if (round == 0) {
+                // nearly sorted
+                src.push_back(i - (i * 13) % 5);
+            } else {
+                // descending with the overflowing deltas
+                src.push_back(i % 300 == 0 ? std::numeric_limits<int32_t>::min() : 10000 - i);
+            }
+        }
+        OwnedSlice page = encode<TYPE_INT, DeltaPageBuilder<TYPE_INT>>(src);
+        DeltaPageDecoder<TYPE_INT> decoder(page.slice());
+        ASSERT_OK(decoder.init());
+
+        auto values = ChunkHelper::column_from_field_type(TYPE_INT, false);
+        values->append_numbers(src.data(), src.size() * sizeof(int32_t));
+        for (const auto& predicate : int_predicates()) {
+            for (size_t batch_size : {1, 100, 1000, 4096}) {
+                check_evaluate(&decoder, *predicate, *values, batch_size);
+            }
+        }
+    }
+}
+
+TEST_F(PagePredicateTest, test_binary_dict_page) {
+    const std::vector<std::string> words = {"apple", "banana", "cherry", "durian", "elderberry"};
+    std::vector<Slice> src;
+    for (int i = 0; i < 1000; i++) {
+        src.emplace_back(words[(i * 7) % words.size()]);
+    }
+
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    options.dict_page_size = 256 * 1024;
+    BinaryDictPageBuilder builder(options);
+    ASSERT_EQ(src.size(), builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size()));
+    OwnedSlice page = builder.finish()->build();
+    OwnedSlice dict_page = builder.get_dictionary_page()->build();
+
+    BinaryPlainPageDecoder<TYPE_VARCHAR> dict_decoder(dict_page.slice());
+    ASSERT_OK(dict_decoder.init());
+    ASSERT_EQ(words.size(), dict_decoder.count());
+
+    Slice encoded_data = page.slice();
+    PageFooterPB footer;
+    footer.set_type(DATA_PAGE);
+    footer.mutable_data_page_footer()->set_nullmap_size(0);
+    std::unique_ptr<char[]> decoded_page;
+    ASSERT_OK(StoragePageDecoder::decode_page(&footer, 0, DICT_ENCODING, &decoded_page, &encoded_data));
+    BinaryDictPageDecoder<TYPE_VARCHAR> decoder(encoded_data);
+    decoder.set_dict_decoder(&dict_decoder);
+    ASSERT_OK(decoder.init());
+
+    auto values = ChunkHelper::column_from_field_type(TYPE_VARCHAR, false);
+    ASSERT_TRUE(values->append_strings(src));
+    const auto type_info = get_type_info(TYPE_VARCHAR);
+    std::vector<std::unique_ptr<ColumnPredicate>> predicates;
+    predicates.emplace_back(new_column_in_predicate(type_info, 0, {"banana", "durian", "fig"}));
+    predicates.emplace_back(new_column_eq_predicate(type_info, 0, "cherry"));
+    predicates.emplace_back(new_column_ge_predicate(type_info, 0, "c"));
+    for (const auto& predicate : predicates) {
+        for (size_t batch_size : {7, 100, 4096}) {
+            check_evaluate(&decoder, *predicate, *values, batch_size);
+        }
+    }
+
+    // fewer remaining values than the dictionary words
+    ASSERT_OK(decoder.seek_to_position_in_page(src.size() - 2));
+    std::unique_ptr<ColumnPredicate> predicate(new_column_eq_predicate(type_info, 0, "apple"));
+    uint8_t selection[2];
+    size_t n = 2;
+    ASSERT_TRUE(decoder.evaluate_next_batch(*predicate, &n, selection).is_not_supported());
+    ASSERT_EQ(src.size() - 2, decoder.current_index());
+}
+
+} // namespace starrocks
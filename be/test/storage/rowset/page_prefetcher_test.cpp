@@ -0,0 +1,72 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/page_prefetcher.h"
+
+#include <gtest/gtest.h>
+
+#include "column/schema.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+TEST(PagePrefetcherTest, test_adaptive_depth) {
+    OlapReaderStatistics stats;
+    PagePrefetcher prefetcher(&stats, 8);
+    ASSERT_TRUE(prefetcher.empty());
+    ASSERT_EQ(1, prefetcher.depth());
+
+    const int64_t slow_ns = PagePrefetcher::kDeviceReadNs * 2;
+    // the page reads wait for the device
+    prefetcher.update(slow_ns * 4, 4);
+    ASSERT_EQ(2, prefetcher.depth());
+    prefetcher.update(slow_ns, 1);
+    ASSERT_EQ(4, prefetcher.depth());
+    prefetcher.update(slow_ns, 1);
+    ASSERT_EQ(8, prefetcher.depth());
+    prefetcher.update(slow_ns, 1);
+    ASSERT_EQ(8, prefetcher.depth());
+
+    // no page is read
+    prefetcher.update(0, 0);
+    ASSERT_EQ(8, prefetcher.depth());
+
+    // the pages are read from the page cache
+    prefetcher.update(1000, 4);
+    ASSERT_EQ(7, prefetcher.depth());
+    for (int i = 0; i < 10; i++) {
+        prefetcher.update(1000, 4);
+    }
+    ASSERT_EQ(1, prefetcher.depth());
+}
+
+TEST(PagePrefetcherTest, test_max_depth) {
+    OlapReaderStatistics stats;
+    PagePrefetcher prefetcher(&stats, 0);
+    prefetcher.update(PagePrefetcher::kDeviceReadNs * 2, 1);
+    ASSERT_EQ(1, prefetcher.depth());
+}
+
+TEST(PagePrefetcherTest, test_prefetch_without_columns) {
+    OlapReaderStatistics stats;
+    PagePrefetcher prefetcher(&stats, 8);
+    Schema schema;
+    SparseRange<> range(0, 100);
+    auto iter = range.new_iterator();
+    ASSERT_OK(prefetcher.prefetch(schema, iter, 10));
+    ASSERT_EQ(0, stats.page_prefetch_bytes);
+    ASSERT_EQ(0, iter.begin());
+}
+
+} // namespace starrocks
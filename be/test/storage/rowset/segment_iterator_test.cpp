@@ -18,15 +18,23 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_map>
 
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
 #include "common/object_pool.h"
+#include "exprs/runtime_filter.h"
+#include "exprs/runtime_filter_bank.h"
 #include "fs/fs_memory.h"
 #include "gen_cpp/tablet_schema.pb.h"
 #include "gtest/gtest.h"
 #include "storage/chunk_helper.h"
+#include "runtime/descriptors.h"
 #include "storage/olap_common.h"
+#include "storage/olap_runtime_range_pruner.h"
+#include "storage/predicate_parser.h"
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/segment_options.h"
@@ -34,6 +42,7 @@
 #include "storage/tablet_schema_helper.h"
 #include "testutil/assert.h"
 #include "types/logical_type.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -530,4 +539,263 @@ TEST_F(SegmentIteratorTest, TestGlobalDictNoLocalDict) {
     res_chunk->reset();
 }
 
+// NOLINTNEXTLINE
+TEST_F(SegmentIteratorTest, TestEncodedPredicate) {
+    using namespace starrocks::test;
+
+    TabletSchemaBuilder builder;
+    std::shared_ptr<TabletSchema> tablet_schema =
+            builder.create(1, false, TYPE_INT, true).create(2, false, TYPE_INT).create(3, false, TYPE_VARCHAR).build();
+
+    // c1 is 1 or 2 in [1000, 2000), [4000, 5000) and [7000, 8000), and 0 in the others, so the zone maps of the
+    // small pages leave a sparse range for the predicate c1 = 1.
+    const int32_t num_rows = 10000;
+    auto c1_value = [](int32_t i) { return (i / 1000) % 3 == 1 ? i % 2 + 1 : 0; };
+    std::vector<std::string> strs(num_rows);
+    auto schema = ChunkHelper::convert_schema(tablet_schema);
+    // c1 is encoded by DELTA_ENCODING, which evaluates the predicate on the encoded pages, or by BIT_SHUFFLE, which
+    // doesn't, and the predicate is evaluated on the rows read then.
+    auto write_segment = [&](bool delta_encoding) {
+        std::string file_name = kSegmentDir + "/encoded_predicate_" + std::to_string(delta_encoding);
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+        const int32_t old_data_page_size = config::data_page_size;
+        const bool old_delta_encoding = config::enable_delta_integer_encoding;
+        config::data_page_size = 1024;
+        config::enable_delta_integer_encoding = delta_encoding;
+        DeferOp defer([&]() {
+            config::data_page_size = old_data_page_size;
+            config::enable_delta_integer_encoding = old_delta_encoding;
+        });
+        SegmentWriterOptions opts;
+        SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+        EXPECT_OK(writer.init());
+        auto chunk = ChunkHelper::new_chunk(schema, num_rows);
+        for (int32_t i = 0; i < num_rows; ++i) {
+            strs[i] = fmt::format("str-{}", i);
+            chunk->columns()[0]->append_datum(Datum(i));
+            chunk->columns()[1]->append_datum(Datum(c1_value(i)));
+            chunk->columns()[2]->append_datum(Datum(Slice(strs[i])));
+        }
+        EXPECT_OK(writer.append_chunk(*chunk));
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        EXPECT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+        return *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    };
+
+    std::vector<int32_t> expected;
+    for (int32_t i = 0; i < num_rows; ++i) {
+        if (c1_value(i) == 1) {
+            expected.push_back(i);
+        }
+    }
+
+    std::unique_ptr<ColumnPredicate> predicate(new_column_eq_predicate(get_type_info(TYPE_INT), 1, "1"));
+    const bool old_enable = config::enable_segment_encoded_predicate;
+    const int32_t old_ratio = config::late_materialization_ratio;
+    DeferOp defer([&]() {
+        config::enable_segment_encoded_predicate = old_enable;
+        config::late_materialization_ratio = old_ratio;
+    });
+    for (bool delta_encoding : {true, false}) {
+        auto segment = write_segment(delta_encoding);
+        ASSERT_EQ(num_rows, segment->num_rows());
+        for (bool enable : {true, false}) {
+            // without and with the late materialization
+            for (int32_t ratio : {0, 1000}) {
+                config::enable_segment_encoded_predicate = enable;
+                config::late_materialization_ratio = ratio;
+
+                OlapReaderStatistics stats;
+                SegmentReadOptions seg_opts;
+                seg_opts.fs = _fs;
+                seg_opts.stats = &stats;
+                seg_opts.tablet_schema = tablet_schema;
+                PredicateAndNode pred_root;
+                pred_root.add_child(PredicateColumnNode{predicate.get()});
+                seg_opts.pred_tree = PredicateTree::create(std::move(pred_root));
+                ASSIGN_OR_ABORT(auto seg_iter, segment->new_iterator(schema, seg_opts));
+
+                std::vector<int32_t> rows;
+                auto res = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+                while (true) {
+                    res->reset();
+                    auto st = seg_iter->get_next(res.get());
+                    if (st.is_end_of_file()) {
+                        break;
+                    }
+                    ASSERT_OK(st);
+                    for (size_t i = 0; i < res->num_rows(); ++i) {
+                        auto row = res->get(i);
+                        const int32_t c0 = row[0].get_int32();
+                        ASSERT_EQ(1, row[1].get_int32());
+                        ASSERT_EQ(strs[c0], row[2].get_slice().to_string());
+                        rows.push_back(c0);
+                    }
+                }
+                seg_iter->close();
+
+                ASSERT_EQ(expected, rows) << "delta_encoding: " << delta_encoding << ", enable: " << enable
+                                          << ", ratio: " << ratio;
+                ASSERT_GT(stats.rows_stats_filtered, 0);
+                ASSERT_GT(stats.rows_vec_cond_filtered, 0);
+                if (enable && delta_encoding) {
+                    ASSERT_EQ(stats.rows_vec_cond_filtered, stats.rows_encoded_cond_filtered);
+                } else {
+                    ASSERT_EQ(0, stats.rows_encoded_cond_filtered);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(SegmentIteratorTest, TestRuntimeFilterPredicate) {
+    using namespace starrocks::test;
+
+    TabletSchemaBuilder builder;
+    std::shared_ptr<TabletSchema> tablet_schema =
+            builder.create(1, false, TYPE_INT, true).create(2, false, TYPE_INT).create(3, false, TYPE_VARCHAR).build();
+
+    // c1 is a plain INT column, c2 is dictionary encoded because it has only 100 distinct words. The min and max
+    // values of both columns are in each page, so that the zone maps can't prune the pages by the runtime filters.
+    const int32_t num_rows = 20000;
+    auto c1_value = [](int32_t i) { return i % 1000; };
+    std::vector<std::string> strs(num_rows);
+    auto schema = ChunkHelper::convert_schema(tablet_schema);
+
+    std::string file_name = kSegmentDir + "/runtime_filter_predicate";
+    {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+        SegmentWriterOptions opts;
+        SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+        ASSERT_OK(writer.init());
+        auto chunk = ChunkHelper::new_chunk(schema, num_rows);
+        for (int32_t i = 0; i < num_rows; ++i) {
+            strs[i] = fmt::format("s-{}", i % 100);
+            chunk->columns()[0]->append_datum(Datum(i));
+            chunk->columns()[1]->append_datum(Datum(c1_value(i)));
+            chunk->columns()[2]->append_datum(Datum(Slice(strs[i])));
+        }
+        ASSERT_OK(writer.append_chunk(*chunk));
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+    }
+    auto segment = *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    ASSERT_EQ(num_rows, segment->num_rows());
+
+    ObjectPool pool;
+    SlotDescriptor c1_slot(0, "2", TypeDescriptor(TYPE_INT));
+    SlotDescriptor c2_slot(1, "3", TypeDescriptor::create_varchar_type(128));
+
+    auto* c1_rf = RuntimeFilterHelper::create_join_runtime_filter(&pool, TYPE_INT);
+    c1_rf->init(10);
+    auto c1_build = Int32Column::create();
+    for (int32_t v : {0, 500, 999}) {
+        c1_build->append(v);
+    }
+    ASSERT_OK(RuntimeFilterHelper::fill_runtime_bloom_filter(c1_build, TYPE_INT, c1_rf, 0, false));
+
+    auto* c2_rf = RuntimeFilterHelper::create_join_runtime_filter(&pool, TYPE_VARCHAR);
+    c2_rf->init(10);
+    auto c2_build = BinaryColumn::create();
+    for (const char* v : {"s-0", "s-42", "s-99"}) {
+        c2_build->append(Slice(v));
+    }
+    ASSERT_OK(RuntimeFilterHelper::fill_runtime_bloom_filter(c2_build, TYPE_VARCHAR, c2_rf, 0, false));
+
+    // The rows passed by the runtime filter of the column, the bloom filter may have false positives.
+    auto rows_passed = [&](const JoinRuntimeFilter* rf, int column_index) {
+        auto values = ChunkHelper::column_from_field(*schema.field(column_index));
+        for (int32_t i = 0; i < num_rows; ++i) {
+            values->append_datum(column_index == 1 ? Datum(c1_value(i)) : Datum(Slice(strs[i])));
+        }
+        JoinRuntimeFilter::RunningContext ctx;
+        ctx.use_merged_selection = false;
+        rf->evaluate(values.get(), &ctx);
+        std::vector<int32_t> rows;
+        for (int32_t i = 0; i < num_rows; ++i) {
+            if (ctx.selection[i]) {
+                rows.push_back(i);
+            }
+        }
+        return rows;
+    };
+
+    PredicateParser parser(tablet_schema);
+    const bool old_enable = config::enable_segment_runtime_filter_predicate;
+    const int32_t old_ratio = config::late_materialization_ratio;
+    DeferOp defer([&]() {
+        config::enable_segment_runtime_filter_predicate = old_enable;
+        config::late_materialization_ratio = old_ratio;
+    });
+    config::enable_segment_runtime_filter_predicate = true;
+    struct Case {
+        const SlotDescriptor* slot;
+        JoinRuntimeFilter* rf;
+        int column_index;
+    };
+    for (const Case& c : {Case{&c1_slot, c1_rf, 1}, Case{&c2_slot, c2_rf, 2}}) {
+        std::vector<int32_t> all_rows(num_rows);
+        std::iota(all_rows.begin(), all_rows.end(), 0);
+        const std::vector<int32_t> passed_rows = rows_passed(c.rf, c.column_index);
+        ASSERT_LT(passed_rows.size(), static_cast<size_t>(num_rows / 10));
+
+        for (bool arrived : {false, true}) {
+            // without late materialization, and switch to it once the runtime filter filters more than 90% rows
+            for (int32_t ratio : {0, 100}) {
+                config::late_materialization_ratio = ratio;
+
+                // the runtime filter arrives before the first chunk is read, or never arrives
+                RuntimeFilterProbeDescriptor rf_desc;
+                ASSERT_OK(rf_desc.init(c.column_index, nullptr));
+                if (arrived) {
+                    rf_desc.set_runtime_filter(c.rf);
+                }
+                UnarrivedRuntimeFilterList rf_list;
+                rf_list.add_unarrived_rf(&rf_desc, c.slot, 0);
+
+                OlapReaderStatistics stats;
+                SegmentReadOptions seg_opts;
+                seg_opts.fs = _fs;
+                seg_opts.stats = &stats;
+                seg_opts.tablet_schema = tablet_schema;
+                seg_opts.runtime_range_pruner = OlapRuntimeScanRangePruner(&parser, rf_list);
+                ASSIGN_OR_ABORT(auto seg_iter, segment->new_iterator(schema, seg_opts));
+
+                std::vector<int32_t> rows;
+                auto res = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+                while (true) {
+                    res->reset();
+                    auto st = seg_iter->get_next(res.get());
+                    if (st.is_end_of_file()) {
+                        break;
+                    }
+                    ASSERT_OK(st);
+                    for (size_t i = 0; i < res->num_rows(); ++i) {
+                        auto row = res->get(i);
+                        const int32_t c0 = row[0].get_int32();
+                        ASSERT_EQ(c1_value(c0), row[1].get_int32());
+                        ASSERT_EQ(strs[c0], row[2].get_slice().to_string());
+                        rows.push_back(c0);
+                    }
+                }
+                seg_iter->close();
+
+                ASSERT_EQ(arrived ? passed_rows : all_rows, rows)
+                        << "column: " << c.column_index << ", arrived: " << arrived << ", ratio: " << ratio;
+                ASSERT_EQ(static_cast<int64_t>(num_rows - rows.size()), stats.rows_runtime_filter_filtered);
+                // the columns other than the one of the runtime filter are late materialized after the switch
+                if (arrived && ratio > 0) {
+                    ASSERT_GT(stats.late_materialize_ns, 0);
+                } else {
+                    ASSERT_EQ(0, stats.late_materialize_ns);
+                }
+            }
+        }
+    }
+}
+
 } // namespace starrocks
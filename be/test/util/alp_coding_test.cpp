@@ -0,0 +1,184 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/alp_coding.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace starrocks {
+
+class AlpCodingTest : public testing::Test {
+public:
+    // Encode |data| and check the decoded values are bitwise identical, return the encoded size.
+    template <typename T>
+    static size_t check_encode_decode(const std::vector<T>& data) {
+        faststring buffer;
+        AlpEncoder<T> encoder(&buffer);
+        // put the values by batches not aligned to the vectors
+        size_t pos = 0;
+        while (pos < data.size()) {
+            size_t n = std::min<size_t>(data.size() - pos, 777);
+            encoder.put_batch(data.data() + pos, n);
+            pos += n;
+        }
+        encoder.flush();
+        EXPECT_EQ(data.size(), encoder.count());
+
+        AlpDecoder<T> decoder(buffer.data(), buffer.size());
+        EXPECT_TRUE(decoder.init());
+        EXPECT_EQ(data.size(), decoder.count());
+        std::vector<T> actual(data.size());
+        pos = 0;
+        while (pos < data.size()) {
+            size_t n = std::min<size_t>(data.size() - pos, 1000);
+            EXPECT_TRUE(decoder.get_batch(actual.data() + pos, n));
+            pos += n;
+        }
+        for (size_t i = 0; i < data.size(); i++) {
+            EXPECT_EQ(0, memcmp(&data[i], &actual[i], sizeof(T))) << "mismatch at " << i;
+        }
+        return buffer.size();
+    }
+};
+
+TEST_F(AlpCodingTest, test_decimal_doubles) {
+    std::mt19937_64 rng(1);
+    std::vector<double> data;
+    for (int i = 0; i < 10000; i++) {
+        data.push_back(static_cast<double>(rng() % 1000000) / 100);
+    }
+    size_t size = check_encode_decode(data);
+    // 20 bits for each value
+    ASSERT_LT(size, data.size() * 3);
+}
+
+TEST_F(AlpCodingTest, test_decimal_floats) {
+    std::mt19937 rng(1);
+    std::vector<float> data;
+    for (int i = 0; i < 10000; i++) {
+        data.push_back(static_cast<float>(rng() % 100000) / 100);
+    }
+    size_t size = check_encode_decode(data);
+    ASSERT_LT(size, data.size() * sizeof(float) * 2 / 3);
+}
+
+TEST_F(AlpCodingTest, test_random_doubles) {
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<double> data;
+    for (int i = 0; i < 10000; i++) {
+        data.push_back(dist(rng));
+    }
+    size_t size = check_encode_decode(data);
+    // never much larger than the raw values
+    ASSERT_LT(size, data.size() * sizeof(double) + 1024);
+}
+
+TEST_F(AlpCodingTest, test_random_walk) {
+    std::mt19937_64 rng(1);
+    std::normal_distribution<double> dist(0, 0.001);
+    std::vector<double> data;
+    double value = 100;
+    for (int i = 0; i < 10000; i++) {
+        value += dist(rng);
+        data.push_back(value);
+    }
+    size_t size = check_encode_decode(data);
+    ASSERT_LT(size, data.size() * sizeof(double));
+}
+
+TEST_F(AlpCodingTest, test_special_values) {
+    std::vector<double> data;
+    for (int i = 0; i < 3000; i++) {
+        switch (i % 7) {
+        case 0:
+            data.push_back(std::numeric_limits<double>::quiet_NaN());
+            break;
+        case 1:
+            data.push_back(-0.0);
+            break;
+        case 2:
+            data.push_back(std::numeric_limits<double>::infinity());
+            break;
+        case 3:
+            data.push_back(std::numeric_limits<double>::max());
+            break;
+        case 4:
+            data.push_back(std::numeric_limits<double>::denorm_min());
+            break;
+        default:
+            data.push_back(i * 0.1);
+        }
+    }
+    check_encode_decode(data);
+
+    std::vector<float> floats;
+    for (double value : data) {
+        floats.push_back(static_cast<float>(value));
+    }
+    check_encode_decode(floats);
+}
+
+TEST_F(AlpCodingTest, test_small) {
+    check_encode_decode(std::vector<double>{});
+    check_encode_decode(std::vector<double>{1.5});
+    check_encode_decode(std::vector<float>{-2.25f, 3.0f});
+    std::vector<double> same(5000, 42.42);
+    size_t size = check_encode_decode(same);
+    ASSERT_LT(size, 200);
+}
+
+TEST_F(AlpCodingTest, test_seek) {
+    std::vector<double> data;
+    for (int i = 0; i < 5000; i++) {
+        data.push_back(i % 3 == 0 ? std::sqrt(i) : i * 0.25);
+    }
+    faststring buffer;
+    AlpEncoder<double> encoder(&buffer);
+    encoder.put_batch(data.data(), data.size());
+    encoder.flush();
+
+    AlpDecoder<double> decoder(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoder.init());
+    for (uint32_t pos : {4999, 0, 1023, 1024, 2500, 2501}) {
+        decoder.seek(pos);
+        double value;
+        ASSERT_TRUE(decoder.get_batch(&value, 1));
+        ASSERT_EQ(data[pos], value);
+        ASSERT_EQ(pos + 1, decoder.current_index());
+    }
+    decoder.seek(4999);
+    double values[2];
+    ASSERT_FALSE(decoder.get_batch(values, 2));
+}
+
+TEST_F(AlpCodingTest, test_corruption) {
+    std::vector<double> data(2000, 1.25);
+    faststring buffer;
+    AlpEncoder<double> encoder(&buffer);
+    encoder.put_batch(data.data(), data.size());
+    encoder.flush();
+
+    AlpDecoder<double> truncated(buffer.data() + 1, buffer.size() - 1);
+    ASSERT_FALSE(truncated.init());
+    AlpDecoder<double> empty(buffer.data(), 2);
+    ASSERT_FALSE(empty.init());
+}
+
+} // namespace starrocks
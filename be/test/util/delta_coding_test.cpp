@@ -0,0 +1,175 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/delta_coding.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+namespace starrocks {
+
+class DeltaCodingTest : public testing::Test {
+public:
+    // Encode |data| and check the decoded values, return the encoded size.
+    template <typename T>
+    static size_t check_encode_decode(const std::vector<T>& data) {
+        faststring buffer;
+        DeltaEncoder<T> encoder(&buffer);
+        // put the values by batches not aligned to the blocks
+        size_t pos = 0;
+        while (pos < data.size()) {
+            size_t n = std::min<size_t>(data.size() - pos, 333);
+            encoder.put_batch(data.data() + pos, n);
+            pos += n;
+        }
+        encoder.flush();
+        EXPECT_EQ(data.size(), encoder.count());
+
+        DeltaDecoder<T> decoder(buffer.data(), buffer.size());
+        EXPECT_TRUE(decoder.init());
+        EXPECT_EQ(data.size(), decoder.count());
+        std::vector<T> actual(data.size());
+        pos = 0;
+        while (pos < data.size()) {
+            size_t n = std::min<size_t>(data.size() - pos, 1000);
+            EXPECT_TRUE(decoder.get_batch(actual.data() + pos, n));
+            pos += n;
+        }
+        EXPECT_EQ(data, actual);
+        return buffer.size();
+    }
+};
+
+TEST_F(DeltaCodingTest, test_sorted) {
+    std::mt19937_64 rng(1);
+    std::vector<int64_t> data;
+    int64_t value = 1700000000000000L;
+    for (int i = 0; i < 10000; i++) {
+        value += rng() % 1000;
+        data.push_back(value);
+    }
+    size_t size = check_encode_decode(data);
+    // 10 bits for each value
+    ASSERT_LT(size, data.size() * 2);
+}
+
+TEST_F(DeltaCodingTest, test_constant_step) {
+    std::vector<int32_t> data;
+    for (int i = 0; i < 10000; i++) {
+        data.push_back(100 + i * 7);
+    }
+    size_t size = check_encode_decode(data);
+    // only the block headers
+    ASSERT_LT(size, data.size() / 8);
+}
+
+TEST_F(DeltaCodingTest, test_random) {
+    std::mt19937_64 rng(1);
+    std::vector<int64_t> longs;
+    std::vector<int32_t> ints;
+    for (int i = 0; i < 10000; i++) {
+        longs.push_back(static_cast<int64_t>(rng()));
+        ints.push_back(static_cast<int32_t>(rng()));
+    }
+    check_encode_decode(longs);
+    check_encode_decode(ints);
+}
+
+TEST_F(DeltaCodingTest, test_overflow) {
+    std::vector<int32_t> ints;
+    std::vector<int64_t> longs;
+    for (int i = 0; i < 1000; i++) {
+        ints.push_back(i % 2 == 0 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max());
+        longs.push_back(i % 3 == 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max() - i);
+    }
+    check_encode_decode(ints);
+    check_encode_decode(longs);
+}
+
+TEST_F(DeltaCodingTest, test_small) {
+    check_encode_decode(std::vector<int32_t>{});
+    check_encode_decode(std::vector<int32_t>{-5});
+    check_encode_decode(std::vector<int64_t>{3, 1});
+    std::vector<int32_t> data;
+    for (int i = 0; i < 257; i++) {
+        data.push_back(1000 - i);
+    }
+    check_encode_decode(data);
+}
+
+TEST_F(DeltaCodingTest, test_seek_and_bounds) {
+    std::vector<int32_t> data;
+    for (int i = 0; i < 1000; i++) {
+        data.push_back(i * 2);
+    }
+    faststring buffer;
+    DeltaEncoder<int32_t> encoder(&buffer);
+    encoder.put_batch(data.data(), data.size());
+    encoder.flush();
+
+    DeltaDecoder<int32_t> decoder(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoder.init());
+    for (uint32_t pos : {999, 0, 255, 256, 500, 501}) {
+        decoder.seek(pos);
+        int32_t value;
+        ASSERT_TRUE(decoder.get_batch(&value, 1));
+        ASSERT_EQ(data[pos], value);
+        ASSERT_EQ(pos + 1, decoder.current_index());
+    }
+
+    int32_t min;
+    int32_t max;
+    uint32_t num_remaining;
+    decoder.seek(300);
+    ASSERT_TRUE(decoder.current_block_bounds(&min, &max, &num_remaining));
+    ASSERT_EQ(512, min);
+    ASSERT_EQ(1022, max);
+    ASSERT_EQ(212, num_remaining);
+    decoder.advance(num_remaining);
+    ASSERT_TRUE(decoder.current_block_bounds(&min, &max, &num_remaining));
+    ASSERT_EQ(1024, min);
+    ASSERT_EQ(1534, max);
+    ASSERT_EQ(256, num_remaining);
+    decoder.seek(999);
+    ASSERT_TRUE(decoder.current_block_bounds(&min, &max, &num_remaining));
+    ASSERT_EQ(1536, min);
+    ASSERT_EQ(1998, max);
+    ASSERT_EQ(1, num_remaining);
+    decoder.seek(1000);
+    ASSERT_FALSE(decoder.current_block_bounds(&min, &max, &num_remaining));
+
+    decoder.seek(999);
+    int32_t values[2];
+    ASSERT_FALSE(decoder.get_batch(values, 2));
+}
+
+TEST_F(DeltaCodingTest, test_corruption) {
+    std::vector<int64_t> data;
+    for (int i = 0; i < 2000; i++) {
+        data.push_back(i * i);
+    }
+    faststring buffer;
+    DeltaEncoder<int64_t> encoder(&buffer);
+    encoder.put_batch(data.data(), data.size());
+    encoder.flush();
+
+    DeltaDecoder<int64_t> truncated(buffer.data(), buffer.size() - 1);
+    ASSERT_FALSE(truncated.init());
+    DeltaDecoder<int64_t> empty(buffer.data(), 2);
+    ASSERT_FALSE(empty.init());
+}
+
+} // namespace starrocks
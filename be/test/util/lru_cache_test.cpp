@@ -36,6 +36,9 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 using namespace starrocks;
@@ -348,4 +351,143 @@ TEST_F(CacheTest, SetCapacity) {
     ASSERT_EQ(32, _cache->get_memory_usage());
 }
 
+
+// The parameters are the evict policy and whether the cache is in read mostly mode.
+class CacheEvictPolicyTest : public testing::TestWithParam<std::tuple<CacheEvictPolicy, bool>> {
+public:
+    static void Deleter(const CacheKey& key, void* v) {}
+
+    static constexpr int kCacheSize = kNumShards * 1000;
+
+    CacheEvictPolicyTest()
+            : _cache(new_lru_cache(kCacheSize, ChargeMode::VALUESIZE, std::get<0>(GetParam()),
+                                   std::get<1>(GetParam()))) {}
+
+    bool Lookup(int key) {
+        std::string result;
+        Cache::Handle* handle = _cache->lookup(EncodeKey(&result, key));
+        if (handle != nullptr) {
+            _cache->release(handle);
+        }
+        return handle != nullptr;
+    }
+
+    void Insert(int key) {
+        std::string result;
+        _cache->release(_cache->insert(EncodeKey(&result, key), EncodeValue(key), 1, &CacheEvictPolicyTest::Deleter));
+    }
+
+protected:
+    std::unique_ptr<Cache> _cache;
+};
+
+TEST_P(CacheEvictPolicyTest, HitAndEvict) {
+    for (int i = 0; i < 2 * kCacheSize; i++) {
+        Insert(i);
+        ASSERT_TRUE(Lookup(i));
+    }
+    ASSERT_EQ(kCacheSize, _cache->get_memory_usage());
+    ASSERT_EQ(2 * kCacheSize, _cache->get_hit_count());
+
+    _cache->prune();
+    ASSERT_EQ(0, _cache->get_memory_usage());
+}
+
+TEST_P(CacheEvictPolicyTest, ScanResistant) {
+    // the hot entries are accessed repeatedly
+    for (int i = 0; i < 100; i++) {
+        Insert(i);
+        for (int j = 0; j < 5; j++) {
+            ASSERT_TRUE(Lookup(i));
+        }
+    }
+    // followed by a scan accessing each entry once
+    for (int i = 1000; i < 1000 + 2 * kCacheSize; i++) {
+        if (!Lookup(i)) {
+            Insert(i);
+        }
+    }
+    ASSERT_EQ(kCacheSize, _cache->get_memory_usage());
+
+    int num_hot_entries = 0;
+    for (int i = 0; i < 100; i++) {
+        num_hot_entries += Lookup(i);
+    }
+    if (std::get<0>(GetParam()) == CacheEvictPolicy::LRU) {
+        ASSERT_EQ(0, num_hot_entries);
+    } else {
+        // the count-min sketch may overestimate some scanned entries
+        ASSERT_GE(num_hot_entries, 95);
+    }
+    if (std::get<0>(GetParam()) == CacheEvictPolicy::W_TINY_LFU) {
+        ASSERT_GT(_cache->get_admission_reject_count(), 0);
+    } else {
+        ASSERT_EQ(0, _cache->get_admission_reject_count());
+    }
+}
+
+TEST_P(CacheEvictPolicyTest, PinnedEntriesNotEvicted) {
+    std::string result;
+    Cache::Handle* handle = _cache->insert(EncodeKey(&result, 0), EncodeValue(0), 1, &CacheEvictPolicyTest::Deleter);
+    for (int i = 1; i < 2 * kCacheSize; i++) {
+        Insert(i);
+    }
+    ASSERT_EQ(kCacheSize, _cache->get_memory_usage());
+    ASSERT_TRUE(Lookup(0));
+    _cache->prune();
+    ASSERT_EQ(1, _cache->get_memory_usage());
+    std::string erased;
+    _cache->erase(EncodeKey(&erased, 0));
+    ASSERT_FALSE(Lookup(0));
+    ASSERT_EQ(1, _cache->get_memory_usage());
+    _cache->release(handle);
+    ASSERT_EQ(0, _cache->get_memory_usage());
+}
+
+TEST_P(CacheEvictPolicyTest, ConcurrentAccess) {
+    static constexpr int kNumThreads = 8;
+    static constexpr int kNumKeys = 2 * kCacheSize;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < 20000; i++) {
+                const int key = (i * 7919 + t * 104729) % kNumKeys;
+                std::string result;
+                Cache::Handle* handle = _cache->lookup(EncodeKey(&result, key));
+                if (handle == nullptr) {
+                    handle = _cache->insert(EncodeKey(&result, key), EncodeValue(key), 1,
+                                            &CacheEvictPolicyTest::Deleter);
+                }
+                ASSERT_EQ(key, DecodeValue(_cache->value(handle)));
+                if (i % 100 == 0) {
+                    _cache->erase(EncodeKey(&result, key));
+                }
+                _cache->release(handle);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_LE(_cache->get_memory_usage(), kCacheSize);
+    _cache->prune();
+    ASSERT_EQ(0, _cache->get_memory_usage());
+}
+
+INSTANTIATE_TEST_SUITE_P(CacheEvictPolicyTest, CacheEvictPolicyTest,
+                         testing::Combine(testing::Values(CacheEvictPolicy::LRU, CacheEvictPolicy::TWO_QUEUE,
+                                                          CacheEvictPolicy::W_TINY_LFU),
+                                          testing::Bool()));
+
+TEST(CacheEvictPolicyParseTest, parse) {
+    CacheEvictPolicy policy;
+    ASSERT_TRUE(parse_cache_evict_policy("lru", &policy));
+    ASSERT_EQ(CacheEvictPolicy::LRU, policy);
+    ASSERT_TRUE(parse_cache_evict_policy("2q", &policy));
+    ASSERT_EQ(CacheEvictPolicy::TWO_QUEUE, policy);
+    ASSERT_TRUE(parse_cache_evict_policy("w-tinylfu", &policy));
+    ASSERT_EQ(CacheEvictPolicy::W_TINY_LFU, policy);
+    ASSERT_FALSE(parse_cache_evict_policy("arc", &policy));
+}
+
 } // namespace starrocks
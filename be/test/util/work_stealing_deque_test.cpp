@@ -0,0 +1,97 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/work_stealing_deque.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+TEST(WorkStealingDequeTest, test_owner_and_thief_order) {
+    WorkStealingDeque<int> deque(4);
+    ASSERT_TRUE(deque.empty());
+    ASSERT_FALSE(deque.pop().has_value());
+    ASSERT_FALSE(deque.steal().has_value());
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(deque.push(i));
+    }
+    // Full.
+    ASSERT_FALSE(deque.push(4));
+    ASSERT_EQ(4, deque.size());
+
+    // The owner takes from the bottom and the thieves take from the top.
+    ASSERT_EQ(3, deque.pop().value());
+    ASSERT_EQ(0, deque.steal().value());
+    ASSERT_EQ(1, deque.steal().value());
+    ASSERT_EQ(2, deque.pop().value());
+    ASSERT_TRUE(deque.empty());
+
+    // Wrap around the ring buffer.
+    for (int i = 0; i < 16; i++) {
+        ASSERT_TRUE(deque.push(i));
+        ASSERT_EQ(i, deque.steal().value());
+    }
+    ASSERT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, test_concurrent_steal) {
+    constexpr int kNumItems = 200000;
+    constexpr int kNumThieves = 4;
+
+    WorkStealingDeque<int> deque(1024);
+    std::vector<std::atomic<int>> taken_times(kNumItems);
+    std::atomic<int> num_taken = 0;
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < kNumThieves; i++) {
+        thieves.emplace_back([&] {
+            while (num_taken.load() < kNumItems) {
+                if (auto item = deque.steal(); item.has_value()) {
+                    taken_times[item.value()]++;
+                    num_taken++;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < kNumItems; i++) {
+        while (!deque.push(i)) {
+            if (auto item = deque.pop(); item.has_value()) {
+                taken_times[item.value()]++;
+                num_taken++;
+            }
+        }
+    }
+    while (auto item = deque.pop()) {
+        taken_times[item.value()]++;
+        num_taken++;
+    }
+
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    // Every element is taken exactly once.
+    ASSERT_EQ(kNumItems, num_taken.load());
+    for (int i = 0; i < kNumItems; i++) {
+        ASSERT_EQ(1, taken_times[i].load());
+    }
+}
+
+} // namespace starrocks
@@ -129,9 +129,10 @@ public class HashJoinNode extends JoinNode {
             } else {
                 msg.hash_join_node.setEnable_partition_hash_join(false);
             }
-        } else {
+        } else if (sv.enablePartitionHashJoin() || !sv.enableAutoPartitionHashJoin()) {
             msg.hash_join_node.setEnable_partition_hash_join(sv.enablePartitionHashJoin());
         }
+        // Otherwise it's left unset, and the backend turns it on for the large build sides.
         msg.hash_join_node.setBuild_runtime_filters_from_planner(sv.getEnableGlobalRuntimeFilter());
 
         if (partitionExprs != null) {
@@ -294,6 +294,7 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
 
     public static final String JOIN_LATE_MATERIALIZATION = "join_late_materialization";
     public static final String ENABLE_PARTITION_HASH_JOIN = "enable_partition_hash_join";
+    public static final String ENABLE_AUTO_PARTITION_HASH_JOIN = "enable_auto_partition_hash_join";
 
     public static final String ENABLE_PRUNE_COLUMN_AFTER_INDEX_FILTER =
             "enable_prune_column_after_index_filter";
@@ -1168,9 +1169,10 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VarAttr(name = SPILL_REVOCABLE_MAX_BYTES)
     private long spillRevocableMaxBytes = 0;
     // the encoding level of spilled data, the meaning of values is similar to transmission_encode_level,
-    // see more details in the comment above transmissionEncodeLevel
+    // see more details in the comment above transmissionEncodeLevel.
+    // the spilled data is only read by the BE which writes it, so the codecs chosen by the data (8) are enabled.
     @VarAttr(name = SPILL_ENCODE_LEVEL)
-    private int spillEncodeLevel = 7;
+    private int spillEncodeLevel = 15;
 
     @VarAttr(name = SPILL_ENABLE_DIRECT_IO)
     private boolean spillEnableDirectIO = false;
@@ -1249,6 +1251,11 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = ENABLE_PARTITION_HASH_JOIN)
     private boolean enablePartitionHashJoin = false;
 
+    // If enable_partition_hash_join is false, let the backend turn on the partitioned hash join for the large
+    // build sides, see be config auto_partition_hash_join_min_build_bytes.
+    @VariableMgr.VarAttr(name = ENABLE_AUTO_PARTITION_HASH_JOIN)
+    private boolean enableAutoPartitionHashJoin = true;
+
     @VariableMgr.VarAttr(name = ENABLE_PRUNE_COLUMN_AFTER_INDEX_FILTER, flag = VariableMgr.INVISIBLE)
     private boolean enablePruneColumnAfterIndexFilter = true;
 
@@ -1333,6 +1340,8 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     // if transmission_encode_level & 2, intergers are encode by streamvbyte, in order or not;
     // if transmission_encode_level & 4, binary columns are compressed by lz4
     // if transmission_encode_level & 1, enable adaptive encoding.
+    // if transmission_encode_level & 8, the codec of each column is chosen by its data: integers and null flags are
+    // bit packed or run length encoded, and low cardinality strings are dictionary encoded;
     // e.g.
     // if transmission_encode_level = 7, SR will adaptively encode numbers and string columns according to the proper encoding
     // ratio(< 0.9);
@@ -2895,6 +2904,10 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         return enablePartitionHashJoin;
     }
 
+    public boolean enableAutoPartitionHashJoin() {
+        return enableAutoPartitionHashJoin;
+    }
+
     public void disableTrimOnlyFilteredColumnsInScanStage() {
         this.enableFilterUnusedColumnsInScanStage = false;
     }